@@ -0,0 +1,139 @@
+/* Measure memcpy_hint functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "memcpy_hint"
+#include "bench-string.h"
+
+#include "json-lib.h"
+
+typedef void *(*proto_t) (void *, const void *, size_t);
+
+void *copy_plain (void *, const void *, size_t);
+void *copy_nontemporal (void *, const void *, size_t);
+void *copy_dest_hot (void *, const void *, size_t);
+void *copy_prefetch (void *, const void *, size_t);
+
+IMPL (copy_plain, 0)
+IMPL (copy_nontemporal, 1)
+IMPL (copy_dest_hot, 0)
+IMPL (copy_prefetch, 0)
+
+void *
+copy_plain (void *dest, const void *src, size_t n)
+{
+  return memcpy (dest, src, n);
+}
+
+void *
+copy_nontemporal (void *dest, const void *src, size_t n)
+{
+  return memcpy_hint (dest, src, n, MEMCPY_HINT_NONTEMPORAL);
+}
+
+void *
+copy_dest_hot (void *dest, const void *src, size_t n)
+{
+  return memcpy_hint (dest, src, n, MEMCPY_HINT_DEST_HOT);
+}
+
+void *
+copy_prefetch (void *dest, const void *src, size_t n)
+{
+  return memcpy_hint (dest, src, n, MEMCPY_HINT_PREFETCH (1024));
+}
+
+#define MAX_LEN (64 * 1024 * 1024)
+
+static char *src_buf;
+static char *dst_buf;
+
+static void
+do_one_test (json_ctx_t *json_ctx, impl_t *impl, size_t len)
+{
+  size_t i, iters = 16;
+  timing_t start, stop, cur;
+
+  /* Warm up.  */
+  CALL (impl, dst_buf, src_buf, len);
+
+  TIMING_NOW (start);
+  for (i = 0; i < iters; ++i)
+    CALL (impl, dst_buf, src_buf, len);
+  TIMING_NOW (stop);
+
+  TIMING_DIFF (cur, start, stop);
+
+  json_element_double (json_ctx, (double) cur / (double) iters);
+}
+
+static void
+do_test (json_ctx_t *json_ctx, size_t len)
+{
+  json_element_object_begin (json_ctx);
+  json_attr_uint (json_ctx, "length", len);
+  json_array_begin (json_ctx, "timings");
+
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (json_ctx, impl, len);
+
+  json_array_end (json_ctx);
+  json_element_object_end (json_ctx);
+}
+
+int
+test_main (void)
+{
+  json_ctx_t json_ctx;
+
+  test_init ();
+
+  src_buf = xmalloc (MAX_LEN);
+  dst_buf = xmalloc (MAX_LEN);
+  memset (src_buf, 0x5a, MAX_LEN);
+  memset (dst_buf, 0xa5, MAX_LEN);
+
+  json_init (&json_ctx, 0, stdout);
+
+  json_document_begin (&json_ctx);
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, TEST_NAME);
+  json_attr_string (&json_ctx, "bench-variant", "");
+
+  json_array_begin (&json_ctx, "ifuncs");
+  FOR_EACH_IMPL (impl, 0)
+    json_element_string (&json_ctx, impl->name);
+  json_array_end (&json_ctx);
+
+  json_array_begin (&json_ctx, "results");
+  for (size_t len = 64 * 1024; len <= MAX_LEN; len *= 4)
+    do_test (&json_ctx, len);
+  json_array_end (&json_ctx);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  free (dst_buf);
+  free (src_buf);
+  return ret;
+}
+
+#include <support/test-driver.c>
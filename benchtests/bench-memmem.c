@@ -198,6 +198,48 @@ do_random_tests (json_ctx_t *json_ctx)
     }
 }
 
+/* Search a 16-page haystack for a needle of NE_LEN bytes whose first
+   and last bytes occur together every PERIOD bytes, so that PERIOD
+   controls how often a candidate position has to be verified.  The
+   second byte of the needle does not occur elsewhere, so the only full
+   match is at the end of the haystack.  */
+static void
+do_sweep_test (json_ctx_t *json_ctx, size_t ne_len, size_t period)
+{
+  size_t hs_len = 16 * page_size;
+  char *hs = (char *) buf1;
+  char ne[ne_len];
+
+  for (size_t i = 0; i < hs_len; ++i)
+    hs[i] = 60 + random () % 32;
+  for (size_t i = 0; i < ne_len; ++i)
+    ne[i] = 60 + random () % 32;
+  ne[0] = '{';
+  ne[1] = '|';
+  ne[ne_len - 1] = '}';
+  for (size_t i = 0; i + ne_len < hs_len - 2 * ne_len; i += period)
+    {
+      hs[i] = '{';
+      hs[i + ne_len - 1] = '}';
+    }
+  memcpy (hs + hs_len - ne_len, ne, ne_len);
+
+  json_element_object_begin (json_ctx);
+  json_attr_uint (json_ctx, "len_haystack", hs_len);
+  json_attr_uint (json_ctx, "len_needle", ne_len);
+  json_attr_uint (json_ctx, "candidate_period", period);
+  json_attr_uint (json_ctx, "fail", 0);
+
+  json_array_begin (json_ctx, "timings");
+
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (json_ctx, impl, hs, hs_len, ne, ne_len,
+		 hs + hs_len - ne_len);
+
+  json_array_end (json_ctx);
+  json_element_object_end (json_ctx);
+}
+
 static const char *const strs[] =
   {
     "00000", "00112233", "0123456789", "0000111100001111",
@@ -241,6 +283,10 @@ test_main (void)
 
   do_random_tests (&json_ctx);
 
+  for (size_t ne_len = 3; ne_len <= 256; ne_len *= 2)
+    for (size_t period = 4096; period >= 1; period /= 8)
+      do_sweep_test (&json_ctx, ne_len, period);
+
   json_array_end (&json_ctx);
   json_attr_object_end (&json_ctx);
   json_attr_object_end (&json_ctx);
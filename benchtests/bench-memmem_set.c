@@ -0,0 +1,160 @@
+/* Measure memmem_set_search functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "memmem_set_search"
+#define BUF1PAGES 16
+#include "bench-string.h"
+
+#include "json-lib.h"
+
+typedef void *(*proto_t) (const struct memmem_set *, const void *, size_t,
+			  size_t *);
+
+void *loop_memmem (const struct memmem_set *, const void *, size_t,
+		   size_t *);
+
+IMPL (loop_memmem, 0)
+IMPL (memmem_set_search, 1)
+
+#define MAX_NEEDLES 128
+#define MAX_NEEDLE_LEN 12
+
+static const void *needles[MAX_NEEDLES];
+static size_t needlelens[MAX_NEEDLES];
+static size_t nneedles;
+static char needle_buf[MAX_NEEDLES][MAX_NEEDLE_LEN];
+
+/* The loop over memmem which memmem_set_search replaces.  */
+void *
+loop_memmem (const struct memmem_set *set, const void *haystack,
+	     size_t haystacklen, size_t *index)
+{
+  const char *best = NULL;
+  for (size_t i = 0; i < nneedles; i++)
+    {
+      /* Only search up to the best match so far.  */
+      size_t len = haystacklen;
+      if (best != NULL)
+	len = best - (const char *) haystack + needlelens[i] - 1;
+      const char *p = memmem (haystack, len, needles[i], needlelens[i]);
+      if (p != NULL)
+	{
+	  best = p;
+	  *index = i;
+	}
+    }
+  return (void *) best;
+}
+
+static void
+do_one_test (json_ctx_t *json_ctx, impl_t *impl,
+	     const struct memmem_set *set, const char *hs, size_t len)
+{
+  size_t i, iters = INNER_LOOP_ITERS_SMALL / 8;
+  size_t index;
+  timing_t start, stop, cur;
+
+  TIMING_NOW (start);
+  for (i = 0; i < iters; ++i)
+    CALL (impl, set, hs, len, &index);
+  TIMING_NOW (stop);
+
+  TIMING_DIFF (cur, start, stop);
+
+  json_element_double (json_ctx, (double) cur / (double) iters);
+}
+
+/* Search a haystack of LEN random lower case letters for COUNT needles
+   of 4 to MAX_NEEDLE_LEN bytes.  The needles are random lower case
+   letters followed by '#', and the only match is at the end of the
+   haystack.  */
+static void
+do_test (json_ctx_t *json_ctx, size_t n, size_t len)
+{
+  if (len > BUF1PAGES * page_size)
+    return;
+
+  nneedles = n;
+  for (size_t i = 0; i < n; i++)
+    {
+      needlelens[i] = 4 + random () % (MAX_NEEDLE_LEN - 3);
+      for (size_t j = 0; j < needlelens[i] - 1; j++)
+	needle_buf[i][j] = 'a' + random () % 26;
+      needle_buf[i][needlelens[i] - 1] = '#';
+      needles[i] = needle_buf[i];
+    }
+  struct memmem_set *set = memmem_set_compile (needles, needlelens, n);
+  if (set == NULL)
+    error (EXIT_FAILURE, errno, "memmem_set_compile");
+
+  char *hs = (char *) buf1;
+  for (size_t i = 0; i < len; i++)
+    hs[i] = 'a' + random () % 26;
+  size_t last = n - 1;
+  memcpy (hs + len - needlelens[last], needles[last], needlelens[last]);
+
+  json_element_object_begin (json_ctx);
+  json_attr_uint (json_ctx, "needles", n);
+  json_attr_uint (json_ctx, "length", len);
+  json_array_begin (json_ctx, "timings");
+
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (json_ctx, impl, set, hs, len);
+
+  json_array_end (json_ctx);
+  json_element_object_end (json_ctx);
+
+  memmem_set_free (set);
+}
+
+int
+test_main (void)
+{
+  json_ctx_t json_ctx;
+
+  test_init ();
+
+  json_init (&json_ctx, 0, stdout);
+
+  json_document_begin (&json_ctx);
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, TEST_NAME);
+  json_attr_string (&json_ctx, "bench-variant", "");
+
+  json_array_begin (&json_ctx, "ifuncs");
+  FOR_EACH_IMPL (impl, 0)
+    json_element_string (&json_ctx, impl->name);
+  json_array_end (&json_ctx);
+
+  json_array_begin (&json_ctx, "results");
+  for (size_t n = 1; n <= MAX_NEEDLES; n *= 2)
+    for (size_t len = 64; len <= 65536; len *= 4)
+      do_test (&json_ctx, n, len);
+  json_array_end (&json_ctx);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  return ret;
+}
+
+#include <support/test-driver.c>
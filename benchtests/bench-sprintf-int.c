@@ -0,0 +1,99 @@
+/* Measure integer conversions of sprintf.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "sprintf-int"
+
+#include <stdio.h>
+#include "bench-timing.h"
+
+#undef INNER_LOOP_ITERS
+#define INNER_LOOP_ITERS 131072
+
+/* Values of different magnitudes, as written by metrics exporters and
+   CSV writers.  */
+static const long long int values[] =
+{
+  0, 7, 42, 404, 8080, 65536, 1234567, 2147483647, 4294967295LL,
+  1660000000123LL, 9223372036854775807LL
+};
+
+#define NVALUES (sizeof (values) / sizeof (values[0]))
+
+static const struct
+{
+  const char *name;
+  const char *format;
+} formats[] =
+{
+  { "%d", "%d" },
+  { "%u", "%u" },
+  { "%x", "%x" },
+  { "%ld", "%ld" },
+  { "%lx", "%lx" },
+  { "%lld", "%lld" },
+  { "%d,%d,%d", "%d,%d,%d" },
+};
+
+int
+do_bench (void)
+{
+  const size_t iters = INNER_LOOP_ITERS;
+  char buf[128];
+
+  for (size_t i = 0; i < sizeof (formats) / sizeof (formats[0]); ++i)
+    {
+      const char *format = formats[i].format;
+      timing_t start, stop, cur;
+
+      printf ("Format %-23s:", formats[i].name);
+      TIMING_NOW (start);
+      for (size_t j = 0; j < iters; ++j)
+	{
+	  long long int v = values[j % NVALUES];
+	  switch (i)
+	    {
+	    case 0:
+	    case 1:
+	    case 2:
+	      sprintf (buf, format, (int) v);
+	      break;
+	    case 3:
+	    case 4:
+	      sprintf (buf, format, (long int) v);
+	      break;
+	    case 5:
+	      sprintf (buf, format, v);
+	      break;
+	    default:
+	      sprintf (buf, format, (int) v, (int) (v >> 3), (int) (v >> 7));
+	    }
+	}
+      TIMING_NOW (stop);
+
+      TIMING_DIFF (cur, start, stop);
+      TIMING_PRINT_MEAN ((double) cur, (double) iters);
+      putchar ('\n');
+    }
+
+  return 0;
+}
+
+#define TEST_FUNCTION do_bench ()
+
+#include "../test-skeleton.c"
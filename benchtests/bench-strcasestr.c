@@ -97,6 +97,36 @@ do_test (size_t align1, size_t align2, size_t len1, size_t len2,
   putchar ('\n');
 }
 
+/* Search a haystack of LEN1 bytes for a needle of LEN2 bytes whose
+   first and last letters occur, in the other case, every PERIOD bytes.
+   The only full match is at the end of the haystack.  */
+static void
+do_sweep_test (size_t len1, size_t len2, size_t period)
+{
+  char *s1 = (char *) buf1;
+  char *s2 = (char *) buf2;
+
+  memset (s2, '-', len2);
+  s2[0] = 'q';
+  s2[len2 - 1] = 'z';
+  s2[len2] = '\0';
+  memset (s1, '0', len1);
+  for (size_t i = 0; i + len2 < len1 - 2 * len2; i += period)
+    {
+      s1[i] = 'Q';
+      s1[i + len2 - 1] = 'Z';
+    }
+  memcpy (s1 + len1 - len2, s2, len2);
+  s1[len1] = '\0';
+
+  printf ("Length %4zd/%zd, period %4zd, found:", len1, len2, period);
+
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (impl, s1, s2, s1 + len1 - len2);
+
+  putchar ('\n');
+}
+
 static int
 test_main (void)
 {
@@ -150,6 +180,10 @@ test_main (void)
   do_test (0, 0, page_size - 1, 16, 0);
   do_test (0, 0, page_size - 1, 16, 1);
 
+  for (size_t len2 = 3; len2 <= 256; len2 *= 2)
+    for (size_t period = 2048; period >= 1; period /= 8)
+      do_sweep_test (page_size - 1, len2, period);
+
   return ret;
 }
 
@@ -154,6 +154,11 @@ test_main (void)
       do_test (i, i, 8 << i, 10, BIG_CHAR);
     }
 
+  /* Short strings at all alignments of source and destination.  */
+  for (i = 17; i < 64; i += 3)
+    for (size_t j = 0; j < 8; ++j)
+      do_test (j, 7 - j, i, 16, SMALL_CHAR);
+
   return ret;
 }
 
@@ -0,0 +1,141 @@
+/* Measure strcmp_batch functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "strcmp_batch"
+#define BUF1PAGES 16
+#include "bench-string.h"
+
+#include "json-lib.h"
+
+typedef void (*proto_t) (int *, const char *const *, const char *const *,
+			 size_t);
+
+void loop_strcmp (int *, const char *const *, const char *const *, size_t);
+
+IMPL (loop_strcmp, 0)
+IMPL (strcmp_batch, 1)
+
+/* The loop which strcmp_batch replaces.  */
+void
+loop_strcmp (int *results, const char *const *s1, const char *const *s2,
+	     size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    results[i] = strcmp (s1[i], s2[i]);
+}
+
+#define NPAIRS 128
+
+static const char *s1[NPAIRS];
+static const char *s2[NPAIRS];
+static int results[NPAIRS];
+
+static void
+do_one_test (json_ctx_t *json_ctx, impl_t *impl)
+{
+  size_t i, iters = INNER_LOOP_ITERS_SMALL;
+  timing_t start, stop, cur;
+
+  TIMING_NOW (start);
+  for (i = 0; i < iters; ++i)
+    CALL (impl, results, s1, s2, NPAIRS);
+  TIMING_NOW (stop);
+
+  TIMING_DIFF (cur, start, stop);
+
+  json_element_double (json_ctx, (double) cur / (double) iters);
+}
+
+/* NPAIRS pairs of strings with lengths between MIN_LEN and MAX_LEN at
+   random alignments.  The strings of a pair are equal with probability
+   1 / EQUAL and differ at a random position otherwise.  */
+static void
+do_test (json_ctx_t *json_ctx, size_t min_len, size_t max_len,
+	 unsigned int equal)
+{
+  size_t slot = (BUF1PAGES * page_size) / (2 * NPAIRS);
+  if (max_len + 64 > slot)
+    return;
+
+  for (size_t i = 0; i < NPAIRS; i++)
+    {
+      size_t len = min_len + random () % (max_len - min_len + 1);
+      char *p1 = (char *) buf1 + 2 * i * slot + random () % 64;
+      char *p2 = (char *) buf1 + (2 * i + 1) * slot + random () % 64;
+      for (size_t j = 0; j < len; j++)
+	p1[j] = p2[j] = 'a' + (i + j) % 26;
+      p1[len] = p2[len] = '\0';
+      if (len > 0 && random () % equal != 0)
+	p2[random () % len] = '_';
+      s1[i] = p1;
+      s2[i] = p2;
+    }
+
+  json_element_object_begin (json_ctx);
+  json_attr_uint (json_ctx, "pairs", NPAIRS);
+  json_attr_uint (json_ctx, "min-length", min_len);
+  json_attr_uint (json_ctx, "max-length", max_len);
+  json_attr_uint (json_ctx, "equal", equal);
+  json_array_begin (json_ctx, "timings");
+
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (json_ctx, impl);
+
+  json_array_end (json_ctx);
+  json_element_object_end (json_ctx);
+}
+
+int
+test_main (void)
+{
+  json_ctx_t json_ctx;
+
+  test_init ();
+
+  json_init (&json_ctx, 0, stdout);
+
+  json_document_begin (&json_ctx);
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, TEST_NAME);
+  json_attr_string (&json_ctx, "bench-variant", "");
+
+  json_array_begin (&json_ctx, "ifuncs");
+  FOR_EACH_IMPL (impl, 0)
+    json_element_string (&json_ctx, impl->name);
+  json_array_end (&json_ctx);
+
+  json_array_begin (&json_ctx, "results");
+  for (size_t len = 1; len <= 256; len *= 2)
+    {
+      do_test (&json_ctx, len, len, 1);
+      do_test (&json_ctx, 0, len, 2);
+      do_test (&json_ctx, 0, len, 8);
+    }
+  json_array_end (&json_ctx);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  return ret;
+}
+
+#include <support/test-driver.c>
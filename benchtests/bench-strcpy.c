@@ -168,6 +168,17 @@ test_main (void)
       do_test (7, 5, i, SMALL_CHAR);
     }
 
+  /* Short strings at all alignments of source and destination.  */
+  for (i = 17; i < 64; i += 3)
+    for (size_t j = 0; j < 8; ++j)
+      do_test (j, 7 - j, i, SMALL_CHAR);
+
+  for (i = 1024; i * sizeof (CHAR) < page_size; i *= 2)
+    {
+      do_test (0, 0, i, SMALL_CHAR);
+      do_test (3, 5, i, SMALL_CHAR);
+    }
+
   return ret;
 }
 
@@ -0,0 +1,130 @@
+/* Measure strlen_batch functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "strlen_batch"
+#define BUF1PAGES 16
+#include "bench-string.h"
+
+#include "json-lib.h"
+
+typedef void (*proto_t) (size_t *, const char *const *, size_t);
+
+void loop_strlen (size_t *, const char *const *, size_t);
+
+IMPL (loop_strlen, 0)
+IMPL (strlen_batch, 1)
+
+/* The loop which strlen_batch replaces.  */
+void
+loop_strlen (size_t *lengths, const char *const *strings, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    lengths[i] = strlen (strings[i]);
+}
+
+#define NSTRINGS 256
+
+static const char *strings[NSTRINGS];
+static size_t lengths[NSTRINGS];
+
+static void
+do_one_test (json_ctx_t *json_ctx, impl_t *impl)
+{
+  size_t i, iters = INNER_LOOP_ITERS_SMALL;
+  timing_t start, stop, cur;
+
+  TIMING_NOW (start);
+  for (i = 0; i < iters; ++i)
+    CALL (impl, lengths, strings, NSTRINGS);
+  TIMING_NOW (stop);
+
+  TIMING_DIFF (cur, start, stop);
+
+  json_element_double (json_ctx, (double) cur / (double) iters);
+}
+
+/* NSTRINGS strings with lengths between MIN_LEN and MAX_LEN at random
+   alignments.  */
+static void
+do_test (json_ctx_t *json_ctx, size_t min_len, size_t max_len)
+{
+  size_t slot = (BUF1PAGES * page_size) / NSTRINGS;
+  if (max_len + 64 > slot)
+    return;
+
+  for (size_t i = 0; i < NSTRINGS; i++)
+    {
+      size_t len = min_len + random () % (max_len - min_len + 1);
+      char *s = (char *) buf1 + i * slot + random () % 64;
+      memset (s, 'a' + i % 26, len);
+      s[len] = '\0';
+      strings[i] = s;
+    }
+
+  json_element_object_begin (json_ctx);
+  json_attr_uint (json_ctx, "strings", NSTRINGS);
+  json_attr_uint (json_ctx, "min-length", min_len);
+  json_attr_uint (json_ctx, "max-length", max_len);
+  json_array_begin (json_ctx, "timings");
+
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (json_ctx, impl);
+
+  json_array_end (json_ctx);
+  json_element_object_end (json_ctx);
+}
+
+int
+test_main (void)
+{
+  json_ctx_t json_ctx;
+
+  test_init ();
+
+  json_init (&json_ctx, 0, stdout);
+
+  json_document_begin (&json_ctx);
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, TEST_NAME);
+  json_attr_string (&json_ctx, "bench-variant", "");
+
+  json_array_begin (&json_ctx, "ifuncs");
+  FOR_EACH_IMPL (impl, 0)
+    json_element_string (&json_ctx, impl->name);
+  json_array_end (&json_ctx);
+
+  json_array_begin (&json_ctx, "results");
+  for (size_t len = 1; len <= 256; len *= 2)
+    {
+      do_test (&json_ctx, len, len);
+      do_test (&json_ctx, 0, len);
+    }
+  do_test (&json_ctx, 0, 400);
+  json_array_end (&json_ctx);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  return ret;
+}
+
+#include <support/test-driver.c>
@@ -163,6 +163,15 @@ test_main (void)
       do_test (8 - i, 2 * i, 16 << i, 8 << i, SMALL_CHAR);
     }
 
+  /* Short strings at all alignments of source and destination, with
+     and without padding.  */
+  for (i = 17; i < 64; i += 3)
+    for (size_t j = 0; j < 8; ++j)
+      {
+	do_test (j, 7 - j, i, i + 16, SMALL_CHAR);
+	do_test (j, 7 - j, i + 16, i, SMALL_CHAR);
+      }
+
   return ret;
 }
 
@@ -85,6 +85,44 @@ static const char *inputs[] =
   NULL
 };
 
+/* Corpora of the numbers found in typical CSV and JSON data.  */
+static const char *short_decimals[] =
+{
+  "0", "1", "42", "-7", "0.5", "-0.75", "3.14", "12.25", "99.99",
+  "100.0", "0.001", "1234.5678", "-273.15", "0.1", "0.2", "0.3",
+  "65536", "1.5", "2.75", "-0.0625", "37.7749", "-122.4194", "19.99",
+  "0.07", NULL
+};
+
+static const char *long_mantissas[] =
+{
+  "0.30000000000000004", "3.141592653589793", "2.718281828459045",
+  "1.4142135623730951", "0.6931471805599453", "-0.5772156649015329",
+  "1.618033988749895", "9007199254740993", "4.123456789012345e-05",
+  "123456.78901234567", "0.1234567890123456789",
+  "12345678901234567890123", "3.14159265358979323846264338327950",
+  "2.2250738585072011e-308", NULL
+};
+
+static const char *exponents[] =
+{
+  "6.02214076e23", "1.602176634e-19", "6.62607015e-34",
+  "9.1093837015e-31", "2.99792458e8", "6.674e-11", "1e300", "1e-300",
+  "5e-324", "1.7976931348623157e308", "2.5e-150", "7.2e+88",
+  "-4.2e-7", "1E10", "3.0e-5", "8.854187817e-12", NULL
+};
+
+static const struct
+{
+  const char *name;
+  const char **inputs;
+} corpora[] =
+{
+  { "short", short_decimals },
+  { "long", long_mantissas },
+  { "exponent", exponents },
+};
+
 int
 do_bench (void)
 {
@@ -106,6 +144,27 @@ do_bench (void)
       putchar ('\n');
     }
 
+  for (size_t i = 0; i < sizeof (corpora) / sizeof (corpora[0]); ++i)
+    {
+      const char **corpus = corpora[i].inputs;
+      size_t n = 0;
+      char *ep;
+      timing_t start, stop, cur;
+
+      while (corpus[n] != NULL)
+	++n;
+
+      printf ("Corpus %-23s:", corpora[i].name);
+      TIMING_NOW (start);
+      for (size_t j = 0; j < iters; ++j)
+	strtod (corpus[j % n], &ep);
+      TIMING_NOW (stop);
+
+      TIMING_DIFF (cur, start, stop);
+      TIMING_PRINT_MEAN ((double) cur, (double) iters);
+      putchar ('\n');
+    }
+
   return 0;
 }
 
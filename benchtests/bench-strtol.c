@@ -0,0 +1,116 @@
+/* Measure strtol, strtoul and strtoll.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "strtol"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench-timing.h"
+
+#undef INNER_LOOP_ITERS
+#define INNER_LOOP_ITERS 131072
+
+/* Numbers as found in typical CSV and log data.  */
+static const char *short_numbers[] =
+{
+  "0", "1", "42", "-7", "255", "1000", "-273", "65536", "99", "8080",
+  "404", "-1", NULL
+};
+
+static const char *medium_numbers[] =
+{
+  "1234567", "-98765432", "2147483647", "-2147483648", "4294967295",
+  "1660000000", "31415926", "100000000", NULL
+};
+
+static const char *long_numbers[] =
+{
+  "9223372036854775807", "-9223372036854775808", "1234567890123456",
+  "18446744073709551615", "1660000000123456789", "99999999999999999",
+  NULL
+};
+
+static const char *hex_numbers[] =
+{
+  "ff", "0x7fffffff", "deadbeef", "0x1234", "CAFEBABE", "0", NULL
+};
+
+static const struct
+{
+  const char *name;
+  const char **inputs;
+  int base;
+} corpora[] =
+{
+  { "short", short_numbers, 10 },
+  { "medium", medium_numbers, 10 },
+  { "long", long_numbers, 10 },
+  { "hex", hex_numbers, 16 },
+};
+
+int
+do_bench (void)
+{
+  const size_t iters = INNER_LOOP_ITERS;
+
+  for (size_t i = 0; i < sizeof (corpora) / sizeof (corpora[0]); ++i)
+    {
+      const char **corpus = corpora[i].inputs;
+      int base = corpora[i].base;
+      size_t n = 0;
+      char *ep;
+      timing_t start, stop, cur;
+
+      while (corpus[n] != NULL)
+	++n;
+
+      printf ("strtol %-24s:", corpora[i].name);
+      TIMING_NOW (start);
+      for (size_t j = 0; j < iters; ++j)
+	strtol (corpus[j % n], &ep, base);
+      TIMING_NOW (stop);
+      TIMING_DIFF (cur, start, stop);
+      TIMING_PRINT_MEAN ((double) cur, (double) iters);
+      putchar ('\n');
+
+      printf ("strtoul %-23s:", corpora[i].name);
+      TIMING_NOW (start);
+      for (size_t j = 0; j < iters; ++j)
+	strtoul (corpus[j % n], &ep, base);
+      TIMING_NOW (stop);
+      TIMING_DIFF (cur, start, stop);
+      TIMING_PRINT_MEAN ((double) cur, (double) iters);
+      putchar ('\n');
+
+      printf ("strtoll %-23s:", corpora[i].name);
+      TIMING_NOW (start);
+      for (size_t j = 0; j < iters; ++j)
+	strtoll (corpus[j % n], &ep, base);
+      TIMING_NOW (stop);
+      TIMING_DIFF (cur, start, stop);
+      TIMING_PRINT_MEAN ((double) cur, (double) iters);
+      putchar ('\n');
+    }
+
+  return 0;
+}
+
+#define TEST_FUNCTION do_bench ()
+
+#include "../test-skeleton.c"
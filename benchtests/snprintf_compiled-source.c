@@ -0,0 +1,28 @@
+#include <printf.h>
+#include <stdarg.h>
+#include "sprintf-source.c"
+
+/* Call vsnprintf_compiled with the format compiled on first use, so
+   that the same inputs as for snprintf can be used.  */
+static int
+bench_snprintf_compiled (char *s, size_t maxlen, const char *format, ...)
+{
+  static const char *formats[16];
+  static struct printf_compiled *compiled[16];
+  size_t i;
+
+  for (i = 0; formats[i] != NULL && formats[i] != format; ++i)
+    ;
+  if (formats[i] == NULL)
+    {
+      compiled[i] = printf_compile (format);
+      formats[i] = format;
+    }
+
+  va_list ap;
+  va_start (ap, format);
+  int ret = vsnprintf_compiled (s, maxlen, compiled[i], ap);
+  va_end (ap);
+  return ret;
+}
+#define snprintf_compiled bench_snprintf_compiled
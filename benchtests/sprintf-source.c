@@ -2,5 +2,12 @@
 #define FORMAT1 "   %1$d: %2$c%3$c%4$c%5$c%6$c %7$20s %8$f (%9$02x)\n"
 /* A matching, but arbitrarily selected, set of non-positional format specifiers.  */
 #define FORMAT2 "   %d: %c%c%c%c%c %20s %f (%02x)\n"
+/* Floating-point conversions with the same arguments.  Up to 17
+   significant digits are usually generated without multi-precision
+   arithmetic; longer conversions always need it.  */
+#define FORMAT3 "%d %c%c%c%c%c %s %.17g %x"
+#define FORMAT4 "%d %c%c%c%c%c %s %e %x"
+#define FORMAT5 "%d %c%c%c%c%c %s %.3f %x"
+#define FORMAT6 "%d %c%c%c%c%c %s %.30e %x"
 /* Sufficiently large buffer.  */
 char buf[256];
@@ -0,0 +1,9 @@
+/* Integers, floating-point numbers and a line of comma-separated
+   fields, each read into the variables below.  */
+#define FORMAT1 "%d %d %d"
+#define FORMAT2 "%lf %lf"
+#define FORMAT3 "%63[^,],%d,%lf,%63s"
+/* Destinations of the conversions.  */
+int i1, i2, i3;
+double d1, d2;
+char s1[64], s2[64];
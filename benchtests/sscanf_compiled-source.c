@@ -0,0 +1,27 @@
+#include <stdarg.h>
+#include "sscanf-source.c"
+
+/* Call vsscanf_compiled with the format compiled on first use, so
+   that the same inputs as for sscanf can be used.  */
+static int
+bench_sscanf_compiled (const char *s, const char *format, ...)
+{
+  static const char *formats[16];
+  static struct scanf_compiled *compiled[16];
+  size_t i;
+
+  for (i = 0; formats[i] != NULL && formats[i] != format; ++i)
+    ;
+  if (formats[i] == NULL)
+    {
+      compiled[i] = scanf_compile (format);
+      formats[i] = format;
+    }
+
+  va_list ap;
+  va_start (ap, format);
+  int ret = vsscanf_compiled (s, compiled[i], ap);
+  va_end (ap);
+  return ret;
+}
+#define sscanf_compiled bench_sscanf_compiled
@@ -60,6 +60,9 @@ size_t _dl_tls_static_surplus;
 /* Remaining amount of static TLS that may be used for optimizing
    dynamic TLS access (e.g. with TLSDESC).  */
 size_t _dl_tls_static_optional;
+/* Remaining amount of static TLS that may be used for the TLS blocks
+   of dlopen'd objects which do not require static TLS.  */
+size_t _dl_tls_static_promoted;
 
 /* Generation counter for the dtv.  */
 size_t _dl_tls_generation;
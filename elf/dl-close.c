@@ -16,6 +16,7 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <array_length.h>
 #include <assert.h>
 #include <dlfcn.h>
 #include <errno.h>
@@ -35,6 +36,7 @@
 #include <dl-find_object.h>
 
 #include <dl-unmap-segments.h>
+#include <elf/dl-tunables.h>
 
 
 /* Type of the constructor functions.  */
@@ -504,6 +506,15 @@ _dl_close_worker (struct link_map *map, bool force)
 	  free (fsl->list[--fsl->count]);
     }
 
+#ifdef SHARED
+  /* Stop reporting the removed objects without the lock, and wait for
+     the threads which may still report them.  */
+  __rtld_lock_lock_recursive (GL(dl_load_write_lock));
+  _dl_phdr_snapshot_update ();
+  __rtld_lock_unlock_recursive (GL(dl_load_write_lock));
+  _dl_phdr_snapshot_reclaim (true);
+#endif
+
   size_t tls_free_start;
   size_t tls_free_end;
   tls_free_start = tls_free_end = NO_TLS_OFFSET;
@@ -760,9 +771,19 @@ _dl_close_worker (struct link_map *map, bool force)
 
   if (__builtin_expect (ns->_ns_loaded == NULL, 0)
       && nsid == GL(dl_nns) - 1)
-    do
-      --GL(dl_nns);
-    while (GL(dl_ns)[GL(dl_nns) - 1]._ns_loaded == NULL);
+    {
+      do
+	--GL(dl_nns);
+      while (GL(dl_ns)[GL(dl_nns) - 1]._ns_loaded == NULL);
+
+#ifdef SHARED
+      /* With a single namespace left, snapshots can be used again.  */
+      __rtld_lock_lock_recursive (GL(dl_load_write_lock));
+      _dl_phdr_snapshot_update ();
+      __rtld_lock_unlock_recursive (GL(dl_load_write_lock));
+      _dl_phdr_snapshot_reclaim (false);
+#endif
+    }
 
   /* Notify the debugger those objects are finalized and gone.  */
   r->r_state = RT_CONSISTENT;
@@ -778,6 +799,98 @@ _dl_close_worker (struct link_map *map, bool force)
 }
 
 
+#if HAVE_TUNABLES
+/* Objects which have been dlclose'd for the last time but are kept
+   mapped, so that a subsequent dlopen of the same object does not
+   have to load and relocate it again.  Each entry owns one
+   l_direct_opencount reference.  Entries are kept in closing order,
+   the oldest first, and are evicted when the cache is full.  The
+   array is protected by GL(dl_load_lock).  Like RTLD_NODELETE
+   objects, cached objects stay on the list of loaded objects and in
+   the global scope if they were opened with RTLD_GLOBAL.  */
+static struct link_map *dl_close_cache[64];
+static size_t dl_close_cache_used;
+
+/* Return true if MAP is in the dlclose cache.  The only reference the
+   application held is then gone, and another dlclose call on MAP is an
+   error.  */
+static bool
+dl_close_cache_contains (struct link_map *map)
+{
+  for (size_t i = 0; i < dl_close_cache_used; ++i)
+    if (dl_close_cache[i] == map)
+      return true;
+  return false;
+}
+
+void
+_dl_close_cache_take (struct link_map *map)
+{
+  for (size_t i = 0; i < dl_close_cache_used; ++i)
+    if (dl_close_cache[i] == map)
+      {
+	memmove (&dl_close_cache[i], &dl_close_cache[i + 1],
+		 (dl_close_cache_used - i - 1) * sizeof (dl_close_cache[0]));
+	--dl_close_cache_used;
+	--map->l_direct_opencount;
+
+	if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES))
+	  _dl_debug_printf ("reusing file=%s [%lu] from the dlclose cache\n",
+			    map->l_name, map->l_ns);
+	return;
+      }
+}
+
+/* Keep MAP mapped instead of unloading it if the dlclose cache is
+   enabled and MAP is about to lose its last direct reference.  The
+   reference is transferred to the cache.  Returns true if MAP was
+   cached.  */
+static bool
+dl_close_cache_add (struct link_map *map)
+{
+  size_t limit = TUNABLE_GET (glibc, rtld, dlclose_cache, size_t, NULL);
+  if (limit == 0 || map->l_direct_opencount != 1 || map->l_type != lt_loaded)
+    return false;
+  assert (limit <= array_length (dl_close_cache));
+
+  /* Make room by unloading the oldest entries.  The closed objects may
+     run destructors which call dlclose recursively, so each entry is
+     removed from the cache before it is closed.  */
+  while (dl_close_cache_used >= limit)
+    {
+      struct link_map *oldest = dl_close_cache[0];
+      --dl_close_cache_used;
+      memmove (&dl_close_cache[0], &dl_close_cache[1],
+	       dl_close_cache_used * sizeof (dl_close_cache[0]));
+      _dl_close_worker (oldest, false);
+    }
+
+  dl_close_cache[dl_close_cache_used++] = map;
+
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES))
+    _dl_debug_printf ("\nclosing file=%s; kept in the dlclose cache\n",
+		      map->l_name);
+  return true;
+}
+#else
+static bool
+dl_close_cache_contains (struct link_map *map)
+{
+  return false;
+}
+
+void
+_dl_close_cache_take (struct link_map *map)
+{
+}
+
+static bool
+dl_close_cache_add (struct link_map *map)
+{
+  return false;
+}
+#endif
+
 void
 _dl_close (void *_map)
 {
@@ -808,14 +921,36 @@ _dl_close (void *_map)
      POSIX has language in dlclose that appears to guarantee that this
      should be a detectable case and given that dlclose should be threadsafe
      we need this to be a reliable detection.
-     This is bug 20990. */
-  if (__builtin_expect (map->l_direct_opencount, 1) == 0)
+     This is bug 20990.  An object in the dlclose cache still has the
+     reference held by the cache, but it is no longer open.  */
+  if (__builtin_expect (map->l_direct_opencount, 1) == 0
+      || dl_close_cache_contains (map))
     {
       __rtld_lock_unlock_recursive (GL(dl_load_lock));
       _dl_signal_error (0, map->l_name, NULL, N_("shared object not open"));
     }
 
-  _dl_close_worker (map, false);
+  uint64_t timing_start = _dl_timing_start ();
+  const char *timing_name = NULL;
+  Lmid_t timing_ns = map->l_ns;
+  unsigned int timing_nloaded = GL(dl_ns)[timing_ns]._ns_nloaded;
+  /* The link map may be freed by _dl_close_worker.  */
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_TIMING))
+    timing_name = strdupa (DSO_FILENAME (map->l_name));
+
+  if (!dl_close_cache_add (map))
+    _dl_close_worker (map, false);
+
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_TIMING))
+    {
+      struct dl_timing_field fields[] =
+	{
+	  { "ns", timing_ns },
+	  { "unloaded", timing_nloaded - GL(dl_ns)[timing_ns]._ns_nloaded },
+	};
+      _dl_timing_event ("dlclose", NULL, timing_name, NULL, timing_start,
+			fields, array_length (fields));
+    }
 
   __rtld_lock_unlock_recursive (GL(dl_load_lock));
 }
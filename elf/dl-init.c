@@ -17,9 +17,11 @@
    <https://www.gnu.org/licenses/>.  */
 
 #include <assert.h>
+#include <atomic.h>
 #include <stddef.h>
 #include <ldsodefs.h>
 #include <elf-initfini.h>
+#include <elf/dl-tunables.h>
 
 
 static void
@@ -48,6 +50,8 @@ call_init (struct link_map *l, int argc, char **argv, char **env)
     _dl_debug_printf ("\ncalling init: %s\n\n",
 		      DSO_FILENAME (l->l_name));
 
+  uint64_t timing_start = _dl_timing_start ();
+
   /* Now run the local constructors.  There are two forms of them:
      - the one named by DT_INIT
      - the others in the DT_INIT_ARRAY.
@@ -69,9 +73,101 @@ call_init (struct link_map *l, int argc, char **argv, char **env)
       for (j = 0; j < jm; ++j)
 	((dl_init_t) addrs[j]) (argc, argv, env);
     }
+
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_TIMING))
+    _dl_timing_event ("init", l, NULL, NULL, timing_start, NULL, 0);
 }
 
 
+#if PTHREAD_IN_LIBC && defined SHARED && HAVE_TUNABLES
+/* Run the initializers of the objects in BATCH which have not been
+   claimed by another thread yet.  */
+static void
+run_init_batch (struct dl_init_batch *batch)
+{
+  unsigned int i;
+  while ((i = atomic_fetch_add_relaxed (&batch->next, 1)) < batch->nmaps)
+    call_init (batch->maps[i], batch->argc, batch->argv, batch->env);
+}
+
+/* Run the initializers of MAIN_MAP and its dependencies using up to
+   NTHREADS threads.  The objects are split into levels: an object is
+   placed one level above the highest level of its direct dependencies,
+   so the objects on one level do not depend on each other and their
+   initializers may run concurrently.  The levels are processed in
+   increasing order, and within a level the initializers are started in
+   the order computed by _dl_sort_maps.  Levels are run serially as long
+   as libc.so has not been initialized, because worker threads cannot
+   be created before that.  */
+static void
+call_init_parallel (struct link_map *main_map, unsigned int nthreads,
+		    int argc, char **argv, char **env)
+{
+  unsigned int nlist = main_map->l_searchlist.r_nlist;
+  struct link_map *order[nlist];
+  struct link_map *batch_maps[nlist];
+  unsigned int level[nlist];
+  unsigned int nlevels = 0;
+
+  for (unsigned int k = 0; k < nlist; ++k)
+    {
+      struct link_map *l = main_map->l_initfini[nlist - 1 - k];
+      order[k] = l;
+      l->l_idx = k;
+      level[k] = 0;
+
+      /* Dependencies which are initialized after L can only result
+	 from a cycle.  They are ignored here, the object which closes
+	 the cycle ends up on a higher level anyway.  */
+      if (l->l_initfini != NULL)
+	for (unsigned int j = 0; l->l_initfini[j] != NULL; ++j)
+	  {
+	    struct link_map *dep = l->l_initfini[j];
+	    if (dep != l && dep->l_idx >= 0 && (unsigned int) dep->l_idx < k
+		&& order[dep->l_idx] == dep && level[dep->l_idx] >= level[k])
+	      level[k] = level[dep->l_idx] + 1;
+	  }
+
+      if (level[k] >= nlevels)
+	nlevels = level[k] + 1;
+    }
+
+  for (unsigned int lv = 0; lv < nlevels; ++lv)
+    {
+      unsigned int nmaps = 0;
+      for (unsigned int k = 0; k < nlist; ++k)
+	if (level[k] == lv && !order[k]->l_init_called)
+	  batch_maps[nmaps++] = order[k];
+
+      struct link_map *libc_map = GL(dl_ns)[LM_ID_BASE].libc_map;
+      if (nmaps > 1 && GL(dl_init_parallel) != NULL
+	  && libc_map != NULL && libc_map->l_init_called)
+	{
+	  struct dl_init_batch batch =
+	    {
+	      .maps = batch_maps,
+	      .nmaps = nmaps,
+	      .nthreads = nmaps < nthreads ? nmaps : nthreads,
+	      .next = 0,
+	      .argc = argc,
+	      .argv = argv,
+	      .env = env,
+	      .run = run_init_batch,
+	    };
+
+	  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_IMPCALLS))
+	    _dl_debug_printf ("\ncalling init: %u objects on %u threads\n\n",
+			      nmaps, batch.nthreads);
+
+	  GL(dl_init_parallel) (&batch);
+	}
+      else
+	for (unsigned int k = 0; k < nmaps; ++k)
+	  call_init (batch_maps[k], argc, argv, env);
+    }
+}
+#endif
+
 void
 _dl_init (struct link_map *main_map, int argc, char **argv, char **env)
 {
@@ -113,6 +209,18 @@ _dl_init (struct link_map *main_map, int argc, char **argv, char **env)
      letting the user do it right.  Stupidity rules!  */
 
   i = main_map->l_searchlist.r_nlist;
+#if PTHREAD_IN_LIBC && defined SHARED && HAVE_TUNABLES
+  /* Initializers are only run in parallel for the objects loaded at
+     process startup.  dlopen calls _dl_init with GL(dl_load_lock)
+     held, and initializers running on other threads would deadlock as
+     soon as they call into the dynamic loader.  */
+  size_t nthreads = TUNABLE_GET (glibc, rtld, parallel_init, size_t, NULL);
+  if (nthreads > 1 && main_map->l_type == lt_executable)
+    {
+      call_init_parallel (main_map, nthreads, argc, argv, env);
+      i = 0;
+    }
+#endif
   while (i-- > 0)
     call_init (main_map->l_initfini[i], argc, argv, env);
 
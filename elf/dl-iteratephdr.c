@@ -16,10 +16,16 @@
    License along with the GNU C Library; see the file COPYING.LIB.  If
    not, see <https://www.gnu.org/licenses/>.  */
 
+#include <atomic.h>
 #include <errno.h>
 #include <ldsodefs.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <libc-lock.h>
+#if PTHREAD_IN_LIBC
+# include <futex-internal.h>
+# include <nptl/descr.h>
+#endif
 
 static void
 cancel_handler (void *arg __attribute__((unused)))
@@ -27,6 +33,44 @@ cancel_handler (void *arg __attribute__((unused)))
   __rtld_lock_unlock_recursive (GL(dl_load_write_lock));
 }
 
+#if defined SHARED && PTHREAD_IN_LIBC
+/* Stop using snapshots in the thread SELF.  */
+static void
+snapshot_done (struct pthread *self)
+{
+  if (atomic_exchange_release (&self->dl_phdr_reader, 0)
+      & DL_PHDR_READER_WAITING)
+    {
+      atomic_fetch_add_release (&GL(dl_phdr_wakeups), 1);
+      futex_wake (&GL(dl_phdr_wakeups), INT_MAX, FUTEX_PRIVATE);
+    }
+}
+
+static void
+snapshot_cancel_handler (void *arg)
+{
+  /* Nested calls leave the outer value in place.  */
+  if ((uintptr_t) arg == 0)
+    snapshot_done (THREAD_SELF);
+}
+#endif
+
+static void
+fill_phdr_info (struct dl_phdr_info *info, struct link_map *l,
+		unsigned long long int adds, size_t nloaded)
+{
+  info->dlpi_addr = l->l_real->l_addr;
+  info->dlpi_name = l->l_real->l_name;
+  info->dlpi_phdr = l->l_real->l_phdr;
+  info->dlpi_phnum = l->l_real->l_phnum;
+  info->dlpi_adds = adds;
+  info->dlpi_subs = adds - nloaded;
+  info->dlpi_tls_data = NULL;
+  info->dlpi_tls_modid = l->l_real->l_tls_modid;
+  if (info->dlpi_tls_modid != 0)
+    info->dlpi_tls_data = GLRO(dl_tls_get_addr_soft) (l->l_real);
+}
+
 int
 __dl_iterate_phdr (int (*callback) (struct dl_phdr_info *info,
 				    size_t size, void *data), void *data)
@@ -35,6 +79,43 @@ __dl_iterate_phdr (int (*callback) (struct dl_phdr_info *info,
   struct dl_phdr_info info;
   int ret = 0;
 
+#if defined SHARED && PTHREAD_IN_LIBC
+  /* Report the objects of the current snapshot without taking the lock,
+     so that concurrent callers (such as unwinders and profilers) do not
+     serialize against each other and against dlopen.  The dynamic
+     linker does not free the snapshot, or unmap the objects in it,
+     while dl_phdr_reader records an older generation.  See
+     dl-phdr-snapshot.c.  */
+  struct pthread *self = THREAD_SELF;
+  unsigned int outer = atomic_load_relaxed (&self->dl_phdr_reader);
+  if (outer == 0)
+    {
+      atomic_store_relaxed (&self->dl_phdr_reader,
+			    atomic_load_acquire (&GL(dl_phdr_generation)));
+      /* Pairs with the barrier in _dl_phdr_snapshot_reclaim.  */
+      atomic_full_barrier ();
+    }
+  struct dl_phdr_snapshot *snapshot
+    = atomic_load_acquire (&GL(dl_phdr_snapshot));
+  if (snapshot != NULL)
+    {
+      __libc_cleanup_push (snapshot_cancel_handler,
+			   (void *) (uintptr_t) outer);
+      for (size_t i = 0; i < snapshot->count; ++i)
+	{
+	  fill_phdr_info (&info, snapshot->maps[i], snapshot->adds,
+			  snapshot->count);
+	  ret = callback (&info, sizeof (struct dl_phdr_info), data);
+	  if (ret != 0)
+	    break;
+	}
+      __libc_cleanup_pop (1);
+      return ret;
+    }
+  if (outer == 0)
+    snapshot_done (self);
+#endif
+
   /* Make sure nobody modifies the list of loaded objects.  */
   __rtld_lock_lock_recursive (GL(dl_load_write_lock));
   __libc_cleanup_push (cancel_handler, NULL);
@@ -61,16 +142,7 @@ __dl_iterate_phdr (int (*callback) (struct dl_phdr_info *info,
 
   for (l = GL(dl_ns)[ns]._ns_loaded; l != NULL; l = l->l_next)
     {
-      info.dlpi_addr = l->l_real->l_addr;
-      info.dlpi_name = l->l_real->l_name;
-      info.dlpi_phdr = l->l_real->l_phdr;
-      info.dlpi_phnum = l->l_real->l_phnum;
-      info.dlpi_adds = GL(dl_load_adds);
-      info.dlpi_subs = GL(dl_load_adds) - nloaded;
-      info.dlpi_tls_data = NULL;
-      info.dlpi_tls_modid = l->l_real->l_tls_modid;
-      if (info.dlpi_tls_modid != 0)
-	info.dlpi_tls_data = GLRO(dl_tls_get_addr_soft) (l->l_real);
+      fill_phdr_info (&info, l, GL(dl_load_adds), nloaded);
       ret = callback (&info, sizeof (struct dl_phdr_info), data);
       if (ret)
 	break;
@@ -1990,6 +1990,8 @@ _dl_map_object (struct link_map *loader, const char *name,
       return l;
     }
 
+  uint64_t timing_start = _dl_timing_start ();
+
   /* Display information if we are debugging.  */
   if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES)
       && loader != NULL)
@@ -2250,8 +2252,20 @@ _dl_map_object (struct link_map *loader, const char *name,
     }
 
   void *stack_end = __libc_stack_end;
-  return _dl_map_object_from_fd (name, origname, fd, &fb, realname, loader,
-				 type, mode, &stack_end, nsid);
+  l = _dl_map_object_from_fd (name, origname, fd, &fb, realname, loader,
+			      type, mode, &stack_end, nsid);
+
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_TIMING))
+    {
+      struct dl_timing_field fields[] =
+	{
+	  { "size", l->l_map_end - l->l_map_start },
+	};
+      _dl_timing_event ("map", l, NULL, NULL, timing_start, fields,
+			array_length (fields));
+    }
+
+  return l;
 }
 
 struct add_path_state
@@ -46,8 +46,15 @@ _dl_add_to_namespace_list (struct link_map *new, Lmid_t nsid)
   ++GL(dl_ns)[nsid]._ns_nloaded;
   new->l_serial = GL(dl_load_adds);
   ++GL(dl_load_adds);
+#ifdef SHARED
+  _dl_phdr_snapshot_update ();
+#endif
 
   __rtld_lock_unlock_recursive (GL(dl_load_write_lock));
+
+#ifdef SHARED
+  _dl_phdr_snapshot_reclaim (false);
+#endif
 }
 
 
@@ -40,6 +40,7 @@
 
 #include <dl-dst.h>
 #include <dl-prop.h>
+#include <dl-static-tls.h>
 
 
 /* We must be careful not to leave us in an inconsistent state.  Thus we
@@ -552,6 +553,10 @@ dl_open_worker_begin (void *a)
   /* It was already open.  */
   if (__glibc_unlikely (new->l_searchlist.r_list != NULL))
     {
+      /* The object may only have been kept loaded by the dlclose
+	 cache.  The new reference replaces the one held there.  */
+      _dl_close_cache_take (new);
+
       /* Let the user know about the opencount.  */
       if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES))
 	_dl_debug_printf ("opening file=%s [%lu]; direct_opencount=%u\n\n",
@@ -652,6 +657,23 @@ dl_open_worker_begin (void *a)
     }
   while (l != NULL);
 
+  /* Place the TLS blocks of the new objects in the static TLS area if
+     the surplus reserved for this purpose allows it.  This has to
+     happen before relocation, so that TLS descriptors can use the
+     static TLS fast path.  The space is not reclaimed by dlclose.  */
+  if (GL(dl_tls_static_promoted) > 0)
+    for (unsigned int i = first; i < last; ++i)
+      {
+	l = new->l_initfini[i];
+	if (! l->l_real->l_relocated && l->l_tls_blocksize > 0
+	    && l->l_tls_offset == NO_TLS_OFFSET
+	    && _dl_try_allocate_static_tls (l,
+					    &GL(dl_tls_static_promoted)) == 0
+	    && __glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES))
+	  _dl_debug_printf ("\nfile=%s [%lu];  placing TLS in static TLS\n",
+			    l->l_name, args->nsid);
+      }
+
   int relocation_in_progress = 0;
 
   /* Perform relocation.  This can trigger lazy binding in IFUNC
@@ -826,6 +848,8 @@ _dl_open (const char *file, int mode, const void *caller_dlopen, Lmid_t nsid,
     /* One of the flags must be set.  */
     _dl_signal_error (EINVAL, file, NULL, N_("invalid mode for dlopen()"));
 
+  uint64_t timing_start = _dl_timing_start ();
+
   /* Make sure we are alone.  */
   __rtld_lock_lock_recursive (GL(dl_load_lock));
 
@@ -931,6 +955,16 @@ no more namespaces available for dlmopen()"));
   /* Release the lock.  */
   __rtld_lock_unlock_recursive (GL(dl_load_lock));
 
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_TIMING))
+    {
+      struct dl_timing_field fields[] =
+	{
+	  { "mode", mode },
+	};
+      _dl_timing_event ("dlopen", args.map, NULL, file, timing_start, fields,
+			array_length (fields));
+    }
+
   return args.map;
 }
 
@@ -0,0 +1,33 @@
+/* Snapshots of the loaded objects for dl_iterate_phdr.  Generic version.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <ldsodefs.h>
+
+/* Without a way to find the threads which use a snapshot, no snapshot
+   is published, and dl_iterate_phdr always takes
+   _dl_load_write_lock.  */
+
+void
+_dl_phdr_snapshot_update (void)
+{
+}
+
+void
+_dl_phdr_snapshot_reclaim (bool wait)
+{
+}
@@ -17,6 +17,7 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <array_length.h>
 #include <errno.h>
 #include <libintl.h>
 #include <stdlib.h>
@@ -32,8 +33,12 @@
 /* Statistics function.  */
 #ifdef SHARED
 # define bump_num_cache_relocations() ++GL(dl_num_cache_relocations)
+# define num_relocations() GL(dl_num_relocations)
+# define num_cache_relocations() GL(dl_num_cache_relocations)
 #else
 # define bump_num_cache_relocations() ((void) 0)
+# define num_relocations() 0UL
+# define num_cache_relocations() 0UL
 #endif
 
 
@@ -43,13 +48,15 @@
    object's TLS segment is too big to fit, we fail with -1.  If it fits,
    we set MAP->l_tls_offset and return 0.
    A portion of the surplus static TLS can be optionally used to optimize
-   dynamic TLS access (with TLSDESC or powerpc TLS optimizations).
-   If OPTIONAL is true then TLS is allocated for such optimization and
-   the caller must have a fallback in case the optional portion of surplus
-   TLS runs out.  If OPTIONAL is false then the entire surplus TLS area is
-   considered and the allocation only fails if that runs out.  */
+   dynamic TLS access (with TLSDESC or powerpc TLS optimizations, or by
+   promoting the TLS of dlopen'd objects).  If BUDGET is not NULL then
+   TLS is allocated for such optimization, the allocation is accounted
+   against *BUDGET, and the caller must have a fallback in case that
+   portion of surplus TLS runs out.  If BUDGET is NULL then the entire
+   surplus TLS area is considered and the allocation only fails if that
+   runs out.  */
 int
-_dl_try_allocate_static_tls (struct link_map *map, bool optional)
+_dl_try_allocate_static_tls (struct link_map *map, size_t *budget)
 {
   /* If we've already used the variable with dynamic access, or if the
      alignment requirements are too high, fail.  */
@@ -74,10 +81,10 @@ _dl_try_allocate_static_tls (struct link_map *map, bool optional)
 
   /* Account optional static TLS surplus usage.  */
   size_t use = freebytes - n * map->l_tls_align - map->l_tls_firstbyte_offset;
-  if (optional && use > GL(dl_tls_static_optional))
+  if (budget != NULL && use > *budget)
     goto fail;
-  else if (optional)
-    GL(dl_tls_static_optional) -= use;
+  else if (budget != NULL)
+    *budget -= use;
 
   size_t offset = GL(dl_tls_static_used) + use;
 
@@ -95,10 +102,10 @@ _dl_try_allocate_static_tls (struct link_map *map, bool optional)
 
   /* Account optional static TLS surplus usage.  */
   size_t use = used - GL(dl_tls_static_used);
-  if (optional && use > GL(dl_tls_static_optional))
+  if (budget != NULL && use > *budget)
     goto fail;
-  else if (optional)
-    GL(dl_tls_static_optional) -= use;
+  else if (budget != NULL)
+    *budget -= use;
 
   map->l_tls_offset = offset;
   map->l_tls_firstbyte_offset = GL(dl_tls_static_used);
@@ -135,7 +142,7 @@ __attribute_noinline__
 _dl_allocate_static_tls (struct link_map *map)
 {
   if (map->l_tls_offset == FORCED_DYNAMIC_TLS_OFFSET
-      || _dl_try_allocate_static_tls (map, false))
+      || _dl_try_allocate_static_tls (map, NULL))
     {
       _dl_signal_error (0, map->l_name, NULL, N_("\
 cannot allocate memory in static TLS block"));
@@ -245,6 +252,10 @@ _dl_relocate_object (struct link_map *l, struct r_scope_elem *scope[],
   if (l->l_relocated)
     return;
 
+  uint64_t timing_start = _dl_timing_start ();
+  unsigned long int timing_relocations = num_relocations ();
+  unsigned long int timing_cached = num_cache_relocations ();
+
   /* If DT_BIND_NOW is set relocate all references in this object.  We
      do not do this if we are profiling, of course.  */
   // XXX Correct for auditing?
@@ -347,6 +358,18 @@ _dl_relocate_object (struct link_map *l, struct r_scope_elem *scope[],
      done, do it.  */
   if (l->l_relro_size != 0)
     _dl_protect_relro (l);
+
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_TIMING))
+    {
+      struct dl_timing_field fields[] =
+	{
+	  { "relocations", num_relocations () - timing_relocations },
+	  { "cached_relocations", num_cache_relocations () - timing_cached },
+	  { "lazy", lazy != 0 },
+	};
+      _dl_timing_event ("relocate", l, NULL, NULL, timing_start, fields,
+			array_length (fields));
+    }
 }
 
 
@@ -43,9 +43,10 @@
     (__builtin_expect ((sym_map)->l_tls_offset				\
 		       != FORCED_DYNAMIC_TLS_OFFSET, 1)			\
      && (__builtin_expect ((sym_map)->l_tls_offset != NO_TLS_OFFSET, 1)	\
-	 || _dl_try_allocate_static_tls (sym_map, true) == 0))
+	 || _dl_try_allocate_static_tls (sym_map,			\
+					 &GL(dl_tls_static_optional)) == 0))
 
-int _dl_try_allocate_static_tls (struct link_map *map, bool optional)
+int _dl_try_allocate_static_tls (struct link_map *map, size_t *budget)
   attribute_hidden;
 
 #endif
@@ -0,0 +1,122 @@
+/* Machine-readable loader events for LD_DEBUG=timing.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <_itoa.h>
+#include <assert.h>
+#include <ldsodefs.h>
+#include <string.h>
+
+/* Append the string S to the buffer at P.  */
+static char *
+put_str (char *p, const char *s)
+{
+  size_t len = strlen (s);
+  return __mempcpy (p, s, len);
+}
+
+/* Append S as a quoted JSON string.  Every input byte produces at most
+   six output bytes.  */
+static char *
+put_json_str (char *p, const char *s)
+{
+  *p++ = '"';
+  for (; *s != '\0'; ++s)
+    {
+      unsigned char c = *s;
+      if (c == '"' || c == '\\')
+	{
+	  *p++ = '\\';
+	  *p++ = c;
+	}
+      else if (c < 0x20)
+	{
+	  p = put_str (p, "\\u00");
+	  *p++ = "0123456789abcdef"[c >> 4];
+	  *p++ = "0123456789abcdef"[c & 0xf];
+	}
+      else
+	*p++ = c;
+    }
+  *p++ = '"';
+  return p;
+}
+
+/* Append ,"NAME":VALUE.  */
+static char *
+put_field (char *p, const char *name, uint64_t value)
+{
+  char buf[3 * sizeof (value) + 1];
+  char *end = buf + sizeof (buf);
+  char *cp = _itoa (value, end, 10, 0);
+
+  p = put_str (p, ",\"");
+  p = put_str (p, name);
+  p = put_str (p, "\":");
+  return __mempcpy (p, cp, end - cp);
+}
+
+void
+_dl_timing_event (const char *event, struct link_map *map, const char *object,
+		  const char *file, uint64_t start,
+		  const struct dl_timing_field *fields, size_t nfields)
+{
+#if HP_TIMING_INLINE
+  uint64_t end = _dl_timing_now ();
+#endif
+  if (map != NULL)
+    object = DSO_FILENAME (map->l_name);
+
+  /* Fixed text, the numbers for the namespace and the time stamps,
+     and the worst case for the escaped strings.  */
+  size_t size = 64 + strlen (event) + 3 * (3 * sizeof (uint64_t) + 16);
+  if (object != NULL)
+    size += 6 * strlen (object);
+  if (file != NULL)
+    size += 6 * strlen (file);
+  for (size_t i = 0; i < nfields; ++i)
+    size += strlen (fields[i].name) + 3 * sizeof (uint64_t) + 4;
+
+  char buf[size];
+  char *p = put_str (buf, "{\"event\":\"");
+  p = put_str (p, event);
+  *p++ = '"';
+  if (file != NULL)
+    {
+      p = put_str (p, ",\"file\":");
+      p = put_json_str (p, file);
+    }
+  if (object != NULL)
+    {
+      p = put_str (p, ",\"object\":");
+      p = put_json_str (p, object);
+      if (map != NULL)
+	p = put_field (p, "ns", map->l_ns);
+    }
+#if HP_TIMING_INLINE
+  p = put_field (p, "start", start);
+  p = put_field (p, "duration", end - start);
+#endif
+  for (size_t i = 0; i < nfields; ++i)
+    p = put_field (p, fields[i].name, fields[i].value);
+  p = put_str (p, "}\n");
+  assert (p <= buf + size);
+
+  /* Write the event with a single system call, so that events from
+     concurrent dlopen and dlclose calls are not interleaved.  */
+  _dl_write (GLRO(dl_debug_fd), buf, p - buf);
+}
@@ -42,7 +42,9 @@
      one where libc.so is not loaded dynamically but at startup time,
    - IE TLS in other libraries which may be dynamically loaded even in the
      initial namespace,
-   - and optionally for optimizing dynamic TLS access.
+   - and optionally for optimizing dynamic TLS access,
+   - and optionally for placing the TLS of dlopen'd objects in static TLS
+     (rtld.promoted_static_tls).
 
    The maximum number of namespaces is DL_NNS, but to support that many
    namespaces correctly the static TLS allocation should be significantly
@@ -95,15 +97,17 @@ tls_static_surplus (int nns, int opt_tls)
 void
 _dl_tls_static_surplus_init (size_t naudit)
 {
-  size_t nns, opt_tls;
+  size_t nns, opt_tls, promoted_tls;
 
 #if HAVE_TUNABLES
   nns = TUNABLE_GET (nns, size_t, NULL);
   opt_tls = TUNABLE_GET (optional_static_tls, size_t, NULL);
+  promoted_tls = TUNABLE_GET (promoted_static_tls, size_t, NULL);
 #else
   /* Default values of the tunables.  */
   nns = DEFAULT_NNS;
   opt_tls = OPTIONAL_TLS;
+  promoted_tls = 0;
 #endif
   if (nns > DL_NNS)
     nns = DL_NNS;
@@ -113,8 +117,10 @@ _dl_tls_static_surplus_init (size_t naudit)
   nns += naudit;
 
   GL(dl_tls_static_optional) = opt_tls;
+  GL(dl_tls_static_promoted) = promoted_tls;
   assert (LEGACY_TLS >= 0);
-  GLRO(dl_tls_static_surplus) = tls_static_surplus (nns, opt_tls) + LEGACY_TLS;
+  GLRO(dl_tls_static_surplus) = (tls_static_surplus (nns, opt_tls)
+				 + LEGACY_TLS + promoted_tls);
 }
 
 /* Out-of-memory handler.  */
@@ -43,6 +43,10 @@
 #endif
 
 #if TUNABLES_FRONTEND == TUNABLES_FRONTEND_valstring
+/* The environment entry holding the GLIBC_TUNABLES variable which was
+   parsed, for __tunables_export.  */
+static char **tunables_env;
+
 static char *
 tunables_strdup (const char *in)
 {
@@ -295,6 +299,7 @@ __tunables_init (char **envp)
 	    parse_tunables (new_env + len + 1, envval);
 	  /* Put in the updated envval.  */
 	  *prev_envp = new_env;
+	  tunables_env = prev_envp;
 	  continue;
 	}
 #endif
@@ -353,6 +358,75 @@ __tunables_init (char **envp)
     }
 }
 
+/* Append the current values of the NIDS tunables in IDS, which must be
+   numeric and not negative, to the GLIBC_TUNABLES variable in the
+   environment, so that processes started with this environment use them
+   instead of computing them again.  Nothing is done if the variable is
+   not set, and in AT_SECURE processes.
+
+   This changes the environment of the running process itself: the
+   entry in the environment array is replaced by a newly allocated
+   string, so getenv ("GLIBC_TUNABLES") returns the extended value while
+   /proc/PID/environ still shows the original one.  The original string
+   is not modified.
+
+   This runs before IRELATIVE relocations are processed in static
+   binaries, so the string functions are not used.  */
+void
+__tunables_export (const tunable_id_t *ids, size_t nids)
+{
+#if TUNABLES_FRONTEND == TUNABLES_FRONTEND_valstring
+  if (tunables_env == NULL || __libc_enable_secure)
+    return;
+
+  const char *old = *tunables_env;
+  size_t size = 0;
+  while (old[size] != '\0')
+    size++;
+  size_t len = size;
+  for (size_t i = 0; i < nids; i++)
+    {
+      const char *n = tunable_list[ids[i]].name;
+      /* The separator, the name, '=' and up to 20 digits.  */
+      size++;
+      while (*n++ != '\0')
+	size++;
+      size += 1 + 20;
+    }
+
+  char *new_env = __minimal_malloc (size + 1);
+  if (new_env == NULL)
+    return;
+
+  char *p = new_env;
+  for (size_t i = 0; i < len; i++)
+    *p++ = old[i];
+  for (size_t i = 0; i < nids; i++)
+    {
+      const tunable_t *cur = &tunable_list[ids[i]];
+
+      /* The value of GLIBC_TUNABLES may still be empty.  */
+      if (p[-1] != '=')
+	*p++ = ':';
+      for (const char *n = cur->name; *n != '\0'; n++)
+	*p++ = *n;
+      *p++ = '=';
+
+      char digits[20];
+      char *d = digits + sizeof (digits);
+      uint64_t val = cur->val.numval;
+      do
+	*--d = '0' + val % 10;
+      while ((val /= 10) != 0);
+      while (d < digits + sizeof (digits))
+	*p++ = *d++;
+    }
+  *p = '\0';
+
+  *tunables_env = new_env;
+#endif
+}
+
 void
 __tunables_print (void)
 {
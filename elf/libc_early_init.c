@@ -18,16 +18,75 @@
 
 #include <ctype.h>
 #include <elision-conf.h>
+#include <ldsodefs.h>
 #include <libc-early-init.h>
 #include <libc-internal.h>
 #include <lowlevellock.h>
 #include <pthread_early_init.h>
 #include <sys/single_threaded.h>
 
+#if PTHREAD_IN_LIBC
+# include <list.h>
+# include <pthreadP.h>
+#endif
+
 #ifdef SHARED
 _Bool __libc_initial;
 #endif
 
+#if PTHREAD_IN_LIBC && defined SHARED
+static void *
+dl_init_parallel_worker (void *closure)
+{
+  struct dl_init_batch *batch = closure;
+  batch->run (batch);
+  return NULL;
+}
+
+/* Return true if the calling thread is the only thread of the process.
+   Every other thread is on one of the stack lists until it has freed
+   its TCB, which is the last thing it does before exiting.  */
+static bool
+only_thread (void)
+{
+  lll_lock (GL (dl_stack_cache_lock), LLL_PRIVATE);
+  bool result = (GL (dl_stack_used).next == &GL (dl_stack_used)
+		 && GL (dl_stack_user).next->next == &GL (dl_stack_user));
+  lll_unlock (GL (dl_stack_cache_lock), LLL_PRIVATE);
+  return result;
+}
+
+/* Implementation of GL(dl_init_parallel).  If thread creation fails,
+   the remaining initializers are run on the calling thread.  */
+static void
+dl_init_parallel (struct dl_init_batch *batch)
+{
+  pthread_t threads[batch->nthreads];
+  unsigned int started = 0;
+  bool single_threaded = __libc_single_threaded_internal;
+
+  while (started + 1 < batch->nthreads
+	 && __pthread_create (&threads[started], NULL,
+			      dl_init_parallel_worker, batch) == 0)
+    ++started;
+
+  batch->run (batch);
+
+  for (unsigned int i = 0; i < started; ++i)
+    __pthread_join (threads[i], NULL);
+
+  /* Creating the worker threads cleared __libc_single_threaded.  Set it
+     again if the constructors did not leave threads of their own
+     behind.  Joining the workers orders their exit before this store,
+     as required for the variable.  */
+  if (started > 0 && single_threaded && only_thread ())
+    {
+      __libc_single_threaded_internal = 1;
+      __libc_single_threaded = 1;
+    }
+}
+#endif
+
 void
 __libc_early_init (_Bool initial)
 {
@@ -43,6 +102,13 @@ __libc_early_init (_Bool initial)
 
   __pthread_early_init ();
 
+#if PTHREAD_IN_LIBC && defined SHARED
+  /* Worker threads for running ELF constructors are only used for the
+     objects loaded at startup, see _dl_init.  */
+  if (initial)
+    GL(dl_init_parallel) = dl_init_parallel;
+#endif
+
 #if ENABLE_ELISION_SUPPORT
   __lll_elision_init ();
 #endif
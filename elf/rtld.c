@@ -503,6 +503,24 @@ _dl_start_final (void *arg, struct dl_start_final_info *info)
       print_statistics (RTLD_TIMING_REF(rtld_total_time));
     }
 
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_TIMING))
+    {
+      struct dl_timing_field fields[] =
+	{
+	  { "pid", __getpid () },
+	  { "objects", GL(dl_ns)[LM_ID_BASE]._ns_nloaded },
+	  { "relocations", GL(dl_num_relocations) },
+	  { "cached_relocations", GL(dl_num_cache_relocations) },
+	};
+#if HP_TIMING_INLINE
+      uint64_t timing_start = start_time;
+#else
+      uint64_t timing_start = 0;
+#endif
+      _dl_timing_event ("startup", NULL, NULL, NULL, timing_start, fields,
+			array_length (fields));
+    }
+
 #ifndef ELF_MACHINE_START_ADDRESS
 # define ELF_MACHINE_START_ADDRESS(map, start) (start)
 #endif
@@ -2388,6 +2406,11 @@ dl_main (const ElfW(Phdr) *phdr,
      other libcs.  */
   _dl_call_libc_early_init (GL(dl_ns)[LM_ID_BASE].libc_map, true);
 
+  /* Report the objects loaded at startup to dl_iterate_phdr without
+     the lock.  */
+  GL(dl_phdr_generation) = 1;
+  _dl_phdr_snapshot_update ();
+
   /* Do any necessary cleanups for the startup OS interface code.
      We do these now so that no calls are made after rtld re-relocation
      which might be resolved to different functions than we expect.
@@ -2475,6 +2498,8 @@ process_dl_debug (struct dl_main_state *state, const char *dl_debug)
 	DL_DEBUG_STATISTICS },
       { LEN_AND_STR ("unused"), "determined unused DSOs",
 	DL_DEBUG_UNUSED },
+      { LEN_AND_STR ("timing"), "write loader events as JSON lines",
+	DL_DEBUG_TIMING },
       { LEN_AND_STR ("help"), "display this help message and exit",
 	DL_DEBUG_HELP },
     };
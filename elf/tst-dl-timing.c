@@ -0,0 +1,110 @@
+/* Test the JSON events written by LD_DEBUG=timing.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/xdlfcn.h>
+#include <support/xstdio.h>
+
+/* Open the debug output of the process PID, or return NULL.  */
+static FILE *
+open_debug_output (pid_t pid)
+{
+  const char *base = getenv ("LD_DEBUG_OUTPUT");
+  TEST_VERIFY_EXIT (base != NULL);
+  char *path = xasprintf ("%s.%d", base, (int) pid);
+  FILE *fp = fopen (path, "r");
+  free (path);
+  return fp;
+}
+
+static int
+do_test (void)
+{
+  void *h = xdlopen ("tst-dl-timing-mod.so", RTLD_NOW);
+  xdlclose (h);
+
+  /* The startup events are written by the process which ran ld.so.
+     The test driver may have forked since, in which case the events
+     for dlopen and dlclose are written to the same file.  */
+  FILE *fp = open_debug_output (getpid ());
+  if (fp == NULL)
+    fp = open_debug_output (getppid ());
+  TEST_VERIFY_EXIT (fp != NULL);
+
+  bool seen_startup = false;
+  bool seen_relocate = false;
+  bool seen_map = false;
+  bool seen_init = false;
+  bool seen_dlopen = false;
+  bool seen_dlclose = false;
+
+  char *line = NULL;
+  size_t linelen = 0;
+  while (xgetline (&line, &linelen, fp) > 0)
+    {
+      /* Every event is a single JSON object on its own line.  */
+      TEST_VERIFY (strncmp (line, "{\"event\":\"", 10) == 0);
+      TEST_VERIFY (strcmp (line + strlen (line) - 2, "}\n") == 0);
+
+      if (strstr (line, "\"event\":\"startup\"") != NULL)
+	{
+	  TEST_VERIFY (strstr (line, "\"objects\":") != NULL);
+	  seen_startup = true;
+	}
+      else if (strstr (line, "\"event\":\"relocate\"") != NULL)
+	{
+	  TEST_VERIFY (strstr (line, "\"relocations\":") != NULL);
+	  seen_relocate = true;
+	}
+      else if (strstr (line, "\"event\":\"map\"") != NULL)
+	seen_map |= strstr (line, "tst-dl-timing-mod.so\"") != NULL;
+      else if (strstr (line, "\"event\":\"init\"") != NULL)
+	seen_init |= strstr (line, "tst-dl-timing-mod.so\"") != NULL;
+      else if (strstr (line, "\"event\":\"dlopen\"") != NULL)
+	{
+	  TEST_VERIFY (strstr (line, "\"file\":\"tst-dl-timing-mod.so\"")
+		       != NULL);
+	  seen_dlopen = true;
+	}
+      else if (strstr (line, "\"event\":\"dlclose\"") != NULL)
+	{
+	  TEST_VERIFY (strstr (line, "\"object\":") != NULL);
+	  TEST_VERIFY (strstr (line, "tst-dl-timing-mod.so\"") != NULL);
+	  TEST_VERIFY (strstr (line, "\"unloaded\":1") != NULL);
+	  seen_dlclose = true;
+	}
+    }
+  free (line);
+  xfclose (fp);
+
+  TEST_VERIFY (seen_startup);
+  TEST_VERIFY (seen_relocate);
+  TEST_VERIFY (seen_map);
+  TEST_VERIFY (seen_init);
+  TEST_VERIFY (seen_dlopen);
+  TEST_VERIFY (seen_dlclose);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
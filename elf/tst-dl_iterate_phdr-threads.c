@@ -0,0 +1,109 @@
+/* Test dl_iterate_phdr concurrently with dlopen and dlclose.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <dlfcn.h>
+#include <gnu/lib-names.h>
+#include <link.h>
+#include <stdbool.h>
+#include <support/check.h>
+#include <support/xdlfcn.h>
+#include <support/xthread.h>
+
+/* Set by the main thread once it has finished its dlopen/dlclose
+   cycles.  */
+static bool exit_requested;
+
+struct iterate_state
+{
+  unsigned long long int adds;
+  unsigned long long int subs;
+  size_t count;
+  bool inconsistent;
+};
+
+static int
+callback (struct dl_phdr_info *info, size_t size, void *closure)
+{
+  struct iterate_state *state = closure;
+  TEST_VERIFY (size >= sizeof (*info));
+  if (state->count == 0)
+    {
+      state->adds = info->dlpi_adds;
+      state->subs = info->dlpi_subs;
+    }
+  else if (info->dlpi_adds != state->adds || info->dlpi_subs != state->subs)
+    state->inconsistent = true;
+  if (info->dlpi_phdr == NULL || info->dlpi_phnum == 0)
+    state->inconsistent = true;
+  ++state->count;
+  return 0;
+}
+
+/* Iterate over the loaded objects until the main thread is done,
+   checking that the reported counters match the number of reported
+   objects.  */
+static void *
+iterate_thread (void *ignored)
+{
+  unsigned long long int last_adds = 0;
+  do
+    {
+      struct iterate_state state = { 0, };
+      TEST_COMPARE (dl_iterate_phdr (callback, &state), 0);
+      TEST_VERIFY (!state.inconsistent);
+      TEST_COMPARE (state.adds - state.subs, state.count);
+      TEST_VERIFY (state.adds >= last_adds);
+      last_adds = state.adds;
+    }
+  while (!__atomic_load_n (&exit_requested, __ATOMIC_RELAXED));
+  return NULL;
+}
+
+/* Load and unload an object from a callback, which must not wait for
+   the calling thread.  */
+static int
+dlopen_callback (struct dl_phdr_info *info, size_t size, void *closure)
+{
+  int *calls = closure;
+  if ((*calls)++ == 0)
+    xdlclose (xdlopen (LIBM_SO, RTLD_NOW));
+  return 0;
+}
+
+static int
+do_test (void)
+{
+  int calls = 0;
+  TEST_COMPARE (dl_iterate_phdr (dlopen_callback, &calls), 0);
+  TEST_VERIFY (calls > 0);
+
+  pthread_t threads[4];
+  for (int i = 0; i < 4; ++i)
+    threads[i] = xpthread_create (NULL, iterate_thread, NULL);
+
+  for (int i = 0; i < 200; ++i)
+    xdlclose (xdlopen (LIBM_SO, RTLD_NOW));
+
+  __atomic_store_n (&exit_requested, true, __ATOMIC_RELAXED);
+  for (int i = 0; i < 4; ++i)
+    xpthread_join (threads[i]);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,85 @@
+/* Test reopening objects kept loaded by glibc.rtld.dlclose_cache.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <dlfcn.h>
+#include <stddef.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/xdlfcn.h>
+
+static int
+do_test (void)
+{
+  /* The test runs with a cache of one object.  */
+  void *handle1 = xdlopen ("tst-dlclose-cachemod1.so", RTLD_NOW);
+  int *init_count = xdlsym (handle1, "cachemod1_init_count");
+  TEST_COMPARE (*init_count, 1);
+  xdlclose (handle1);
+
+  /* The object is still loaded, and reopening it does not run its
+     constructor again.  */
+  void *handle = dlopen ("tst-dlclose-cachemod1.so", RTLD_NOW | RTLD_NOLOAD);
+  TEST_VERIFY (handle == handle1);
+  xdlclose (handle);
+  handle = xdlopen ("tst-dlclose-cachemod1.so", RTLD_NOW);
+  TEST_VERIFY (handle == handle1);
+  TEST_COMPARE (*init_count, 1);
+
+  /* A second reference does not place the object in the cache.  */
+  handle = xdlopen ("tst-dlclose-cachemod1.so", RTLD_NOW);
+  xdlclose (handle);
+  xdlclose (handle1);
+  TEST_VERIFY (dlopen ("tst-dlclose-cachemod1.so",
+		       RTLD_NOW | RTLD_NOLOAD) == handle1);
+  xdlclose (handle1);
+
+  /* Closing another object evicts the first one.  */
+  void *handle2 = xdlopen ("tst-dlclose-cachemod2.so", RTLD_NOW);
+  int (*func) (void) = xdlsym (handle2, "cachemod2_function");
+  TEST_COMPARE (func (), 2);
+  xdlclose (handle2);
+  TEST_VERIFY (dlopen ("tst-dlclose-cachemod1.so",
+		       RTLD_NOW | RTLD_NOLOAD) == NULL);
+  handle = dlopen ("tst-dlclose-cachemod2.so", RTLD_NOW | RTLD_NOLOAD);
+  TEST_VERIFY (handle == handle2);
+  xdlclose (handle);
+
+  /* After eviction, the constructor runs again.  */
+  handle1 = xdlopen ("tst-dlclose-cachemod1.so", RTLD_NOW);
+  init_count = xdlsym (handle1, "cachemod1_init_count");
+  TEST_COMPARE (*init_count, 1);
+  xdlclose (handle1);
+
+  /* The object is still mapped, but closing it again is an error and
+     does not add it to the cache a second time.  */
+  TEST_COMPARE (dlclose (handle1), -1);
+  TEST_VERIFY (strstr (dlerror (), "shared object not open") != NULL);
+  TEST_VERIFY (dlopen ("tst-dlclose-cachemod1.so",
+		       RTLD_NOW | RTLD_NOLOAD) == handle1);
+  xdlclose (handle1);
+
+  /* Evicting the object unloads it once.  */
+  handle2 = xdlopen ("tst-dlclose-cachemod2.so", RTLD_NOW);
+  xdlclose (handle2);
+  TEST_VERIFY (dlopen ("tst-dlclose-cachemod1.so",
+		       RTLD_NOW | RTLD_NOLOAD) == NULL);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
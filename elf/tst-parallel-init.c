@@ -0,0 +1,62 @@
+/* Test that glibc.rtld.parallel_init runs independent constructors in
+   parallel and preserves dependency order.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdatomic.h>
+#include <sys/single_threaded.h>
+#include <support/check.h>
+
+extern atomic_uint parallel_init_counter;
+extern int mod1_init_step;
+extern int mod2_init_step;
+extern int mod2_saw_mod1;
+extern int mod3_init_step;
+extern int mod3_saw_mod1;
+extern int mod2_met_other;
+extern int mod3_met_other;
+
+static int
+do_test (void)
+{
+  /* All constructors ran exactly once.  */
+  TEST_COMPARE (atomic_load (&parallel_init_counter), 3);
+
+  /* The common dependency was initialized first, and both dependent
+     objects observed its completed constructor.  The relative order
+     of tst-parallel-initmod2.so and tst-parallel-initmod3.so is
+     unspecified.  */
+  TEST_COMPARE (mod1_init_step, 0);
+  TEST_VERIFY (mod2_init_step > 0);
+  TEST_VERIFY (mod3_init_step > 0);
+  TEST_VERIFY (mod2_init_step != mod3_init_step);
+  TEST_VERIFY (mod2_saw_mod1);
+  TEST_VERIFY (mod3_saw_mod1);
+
+  /* The constructors of the two independent objects waited for each
+     other, which only succeeds if they ran on different threads.  */
+  TEST_VERIFY (mod2_met_other);
+  TEST_VERIFY (mod3_met_other);
+
+  /* The worker threads have been joined, so the process is
+     single-threaded again.  */
+  TEST_VERIFY (__libc_single_threaded);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,60 @@
+/* Test glibc.rtld.parallel_init.  Common dependency.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdatomic.h>
+#include <time.h>
+
+/* Number of constructors which have run so far.  */
+atomic_uint parallel_init_counter;
+
+/* Value of parallel_init_counter when the constructor ran.  */
+int mod1_init_step = -1;
+
+static void __attribute__ ((constructor))
+init (void)
+{
+  mod1_init_step = atomic_fetch_add (&parallel_init_counter, 1);
+}
+
+/* Number of constructors which have called parallel_init_rendezvous.  */
+static atomic_uint arrived;
+
+/* Wait until the constructors of tst-parallel-initmod2.so and
+   tst-parallel-initmod3.so have both called this function.  Return 1
+   if they have, or 0 if the other constructor did not arrive within
+   five seconds, which means that they do not run in parallel.  */
+int
+parallel_init_rendezvous (void)
+{
+  atomic_fetch_add (&arrived, 1);
+
+  struct timespec deadline;
+  clock_gettime (CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += 5;
+  while (atomic_load (&arrived) < 2)
+    {
+      struct timespec now;
+      clock_gettime (CLOCK_MONOTONIC, &now);
+      if (now.tv_sec > deadline.tv_sec
+	  || (now.tv_sec == deadline.tv_sec
+	      && now.tv_nsec >= deadline.tv_nsec))
+	return 0;
+      nanosleep (&(struct timespec) { .tv_nsec = 1000000 }, NULL);
+    }
+  return 1;
+}
@@ -0,0 +1,40 @@
+/* Test glibc.rtld.parallel_init.  Independent object depending on
+   tst-parallel-initmod1.so.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdatomic.h>
+
+extern atomic_uint parallel_init_counter;
+extern int mod1_init_step;
+extern int parallel_init_rendezvous (void);
+
+/* Value of parallel_init_counter when the constructor ran, and whether
+   the constructor of tst-parallel-initmod1.so had completed by then.  */
+int mod2_init_step = -1;
+int mod2_saw_mod1;
+/* Whether the constructor of the other independent object ran at the
+   same time.  */
+int mod2_met_other;
+
+static void __attribute__ ((constructor))
+init (void)
+{
+  mod2_saw_mod1 = mod1_init_step >= 0;
+  mod2_init_step = atomic_fetch_add (&parallel_init_counter, 1);
+  mod2_met_other = parallel_init_rendezvous ();
+}
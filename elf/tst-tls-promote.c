@@ -0,0 +1,90 @@
+/* Test placing the TLS of dlopen'd objects in static TLS.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <support/check.h>
+#include <support/xdlfcn.h>
+#include <support/xthread.h>
+
+/* In the static TLS block of every thread.  */
+static __thread int main_var __attribute__ ((tls_model ("local-exec")));
+
+static int *(*get_promoted_var) (void);
+
+static pthread_barrier_t barrier;
+
+/* Check that the promoted variable is initialized and lies in the
+   static TLS block of the calling thread, near MAIN_VAR.  Dynamic TLS
+   is allocated with malloc, far away from the thread's static TLS.  */
+static void
+check_promoted_var (void)
+{
+  int *var = get_promoted_var ();
+  TEST_COMPARE (var[0], 1);
+  TEST_COMPARE (var[3], 4);
+  uintptr_t distance = labs ((intptr_t) var - (intptr_t) &main_var);
+  if (distance > 64 * 1024)
+    {
+      printf ("error: TLS variable at %p too far from %p\n", var, &main_var);
+      support_record_failure ();
+    }
+  var[0] = 5;
+  TEST_COMPARE (get_promoted_var ()[0], 5);
+}
+
+/* Started before the dlopen call.  */
+static void *
+early_thread (void *ignored)
+{
+  xpthread_barrier_wait (&barrier);
+  xpthread_barrier_wait (&barrier);
+  check_promoted_var ();
+  return NULL;
+}
+
+/* Started after the dlopen call.  */
+static void *
+late_thread (void *ignored)
+{
+  check_promoted_var ();
+  return NULL;
+}
+
+static int
+do_test (void)
+{
+  xpthread_barrier_init (&barrier, NULL, 2);
+  pthread_t early = xpthread_create (NULL, early_thread, NULL);
+  xpthread_barrier_wait (&barrier);
+
+  void *handle = xdlopen ("tst-tls-promote-mod.so", RTLD_NOW);
+  get_promoted_var = xdlsym (handle, "get_promoted_var");
+
+  xpthread_barrier_wait (&barrier);
+  xpthread_join (early);
+  xpthread_join (xpthread_create (NULL, late_thread, NULL));
+
+  xdlclose (handle);
+  xpthread_barrier_destroy (&barrier);
+  return 0;
+}
+
+#include <support/test-driver.c>
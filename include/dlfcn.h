@@ -73,6 +73,10 @@ extern void _dl_close (void *map) attribute_hidden;
    provided map arguments.  */
 extern void _dl_close_worker (struct link_map *map, bool force)
     attribute_hidden;
+/* Remove MAP from the cache of recently closed objects, if it is
+   there, and drop the reference held by the cache.  Called by dlopen
+   with the loader lock held.  */
+extern void _dl_close_cache_take (struct link_map *map) attribute_hidden;
 
 /* Look up NAME in shared object HANDLE (which may be RTLD_DEFAULT or
    RTLD_NEXT).  WHO is the calling function, for RTLD_NEXT.  Returns
@@ -52,6 +52,13 @@ libc_hidden_proto (__printf_fp)
 extern int __printf_fp_l (FILE *, locale_t, const struct printf_info *,
 			  const void *const *);
 libc_hidden_proto (__printf_fp_l)
+/* Like __printf_fp_l, but print the NDIGITS significant digits at
+   DIGITS, the last of which has the decimal exponent EXP10, instead of
+   converting the value.  Only its sign is taken from ARGS.  */
+extern int __printf_fp_digits_l (FILE *, locale_t,
+				 const struct printf_info *,
+				 const void *const *, const char *, int, int)
+     attribute_hidden;
 
 extern unsigned int __guess_grouping (unsigned int intdig_max,
 				      const char *grouping)
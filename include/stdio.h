@@ -39,6 +39,10 @@ fseterr_unlocked (FILE *fp)
 }
 
 extern int __fcloseall (void) attribute_hidden;
+
+/* Write out and free the per-thread stream buffers of the calling
+   thread.  Called on thread exit.  */
+extern void __libio_threadbuf_freeres (void) attribute_hidden;
 extern int __snprintf (char *__restrict __s, size_t __maxlen,
 		       const char *__restrict __format, ...)
      __attribute__ ((__format__ (__printf__, 3, 4)));
@@ -0,0 +1,69 @@
+/* Enable or disable background writing of a stream.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include "libioP.h"
+#include <errno.h>
+#include <stdio_ext.h>
+
+int
+__fsetasync (FILE *fp, int type)
+{
+  int result;
+
+  CHECK_FILE (fp, -1);
+  _IO_acquire_lock (fp);
+  result = ((fp->_flags2 & _IO_FLAGS2_ASYNC)
+	    ? FSETASYNC_BACKGROUND : FSETASYNC_DIRECT);
+
+  if (type == FSETASYNC_BACKGROUND && result == FSETASYNC_DIRECT)
+    {
+      /* Only write-only file streams with narrow orientation can be
+	 written in the background.  */
+      if (_IO_vtable_offset (fp) != 0
+	  || !(fp->_flags & _IO_IS_FILEBUF)
+	  || !(fp->_flags & _IO_NO_READS)
+	  || (fp->_flags2 & _IO_FLAGS2_THREADBUF)
+	  || fp->_fileno < 0
+	  || _IO_fwide (fp, -1) != -1)
+	{
+	  __set_errno (EINVAL);
+	  result = -1;
+	}
+      else if (_IO_OVERFLOW (fp, EOF) == EOF || __libio_async_start (fp) != 0)
+	result = -1;
+      else
+	fp->_flags2 |= _IO_FLAGS2_ASYNC;
+    }
+  else if (type == FSETASYNC_DIRECT && result == FSETASYNC_BACKGROUND)
+    {
+      /* Write the pending output and wait until it has been written.  */
+      if (_IO_OVERFLOW (fp, EOF) == EOF)
+	result = -1;
+      if (__libio_async_release (fp) != 0)
+	result = -1;
+    }
+  else if (type != FSETASYNC_QUERY && type != FSETASYNC_DIRECT
+	   && type != FSETASYNC_BACKGROUND)
+    {
+      __set_errno (EINVAL);
+      result = -1;
+    }
+
+  _IO_release_lock (fp);
+  return result;
+}
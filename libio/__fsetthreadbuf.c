@@ -0,0 +1,87 @@
+/* Switch an output stream to per-thread buffers.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include "libioP.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio_ext.h>
+
+int
+__fsetthreadbuf (FILE *fp, int type)
+{
+  int result;
+  bool release = false;
+
+  CHECK_FILE (fp, -1);
+  _IO_acquire_lock (fp);
+  result = ((fp->_flags2 & _IO_FLAGS2_THREADBUF)
+	    ? FSETTHREADBUF_PERTHREAD : FSETTHREADBUF_SHARED);
+
+  if (type == FSETTHREADBUF_PERTHREAD && result == FSETTHREADBUF_SHARED)
+    {
+      /* Only write-only file streams with narrow orientation and a
+	 buffer can be used this way.  */
+      if (_IO_vtable_offset (fp) != 0
+	  || !(fp->_flags & _IO_IS_FILEBUF)
+	  || !(fp->_flags & _IO_NO_READS)
+	  || (fp->_flags & _IO_UNBUFFERED)
+	  || (fp->_flags2 & _IO_FLAGS2_ASYNC)
+	  || fp->_fileno < 0
+	  || _IO_fwide (fp, -1) != -1)
+	{
+	  __set_errno (EINVAL);
+	  result = -1;
+	}
+      else
+	{
+	  /* The size of the buffer of FP is the size of the per-thread
+	     buffers.  */
+	  if (fp->_IO_buf_base == NULL)
+	    _IO_doallocbuf (fp);
+	  if (_IO_OVERFLOW (fp, EOF) == EOF)
+	    result = -1;
+	  else
+	    {
+	      /* The file position is no longer known.  */
+	      fp->_offset = _IO_pos_BAD;
+	      fp->_flags2 |= _IO_FLAGS2_THREADBUF;
+	    }
+	}
+    }
+  else if (type == FSETTHREADBUF_SHARED && result == FSETTHREADBUF_PERTHREAD)
+    {
+      fp->_flags2 &= ~_IO_FLAGS2_THREADBUF;
+      release = true;
+    }
+  else if (type != FSETTHREADBUF_QUERY && type != FSETTHREADBUF_SHARED
+	   && type != FSETTHREADBUF_PERTHREAD)
+    {
+      __set_errno (EINVAL);
+      result = -1;
+    }
+
+  _IO_release_lock (fp);
+
+  /* Write out the buffers of all threads.  They stay attached to FP
+     because a thread may still be writing to its buffer after having
+     seen the flag set.  This takes the lock of the list of all streams,
+     which must not be acquired while holding the lock of FP.  */
+  if (release && __libio_threadbuf_release (fp, 0) != 0)
+    result = -1;
+  return result;
+}
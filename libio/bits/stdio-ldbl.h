@@ -80,6 +80,10 @@ __LDBL_REDIR2_DECL (asprintf)
 __LDBL_REDIR_DECL (asprintf)
 __LDBL_REDIR_DECL (obstack_printf)
 __LDBL_REDIR_DECL (obstack_vprintf)
+__LDBL_REDIR_DECL (vfscanf_compiled)
+__LDBL_REDIR_DECL (fscanf_compiled)
+__LDBL_REDIR_DECL (vsscanf_compiled)
+__LDBL_REDIR_DECL (sscanf_compiled)
 #endif
 
 #if __USE_FORTIFY_LEVEL > 0 && defined __fortify_function
@@ -32,6 +32,7 @@
 #include <sys/param.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
@@ -136,6 +137,11 @@ _IO_new_file_close_it (FILE *fp)
   else
     write_status = 0;
 
+  /* Wait for the data queued for the helper thread.  */
+  if ((fp->_flags2 & _IO_FLAGS2_ASYNC) != 0
+      && __libio_async_release (fp) != 0)
+    write_status = EOF;
+
   _IO_unsave_markers (fp);
 
   int close_status = ((fp->_flags2 & _IO_FLAGS2_NOCLOSE) == 0
@@ -169,6 +175,8 @@ _IO_new_file_finish (FILE *fp, int dummy)
   if (_IO_file_is_open (fp))
     {
       _IO_do_flush (fp);
+      if (fp->_flags2 & _IO_FLAGS2_ASYNC)
+	__libio_async_release (fp);
       if (!(fp->_flags & _IO_DELETE_DONT_CLOSE))
 	_IO_SYSCLOSE (fp);
     }
@@ -426,10 +434,11 @@ _IO_new_do_write (FILE *fp, const char *data, size_t to_do)
 }
 libc_hidden_ver (_IO_new_do_write, _IO_do_write)
 
-static size_t
-new_do_write (FILE *fp, const char *data, size_t to_do)
+/* Move the file position of FP to the start of the pending output.
+   Return false if that fails.  */
+static bool
+new_do_write_seek (FILE *fp)
 {
-  size_t count;
   if (fp->_flags & _IO_IS_APPENDING)
     /* On a system without a proper O_APPEND implementation,
        you would need to sys_seek(0, SEEK_END) here, but is
@@ -442,20 +451,93 @@ new_do_write (FILE *fp, const char *data, size_t to_do)
       off64_t new_pos
 	= _IO_SYSSEEK (fp, fp->_IO_write_base - fp->_IO_read_end, 1);
       if (new_pos == _IO_pos_BAD)
-	return 0;
+	return false;
       fp->_offset = new_pos;
     }
-  count = _IO_SYSWRITE (fp, data, to_do);
-  if (fp->_cur_column && count)
-    fp->_cur_column = _IO_adjust_column (fp->_cur_column - 1, data, count) + 1;
+  return true;
+}
+
+/* Empty the buffer of FP after its contents have been written.  */
+static void
+new_do_write_reset (FILE *fp)
+{
   _IO_setg (fp, fp->_IO_buf_base, fp->_IO_buf_base, fp->_IO_buf_base);
   fp->_IO_write_base = fp->_IO_write_ptr = fp->_IO_buf_base;
   fp->_IO_write_end = (fp->_mode <= 0
 		       && (fp->_flags & (_IO_LINE_BUF | _IO_UNBUFFERED))
 		       ? fp->_IO_buf_base : fp->_IO_buf_end);
+}
+
+static size_t
+new_do_write (FILE *fp, const char *data, size_t to_do)
+{
+  size_t count;
+  if (!new_do_write_seek (fp))
+    return 0;
+  count = _IO_SYSWRITE (fp, data, to_do);
+  if (fp->_cur_column && count)
+    fp->_cur_column = _IO_adjust_column (fp->_cur_column - 1, data, count) + 1;
+  new_do_write_reset (fp);
   return count;
 }
 
+/* Write the pending output of FP followed by the TO_DO bytes at DATA,
+   with as few writev calls as possible and without copying DATA into
+   the buffer.  Return the number of bytes of DATA written, or -1 if
+   not all of the pending output could be written.  FP must use
+   _IO_new_file_write.  */
+static ssize_t
+new_do_writev (FILE *fp, const char *data, size_t to_do)
+{
+  size_t pending = fp->_IO_write_ptr - fp->_IO_write_base;
+  struct iovec iov[2] =
+    {
+      { .iov_base = fp->_IO_write_base, .iov_len = pending },
+      { .iov_base = (char *) data, .iov_len = to_do }
+    };
+  struct iovec *iovp = pending > 0 ? iov : iov + 1;
+  int iovcnt = pending > 0 ? 2 : 1;
+  size_t written = 0;
+
+  if (!new_do_write_seek (fp))
+    return -1;
+  while (iovcnt > 0)
+    {
+      ssize_t count = __writev (fp->_fileno, iovp, iovcnt);
+      if (count < 0)
+	{
+	  fp->_flags |= _IO_ERR_SEEN;
+	  break;
+	}
+      written += count;
+      while (iovcnt > 0 && (size_t) count >= iovp->iov_len)
+	{
+	  count -= iovp->iov_len;
+	  ++iovp;
+	  --iovcnt;
+	}
+      if (iovcnt > 0)
+	{
+	  iovp->iov_base = (char *) iovp->iov_base + count;
+	  iovp->iov_len -= count;
+	}
+    }
+  if (fp->_offset >= 0)
+    fp->_offset += written;
+
+  if (fp->_cur_column && written)
+    {
+      size_t n = MIN (written, pending);
+      unsigned int column = _IO_adjust_column (fp->_cur_column - 1,
+					       fp->_IO_write_base, n);
+      if (written > pending)
+	column = _IO_adjust_column (column, data, written - pending);
+      fp->_cur_column = column + 1;
+    }
+  new_do_write_reset (fp);
+  return written < pending ? -1 : (ssize_t) (written - pending);
+}
+
 int
 _IO_new_file_underflow (FILE *fp)
 {
@@ -537,103 +619,174 @@ _IO_new_file_underflow (FILE *fp)
 }
 libc_hidden_ver (_IO_new_file_underflow, _IO_file_underflow)
 
+/* The mmap-based read functions map at most this many bytes of the file
+   at a time.  Reading past the end of the mapping unmaps it and maps the
+   next part of the file, so that files of any size can be read without
+   using address space and page tables in proportion to their size.  */
+#define MMAP_WINDOW_SIZE (16 * 1024 * 1024)
+
+/* Mappings up to this size are populated when they are created, which
+   avoids taking page faults on small files.  The kernel is asked to
+   read ahead larger ones instead.  */
+#define MMAP_POPULATE_SIZE (1024 * 1024)
+
+/* The stream state of a file read through a mapping is the same as if
+   the mapped part of the file had been read into the buffer: _offset
+   is the file offset corresponding to _IO_read_end, which lies within
+   the mapping at _IO_buf_base.  This is also true if nothing is mapped
+   and all of these pointers are null.  */
+
+/* Return the file offset of the start of the mapping of FP.  */
+static off64_t
+mmap_window_start (FILE *fp)
+{
+  return fp->_offset - (fp->_IO_read_end - fp->_IO_buf_base);
+}
+
+/* Map LEN bytes of the file of FP starting at offset START, which must
+   be a multiple of the page size.  */
+static void *
+mmap_window (FILE *fp, off64_t start, size_t len)
+{
+  int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+  if (len <= MMAP_POPULATE_SIZE)
+    flags |= MAP_POPULATE;
+#endif
+  void *p = __mmap64 (NULL, len, PROT_READ, flags, fp->_fileno, start);
+  if (p != MAP_FAILED && len > MMAP_POPULATE_SIZE)
+    {
+      (void) __madvise (p, len, MADV_SEQUENTIAL);
+      (void) __madvise (p, len, MADV_WILLNEED);
+    }
+  return p;
+}
+
+/* Remove the mapping of FP, keeping the stream position.  */
+static void
+mmap_unmap (FILE *fp)
+{
+  off64_t pos = fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
+  if (fp->_IO_buf_base != NULL)
+    (void) __munmap (fp->_IO_buf_base, fp->_IO_buf_end - fp->_IO_buf_base);
+  fp->_IO_buf_base = fp->_IO_buf_end = NULL;
+  _IO_setg (fp, NULL, NULL, NULL);
+  fp->_offset = pos;
+}
+
 /* Guts of underflow callback if we mmap the file.  This stats the file and
-   updates the stream state to match.  In the normal case we return zero.
-   If the file is no longer eligible for mmap, its jump tables are reset to
-   the vanilla ones and we return nonzero.  */
+   maps the part of it at the current position, dropping pages past the
+   end of the file and mapping pages which were added to it.  In the
+   normal case we return zero.  If the file is no longer eligible for
+   mmap, its jump tables are reset to the vanilla ones and we return
+   nonzero.  */
 static int
 mmap_remap_check (FILE *fp)
 {
   struct __stat64_t64 st;
+  const size_t pagesize = __getpagesize ();
+  off64_t start = mmap_window_start (fp);
+  off64_t pos = fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
+  size_t len = fp->_IO_buf_end - fp->_IO_buf_base;
 
-  if (_IO_SYSSTAT (fp, &st) == 0
-      && S_ISREG (st.st_mode) && st.st_size != 0
-      /* Limit the file size to 1MB for 32-bit machines.  */
-      && (sizeof (ptrdiff_t) > 4 || st.st_size < 1*1024*1024))
+  if (_IO_SYSSTAT (fp, &st) != 0
+      || !S_ISREG (st.st_mode) || st.st_size == 0)
+    goto punt;
+
+  if (pos >= st.st_size)
     {
-      const size_t pagesize = __getpagesize ();
+      /* We are at or past the end of the file.  Keep the mapping unless
+	 the file shrank, so that seeking back within it is cheap, and do
+	 not change the current offset.  */
+      if (fp->_IO_buf_base != NULL
+	  && (st.st_size < start + len || pos > start + len))
+	mmap_unmap (fp);
+      _IO_setg (fp, fp->_IO_buf_base, fp->_IO_read_ptr, fp->_IO_read_ptr);
+      fp->_offset = pos;
+      return 0;
+    }
+
 # define ROUNDED(x)	(((x) + pagesize - 1) & ~(pagesize - 1))
-      if (ROUNDED (st.st_size) < ROUNDED (fp->_IO_buf_end
-					  - fp->_IO_buf_base))
-	{
-	  /* We can trim off some pages past the end of the file.  */
-	  (void) __munmap (fp->_IO_buf_base + ROUNDED (st.st_size),
-			   ROUNDED (fp->_IO_buf_end - fp->_IO_buf_base)
-			   - ROUNDED (st.st_size));
-	  fp->_IO_buf_end = fp->_IO_buf_base + st.st_size;
-	}
-      else if (ROUNDED (st.st_size) > ROUNDED (fp->_IO_buf_end
-					       - fp->_IO_buf_base))
+  if (fp->_IO_buf_base != NULL && pos >= start
+      && pos - start < MMAP_WINDOW_SIZE)
+    {
+      /* Keep the start of the mapping and adjust its end to the current
+	 size of the file.  */
+      size_t new_len = MIN (st.st_size - start, MMAP_WINDOW_SIZE);
+      if (ROUNDED (new_len) < ROUNDED (len))
+	/* We can trim off some pages past the end of the file.  */
+	(void) __munmap (fp->_IO_buf_base + ROUNDED (new_len),
+			 ROUNDED (len) - ROUNDED (new_len));
+      else if (ROUNDED (new_len) > ROUNDED (len))
 	{
 	  /* The file added some pages.  We need to remap it.  */
 	  void *p;
 #if _G_HAVE_MREMAP
-	  p = __mremap (fp->_IO_buf_base, ROUNDED (fp->_IO_buf_end
-						   - fp->_IO_buf_base),
-			ROUNDED (st.st_size), MREMAP_MAYMOVE);
+	  p = __mremap (fp->_IO_buf_base, ROUNDED (len), ROUNDED (new_len),
+			MREMAP_MAYMOVE);
 	  if (p == MAP_FAILED)
 	    {
-	      (void) __munmap (fp->_IO_buf_base,
-			       fp->_IO_buf_end - fp->_IO_buf_base);
+	      mmap_unmap (fp);
 	      goto punt;
 	    }
 #else
-	  (void) __munmap (fp->_IO_buf_base,
-			   fp->_IO_buf_end - fp->_IO_buf_base);
-	  p = __mmap64 (NULL, st.st_size, PROT_READ, MAP_SHARED,
-			fp->_fileno, 0);
+	  (void) __munmap (fp->_IO_buf_base, len);
+	  fp->_IO_buf_base = fp->_IO_buf_end = NULL;
+	  p = mmap_window (fp, start, new_len);
 	  if (p == MAP_FAILED)
 	    goto punt;
 #endif
 	  fp->_IO_buf_base = p;
-	  fp->_IO_buf_end = fp->_IO_buf_base + st.st_size;
-	}
-      else
-	{
-	  /* The number of pages didn't change.  */
-	  fp->_IO_buf_end = fp->_IO_buf_base + st.st_size;
 	}
+      len = new_len;
+    }
+  else
+    {
+      /* Map the part of the file which starts at the page containing
+	 the current position.  */
+      mmap_unmap (fp);
+      start = pos & ~(off64_t) (pagesize - 1);
+      len = MIN (st.st_size - start, MMAP_WINDOW_SIZE);
+      void *p = mmap_window (fp, start, len);
+      if (p == MAP_FAILED)
+	goto punt;
+      fp->_IO_buf_base = p;
+    }
 # undef ROUNDED
 
-      fp->_offset -= fp->_IO_read_end - fp->_IO_read_ptr;
-      _IO_setg (fp, fp->_IO_buf_base,
-		fp->_offset < fp->_IO_buf_end - fp->_IO_buf_base
-		? fp->_IO_buf_base + fp->_offset : fp->_IO_buf_end,
-		fp->_IO_buf_end);
-
-      /* If we are already positioned at or past the end of the file, don't
-	 change the current offset.  If not, seek past what we have mapped,
-	 mimicking the position left by a normal underflow reading into its
-	 buffer until EOF.  */
-
-      if (fp->_offset < fp->_IO_buf_end - fp->_IO_buf_base)
-	{
-	  if (__lseek64 (fp->_fileno, fp->_IO_buf_end - fp->_IO_buf_base,
-			 SEEK_SET)
-	      != fp->_IO_buf_end - fp->_IO_buf_base)
-	    fp->_flags |= _IO_ERR_SEEN;
-	  else
-	    fp->_offset = fp->_IO_buf_end - fp->_IO_buf_base;
-	}
+  fp->_IO_buf_end = fp->_IO_buf_base + len;
+  _IO_setg (fp, fp->_IO_buf_base, fp->_IO_buf_base + (pos - start),
+	    fp->_IO_buf_end);
 
-      return 0;
+  /* Position the file descriptor after what we have mapped, mimicking
+     the position left by a normal underflow reading into its buffer.  */
+  if (__lseek64 (fp->_fileno, start + len, SEEK_SET) != start + len)
+    {
+      fp->_flags |= _IO_ERR_SEEN;
+      mmap_unmap (fp);
+      goto punt;
     }
+  fp->_offset = start + len;
+  return 0;
+
+ punt:
+  /* Life is no longer good for mmap.  Punt it, continuing to read at
+     the current position.  */
+  if (fp->_IO_buf_base != NULL)
+    mmap_unmap (fp);
+  fp->_IO_buf_base = fp->_IO_buf_end = NULL;
+  _IO_setg (fp, NULL, NULL, NULL);
+  if (__lseek64 (fp->_fileno, pos, SEEK_SET) == pos)
+    fp->_offset = pos;
   else
-    {
-      /* Life is no longer good for mmap.  Punt it.  */
-      (void) __munmap (fp->_IO_buf_base,
-		       fp->_IO_buf_end - fp->_IO_buf_base);
-    punt:
-      fp->_IO_buf_base = fp->_IO_buf_end = NULL;
-      _IO_setg (fp, NULL, NULL, NULL);
-      if (fp->_mode <= 0)
-	_IO_JUMPS_FILE_plus (fp) = &_IO_file_jumps;
-      else
-	_IO_JUMPS_FILE_plus (fp) = &_IO_wfile_jumps;
-      fp->_wide_data->_wide_vtable = &_IO_wfile_jumps;
+    fp->_offset = _IO_pos_BAD;
+  if (fp->_mode <= 0)
+    _IO_JUMPS_FILE_plus (fp) = &_IO_file_jumps;
+  else
+    _IO_JUMPS_FILE_plus (fp) = &_IO_wfile_jumps;
+  fp->_wide_data->_wide_vtable = &_IO_wfile_jumps;
 
-      return 1;
-    }
+  return 1;
 }
 
 /* Special callback replacing the underflow callbacks if we mmap the file.  */
@@ -659,52 +812,31 @@ decide_maybe_mmap (FILE *fp)
 {
   /* We use the file in read-only mode.  This could mean we can
      mmap the file and use it without any copying.  But not all
-     file descriptors are for mmap-able objects and on 32-bit
-     machines we don't want to map files which are too large since
-     this would require too much virtual memory.  */
+     file descriptors are for mmap-able objects.  */
   struct __stat64_t64 st;
 
   if (_IO_SYSSTAT (fp, &st) == 0
       && S_ISREG (st.st_mode) && st.st_size != 0
-      /* Limit the file size to 1MB for 32-bit machines.  */
-      && (sizeof (ptrdiff_t) > 4 || st.st_size < 1*1024*1024)
       /* Sanity check.  */
       && (fp->_offset == _IO_pos_BAD || fp->_offset <= st.st_size))
     {
-      /* Try to map the file.  */
-      void *p;
-
-      p = __mmap64 (NULL, st.st_size, PROT_READ, MAP_SHARED, fp->_fileno, 0);
-      if (p != MAP_FAILED)
-	{
-	  /* OK, we managed to map the file.  Set the buffer up and use a
-	     special jump table with simplified underflow functions which
-	     never tries to read anything from the file.  */
-
-	  if (__lseek64 (fp->_fileno, st.st_size, SEEK_SET) != st.st_size)
-	    {
-	      (void) __munmap (p, st.st_size);
-	      fp->_offset = _IO_pos_BAD;
-	    }
-	  else
-	    {
-	      _IO_setb (fp, p, (char *) p + st.st_size, 0);
-
-	      if (fp->_offset == _IO_pos_BAD)
-		fp->_offset = 0;
-
-	      _IO_setg (fp, p, p + fp->_offset, p + st.st_size);
-	      fp->_offset = st.st_size;
+      /* Use a special jump table with simplified underflow functions
+	 which never try to read anything from the file, and map the
+	 part of the file at the current position.  If that fails,
+	 mmap_remap_check reverts to the vanilla file operations.  */
+      if (fp->_offset == _IO_pos_BAD)
+	fp->_offset = 0;
+      _IO_setb (fp, NULL, NULL, 0);
+      _IO_setg (fp, NULL, NULL, NULL);
 
-	      if (fp->_mode <= 0)
-		_IO_JUMPS_FILE_plus (fp) = &_IO_file_jumps_mmap;
-	      else
-		_IO_JUMPS_FILE_plus (fp) = &_IO_wfile_jumps_mmap;
-	      fp->_wide_data->_wide_vtable = &_IO_wfile_jumps_mmap;
+      if (fp->_mode <= 0)
+	_IO_JUMPS_FILE_plus (fp) = &_IO_file_jumps_mmap;
+      else
+	_IO_JUMPS_FILE_plus (fp) = &_IO_wfile_jumps_mmap;
+      fp->_wide_data->_wide_vtable = &_IO_wfile_jumps_mmap;
 
-	      return;
-	    }
-	}
+      mmap_remap_check (fp);
+      return;
     }
 
   /* We couldn't use mmap, so revert to the vanilla file operations.  */
@@ -807,7 +939,15 @@ _IO_new_file_sync (FILE *fp)
       else
 	retval = EOF;
     }
-  if (retval != EOF)
+  if ((fp->_flags2 & _IO_FLAGS2_ASYNC) != 0)
+    {
+      /* Report write errors of the helper thread.  The file offset is
+	 still known, and looking it up would wait for the helper
+	 thread.  */
+      if (__libio_async_sync (fp) != 0)
+	retval = EOF;
+    }
+  else if (retval != EOF)
     fp->_offset = _IO_pos_BAD;
   /* FIXME: Cleanup - can this be shared? */
   /*    setg(base(), ptr, ptr); */
@@ -818,18 +958,22 @@ libc_hidden_ver (_IO_new_file_sync, _IO_file_sync)
 static int
 _IO_file_sync_mmap (FILE *fp)
 {
+  /* Characters pushed back with ungetc are discarded.  */
+  if (_IO_in_backup (fp))
+    _IO_switch_to_main_get_area (fp);
+
+  off64_t pos = fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
   if (fp->_IO_read_ptr != fp->_IO_read_end)
     {
-      if (__lseek64 (fp->_fileno, fp->_IO_read_ptr - fp->_IO_buf_base,
-		     SEEK_SET)
-	  != fp->_IO_read_ptr - fp->_IO_buf_base)
+      if (__lseek64 (fp->_fileno, pos, SEEK_SET) != pos)
 	{
 	  fp->_flags |= _IO_ERR_SEEN;
 	  return EOF;
 	}
     }
-  fp->_offset = fp->_IO_read_ptr - fp->_IO_buf_base;
-  fp->_IO_read_end = fp->_IO_read_ptr = fp->_IO_read_base;
+  /* Keep the mapping, but make the next read call underflow.  */
+  fp->_offset = pos;
+  fp->_IO_read_end = fp->_IO_read_ptr;
   return 0;
 }
 
@@ -1061,21 +1205,25 @@ _IO_file_seekoff_mmap (FILE *fp, off64_t offset, int dir, int mode)
 
   /* If we are only interested in the current position, calculate it and
      return right now.  This calculation does the right thing when we are
-     using a pushback buffer, but in the usual case has the same value as
-     (fp->_IO_read_ptr - fp->_IO_buf_base).  */
+     using a pushback buffer.  */
   if (mode == 0)
     return fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
 
   switch (dir)
     {
     case _IO_seek_cur:
-      /* Adjust for read-ahead (bytes is buffer). */
-      offset += fp->_IO_read_ptr - fp->_IO_read_base;
+      offset += fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
       break;
     case _IO_seek_set:
       break;
     case _IO_seek_end:
-      offset += fp->_IO_buf_end - fp->_IO_buf_base;
+      {
+	/* The mapping need not extend to the end of the file.  */
+	struct __stat64_t64 st;
+	if (_IO_SYSSTAT (fp, &st) != 0)
+	  return EOF;
+	offset += st.st_size;
+      }
       break;
     }
   /* At this point, dir==_IO_seek_set. */
@@ -1091,16 +1239,24 @@ _IO_file_seekoff_mmap (FILE *fp, off64_t offset, int dir, int mode)
   if (result < 0)
     return EOF;
 
-  if (offset > fp->_IO_buf_end - fp->_IO_buf_base)
-    /* One can fseek arbitrarily past the end of the file
-       and it is meaningless until one attempts to read.
-       Leave the buffer pointers in EOF state until underflow.  */
-    _IO_setg (fp, fp->_IO_buf_base, fp->_IO_buf_end, fp->_IO_buf_end);
-  else
+  off64_t start = mmap_window_start (fp);
+  if (fp->_IO_buf_base != NULL && offset >= start
+      && offset - start <= fp->_IO_buf_end - fp->_IO_buf_base)
     /* Adjust the read pointers to match the file position,
        but so the next read attempt will call underflow.  */
-    _IO_setg (fp, fp->_IO_buf_base, fp->_IO_buf_base + offset,
-	      fp->_IO_buf_base + offset);
+    _IO_setg (fp, fp->_IO_buf_base, fp->_IO_buf_base + (offset - start),
+	      fp->_IO_buf_base + (offset - start));
+  else
+    {
+      /* One can fseek arbitrarily past the end of the file and it is
+	 meaningless until one attempts to read.  The next read attempt
+	 maps the part of the file at the new position.  */
+      if (fp->_IO_buf_base != NULL)
+	(void) __munmap (fp->_IO_buf_base,
+			 fp->_IO_buf_end - fp->_IO_buf_base);
+      fp->_IO_buf_base = fp->_IO_buf_end = NULL;
+      _IO_setg (fp, NULL, NULL, NULL);
+    }
 
   fp->_offset = result;
 
@@ -1137,6 +1293,9 @@ libc_hidden_def (_IO_file_read)
 off64_t
 _IO_file_seek (FILE *fp, off64_t offset, int dir)
 {
+  /* The file offset is only right once the queued data is written.  */
+  if (__glibc_unlikely (fp->_flags2 & _IO_FLAGS2_ASYNC))
+    __libio_async_wait (fp);
   return __lseek64 (fp->_fileno, offset, dir);
 }
 libc_hidden_def (_IO_file_seek)
@@ -1152,7 +1311,8 @@ int
 _IO_file_close_mmap (FILE *fp)
 {
   /* In addition to closing the file descriptor we have to unmap the file.  */
-  (void) __munmap (fp->_IO_buf_base, fp->_IO_buf_end - fp->_IO_buf_base);
+  if (fp->_IO_buf_base != NULL)
+    (void) __munmap (fp->_IO_buf_base, fp->_IO_buf_end - fp->_IO_buf_base);
   fp->_IO_buf_base = fp->_IO_buf_end = NULL;
   /* Cancelling close should be avoided if possible since it leaves an
      unrecoverable state behind.  */
@@ -1172,6 +1332,14 @@ ssize_t
 _IO_new_file_write (FILE *f, const void *data, ssize_t n)
 {
   ssize_t to_do = n;
+  if (__glibc_unlikely (f->_flags2 & _IO_FLAGS2_ASYNC))
+    {
+      /* The data is written by a helper thread.  */
+      n = __libio_async_write (f, data, n);
+      if (f->_offset >= 0)
+	f->_offset += n;
+      return n;
+    }
   while (to_do > 0)
     {
       ssize_t count = (__builtin_expect (f->_flags2
@@ -1227,6 +1395,37 @@ _IO_new_file_xsputn (FILE *f, const void *data, size_t n)
   else if (f->_IO_write_end > f->_IO_write_ptr)
     count = f->_IO_write_end - f->_IO_write_ptr; /* Space available. */
 
+  /* If the data does not fit and at least one block of it would be
+     written directly, write the pending output and the data in one
+     writev call instead of copying part of the data into the buffer,
+     flushing it and writing the rest with another system call.  */
+  if (to_do > count
+      && (f->_flags & _IO_CURRENTLY_PUTTING)
+      && f->_IO_buf_base != NULL
+      && !(f->_flags2 & (_IO_FLAGS2_NOTCANCEL | _IO_FLAGS2_ASYNC))
+      && _IO_JUMPS_FILE_plus (f)->__write == _IO_new_file_write)
+    {
+      size_t block_size = f->_IO_buf_end - f->_IO_buf_base;
+      size_t pending = f->_IO_write_ptr - f->_IO_write_base;
+      if (block_size >= 128 && to_do - count >= block_size)
+	{
+	  /* Try to maintain alignment: write a whole number of blocks.  */
+	  size_t do_write = (pending + to_do
+			     - (pending + to_do) % block_size - pending);
+	  ssize_t written = new_do_writev (f, s, do_write);
+	  if (written < 0)
+	    return 0;
+	  to_do -= written;
+	  if ((size_t) written < do_write)
+	    return n - to_do;
+	  /* The remainder is less than a block and fits into the now
+	     empty buffer, except for line-buffered files.  */
+	  if (to_do)
+	    to_do -= _IO_default_xsputn (f, s + do_write, to_do);
+	  return n - to_do;
+	}
+    }
+
   /* Then fill the buffer. */
   if (count > 0)
     {
@@ -1363,46 +1562,40 @@ libc_hidden_def (_IO_file_xsgetn)
 static size_t
 _IO_file_xsgetn_mmap (FILE *fp, void *data, size_t n)
 {
-  size_t have;
-  char *read_ptr = fp->_IO_read_ptr;
   char *s = (char *) data;
+  size_t want = n;
 
-  have = fp->_IO_read_end - fp->_IO_read_ptr;
-
-  if (have < n)
+  while (want > 0)
     {
-      if (__glibc_unlikely (_IO_in_backup (fp)))
+      size_t have = fp->_IO_read_end - fp->_IO_read_ptr;
+      if (have == 0)
 	{
-	  s = __mempcpy (s, read_ptr, have);
-	  n -= have;
-	  _IO_switch_to_main_get_area (fp);
-	  read_ptr = fp->_IO_read_ptr;
-	  have = fp->_IO_read_end - fp->_IO_read_ptr;
-	}
+	  if (__glibc_unlikely (_IO_in_backup (fp)))
+	    {
+	      _IO_switch_to_main_get_area (fp);
+	      continue;
+	    }
 
-      if (have < n)
-	{
-	  /* Check that we are mapping all of the file, in case it grew.  */
+	  /* Map the next part of the file, or more of it if it grew.  */
 	  if (__glibc_unlikely (mmap_remap_check (fp)))
 	    /* We punted mmap, so complete with the vanilla code.  */
-	    return s - (char *) data + _IO_XSGETN (fp, data, n);
+	    return n - want + _IO_XSGETN (fp, s, want);
 
-	  read_ptr = fp->_IO_read_ptr;
-	  have = fp->_IO_read_end - read_ptr;
+	  have = fp->_IO_read_end - fp->_IO_read_ptr;
+	  if (have == 0)
+	    {
+	      fp->_flags |= _IO_EOF_SEEN;
+	      break;
+	    }
 	}
-    }
-
-  if (have < n)
-    fp->_flags |= _IO_EOF_SEEN;
 
-  if (have != 0)
-    {
-      have = MIN (have, n);
-      s = __mempcpy (s, read_ptr, have);
-      fp->_IO_read_ptr = read_ptr + have;
+      have = MIN (have, want);
+      s = __mempcpy (s, fp->_IO_read_ptr, have);
+      fp->_IO_read_ptr += have;
+      want -= have;
     }
 
-  return s - (char *) data;
+  return n - want;
 }
 
 static size_t
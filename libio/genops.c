@@ -27,16 +27,135 @@
 /* Generic or default I/O operations. */
 
 #include "libioP.h"
+#include <atomic.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <sched.h>
 
+/* The open streams are kept on several lists, so that threads opening
+   and closing streams at the same time do not contend for one lock.
+   Each thread links the streams it opens into a list assigned to it
+   when it first opens a stream, and the index of the list is recorded
+   in the _flags2 field of the stream.
+
+   The lists are parts of one chain, which starts at the exported
+   _IO_list_all, so that programs walking it still see all streams.
+   The first list holds the standard streams and ends at
+   _IO_list_marks[0].  Every other list starts after a mark and ends at
+   the next one.  The marks are never open and never move, so linking
+   and unlinking a stream only changes the _chain fields within the
+   part of the chain that belongs to its list, under the lock of that
+   list.
+
+   A thread walking all streams locks one list at a time.  _IO_list_lock
+   locks all of them, in ascending order.  */
+
 #ifdef _IO_MTSAFE_IO
-static _IO_lock_t list_all_lock = _IO_lock_initializer;
+struct stream_list
+{
+  _IO_lock_t lock;
+} __attribute__ ((aligned (64)));
+
+static struct stream_list stream_lists[IO_LIST_COUNT] =
+  {
+    [0 ... IO_LIST_COUNT - 1] = { .lock = _IO_lock_initializer }
+  };
 #endif
 
-static FILE *run_fp;
+#define LIST_MARK(next)							\
+  {									\
+    .file =								\
+      {									\
+	._flags = (_IO_MAGIC | _IO_NO_READS | _IO_NO_WRITES		\
+		   | _IO_UNBUFFERED | _IO_USER_LOCK),			\
+	._chain = (FILE *) (next),					\
+	._fileno = -1,							\
+	._old_offset = _IO_pos_BAD,					\
+	._offset = _IO_pos_BAD,						\
+	._mode = -1							\
+      },								\
+    .vtable = &_IO_file_jumps						\
+  }
+
+struct _IO_FILE_plus _IO_list_marks[IO_LIST_COUNT - 1] =
+  {
+    LIST_MARK (&_IO_list_marks[1]), LIST_MARK (&_IO_list_marks[2]),
+    LIST_MARK (&_IO_list_marks[3]), LIST_MARK (&_IO_list_marks[4]),
+    LIST_MARK (&_IO_list_marks[5]), LIST_MARK (&_IO_list_marks[6]),
+    LIST_MARK (&_IO_list_marks[7]), LIST_MARK (&_IO_list_marks[8]),
+    LIST_MARK (&_IO_list_marks[9]), LIST_MARK (&_IO_list_marks[10]),
+    LIST_MARK (&_IO_list_marks[11]), LIST_MARK (&_IO_list_marks[12]),
+    LIST_MARK (&_IO_list_marks[13]), LIST_MARK (&_IO_list_marks[14]),
+    LIST_MARK (NULL)
+  };
+_Static_assert (IO_LIST_COUNT == 16, "one mark per list after the first");
+
+/* 1 + the list of the calling thread, or 0 if it has not been assigned
+   yet.  */
+static __thread unsigned int thread_list attribute_tls_model_ie;
+
+/* The list assigned to the next thread.  */
+static unsigned int next_list;
+
+/* The stream being processed under the lock of list RUN_LIST, for
+   flush_cleanup.  RUN_LIST is -1 if the thread holds no list lock.  */
+static __thread FILE *run_fp attribute_tls_model_ie;
+static __thread int run_list attribute_tls_model_ie = -1;
+
+static inline FILE *
+list_first (unsigned int list)
+{
+  return (list == 0 ? (FILE *) _IO_list_all
+	  : _IO_list_marks[list - 1].file._chain);
+}
+
+static inline void
+list_set_first (unsigned int list, FILE *fp)
+{
+  if (list == 0)
+    _IO_list_all = (struct _IO_FILE_plus *) fp;
+  else
+    _IO_list_marks[list - 1].file._chain = fp;
+}
+
+/* Return the stream after the last stream of LIST.  */
+static inline FILE *
+list_end (unsigned int list)
+{
+  return list < IO_LIST_COUNT - 1 ? &_IO_list_marks[list].file : NULL;
+}
+
+static inline bool
+is_list_mark (FILE *fp)
+{
+  return (fp >= &_IO_list_marks[0].file
+	  && fp <= &_IO_list_marks[IO_LIST_COUNT - 2].file);
+}
+
+static inline unsigned int
+list_of (FILE *fp)
+{
+  return (fp->_flags2 & _IO_FLAGS2_LIST_MASK) >> _IO_FLAGS2_LIST_SHIFT;
+}
+
+static inline void
+list_lock (unsigned int list)
+{
+#ifdef _IO_MTSAFE_IO
+  _IO_lock_lock (stream_lists[list].lock);
+#endif
+  run_list = list;
+}
+
+static inline void
+list_unlock (unsigned int list)
+{
+  run_list = -1;
+#ifdef _IO_MTSAFE_IO
+  _IO_lock_unlock (stream_lists[list].lock);
+#endif
+}
 
 #ifdef _IO_MTSAFE_IO
 static void
@@ -44,7 +163,9 @@ flush_cleanup (void *not_used)
 {
   if (run_fp != NULL)
     _IO_funlockfile (run_fp);
-  _IO_lock_unlock (list_all_lock);
+  run_fp = NULL;
+  if (run_list >= 0)
+    list_unlock (run_list);
 }
 #endif
 
@@ -53,19 +174,20 @@ _IO_un_link (struct _IO_FILE_plus *fp)
 {
   if (fp->file._flags & _IO_LINKED)
     {
+      unsigned int list = list_of ((FILE *) fp);
+      FILE *end = list_end (list);
       FILE **f;
 #ifdef _IO_MTSAFE_IO
       _IO_cleanup_region_start_noarg (flush_cleanup);
-      _IO_lock_lock (list_all_lock);
+      list_lock (list);
       run_fp = (FILE *) fp;
       _IO_flockfile ((FILE *) fp);
 #endif
-      if (_IO_list_all == NULL)
-	;
-      else if (fp == _IO_list_all)
-	_IO_list_all = (struct _IO_FILE_plus *) _IO_list_all->file._chain;
-      else
-	for (f = &_IO_list_all->file._chain; *f; f = &(*f)->_chain)
+      FILE *first = list_first (list);
+      if (first == (FILE *) fp)
+	list_set_first (list, fp->file._chain);
+      else if (first != end)
+	for (f = &first->_chain; *f != end; f = &(*f)->_chain)
 	  if (*f == (FILE *) fp)
 	    {
 	      *f = fp->file._chain;
@@ -75,7 +197,7 @@ _IO_un_link (struct _IO_FILE_plus *fp)
 #ifdef _IO_MTSAFE_IO
       _IO_funlockfile ((FILE *) fp);
       run_fp = NULL;
-      _IO_lock_unlock (list_all_lock);
+      list_unlock (list);
       _IO_cleanup_region_end (0);
 #endif
     }
@@ -87,19 +209,29 @@ _IO_link_in (struct _IO_FILE_plus *fp)
 {
   if ((fp->file._flags & _IO_LINKED) == 0)
     {
+      unsigned int list = thread_list;
+      if (list == 0)
+	{
+	  list = atomic_fetch_add_relaxed (&next_list, 1) % IO_LIST_COUNT + 1;
+	  thread_list = list;
+	}
+      --list;
+
       fp->file._flags |= _IO_LINKED;
 #ifdef _IO_MTSAFE_IO
       _IO_cleanup_region_start_noarg (flush_cleanup);
-      _IO_lock_lock (list_all_lock);
+      list_lock (list);
       run_fp = (FILE *) fp;
       _IO_flockfile ((FILE *) fp);
 #endif
-      fp->file._chain = (FILE *) _IO_list_all;
-      _IO_list_all = fp;
+      fp->file._flags2 = ((fp->file._flags2 & ~_IO_FLAGS2_LIST_MASK)
+			  | (list << _IO_FLAGS2_LIST_SHIFT));
+      fp->file._chain = list_first (list);
+      list_set_first (list, (FILE *) fp);
 #ifdef _IO_MTSAFE_IO
       _IO_funlockfile ((FILE *) fp);
       run_fp = NULL;
-      _IO_lock_unlock (list_all_lock);
+      list_unlock (list);
       _IO_cleanup_region_end (0);
 #endif
     }
@@ -684,35 +816,40 @@ libc_hidden_def (_IO_adjust_column)
 int
 _IO_flush_all_lockp (int do_lock)
 {
-  int result = 0;
   FILE *fp;
 
+  /* At exit the buffers of other threads are written as well.  */
+  int result = __libio_threadbuf_flush_all (!do_lock);
+
 #ifdef _IO_MTSAFE_IO
   _IO_cleanup_region_start_noarg (flush_cleanup);
-  _IO_lock_lock (list_all_lock);
 #endif
 
-  for (fp = (FILE *) _IO_list_all; fp != NULL; fp = fp->_chain)
+  for (unsigned int list = 0; list < IO_LIST_COUNT; ++list)
     {
-      run_fp = fp;
-      if (do_lock)
-	_IO_flockfile (fp);
-
-      if (((fp->_mode <= 0 && fp->_IO_write_ptr > fp->_IO_write_base)
-	   || (_IO_vtable_offset (fp) == 0
-	       && fp->_mode > 0 && (fp->_wide_data->_IO_write_ptr
-				    > fp->_wide_data->_IO_write_base))
-	   )
-	  && _IO_OVERFLOW (fp, EOF) == EOF)
-	result = EOF;
-
-      if (do_lock)
-	_IO_funlockfile (fp);
-      run_fp = NULL;
+      list_lock (list);
+      for (fp = list_first (list); fp != list_end (list); fp = fp->_chain)
+	{
+	  run_fp = fp;
+	  if (do_lock)
+	    _IO_flockfile (fp);
+
+	  if (((fp->_mode <= 0 && fp->_IO_write_ptr > fp->_IO_write_base)
+	       || (_IO_vtable_offset (fp) == 0
+		   && fp->_mode > 0 && (fp->_wide_data->_IO_write_ptr
+					> fp->_wide_data->_IO_write_base))
+	       )
+	      && _IO_OVERFLOW (fp, EOF) == EOF)
+	    result = EOF;
+
+	  if (do_lock)
+	    _IO_funlockfile (fp);
+	  run_fp = NULL;
+	}
+      list_unlock (list);
     }
 
 #ifdef _IO_MTSAFE_IO
-  _IO_lock_unlock (list_all_lock);
   _IO_cleanup_region_end (0);
 #endif
 
@@ -735,23 +872,26 @@ _IO_flush_all_linebuffered (void)
 
 #ifdef _IO_MTSAFE_IO
   _IO_cleanup_region_start_noarg (flush_cleanup);
-  _IO_lock_lock (list_all_lock);
 #endif
 
-  for (fp = (FILE *) _IO_list_all; fp != NULL; fp = fp->_chain)
+  for (unsigned int list = 0; list < IO_LIST_COUNT; ++list)
     {
-      run_fp = fp;
-      _IO_flockfile (fp);
+      list_lock (list);
+      for (fp = list_first (list); fp != list_end (list); fp = fp->_chain)
+	{
+	  run_fp = fp;
+	  _IO_flockfile (fp);
 
-      if ((fp->_flags & _IO_NO_WRITES) == 0 && fp->_flags & _IO_LINE_BUF)
-	_IO_OVERFLOW (fp, EOF);
+	  if ((fp->_flags & _IO_NO_WRITES) == 0 && fp->_flags & _IO_LINE_BUF)
+	    _IO_OVERFLOW (fp, EOF);
 
-      _IO_funlockfile (fp);
-      run_fp = NULL;
+	  _IO_funlockfile (fp);
+	  run_fp = NULL;
+	}
+      list_unlock (list);
     }
 
 #ifdef _IO_MTSAFE_IO
-  _IO_lock_unlock (list_all_lock);
   _IO_cleanup_region_end (0);
 #endif
 }
@@ -784,62 +924,66 @@ _IO_unbuffer_all (void)
 
 #ifdef _IO_MTSAFE_IO
   _IO_cleanup_region_start_noarg (flush_cleanup);
-  _IO_lock_lock (list_all_lock);
 #endif
 
-  for (fp = (FILE *) _IO_list_all; fp; fp = fp->_chain)
+  for (unsigned int list = 0; list < IO_LIST_COUNT; ++list)
     {
-      int legacy = 0;
+      list_lock (list);
+      for (fp = list_first (list); fp != list_end (list); fp = fp->_chain)
+	{
+	  int legacy = 0;
 
 #if SHLIB_COMPAT (libc, GLIBC_2_0, GLIBC_2_1)
-      if (__glibc_unlikely (_IO_vtable_offset (fp) != 0))
-	legacy = 1;
+	  if (__glibc_unlikely (_IO_vtable_offset (fp) != 0))
+	    legacy = 1;
 #endif
 
-      if (! (fp->_flags & _IO_UNBUFFERED)
-	  /* Iff stream is un-orientated, it wasn't used. */
-	  && (legacy || fp->_mode != 0))
-	{
+	  if (! (fp->_flags & _IO_UNBUFFERED)
+	      /* Iff stream is un-orientated, it wasn't used. */
+	      && (legacy || fp->_mode != 0))
+	    {
 #ifdef _IO_MTSAFE_IO
-	  int cnt;
+	      int cnt;
 #define MAXTRIES 2
-	  for (cnt = 0; cnt < MAXTRIES; ++cnt)
-	    if (fp->_lock == NULL || _IO_lock_trylock (*fp->_lock) == 0)
-	      break;
-	    else
-	      /* Give the other thread time to finish up its use of the
-		 stream.  */
-	      __sched_yield ();
+	      for (cnt = 0; cnt < MAXTRIES; ++cnt)
+		if (fp->_lock == NULL || _IO_lock_trylock (*fp->_lock) == 0)
+		  break;
+		else
+		  /* Give the other thread time to finish up its use of the
+		     stream.  */
+		  __sched_yield ();
 #endif
 
-	  if (! legacy && ! dealloc_buffers && !(fp->_flags & _IO_USER_BUF))
-	    {
-	      fp->_flags |= _IO_USER_BUF;
+	      if (! legacy && ! dealloc_buffers
+		  && !(fp->_flags & _IO_USER_BUF))
+		{
+		  fp->_flags |= _IO_USER_BUF;
 
-	      fp->_freeres_list = freeres_list;
-	      freeres_list = fp;
-	      fp->_freeres_buf = fp->_IO_buf_base;
-	    }
+		  fp->_freeres_list = freeres_list;
+		  freeres_list = fp;
+		  fp->_freeres_buf = fp->_IO_buf_base;
+		}
 
-	  _IO_SETBUF (fp, NULL, 0);
+	      _IO_SETBUF (fp, NULL, 0);
 
-	  if (! legacy && fp->_mode > 0)
-	    _IO_wsetb (fp, NULL, NULL, 0);
+	      if (! legacy && fp->_mode > 0)
+		_IO_wsetb (fp, NULL, NULL, 0);
 
 #ifdef _IO_MTSAFE_IO
-	  if (cnt < MAXTRIES && fp->_lock != NULL)
-	    _IO_lock_unlock (*fp->_lock);
+	      if (cnt < MAXTRIES && fp->_lock != NULL)
+		_IO_lock_unlock (*fp->_lock);
 #endif
-	}
+	    }
 
-      /* Make sure that never again the wide char functions can be
-	 used.  */
-      if (! legacy)
-	fp->_mode = -1;
+	  /* Make sure that never again the wide char functions can be
+	     used.  */
+	  if (! legacy)
+	    fp->_mode = -1;
+	}
+      list_unlock (list);
     }
 
 #ifdef _IO_MTSAFE_IO
-  _IO_lock_unlock (list_all_lock);
   _IO_cleanup_region_end (0);
 #endif
 }
@@ -874,6 +1018,9 @@ _IO_cleanup (void)
      which forces any output from late destructors to be written out. */
   _IO_unbuffer_all ();
 
+  /* Wait until the helper threads have written all queued data.  */
+  call_function_static_weak (__libio_async_flush_all);
+
   return result;
 }
 
@@ -1061,10 +1208,19 @@ _IO_default_imbue (FILE *fp, void *locale)
 {
 }
 
+/* Return FP or the first stream after it which is not a list mark.  */
+static _IO_ITER
+skip_list_marks (FILE *fp)
+{
+  while (fp != NULL && is_list_mark (fp))
+    fp = fp->_chain;
+  return fp;
+}
+
 _IO_ITER
 _IO_iter_begin (void)
 {
-  return (_IO_ITER) _IO_list_all;
+  return skip_list_marks ((FILE *) _IO_list_all);
 }
 libc_hidden_def (_IO_iter_begin)
 
@@ -1078,7 +1234,7 @@ libc_hidden_def (_IO_iter_end)
 _IO_ITER
 _IO_iter_next (_IO_ITER iter)
 {
-  return iter->_chain;
+  return skip_list_marks (iter->_chain);
 }
 libc_hidden_def (_IO_iter_next)
 
@@ -1093,7 +1249,8 @@ void
 _IO_list_lock (void)
 {
 #ifdef _IO_MTSAFE_IO
-  _IO_lock_lock (list_all_lock);
+  for (unsigned int list = 0; list < IO_LIST_COUNT; ++list)
+    _IO_lock_lock (stream_lists[list].lock);
 #endif
 }
 libc_hidden_def (_IO_list_lock)
@@ -1102,7 +1259,8 @@ void
 _IO_list_unlock (void)
 {
 #ifdef _IO_MTSAFE_IO
-  _IO_lock_unlock (list_all_lock);
+  for (unsigned int list = IO_LIST_COUNT; list > 0; --list)
+    _IO_lock_unlock (stream_lists[list - 1].lock);
 #endif
 }
 libc_hidden_def (_IO_list_unlock)
@@ -1111,7 +1269,8 @@ void
 _IO_list_resetlock (void)
 {
 #ifdef _IO_MTSAFE_IO
-  _IO_lock_init (list_all_lock);
+  for (unsigned int list = 0; list < IO_LIST_COUNT; ++list)
+    _IO_lock_init (stream_lists[list].lock);
 #endif
 }
 libc_hidden_def (_IO_list_resetlock)
@@ -0,0 +1,77 @@
+/* Background writing of output streams.  Generic version.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Without a way to start helper threads inside libc, no stream can be
+   written in the background.  Since __libio_async_start always fails,
+   _IO_FLAGS2_ASYNC is never set, and the other functions are never
+   called for a stream.  */
+
+#include <errno.h>
+#include "libioP.h"
+
+int
+__libio_async_start (FILE *fp)
+{
+  __set_errno (ENOSYS);
+  return -1;
+}
+
+ssize_t
+__libio_async_write (FILE *fp, const void *data, size_t n)
+{
+  __set_errno (ENOSYS);
+  return -1;
+}
+
+int
+__libio_async_sync (FILE *fp)
+{
+  return 0;
+}
+
+void
+__libio_async_wait (FILE *fp)
+{
+}
+
+int
+__libio_async_release (FILE *fp)
+{
+  fp->_flags2 &= ~_IO_FLAGS2_ASYNC;
+  return 0;
+}
+
+void
+__libio_async_flush_all (void)
+{
+}
+
+void
+__libio_async_fork_lock (void)
+{
+}
+
+void
+__libio_async_fork_unlock_parent (void)
+{
+}
+
+void
+__libio_async_fork_unlock_child (void)
+{
+}
@@ -44,6 +44,11 @@ _IO_new_fclose (FILE *fp)
     return _IO_old_fclose (fp);
 #endif
 
+  /* Write out and detach the buffers of all threads.  */
+  int threadbuf_status = 0;
+  if (fp->_flags2 & _IO_FLAGS2_THREADBUF)
+    threadbuf_status = __libio_threadbuf_release (fp, 1);
+
   /* First unlink the stream.  */
   if (fp->_flags & _IO_IS_FILEBUF)
     _IO_un_link ((struct _IO_FILE_plus *) fp);
@@ -53,6 +58,8 @@ _IO_new_fclose (FILE *fp)
     status = _IO_file_close_it (fp);
   else
     status = fp->_flags & _IO_ERR_SEEN ? -1 : 0;
+  if (threadbuf_status != 0)
+    status = EOF;
   _IO_release_lock (fp);
   _IO_FINISH (fp);
   if (fp->_mode > 0)
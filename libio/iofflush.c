@@ -36,8 +36,13 @@ _IO_fflush (FILE *fp)
     {
       int result;
       CHECK_FILE (fp, EOF);
+      result = 0;
+      if ((fp->_flags2 & _IO_FLAGS2_THREADBUF) != 0)
+	/* Write out the buffer of the calling thread.  */
+	result = __libio_threadbuf_flush (fp);
       _IO_acquire_lock (fp);
-      result = _IO_SYNC (fp) ? EOF : 0;
+      if (_IO_SYNC (fp))
+	result = EOF;
       _IO_release_lock (fp);
       return result;
     }
@@ -33,6 +33,7 @@ _IO_fputs (const char *str, FILE *fp)
   size_t len = strlen (str);
   int result = EOF;
   CHECK_FILE (fp, EOF);
+  fp = _IO_threadbuf_stream (fp);
   _IO_acquire_lock (fp);
   if ((_IO_vtable_offset (fp) != 0 || _IO_fwide (fp, -1) == -1)
       && _IO_sputn (fp, str, len) == len)
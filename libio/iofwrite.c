@@ -34,6 +34,7 @@ _IO_fwrite (const void *buf, size_t size, size_t count, FILE *fp)
   CHECK_FILE (fp, 0);
   if (request == 0)
     return 0;
+  fp = _IO_threadbuf_stream (fp);
   _IO_acquire_lock (fp);
   if (_IO_vtable_offset (fp) != 0 || _IO_fwide (fp, -1) == -1)
     written = _IO_sputn (fp, (const char *) buf, request);
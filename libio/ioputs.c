@@ -33,15 +33,16 @@ _IO_puts (const char *str)
 {
   int result = EOF;
   size_t len = strlen (str);
-  _IO_acquire_lock (stdout);
+  FILE *fp = _IO_threadbuf_stream (stdout);
+  _IO_acquire_lock (fp);
 
-  if ((_IO_vtable_offset (stdout) != 0
-       || _IO_fwide (stdout, -1) == -1)
-      && _IO_sputn (stdout, str, len) == len
-      && _IO_putc_unlocked ('\n', stdout) != EOF)
+  if ((_IO_vtable_offset (fp) != 0
+       || _IO_fwide (fp, -1) == -1)
+      && _IO_sputn (fp, str, len) == len
+      && _IO_putc_unlocked ('\n', fp) != EOF)
     result = MIN (INT_MAX, len + 1);
 
-  _IO_release_lock (stdout);
+  _IO_release_lock (fp);
   return result;
 }
 
@@ -0,0 +1,394 @@
+/* Per-thread buffers for output streams.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* A stream marked with _IO_FLAGS2_THREADBUF is not written through its
+   own buffer.  Instead each thread gets a private stream, whose buffer
+   is written to the file descriptor of the shared stream in whole
+   lines.  As long as lines fit into the buffer, the output of different
+   threads is interleaved only at line boundaries.
+
+   The buffers of all threads are also kept on a list with a lock of its
+   own, so that fclose, exit and fork can find them.  A thread takes it
+   only when it first writes to a stream and when it exits.  Because
+   fclose, __fsetthreadbuf and exit write out the buffers of other
+   threads, each private stream has a lock of its own.  Only its thread
+   and these functions take it, so it is normally uncontended.  */
+
+#include <atomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <not-cancel.h>
+#include "libioP.h"
+
+struct threadbuf
+{
+  /* The stream written by the thread.  Must come first.  */
+  struct _IO_FILE_plus file;
+  /* The shared stream, or NULL after it has been closed or switched
+     back to the shared buffer.  */
+  FILE *owner;
+  /* The next buffer of the same thread.  */
+  struct threadbuf *next;
+  /* The next buffer of any thread.  */
+  struct threadbuf *all_next;
+  /* The lock of FILE.  */
+  _IO_lock_t lock;
+  char buf[];
+};
+
+/* The buffers of the calling thread, most recently used first.  */
+static __thread struct threadbuf *thread_buffers attribute_tls_model_ie;
+
+/* The buffers of all threads.  Protected by all_buffers_lock, which is
+   taken after the locks of the lists of streams and before the locks of
+   the buffers.  */
+static struct threadbuf *all_buffers;
+static _IO_lock_t all_buffers_lock = _IO_lock_initializer;
+
+static const struct _IO_jump_t _IO_threadbuf_jumps;
+
+/* Write the N bytes at DATA to the file descriptor of the stream of
+   TB.  CANCEL says whether the write may be a cancellation point.  */
+static int
+threadbuf_write (struct threadbuf *tb, const char *data, size_t n,
+		 bool cancel)
+{
+  FILE *owner = atomic_load_relaxed (&tb->owner);
+  if (owner == NULL)
+    return 0;
+  if ((owner->_flags2 & _IO_FLAGS2_NOTCANCEL) != 0)
+    cancel = false;
+
+  while (n > 0)
+    {
+      ssize_t count = (cancel
+		       ? __write (owner->_fileno, data, n)
+		       : __write_nocancel (owner->_fileno, data, n));
+      if (count < 0)
+	{
+	  tb->file.file._flags |= _IO_ERR_SEEN;
+	  _IO_flockfile (owner);
+	  owner->_flags |= _IO_ERR_SEEN;
+	  _IO_funlockfile (owner);
+	  return EOF;
+	}
+      data += count;
+      n -= count;
+    }
+  return 0;
+}
+
+/* Write the buffered data of TB.  If LINES, an incomplete last line is
+   kept in the buffer unless it fills the whole buffer.  */
+static int
+threadbuf_flush (struct threadbuf *tb, bool lines, bool cancel)
+{
+  FILE *fp = &tb->file.file;
+  char *base = fp->_IO_write_base;
+  size_t len = fp->_IO_write_ptr - base;
+
+  if (lines)
+    {
+      char *nl = __memrchr (base, '\n', len);
+      if (nl != NULL)
+	len = nl + 1 - base;
+      else if (fp->_IO_write_ptr < fp->_IO_buf_end)
+	return 0;
+    }
+  if (len == 0)
+    return 0;
+
+  /* On error the data is discarded, like the file stream does when it
+     cannot make progress.  */
+  int result = threadbuf_write (tb, base, len, cancel);
+  size_t rest = fp->_IO_write_ptr - (base + len);
+  memmove (base, base + len, rest);
+  fp->_IO_write_ptr = base + rest;
+  return result;
+}
+
+static int
+_IO_threadbuf_overflow (FILE *fp, int c)
+{
+  struct threadbuf *tb = (struct threadbuf *) fp;
+
+  if (c == EOF)
+    return threadbuf_flush (tb, false, true);
+  if (fp->_IO_write_ptr == fp->_IO_buf_end
+      && threadbuf_flush (tb, true, true) == EOF)
+    return EOF;
+  *fp->_IO_write_ptr++ = c;
+  /* A line-buffered stream keeps _IO_write_end at the start of the
+     buffer, so every character comes here.  */
+  if (c == '\n' && (fp->_flags & _IO_LINE_BUF) != 0
+      && threadbuf_flush (tb, true, true) == EOF)
+    return EOF;
+  return (unsigned char) c;
+}
+
+static size_t
+_IO_threadbuf_xsputn (FILE *fp, const void *data, size_t n)
+{
+  struct threadbuf *tb = (struct threadbuf *) fp;
+  const char *s = data;
+  size_t to_do = n;
+
+  while (to_do > 0)
+    {
+      size_t count = fp->_IO_buf_end - fp->_IO_write_ptr;
+      if (count == 0)
+	{
+	  if (threadbuf_flush (tb, true, true) == EOF)
+	    break;
+	  continue;
+	}
+      if (count > to_do)
+	count = to_do;
+      fp->_IO_write_ptr = __mempcpy (fp->_IO_write_ptr, s, count);
+      s += count;
+      to_do -= count;
+    }
+
+  if ((fp->_flags & _IO_LINE_BUF) != 0 && to_do < n
+      && memchr (data, '\n', n - to_do) != NULL)
+    threadbuf_flush (tb, true, true);
+  return n - to_do;
+}
+
+static int
+_IO_threadbuf_sync (FILE *fp)
+{
+  return threadbuf_flush ((struct threadbuf *) fp, false, true);
+}
+
+static const struct _IO_jump_t _IO_threadbuf_jumps libio_vtable =
+{
+  JUMP_INIT_DUMMY,
+  JUMP_INIT(finish, _IO_default_finish),
+  JUMP_INIT(overflow, _IO_threadbuf_overflow),
+  JUMP_INIT(underflow, _IO_default_underflow),
+  JUMP_INIT(uflow, _IO_default_uflow),
+  JUMP_INIT(pbackfail, _IO_default_pbackfail),
+  JUMP_INIT(xsputn, _IO_threadbuf_xsputn),
+  JUMP_INIT(xsgetn, _IO_default_xsgetn),
+  JUMP_INIT(seekoff, _IO_default_seekoff),
+  JUMP_INIT(seekpos, _IO_default_seekpos),
+  JUMP_INIT(setbuf, _IO_default_setbuf),
+  JUMP_INIT(sync, _IO_threadbuf_sync),
+  JUMP_INIT(doallocate, _IO_default_doallocate),
+  JUMP_INIT(read, _IO_default_read),
+  JUMP_INIT(write, _IO_default_write),
+  JUMP_INIT(seek, _IO_default_seek),
+  JUMP_INIT(close, _IO_default_close),
+  JUMP_INIT(stat, _IO_default_stat),
+  JUMP_INIT(showmanyc, _IO_default_showmanyc),
+  JUMP_INIT(imbue, _IO_default_imbue)
+};
+
+/* Free the buffers of the calling thread whose stream is gone.  Must be
+   called with all_buffers_lock held.  */
+static void
+threadbuf_free_dead (void)
+{
+  struct threadbuf **prevp = &thread_buffers;
+  while (*prevp != NULL)
+    {
+      struct threadbuf *tb = *prevp;
+      if (atomic_load_relaxed (&tb->owner) != NULL)
+	{
+	  prevp = &tb->next;
+	  continue;
+	}
+      *prevp = tb->next;
+      for (struct threadbuf **allp = &all_buffers; *allp != NULL;
+	   allp = &(*allp)->all_next)
+	if (*allp == tb)
+	  {
+	    *allp = tb->all_next;
+	    break;
+	  }
+      free (tb);
+    }
+}
+
+FILE *
+__libio_threadbuf_lookup (FILE *fp)
+{
+  struct threadbuf **prevp = &thread_buffers;
+  for (struct threadbuf *tb = *prevp; tb != NULL;
+       prevp = &tb->next, tb = *prevp)
+    if (atomic_load_relaxed (&tb->owner) == fp)
+      {
+	if (prevp != &thread_buffers)
+	  {
+	    *prevp = tb->next;
+	    tb->next = thread_buffers;
+	    thread_buffers = tb;
+	  }
+	return &tb->file.file;
+      }
+
+  /* The buffer has the size __fsetthreadbuf allocated for FP.  */
+  size_t size = fp->_IO_buf_end - fp->_IO_buf_base;
+  if (size == 0)
+    size = BUFSIZ;
+  struct threadbuf *tb = malloc (sizeof (*tb) + size);
+  if (tb == NULL)
+    /* Fall back to the shared buffer.  */
+    return fp;
+
+  FILE *f = &tb->file.file;
+  f->_lock = &tb->lock;
+  _IO_no_init (f, 0, -1, NULL, NULL);
+  /* Other threads may lock the stream to write out its buffer even if
+     this thread started before them.  */
+  f->_flags2 |= _IO_FLAGS2_NEED_LOCK;
+  _IO_JUMPS (&tb->file) = &_IO_threadbuf_jumps;
+  f->_flags |= (_IO_NO_READS | _IO_CURRENTLY_PUTTING
+		| (fp->_flags & _IO_LINE_BUF));
+  _IO_setb (f, tb->buf, tb->buf + size, 0);
+  _IO_setg (f, tb->buf, tb->buf, tb->buf);
+  f->_IO_write_base = f->_IO_write_ptr = tb->buf;
+  f->_IO_write_end = (f->_flags & _IO_LINE_BUF) ? tb->buf : tb->buf + size;
+  tb->owner = fp;
+
+  _IO_lock_lock (all_buffers_lock);
+  threadbuf_free_dead ();
+  tb->next = thread_buffers;
+  thread_buffers = tb;
+  tb->all_next = all_buffers;
+  all_buffers = tb;
+  _IO_lock_unlock (all_buffers_lock);
+
+  return f;
+}
+
+/* Write out the buffer of TB, which belongs to the calling thread.  */
+static int
+threadbuf_flush_own (struct threadbuf *tb)
+{
+  int result;
+  _IO_acquire_lock (&tb->file.file);
+  result = threadbuf_flush (tb, false, true);
+  _IO_release_lock (&tb->file.file);
+  return result;
+}
+
+int
+__libio_threadbuf_flush (FILE *fp)
+{
+  for (struct threadbuf *tb = thread_buffers; tb != NULL; tb = tb->next)
+    if (atomic_load_relaxed (&tb->owner) == fp)
+      return threadbuf_flush_own (tb);
+  return 0;
+}
+
+int
+__libio_threadbuf_flush_all (int all_threads)
+{
+  int result = 0;
+
+  if (!all_threads)
+    {
+      for (struct threadbuf *tb = thread_buffers; tb != NULL; tb = tb->next)
+	if (threadbuf_flush_own (tb) == EOF)
+	  result = EOF;
+      return result;
+    }
+
+  /* At exit the other threads may still be running, and may be in the
+     middle of writing to their buffers.  Like the streams themselves
+     at exit, such buffers are skipped instead of waiting for them.  */
+  if (atomic_load_relaxed (&all_buffers) == NULL)
+    return 0;
+  _IO_lock_lock (all_buffers_lock);
+  for (struct threadbuf *tb = all_buffers; tb != NULL; tb = tb->all_next)
+    if (_IO_lock_trylock (tb->lock) == 0)
+      {
+	if (threadbuf_flush (tb, false, false) == EOF)
+	  result = EOF;
+	_IO_lock_unlock (tb->lock);
+      }
+  _IO_lock_unlock (all_buffers_lock);
+  return result;
+}
+
+int
+__libio_threadbuf_release (FILE *fp, int detach)
+{
+  int result = 0;
+
+  _IO_lock_lock (all_buffers_lock);
+  for (struct threadbuf *tb = all_buffers; tb != NULL; tb = tb->all_next)
+    if (atomic_load_relaxed (&tb->owner) == fp)
+      {
+	/* Wait until the thread has finished its current write.  */
+	_IO_lock_lock (tb->lock);
+	if (threadbuf_flush (tb, false, false) == EOF)
+	  result = EOF;
+	/* The thread frees the buffer when it next needs a new one, or
+	   when it exits.  */
+	if (detach)
+	  atomic_store_relaxed (&tb->owner, NULL);
+	_IO_lock_unlock (tb->lock);
+      }
+  _IO_lock_unlock (all_buffers_lock);
+  return result;
+}
+
+void
+__libio_threadbuf_fork_lock (void)
+{
+  _IO_lock_lock (all_buffers_lock);
+}
+
+void
+__libio_threadbuf_fork_unlock_parent (void)
+{
+  _IO_lock_unlock (all_buffers_lock);
+}
+
+void
+__libio_threadbuf_fork_unlock_child (void)
+{
+  /* The threads which held the locks of their buffers do not exist in
+     the child.  */
+  for (struct threadbuf *tb = all_buffers; tb != NULL; tb = tb->all_next)
+    _IO_lock_init (tb->lock);
+  _IO_lock_init (all_buffers_lock);
+}
+
+void
+__libio_threadbuf_freeres (void)
+{
+  if (thread_buffers == NULL)
+    return;
+
+  /* The other threads only write out these buffers with
+     all_buffers_lock held.  */
+  _IO_lock_lock (all_buffers_lock);
+  for (struct threadbuf *tb = thread_buffers; tb != NULL; tb = tb->next)
+    {
+      threadbuf_flush (tb, false, false);
+      atomic_store_relaxed (&tb->owner, NULL);
+    }
+  threadbuf_free_dead ();
+  _IO_lock_unlock (all_buffers_lock);
+}
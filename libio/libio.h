@@ -89,6 +89,11 @@ typedef struct
 #define _IO_FLAGS2_NOCLOSE 32
 #define _IO_FLAGS2_CLOEXEC 64
 #define _IO_FLAGS2_NEED_LOCK 128
+#define _IO_FLAGS2_THREADBUF 256
+#define _IO_FLAGS2_ASYNC 512
+/* The list of open streams the stream is linked into.  */
+#define _IO_FLAGS2_LIST_SHIFT 16
+#define _IO_FLAGS2_LIST_MASK (0xf << _IO_FLAGS2_LIST_SHIFT)
 
 /* _IO_pos_BAD is an off64_t value indicating error, unknown, or EOF.  */
 #define _IO_pos_BAD ((off64_t) -1)
@@ -480,6 +480,7 @@ extern const struct _IO_jump_t _IO_old_file_jumps attribute_hidden;
 extern const struct _IO_jump_t _IO_streambuf_jumps;
 extern const struct _IO_jump_t _IO_old_proc_jumps attribute_hidden;
 extern const struct _IO_jump_t _IO_str_jumps attribute_hidden;
+extern const struct _IO_jump_t _IO_strread_jumps attribute_hidden;
 extern const struct _IO_jump_t _IO_wstr_jumps attribute_hidden;
 extern int _IO_do_write (FILE *, const char *, size_t);
 libc_hidden_proto (_IO_do_write)
@@ -671,6 +672,13 @@ extern int __vfwprintf_internal (FILE *fp, const wchar_t *format, va_list ap,
 				 unsigned int mode_flags)
     attribute_hidden;
 
+/* Likewise for a format string parsed by printf_compile.  */
+struct printf_compiled;
+extern int __vfprintf_compiled_internal (FILE *fp,
+					 const struct printf_compiled *cf,
+					 va_list ap, unsigned int mode_flags)
+    attribute_hidden;
+
 extern int __vasprintf_internal (char **result_ptr, const char *format,
 				 va_list ap, unsigned int mode_flags)
     attribute_hidden;
@@ -695,6 +703,10 @@ extern int __vsnprintf_internal (char *string, size_t maxlen,
 				 const char *format, va_list ap,
 				 unsigned int mode_flags)
     attribute_hidden;
+extern int __vsnprintf_compiled_internal (char *string, size_t maxlen,
+					  const struct printf_compiled *cf,
+					  va_list ap, unsigned int mode_flags)
+    attribute_hidden;
 extern int __vswprintf_internal (wchar_t *string, size_t maxlen,
 				 const wchar_t *format, va_list ap,
 				 unsigned int mode_flags)
@@ -740,6 +752,12 @@ extern size_t _IO_getwline_info (FILE *,wchar_t *, size_t,
 
 extern struct _IO_FILE_plus *_IO_list_all;
 libc_hidden_proto (_IO_list_all)
+/* The open streams are kept on IO_LIST_COUNT lists, which are joined
+   into the chain starting at _IO_list_all by these marks.  See
+   genops.c.  */
+#define IO_LIST_COUNT 16
+extern struct _IO_FILE_plus _IO_list_marks[IO_LIST_COUNT - 1]
+  attribute_hidden;
 extern void (*_IO_cleanup_registration_needed) (void);
 
 extern void _IO_str_init_static_internal (struct _IO_strfile_ *, char *,
@@ -801,6 +819,13 @@ extern int __vfwscanf_internal (FILE *fp, const wchar_t *format, va_list argp,
 				unsigned int flags)
   attribute_hidden;
 
+/* Likewise for a format string parsed by scanf_compile.  */
+struct scanf_compiled;
+extern int __vfscanf_compiled_internal (FILE *fp,
+					const struct scanf_compiled *cf,
+					va_list argp, unsigned int flags)
+  attribute_hidden;
+
 extern int _IO_vscanf (const char *, va_list) __THROW;
 
 #ifdef _IO_MTSAFE_IO
@@ -875,6 +900,53 @@ _IO_deallocate_file (FILE *fp)
 # define CHECK_FILE(FILE, RET) do { } while (0)
 #endif
 
+/* Per-thread buffers for streams marked with _IO_FLAGS2_THREADBUF by
+   __fsetthreadbuf.  Each thread writes into a private stream whose lock
+   is only contended by fclose and __fsetthreadbuf, and which is written
+   to the file descriptor of FP in whole lines.
+   __libio_threadbuf_release writes out the buffers of all threads for
+   FP, and detaches them from FP if DETACH is nonzero.  */
+extern FILE *__libio_threadbuf_lookup (FILE *fp) attribute_hidden;
+extern int __libio_threadbuf_flush (FILE *fp) attribute_hidden;
+extern int __libio_threadbuf_flush_all (int all_threads) attribute_hidden;
+extern int __libio_threadbuf_release (FILE *fp, int detach) attribute_hidden;
+extern void __libio_threadbuf_fork_lock (void) attribute_hidden;
+extern void __libio_threadbuf_fork_unlock_parent (void) attribute_hidden;
+extern void __libio_threadbuf_fork_unlock_child (void) attribute_hidden;
+
+/* Return the stream to which the calling thread writes instead of FP.
+   This is FP itself unless FP uses per-thread buffers.  */
+static inline FILE *
+_IO_threadbuf_stream (FILE *fp)
+{
+  if (__glibc_likely ((fp->_flags2 & _IO_FLAGS2_THREADBUF) == 0))
+    return fp;
+  return __libio_threadbuf_lookup (fp);
+}
+
+/* Background writing of streams marked with _IO_FLAGS2_ASYNC by
+   __fsetasync.  _IO_new_file_write queues the data for a helper thread,
+   whose write errors are reported by __libio_async_sync and
+   __libio_async_release.  Static programs contain this code only if
+   they call __fsetasync, which is the only way to set the flag.  */
+#ifdef SHARED
+# define _IO_async_weak
+#else
+# define _IO_async_weak weak_function
+#endif
+extern int __libio_async_start (FILE *fp) attribute_hidden;
+extern ssize_t __libio_async_write (FILE *fp, const void *data, size_t n)
+     attribute_hidden _IO_async_weak;
+extern int __libio_async_sync (FILE *fp) attribute_hidden _IO_async_weak;
+extern void __libio_async_wait (FILE *fp) attribute_hidden _IO_async_weak;
+extern int __libio_async_release (FILE *fp) attribute_hidden _IO_async_weak;
+extern void __libio_async_flush_all (void) attribute_hidden _IO_async_weak;
+extern void __libio_async_fork_lock (void) attribute_hidden _IO_async_weak;
+extern void __libio_async_fork_unlock_parent (void)
+     attribute_hidden _IO_async_weak;
+extern void __libio_async_fork_unlock_child (void)
+     attribute_hidden _IO_async_weak;
+
 static inline void
 __attribute__ ((__always_inline__))
 _IO_acquire_lock_fct (FILE **p)
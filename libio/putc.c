@@ -25,6 +25,7 @@ _IO_putc (int c, FILE *fp)
 {
   int result;
   CHECK_FILE (fp, EOF);
+  fp = _IO_threadbuf_stream (fp);
   if (!_IO_need_lock (fp))
     return _IO_putc_unlocked (c, fp);
   _IO_acquire_lock (fp);
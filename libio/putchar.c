@@ -24,9 +24,10 @@ int
 putchar (int c)
 {
   int result;
-  _IO_acquire_lock (stdout);
-  result = _IO_putc_unlocked (c, stdout);
-  _IO_release_lock (stdout);
+  FILE *fp = _IO_threadbuf_stream (stdout);
+  _IO_acquire_lock (fp);
+  result = _IO_putc_unlocked (c, fp);
+  _IO_release_lock (fp);
   return result;
 }
 
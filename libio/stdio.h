@@ -505,6 +505,42 @@ extern int __isoc99_vsscanf (const char *__restrict __s,
 # endif
 #endif /* Use ISO C9x.  */
 
+#ifdef __USE_GNU
+/* Parsed scanf format strings.  */
+struct scanf_compiled;
+
+/* Parse the format string FORMAT once, so that it can be used with the
+   functions below without parsing it on every call.  The result keeps
+   a copy of FORMAT.  Return NULL and set errno if there is not enough
+   memory.  */
+extern struct scanf_compiled *scanf_compile (const char *__format)
+     __THROW __wur __nonnull ((1));
+
+/* Free the parsed format string CF.  */
+extern void scanf_compiled_free (struct scanf_compiled *__cf) __THROW;
+
+/* Like vfscanf and fscanf, but with a format string parsed by
+   `scanf_compile'.
+
+   These functions are possible cancellation points and therefore not
+   marked with __THROW.  */
+extern int vfscanf_compiled (FILE *__restrict __s,
+			     const struct scanf_compiled *__restrict __cf,
+			     __gnuc_va_list __arg) __wur;
+extern int fscanf_compiled (FILE *__restrict __stream,
+			    const struct scanf_compiled *__restrict __cf, ...)
+     __wur;
+
+/* Like vsscanf and sscanf, but with a format string parsed by
+   `scanf_compile'.  */
+extern int vsscanf_compiled (const char *__restrict __s,
+			     const struct scanf_compiled *__restrict __cf,
+			     __gnuc_va_list __arg) __THROW;
+extern int sscanf_compiled (const char *__restrict __s,
+			    const struct scanf_compiled *__restrict __cf, ...)
+     __THROW;
+#endif
+
 
 /* Read a character from STREAM.
 
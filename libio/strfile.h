@@ -28,6 +28,7 @@
 #define STRFILE_H_
 
 #include "libioP.h"
+#include <string.h>
 
 typedef void *(*_IO_alloc_type) (size_t);
 typedef void (*_IO_free_type) (void*);
@@ -83,6 +84,10 @@ typedef struct
 
 extern const struct _IO_jump_t _IO_wstrn_jumps attribute_hidden;
 
+/* The number of characters of the string which _IO_strfile_read
+   streams look at in one go.  */
+#define _IO_STRREAD_CHUNK 1024
+
 /* Initialize an _IO_strfile SF to read from narrow string STRING, and
    return the corresponding FILE object.  It is not necessary to fclose
    the FILE when it is no longer needed.  */
@@ -91,8 +96,10 @@ _IO_strfile_read (_IO_strfile *sf, const char *string)
 {
   sf->_sbf._f._lock = NULL;
   _IO_no_init (&sf->_sbf._f, _IO_USER_LOCK, -1, NULL, NULL);
-  _IO_JUMPS (&sf->_sbf) = &_IO_str_jumps;
-  _IO_str_init_static_internal (sf, (char*)string, 0, NULL);
+  _IO_JUMPS (&sf->_sbf) = &_IO_strread_jumps;
+  /* The rest of STRING is found as it is read.  */
+  _IO_str_init_static_internal (sf, (char*)string,
+				__strnlen (string, _IO_STRREAD_CHUNK), NULL);
   return &sf->_sbf._f;
 }
 
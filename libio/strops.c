@@ -158,6 +158,27 @@ _IO_str_underflow (FILE *fp)
 }
 libc_hidden_def (_IO_str_underflow)
 
+/* Streams set up by _IO_strfile_read do not determine the length of
+   the string in advance, which would make sscanf take time
+   proportional to the length of its input string rather than to the
+   part it reads.  Instead the get area ends after at most
+   _IO_STRREAD_CHUNK characters and is extended here when it runs
+   empty.  The character at _IO_read_end is always part of the string
+   or its terminating null character.  */
+static int
+_IO_strread_underflow (FILE *fp)
+{
+  if (fp->_IO_read_ptr < fp->_IO_read_end)
+    return *((unsigned char *) fp->_IO_read_ptr);
+
+  size_t len = __strnlen (fp->_IO_read_end, _IO_STRREAD_CHUNK);
+  if (len == 0)
+    return EOF;
+  fp->_IO_read_end += len;
+  fp->_IO_buf_end = fp->_IO_read_end;
+  return *((unsigned char *) fp->_IO_read_ptr);
+}
+
 /* The size of the valid part of the buffer.  */
 
 ssize_t
@@ -376,3 +397,27 @@ const struct _IO_jump_t _IO_str_jumps libio_vtable =
   JUMP_INIT(showmanyc, _IO_default_showmanyc),
   JUMP_INIT(imbue, _IO_default_imbue)
 };
+
+const struct _IO_jump_t _IO_strread_jumps libio_vtable =
+{
+  JUMP_INIT_DUMMY,
+  JUMP_INIT(finish, _IO_str_finish),
+  JUMP_INIT(overflow, _IO_str_overflow),
+  JUMP_INIT(underflow, _IO_strread_underflow),
+  JUMP_INIT(uflow, _IO_default_uflow),
+  JUMP_INIT(pbackfail, _IO_str_pbackfail),
+  JUMP_INIT(xsputn, _IO_default_xsputn),
+  JUMP_INIT(xsgetn, _IO_default_xsgetn),
+  JUMP_INIT(seekoff, _IO_str_seekoff),
+  JUMP_INIT(seekpos, _IO_default_seekpos),
+  JUMP_INIT(setbuf, _IO_default_setbuf),
+  JUMP_INIT(sync, _IO_default_sync),
+  JUMP_INIT(doallocate, _IO_default_doallocate),
+  JUMP_INIT(read, _IO_default_read),
+  JUMP_INIT(write, _IO_default_write),
+  JUMP_INIT(seek, _IO_default_seek),
+  JUMP_INIT(close, _IO_default_close),
+  JUMP_INIT(stat, _IO_default_stat),
+  JUMP_INIT(showmanyc, _IO_default_showmanyc),
+  JUMP_INIT(imbue, _IO_default_imbue)
+};
@@ -0,0 +1,141 @@
+/* Test the lists of open streams with streams opened by many threads.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <dlfcn.h>
+#include <gnu/lib-names.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdio_ext.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xdlfcn.h>
+#include <support/xstdio.h>
+#include <support/xthread.h>
+#include <support/xunistd.h>
+
+/* More threads than there are lists, so that lists are shared.  */
+enum { nthreads = 40, iterations = 500 };
+
+static char *paths[nthreads];
+static FILE *kept[nthreads];
+static pthread_barrier_t barrier;
+
+static off_t
+file_size (const char *path)
+{
+  struct stat64 st;
+  xstat (path, &st);
+  return st.st_size;
+}
+
+/* Open and close streams concurrently with the other threads, then
+   leave one stream open.  */
+static void *
+opener (void *closure)
+{
+  int id = (uintptr_t) closure;
+
+  xpthread_barrier_wait (&barrier);
+  for (int i = 0; i < iterations; ++i)
+    {
+      FILE *fp = xfopen (paths[id], "w");
+      fprintf (fp, "%d %d\n", id, i);
+      if (i % 7 == 0)
+	/* Flushing all streams walks the lists while they change.  */
+	TEST_COMPARE (fflush (NULL), 0);
+      if (i % 11 == 0)
+	_flushlbf ();
+      xfclose (fp);
+    }
+
+  kept[id] = xfopen (paths[id], "w");
+  return NULL;
+}
+
+static int
+do_test (void)
+{
+  for (int i = 0; i < nthreads; ++i)
+    xclose (create_temp_file ("tst-fopen-threads-", &paths[i]));
+
+  xpthread_barrier_init (&barrier, NULL, nthreads);
+  pthread_t threads[nthreads];
+  for (int i = 0; i < nthreads; ++i)
+    threads[i] = xpthread_create (NULL, opener, (void *) (uintptr_t) i);
+  for (int i = 0; i < nthreads; ++i)
+    xpthread_join (threads[i]);
+  xpthread_barrier_destroy (&barrier);
+
+  /* The streams of all threads are on the chain starting at
+     _IO_list_all, which some programs walk to find them.  The variable
+     of libc is used because a copy relocation in this program would
+     only hold its initial value.  */
+  void *libc = xdlopen (LIBC_SO, RTLD_LAZY | RTLD_NOLOAD);
+  FILE **list_all = xdlsym (libc, "_IO_list_all");
+  for (int i = 0; i < nthreads; ++i)
+    {
+      FILE *fp = *list_all;
+      while (fp != NULL && fp != kept[i])
+	fp = fp->_chain;
+      TEST_VERIFY (fp == kept[i]);
+    }
+  xdlclose (libc);
+
+  /* The kept streams truncated the files.  */
+  for (int i = 0; i < nthreads; ++i)
+    {
+      TEST_COMPARE (file_size (paths[i]), 0);
+      TEST_COMPARE (fputs ("kept\n", kept[i]), 1);
+    }
+
+  /* The child flushes the streams of all threads at exit.  */
+  pid_t pid = xfork ();
+  if (pid == 0)
+    {
+      for (int i = 0; i < nthreads; ++i)
+	TEST_COMPARE (fputs ("child\n", kept[i]), 1);
+      exit (0);
+    }
+  int status;
+  xwaitpid (pid, &status, 0);
+  TEST_COMPARE (status, 0);
+  for (int i = 0; i < nthreads; ++i)
+    TEST_COMPARE (file_size (paths[i]), strlen ("kept\nchild\n"));
+
+  /* fflush (NULL) finds the streams of all threads as well.  */
+  for (int i = 0; i < nthreads; ++i)
+    TEST_COMPARE (fputs ("parent\n", kept[i]), 1);
+  TEST_COMPARE (fflush (NULL), 0);
+  for (int i = 0; i < nthreads; ++i)
+    TEST_COMPARE (file_size (paths[i]),
+		  strlen ("kept\nchild\n") + strlen ("kept\nparent\n"));
+
+  for (int i = 0; i < nthreads; ++i)
+    {
+      xfclose (kept[i]);
+      free (paths[i]);
+    }
+  return 0;
+}
+
+#include <support/test-driver.c>
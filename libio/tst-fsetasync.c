@@ -0,0 +1,225 @@
+/* Test background writing of output streams.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdio_ext.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xunistd.h>
+
+enum { total = 1 << 20 };
+
+static char *path;
+static char *data;
+
+/* Return the contents of PATH, which must have SIZE bytes.  */
+static char *
+read_file (size_t size)
+{
+  char *contents = xmalloc (size + 1);
+  FILE *fp = xfopen (path, "r");
+  TEST_COMPARE (fread (contents, 1, size + 1, fp), size);
+  xfclose (fp);
+  return contents;
+}
+
+static FILE *
+open_async (const char *mode)
+{
+  FILE *fp = xfopen (path, mode);
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_BACKGROUND), FSETASYNC_DIRECT);
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_QUERY), FSETASYNC_BACKGROUND);
+  return fp;
+}
+
+/* Write DATA with several functions and check the file position.  */
+static void
+check_write (int bufmode)
+{
+  FILE *fp = open_async ("w");
+  TEST_COMPARE (setvbuf (fp, NULL, bufmode, 1000), 0);
+  size_t done = 0;
+  for (size_t i = 0; done < total; ++i)
+    {
+      size_t n = (i * 1237) % 100000;
+      if (n > total - done)
+	n = total - done;
+      if (i % 3 == 0)
+	TEST_COMPARE (fwrite (data + done, 1, n, fp), n);
+      else
+	{
+	  n = 1;
+	  TEST_COMPARE (fputc (data[done], fp), (unsigned char) data[done]);
+	}
+      done += n;
+      if (i % 10 == 0)
+	TEST_COMPARE (fflush (fp), 0);
+    }
+  TEST_COMPARE (ftell (fp), total);
+  xfclose (fp);
+
+  char *contents = read_file (total);
+  TEST_VERIFY (memcmp (contents, data, total) == 0);
+  free (contents);
+}
+
+static int
+do_test (void)
+{
+  int fd = create_temp_file ("tst-fsetasync-", &path);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xclose (fd);
+
+  data = xmalloc (total);
+  for (size_t i = 0; i < total; ++i)
+    data[i] = i % 61 == 60 ? '\n' : 'a' + i % 26;
+
+  /* Streams which can be read from are rejected.  */
+  FILE *fp = xfopen (path, "r+");
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_QUERY), FSETASYNC_DIRECT);
+  errno = 0;
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_BACKGROUND), -1);
+  TEST_COMPARE (errno, EINVAL);
+  xfclose (fp);
+
+  fp = xfopen (path, "w");
+  if (__fsetasync (fp, FSETASYNC_BACKGROUND) != FSETASYNC_DIRECT)
+    {
+      if (errno == ENOSYS)
+	FAIL_UNSUPPORTED ("background writing not supported");
+      FAIL_EXIT1 ("__fsetasync: %m");
+    }
+  xfclose (fp);
+
+  check_write (_IOFBF);
+  check_write (_IOLBF);
+  check_write (_IONBF);
+
+  /* Seeking waits for the queued data.  */
+  fp = open_async ("w");
+  TEST_COMPARE (fputs ("0123456789", fp), 1);
+  TEST_COMPARE (fseek (fp, 2, SEEK_SET), 0);
+  TEST_COMPARE (fputs ("ab", fp), 1);
+  TEST_COMPARE (fseek (fp, 0, SEEK_END), 0);
+  TEST_COMPARE (ftell (fp), 10);
+  TEST_COMPARE (fputs ("xyz", fp), 1);
+  /* Switching back writes everything.  */
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_DIRECT), FSETASYNC_BACKGROUND);
+  char *contents = read_file (13);
+  TEST_COMPARE_BLOB (contents, 13, "01ab456789xyz", 13);
+  free (contents);
+  TEST_COMPARE (fputs ("!", fp), 1);
+  xfclose (fp);
+  contents = read_file (14);
+  TEST_COMPARE_BLOB (contents, 14, "01ab456789xyz!", 14);
+  free (contents);
+
+  /* Write errors are reported by fclose and when switching back.  */
+  fp = xfopen ("/dev/full", "w");
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_BACKGROUND), FSETASYNC_DIRECT);
+  TEST_COMPARE (fputs ("data\n", fp), 1);
+  errno = 0;
+  TEST_COMPARE (fclose (fp), EOF);
+  TEST_COMPARE (errno, ENOSPC);
+  fp = xfopen ("/dev/full", "w");
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_BACKGROUND), FSETASYNC_DIRECT);
+  TEST_COMPARE (fwrite (data, 1, 100, fp), 100);
+  TEST_COMPARE (fflush (fp), 0);
+  errno = 0;
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_DIRECT), -1);
+  TEST_COMPARE (errno, ENOSPC);
+  TEST_VERIFY (ferror (fp));
+  /* The error has been reported already.  */
+  TEST_COMPARE (fclose (fp), 0);
+
+  /* fflush does not wait for a writer that cannot make progress.  */
+  int fds[2];
+  xpipe (fds);
+  TEST_COMPARE (fcntl (fds[1], F_SETFL, O_NONBLOCK), 0);
+  size_t in_pipe = 0;
+  ssize_t ret;
+  while ((ret = write (fds[1], data, 4096)) > 0)
+    in_pipe += ret;
+  TEST_COMPARE (errno, EAGAIN);
+  TEST_COMPARE (fcntl (fds[1], F_SETFL, 0), 0);
+  fp = fdopen (fds[1], "w");
+  TEST_VERIFY_EXIT (fp != NULL);
+  TEST_COMPARE (__fsetasync (fp, FSETASYNC_BACKGROUND), FSETASYNC_DIRECT);
+  TEST_COMPARE (fwrite (data, 1, 30000, fp), 30000);
+  TEST_COMPARE (fflush (fp), 0);
+  TEST_COMPARE (fwrite (data, 1, 30000, fp), 30000);
+  TEST_COMPARE (fflush (fp), 0);
+  char *buf = xmalloc (in_pipe + 60000);
+  size_t got = 0;
+  while (got < in_pipe + 60000)
+    {
+      ret = read (fds[0], buf + got, in_pipe + 60000 - got);
+      TEST_VERIFY_EXIT (ret > 0);
+      got += ret;
+    }
+  TEST_VERIFY (memcmp (buf + in_pipe, data, 30000) == 0);
+  TEST_VERIFY (memcmp (buf + in_pipe + 30000, data, 30000) == 0);
+  free (buf);
+  xfclose (fp);
+  xclose (fds[0]);
+
+  /* Data queued before fork is written once, by the parent.  The child
+     writes its own data, and exit waits until it has been written.  The
+     processes share the file offset, but their writes can be
+     interleaved.  */
+  enum { child_size = 200000, size = 7 + 6 + child_size + 7 };
+  fp = open_async ("w");
+  TEST_COMPARE (fputs ("before\n", fp), 1);
+  TEST_COMPARE (fflush (fp), 0);
+  pid_t pid = xfork ();
+  if (pid == 0)
+    {
+      TEST_COMPARE (fputs ("child\n", fp), 1);
+      TEST_COMPARE (fflush (fp), 0);
+      for (int i = 0; i < child_size; ++i)
+	TEST_COMPARE (putc ('z', fp), 'z');
+      exit (0);
+    }
+  int status;
+  xwaitpid (pid, &status, 0);
+  TEST_COMPARE (status, 0);
+  TEST_COMPARE (fputs ("parent\n", fp), 1);
+  xfclose (fp);
+  contents = read_file (size);
+  TEST_VERIFY (memmem (contents, size, "before\n", 7) != NULL);
+  TEST_VERIFY (memmem (contents, size, "child\n", 6) != NULL);
+  TEST_VERIFY (memmem (contents, size, "parent\n", 7) != NULL);
+  size_t count = 0;
+  for (size_t i = 0; i < size; ++i)
+    count += contents[i] == 'z';
+  TEST_COMPARE (count, child_size);
+  free (contents);
+
+  free (data);
+  free (path);
+  return 0;
+}
+
+#include <support/test-driver.c>
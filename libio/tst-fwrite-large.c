@@ -0,0 +1,118 @@
+/* Test fwrite calls larger than the stream buffer.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xunistd.h>
+
+enum { bufsize = 4096, total = 1 << 20 };
+
+static char *data;
+static char *contents;
+
+/* Write DATA to PATH in pieces whose sizes grow by STEP, mixed with
+   writes of single characters, and check the contents of the file and
+   the position of the stream.  MODE and BUFMODE select how the stream
+   is opened and buffered.  */
+static void
+check (const char *path, const char *mode, int bufmode, size_t step)
+{
+  FILE *fp = xfopen (path, mode);
+  TEST_COMPARE (setvbuf (fp, NULL, bufmode, bufsize), 0);
+
+  size_t done = 0;
+  for (size_t i = 0; done < total; ++i)
+    {
+      size_t n = (i * step) % (3 * bufsize + 17);
+      if (n > total - done)
+	n = total - done;
+      if (i % 5 == 0 && n > 0)
+	{
+	  TEST_COMPARE (fputc (data[done], fp), (unsigned char) data[done]);
+	  ++done;
+	  continue;
+	}
+      TEST_COMPARE (fwrite (data + done, 1, n, fp), n);
+      done += n;
+      TEST_COMPARE (ftell (fp), done);
+    }
+  xfclose (fp);
+
+  fp = xfopen (path, "r");
+  TEST_COMPARE (fread (contents, 1, total + 1, fp), total);
+  TEST_VERIFY (memcmp (contents, data, total) == 0);
+  xfclose (fp);
+}
+
+static int
+do_test (void)
+{
+  char *path;
+  int fd = create_temp_file ("tst-fwrite-large-", &path);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xclose (fd);
+
+  data = xmalloc (total);
+  contents = xmalloc (total + 1);
+  for (size_t i = 0; i < total; ++i)
+    data[i] = i % 61 == 60 ? '\n' : 'a' + i % 26;
+
+  static const size_t steps[] = { 1, 97, 1000, 4095, 4097, 9999 };
+  for (size_t i = 0; i < sizeof (steps) / sizeof (steps[0]); ++i)
+    {
+      check (path, "w", _IOFBF, steps[i]);
+      check (path, "w+", _IOFBF, steps[i]);
+      check (path, "w", _IOLBF, steps[i]);
+    }
+
+  /* The position is kept after switching from reading to writing.  */
+  FILE *fp = xfopen (path, "r+");
+  TEST_COMPARE (setvbuf (fp, NULL, _IOFBF, bufsize), 0);
+  TEST_COMPARE (fgetc (fp), data[0]);
+  TEST_COMPARE (fseek (fp, 0, SEEK_CUR), 0);
+  TEST_COMPARE (fwrite (data + 1, 1, 3 * bufsize, fp), 3 * bufsize);
+  TEST_COMPARE (ftell (fp), 3 * bufsize + 1);
+  TEST_COMPARE (fseek (fp, 0, SEEK_CUR), 0);
+  TEST_COMPARE (fgetc (fp), data[3 * bufsize + 1]);
+  xfclose (fp);
+
+  /* Append mode.  */
+  fp = xfopen (path, "a");
+  TEST_COMPARE (setvbuf (fp, NULL, _IOFBF, bufsize), 0);
+  TEST_COMPARE (fwrite ("x", 1, 1, fp), 1);
+  TEST_COMPARE (fwrite (data, 1, 2 * bufsize + 5, fp), 2 * bufsize + 5);
+  xfclose (fp);
+  fp = xfopen (path, "r");
+  TEST_COMPARE (fseek (fp, total, SEEK_SET), 0);
+  TEST_COMPARE (fread (contents, 1, 2 * bufsize + 7, fp), 2 * bufsize + 6);
+  TEST_COMPARE (contents[0], 'x');
+  TEST_VERIFY (memcmp (contents + 1, data, 2 * bufsize + 5) == 0);
+  xfclose (fp);
+
+  free (contents);
+  free (data);
+  free (path);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,197 @@
+/* Test reading files larger than the mapping of "m" streams.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <wchar.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xunistd.h>
+
+/* The files span several mappings of 16 MiB.  They are sparse, so
+   that they take no space except around the boundaries of the
+   mappings.  */
+#define WINDOW (16 * 1024 * 1024)
+#define SIZE (2 * WINDOW + 12345)
+
+static const char line[] = "abcdefghijklmnopqrstuvwxyz\n";
+static const char last[] = "last\n";
+
+static char *path;
+static int fd;
+
+static void
+xpwrite (const char *s, size_t n, off64_t offset)
+{
+  TEST_COMPARE (pwrite64 (fd, s, n, offset), n);
+}
+
+/* Read the file in chunks and compare them with its contents.  */
+static void
+check_fread (size_t chunk)
+{
+  FILE *fp = xfopen (path, "rm");
+  char *buf = xmalloc (chunk);
+  char *expected = xmalloc (chunk);
+  off64_t offset = 0;
+  size_t n;
+
+  while ((n = fread (buf, 1, chunk, fp)) > 0)
+    {
+      TEST_COMPARE (pread64 (fd, expected, chunk, offset), n);
+      if (memcmp (buf, expected, n) != 0)
+	{
+	  support_record_failure ();
+	  printf ("error: chunk size %zu: wrong data at %lld\n", chunk,
+		  (long long) offset);
+	  break;
+	}
+      offset += n;
+      TEST_COMPARE (ftello64 (fp), offset);
+    }
+  TEST_COMPARE (offset, SIZE);
+  TEST_VERIFY (feof (fp));
+  free (expected);
+  free (buf);
+  xfclose (fp);
+}
+
+static int
+do_test (void)
+{
+  fd = create_temp_file ("tst-mmap-window-", &path);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xftruncate (fd, SIZE);
+  xpwrite ("line0\n", 6, 0);
+  xpwrite (line, strlen (line), WINDOW - 10);
+  xpwrite (line, strlen (line), 2 * WINDOW - 1);
+  xpwrite (last, strlen (last), SIZE - strlen (last));
+
+  check_fread (1);
+  check_fread (4093);
+  check_fread (WINDOW + 3);
+
+  /* Lines crossing the end of a mapping are read in one piece.  */
+  FILE *fp = xfopen (path, "rm");
+  char *buf = NULL;
+  size_t bufsize = 0;
+  ssize_t n;
+  ssize_t last_n = 0;
+  off64_t total = 0;
+  int found = 0;
+  while ((n = getline (&buf, &bufsize, fp)) > 0)
+    {
+      last_n = n;
+      total += n;
+      if (n >= strlen (line)
+	  && strcmp (buf + n - strlen (line), line) == 0)
+	++found;
+    }
+  TEST_COMPARE (total, SIZE);
+  TEST_COMPARE (found, 2);
+  TEST_VERIFY (last_n >= strlen (last));
+  TEST_COMPARE_STRING (buf + last_n - strlen (last), last);
+
+  /* Seeking within and across mappings.  */
+  TEST_COMPARE (fseeko64 (fp, 0, SEEK_SET), 0);
+  TEST_VERIFY (fgets (buf, bufsize, fp) != NULL);
+  TEST_COMPARE_STRING (buf, "line0\n");
+  TEST_COMPARE (fseeko64 (fp, WINDOW - 10, SEEK_SET), 0);
+  TEST_VERIFY (fgets (buf, bufsize, fp) != NULL);
+  TEST_COMPARE_STRING (buf, line);
+  TEST_COMPARE (ftello64 (fp), WINDOW - 10 + strlen (line));
+  TEST_COMPARE (fseeko64 (fp, -(off64_t) strlen (last), SEEK_END), 0);
+  TEST_VERIFY (fgets (buf, bufsize, fp) != NULL);
+  TEST_COMPARE_STRING (buf, last);
+  TEST_COMPARE (fgetc (fp), EOF);
+  TEST_COMPARE (fseeko64 (fp, 2 * WINDOW - 1, SEEK_SET), 0);
+  TEST_COMPARE (fgetc (fp), 'a');
+  TEST_COMPARE (fseeko64 (fp, 1, SEEK_CUR), 0);
+  TEST_COMPARE (fgetc (fp), 'c');
+  TEST_COMPARE (ftello64 (fp), 2 * WINDOW + 2);
+
+  /* Pushing back a character at the start of a mapping.  */
+  TEST_COMPARE (fseeko64 (fp, 2 * WINDOW, SEEK_SET), 0);
+  TEST_COMPARE (fgetc (fp), 'b');
+  TEST_COMPARE (ungetc ('x', fp), 'x');
+  TEST_COMPARE (fgetc (fp), 'x');
+  TEST_COMPARE (fgetc (fp), 'c');
+
+  /* fflush moves the file descriptor to the position of the stream.  */
+  TEST_COMPARE (fflush (fp), 0);
+  TEST_COMPARE (xlseek (fileno (fp), 0, SEEK_CUR), 2 * WINDOW + 2);
+  TEST_COMPARE (fgetc (fp), 'd');
+  TEST_COMPARE (ftello64 (fp), 2 * WINDOW + 3);
+
+  /* Data appended to the file is read after the end of file.  */
+  TEST_COMPARE (fseeko64 (fp, 0, SEEK_END), 0);
+  TEST_COMPARE (fgetc (fp), EOF);
+  xpwrite ("more\n", 5, SIZE);
+  clearerr (fp);
+  TEST_VERIFY (fgets (buf, bufsize, fp) != NULL);
+  TEST_COMPARE_STRING (buf, "more\n");
+  xpwrite ("grown\n", 6, SIZE + WINDOW);
+  clearerr (fp);
+  TEST_COMPARE (fseeko64 (fp, SIZE + WINDOW, SEEK_SET), 0);
+  TEST_VERIFY (fgets (buf, bufsize, fp) != NULL);
+  TEST_COMPARE_STRING (buf, "grown\n");
+
+  /* If the file shrinks, the stream reaches the end of file.  */
+  TEST_COMPARE (fseeko64 (fp, SIZE, SEEK_SET), 0);
+  xftruncate (fd, SIZE);
+  TEST_COMPARE (fgetc (fp), EOF);
+  TEST_VERIFY (feof (fp));
+  xfclose (fp);
+
+  /* Seeking a wide stream outside of the mapping.  */
+  fp = xfopen (path, "rm");
+  TEST_COMPARE (fwide (fp, 1), 1);
+  wchar_t wbuf[64];
+  TEST_VERIFY (fgetws (wbuf, 64, fp) != NULL);
+  TEST_COMPARE_BLOB (wbuf, wcslen (wbuf) * sizeof (wchar_t),
+		     L"line0\n", 6 * sizeof (wchar_t));
+  TEST_COMPARE (fseeko64 (fp, 2 * WINDOW - 1, SEEK_SET), 0);
+  TEST_COMPARE (fgetwc (fp), L'a');
+  TEST_COMPARE (fseeko64 (fp, 1, SEEK_CUR), 0);
+  TEST_COMPARE (fgetwc (fp), L'c');
+  TEST_COMPARE (ftello64 (fp), 2 * WINDOW + 2);
+  TEST_COMPARE (fseeko64 (fp, WINDOW - 10, SEEK_SET), 0);
+  TEST_COMPARE (fgetwc (fp), L'a');
+  TEST_COMPARE (fseeko64 (fp, 24, SEEK_CUR), 0);
+  TEST_COMPARE (fgetwc (fp), L'z');
+  TEST_COMPARE (ftello64 (fp), WINDOW - 10 + 26);
+  TEST_COMPARE (fseeko64 (fp, -(off64_t) strlen (last), SEEK_END), 0);
+  TEST_VERIFY (fgetws (wbuf, 64, fp) != NULL);
+  TEST_COMPARE_BLOB (wbuf, wcslen (wbuf) * sizeof (wchar_t),
+		     L"last\n", 5 * sizeof (wchar_t));
+  TEST_COMPARE (fgetwc (fp), WEOF);
+  TEST_COMPARE (fseeko64 (fp, 0, SEEK_SET), 0);
+  TEST_COMPARE (fgetwc (fp), L'l');
+  xfclose (fp);
+
+  free (buf);
+  xclose (fd);
+  free (path);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,271 @@
+/* Test per-thread buffering of output streams.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdio_ext.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <support/check.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xthread.h>
+#include <support/xunistd.h>
+
+enum { nthreads = 8, nlines = 3000, maxlen = 199 };
+
+static FILE *out;
+
+/* The number of lines written by all threads.  */
+static unsigned int written;
+
+static off_t
+file_size (const char *path)
+{
+  struct stat64 st;
+  xstat (path, &st);
+  return st.st_size;
+}
+
+/* Write lines of different lengths through all the output functions.
+   Each line starts with the thread and line number.  */
+static void *
+writer (void *closure)
+{
+  int id = (uintptr_t) closure;
+  char payload[maxlen + 1];
+
+  for (int i = 0; i < nlines; ++i)
+    {
+      int len = (i * 37 + id) % maxlen;
+      memset (payload, 'a' + id, len);
+      payload[len] = '\0';
+      switch (i % 4)
+	{
+	case 0:
+	  fprintf (out, "%d %d %s\n", id, i, payload);
+	  break;
+	case 1:
+	  fprintf (out, "%d %d ", id, i);
+	  fputs (payload, out);
+	  fputc ('\n', out);
+	  break;
+	case 2:
+	  fprintf (out, "%d %d ", id, i);
+	  fwrite (payload, 1, len, out);
+	  putc ('\n', out);
+	  break;
+	case 3:
+	  fprintf (out, "%d %d %s", id, i, payload);
+	  /* An explicit flush writes the line of this thread only.  */
+	  fputc ('\n', out);
+	  fflush (out);
+	  break;
+	}
+    }
+  return NULL;
+}
+
+/* Write each line with a single call, while other threads write out
+   the buffers or exit.  */
+static void *
+racer (void *closure)
+{
+  int id = (uintptr_t) closure;
+  char payload[maxlen + 1];
+
+  for (int i = 0; i < nlines; ++i)
+    {
+      int len = (i * 37 + id) % maxlen;
+      memset (payload, 'a' + id, len);
+      payload[len] = '\0';
+      fprintf (out, "%d %d %s\n", id, i, payload);
+      __atomic_fetch_add (&written, 1, __ATOMIC_RELAXED);
+    }
+  return NULL;
+}
+
+/* Check that the lines written by the threads are intact.  If ORDERED,
+   the lines of each thread are in the order it wrote them.  If
+   COMPLETE, all lines are there.  */
+static void
+check_lines (const char *path, bool ordered, bool complete)
+{
+  FILE *fp = xfopen (path, "r");
+  static bool seen[nthreads][nlines];
+  int next[nthreads] = { 0 };
+  int count[nthreads] = { 0 };
+  char *line = NULL;
+  size_t size = 0;
+  ssize_t n;
+
+  memset (seen, 0, sizeof (seen));
+  while ((n = getline (&line, &size, fp)) > 0)
+    {
+      int id, i, off;
+      if (sscanf (line, "%d %d%n", &id, &i, &off) != 2
+	  || line[off++] != ' ' || id < 0 || id >= nthreads
+	  || i < next[id] || i >= nlines || seen[id][i]
+	  || (ordered && complete && i != next[id]))
+	{
+	  support_record_failure ();
+	  printf ("error: unexpected line: %s", line);
+	  break;
+	}
+      int len = (i * 37 + id) % maxlen;
+      if (n != off + len + 1 || strspn (line + off, "abcdefgh") != len)
+	{
+	  support_record_failure ();
+	  printf ("error: garbled line: %s", line);
+	  break;
+	}
+      seen[id][i] = true;
+      ++count[id];
+      if (ordered)
+	next[id] = i + 1;
+    }
+  if (complete)
+    for (int id = 0; id < nthreads; ++id)
+      TEST_COMPARE (count[id], nlines);
+  free (line);
+  xfclose (fp);
+}
+
+static int
+do_test (void)
+{
+  char *path;
+  int fd = create_temp_file ("tst-threadbuf-", &path);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xclose (fd);
+
+  /* Streams which can be read from or are unbuffered are rejected.  */
+  FILE *fp = xfopen (path, "r+");
+  errno = 0;
+  TEST_COMPARE (__fsetthreadbuf (fp, FSETTHREADBUF_PERTHREAD), -1);
+  TEST_COMPARE (errno, EINVAL);
+  xfclose (fp);
+  fp = xfopen (path, "w");
+  setvbuf (fp, NULL, _IONBF, 0);
+  TEST_COMPARE (__fsetthreadbuf (fp, FSETTHREADBUF_PERTHREAD), -1);
+  xfclose (fp);
+
+  /* Lines from several threads are not mixed up.  */
+  out = xfopen (path, "w");
+  TEST_COMPARE (__fsetthreadbuf (out, FSETTHREADBUF_QUERY),
+		FSETTHREADBUF_SHARED);
+  TEST_COMPARE (__fsetthreadbuf (out, FSETTHREADBUF_PERTHREAD),
+		FSETTHREADBUF_SHARED);
+  TEST_COMPARE (__fsetthreadbuf (out, FSETTHREADBUF_QUERY),
+		FSETTHREADBUF_PERTHREAD);
+  pthread_t threads[nthreads];
+  for (int i = 0; i < nthreads; ++i)
+    threads[i] = xpthread_create (NULL, writer, (void *) (uintptr_t) i);
+  for (int i = 0; i < nthreads; ++i)
+    xpthread_join (threads[i]);
+  /* The buffers of the threads have been written when they exited.  */
+  off_t size = file_size (path);
+
+  /* The buffer of the main thread is written by fflush.  */
+  fputs ("main\n", out);
+  TEST_COMPARE (file_size (path), size);
+  TEST_COMPARE (fflush (out), 0);
+  TEST_COMPARE (file_size (path), size + 5);
+
+  /* Switching back to the shared buffer writes pending output.  */
+  fputs ("main\n", out);
+  TEST_COMPARE (__fsetthreadbuf (out, FSETTHREADBUF_SHARED),
+		FSETTHREADBUF_PERTHREAD);
+  TEST_COMPARE (file_size (path), size + 10);
+  fputs ("main\n", out);
+  TEST_COMPARE (file_size (path), size + 10);
+
+  /* And fclose writes pending output of the buffers of all threads.  */
+  TEST_COMPARE (__fsetthreadbuf (out, FSETTHREADBUF_PERTHREAD),
+		FSETTHREADBUF_SHARED);
+  TEST_COMPARE (file_size (path), size + 15);
+  fputs ("main\n", out);
+  xfclose (out);
+  TEST_COMPARE (file_size (path), size + 20);
+
+  /* Remove the lines of the main thread before checking the others.  */
+  TEST_COMPARE (truncate64 (path, size), 0);
+  check_lines (path, true, true);
+
+  /* Switching the stream back and forth waits for the threads which
+     are writing to their buffers, and does not lose their lines.  The
+     stream is line buffered so that neither buffer writes part of a
+     line while the other one is used.  */
+  out = xfopen (path, "w");
+  setvbuf (out, NULL, _IOLBF, 0);
+  written = 0;
+  for (int i = 0; i < nthreads; ++i)
+    threads[i] = xpthread_create (NULL, racer, (void *) (uintptr_t) i);
+  while (__atomic_load_n (&written, __ATOMIC_RELAXED) < nthreads * nlines)
+    {
+      __fsetthreadbuf (out, FSETTHREADBUF_PERTHREAD);
+      TEST_COMPARE (fflush (NULL), 0);
+      __fsetthreadbuf (out, FSETTHREADBUF_SHARED);
+    }
+  for (int i = 0; i < nthreads; ++i)
+    xpthread_join (threads[i]);
+  xfclose (out);
+  check_lines (path, false, true);
+
+  /* exit writes out the buffers of the threads which are still running,
+     except for those which are being written to.  */
+  pid_t pid = xfork ();
+  if (pid == 0)
+    {
+      out = xfopen (path, "w");
+      TEST_COMPARE (__fsetthreadbuf (out, FSETTHREADBUF_PERTHREAD),
+		    FSETTHREADBUF_SHARED);
+      written = 0;
+      for (int i = 0; i < nthreads; ++i)
+	xpthread_create (NULL, racer, (void *) (uintptr_t) i);
+      while (__atomic_load_n (&written, __ATOMIC_RELAXED) < nthreads * 100)
+	;
+      exit (0);
+    }
+  int status;
+  xwaitpid (pid, &status, 0);
+  TEST_COMPARE (status, 0);
+  check_lines (path, true, false);
+
+  /* A line-buffered stream writes each line of a thread at once.  */
+  out = xfopen (path, "w");
+  setvbuf (out, NULL, _IOLBF, 0);
+  TEST_COMPARE (__fsetthreadbuf (out, FSETTHREADBUF_PERTHREAD),
+		FSETTHREADBUF_SHARED);
+  fputs ("ab", out);
+  TEST_COMPARE (file_size (path), 0);
+  fputs ("c\nde", out);
+  TEST_COMPARE (file_size (path), 4);
+  putc ('\n', out);
+  TEST_COMPARE (file_size (path), 7);
+  xfclose (out);
+
+  free (path);
+  return 0;
+}
+
+#include <support/test-driver.c>
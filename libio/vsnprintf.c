@@ -25,6 +25,7 @@
    in files containing the exception.  */
 
 #include "libioP.h"
+#include <printf.h>
 #include "strfile.h"
 
 static int _IO_strn_overflow (FILE *fp, int c) __THROW;
@@ -89,35 +90,72 @@ const struct _IO_jump_t _IO_strn_jumps libio_vtable attribute_hidden =
 };
 
 
-int
-__vsnprintf_internal (char *string, size_t maxlen, const char *format,
-		      va_list args, unsigned int mode_flags)
+/* Set up SF to write at most MAXLEN - 1 characters to STRING and
+   return the stream.  */
+static FILE *
+strnfile_init (_IO_strnfile *sf, char *string, size_t maxlen)
 {
-  _IO_strnfile sf;
-  int ret;
 #ifdef _IO_MTSAFE_IO
-  sf.f._sbf._f._lock = NULL;
+  sf->f._sbf._f._lock = NULL;
 #endif
 
   /* We need to handle the special case where MAXLEN is 0.  Use the
      overflow buffer right from the start.  */
   if (maxlen == 0)
     {
-      string = sf.overflow_buf;
-      maxlen = sizeof (sf.overflow_buf);
+      string = sf->overflow_buf;
+      maxlen = sizeof (sf->overflow_buf);
     }
 
-  _IO_no_init (&sf.f._sbf._f, _IO_USER_LOCK, -1, NULL, NULL);
-  _IO_JUMPS (&sf.f._sbf) = &_IO_strn_jumps;
+  _IO_no_init (&sf->f._sbf._f, _IO_USER_LOCK, -1, NULL, NULL);
+  _IO_JUMPS (&sf->f._sbf) = &_IO_strn_jumps;
   string[0] = '\0';
-  _IO_str_init_static_internal (&sf.f, string, maxlen - 1, string);
-  ret = __vfprintf_internal (&sf.f._sbf._f, format, args, mode_flags);
+  _IO_str_init_static_internal (&sf->f, string, maxlen - 1, string);
+  return &sf->f._sbf._f;
+}
+
+/* Terminate the string written to SF.  */
+static void
+strnfile_finish (_IO_strnfile *sf)
+{
+  if (sf->f._sbf._f._IO_buf_base != sf->overflow_buf)
+    *sf->f._sbf._f._IO_write_ptr = '\0';
+}
+
+int
+__vsnprintf_internal (char *string, size_t maxlen, const char *format,
+		      va_list args, unsigned int mode_flags)
+{
+  _IO_strnfile sf;
+  int ret;
+
+  ret = __vfprintf_internal (strnfile_init (&sf, string, maxlen), format,
+			     args, mode_flags);
+  strnfile_finish (&sf);
+  return ret;
+}
+
+int
+__vsnprintf_compiled_internal (char *string, size_t maxlen,
+			       const struct printf_compiled *cf, va_list args,
+			       unsigned int mode_flags)
+{
+  _IO_strnfile sf;
+  int ret;
 
-  if (sf.f._sbf._f._IO_buf_base != sf.overflow_buf)
-    *sf.f._sbf._f._IO_write_ptr = '\0';
+  ret = __vfprintf_compiled_internal (strnfile_init (&sf, string, maxlen),
+				      cf, args, mode_flags);
+  strnfile_finish (&sf);
   return ret;
 }
 
+int
+vsnprintf_compiled (char *string, size_t maxlen,
+		    const struct printf_compiled *cf, va_list args)
+{
+  return __vsnprintf_compiled_internal (string, maxlen, cf, args, 0);
+}
+
 int
 ___vsnprintf (char *string, size_t maxlen, const char *format, va_list args)
 {
@@ -951,6 +951,38 @@ resync:
 }
 libc_hidden_def (_IO_wfile_seekoff)
 
+/* _IO_wfile_seekoff reads into the byte buffer when seeking outside of
+   it, which is not possible if the buffer is part of a mapping of the
+   file.  Instead position the mapping like for a byte stream, and
+   convert the characters again from there.  */
+static off64_t
+_IO_wfile_seekoff_mmap (FILE *fp, off64_t offset, int dir, int mode)
+{
+  if (mode == 0)
+    return do_ftell_wide (fp);
+
+  if (dir == _IO_seek_cur)
+    {
+      /* The bytes converted ahead of the position do not count.  */
+      off64_t pos = do_ftell_wide (fp);
+      if (pos < 0)
+	return EOF;
+      offset += pos;
+      dir = _IO_seek_set;
+    }
+
+  _IO_free_wbackup_area (fp);
+  off64_t result = _IO_file_seekoff_mmap (fp, offset, dir, mode);
+  if (result != EOF)
+    {
+      _IO_wsetg (fp, fp->_wide_data->_IO_buf_base,
+		 fp->_wide_data->_IO_buf_base, fp->_wide_data->_IO_buf_base);
+      _IO_wsetp (fp, fp->_wide_data->_IO_buf_base,
+		 fp->_wide_data->_IO_buf_base);
+    }
+  return result;
+}
+
 
 size_t
 _IO_wfile_xsputn (FILE *f, const void *data, size_t n)
@@ -1055,7 +1087,7 @@ const struct _IO_jump_t _IO_wfile_jumps_mmap libio_vtable =
   JUMP_INIT(pbackfail, (_IO_pbackfail_t) _IO_wdefault_pbackfail),
   JUMP_INIT(xsputn, _IO_wfile_xsputn),
   JUMP_INIT(xsgetn, _IO_file_xsgetn),
-  JUMP_INIT(seekoff, _IO_wfile_seekoff),
+  JUMP_INIT(seekoff, _IO_wfile_seekoff_mmap),
   JUMP_INIT(seekpos, _IO_default_seekpos),
   JUMP_INIT(setbuf, _IO_file_setbuf_mmap),
   JUMP_INIT(sync, (_IO_sync_t) _IO_wfile_sync),
@@ -543,6 +543,7 @@ static const struct lc_ctype_data lc_ctype_data =
   {
     .fcts = &__wcsmbs_gconv_fcts_c,
     .outdigit_bytes_all_equal = 1,
+    .tolower_ascii_is_c = true,
   };
 
 const struct __locale_data _nl_C_LC_CTYPE attribute_hidden =
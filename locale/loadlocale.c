@@ -90,6 +90,51 @@ _nl_intern_locale_data_fill_cache_ctype (struct __locale_data *locdata)
       else if (data->outdigit_bytes_all_equal != len)
 	data->outdigit_bytes_all_equal = 0;
     }
+
+  const int32_t *tolower = (const int32_t *)
+    locdata->values[_NL_ITEM_INDEX (_NL_CTYPE_TOLOWER)].string + 128;
+  data->tolower_ascii_is_c = true;
+  for (int c = 0; c < 128; ++c)
+    if (tolower[c] != (c >= 'A' && c <= 'Z' ? c + 'a' - 'A' : c))
+      {
+	data->tolower_ascii_is_c = false;
+	break;
+      }
+}
+
+/* Fill in LOCDATA->private for the LC_COLLATE category.  */
+static void
+_nl_intern_locale_data_fill_cache_collate (struct __locale_data *locdata)
+{
+  struct lc_collate_data *data = locdata->private;
+  uint32_t nrules
+    = locdata->values[_NL_ITEM_INDEX (_NL_COLLATE_NRULES)].word;
+
+  /* Assumes zero initialization of *data.  */
+  if (nrules == 0 || nrules > 32)
+    return;
+
+  const int32_t *table = (const int32_t *)
+    locdata->values[_NL_ITEM_INDEX (_NL_COLLATE_TABLEMB)].string;
+  const unsigned char *extra = (const unsigned char *)
+    locdata->values[_NL_ITEM_INDEX (_NL_COLLATE_EXTRAMB)].string;
+  for (int c = 1; c < 256; ++c)
+    if (table[c] < 0)
+      /* The length of the first sequence follows its index.  */
+      data->lookahead[c] = extra[-table[c] + sizeof (int32_t)];
+
+  /* The ruleset table is directly followed by the multibyte table and
+     padded with zero bytes, which have no flags set.  */
+  const unsigned char *rulesets = (const unsigned char *)
+    locdata->values[_NL_ITEM_INDEX (_NL_COLLATE_RULESETS)].string;
+  const unsigned char *end = (const unsigned char *) table;
+  if (end < rulesets || end - rulesets > 128 * nrules + LOCFILE_ALIGN)
+    return;
+  uint32_t backward = 0;
+  for (size_t i = 0; i < end - rulesets; ++i)
+    if (rulesets[i] & sort_backward)
+      backward |= (uint32_t) 1 << (i % nrules);
+  data->prefix_skip_levels = ~backward;
 }
 
 /* Updates data in LOCDATA->private for CATEGORY.  */
@@ -101,6 +146,9 @@ _nl_intern_locale_data_fill_cache (int category, struct __locale_data *locdata)
     case LC_CTYPE:
       _nl_intern_locale_data_fill_cache_ctype (locdata);
       break;
+    case LC_COLLATE:
+      _nl_intern_locale_data_fill_cache_collate (locdata);
+      break;
     }
 }
 
@@ -113,6 +161,8 @@ _nl_intern_locale_data_extra_size (int category)
     {
     case LC_CTYPE:
       return sizeof (struct lc_ctype_data);
+    case LC_COLLATE:
+      return sizeof (struct lc_collate_data);
     default:
       return 0;
     }
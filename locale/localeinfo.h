@@ -62,6 +62,7 @@ struct __locale_data
      computed about this locale.  Type of the data pointed to:
 
      LC_CTYPE   struct lc_ctype_data (_nl_intern_locale_data)
+     LC_COLLATE struct lc_collate_data (_nl_intern_locale_data)
      LC_TIME    struct lc_time_data (_nl_init_alt_digit, _nl_init_era_entries)
 
      This data deallocated at the start of _nl_unload_locale.  */
@@ -181,6 +182,27 @@ struct lc_ctype_data
   /* If all outdigit_bytes elements are equal, this is that value,
      otherwise it is 0.  */
   unsigned char outdigit_bytes_all_equal;
+
+  /* True if tolower maps the bytes 0 to 127 as in the C locale.  The
+     vector strcasecmp implementations then only need the tolower table
+     for bytes 128 to 255, even if _NL_CTYPE_NONASCII_CASE is set.  */
+  bool tolower_ascii_is_c;
+};
+
+/* Ancillary data for LC_COLLATE.  Co-allocated after struct
+   __locale_data by _nl_intern_locale_data.  */
+struct lc_collate_data
+{
+  /* For each byte C, the maximum number of bytes after C at which
+     findidx looks in the multibyte table to find the collating element
+     starting with C.  It is 0 if C is a collating element on its own.
+     The lists of longer sequences start with the longest one.  */
+  unsigned char lookahead[256];
+
+  /* Bit P is set if no ruleset sorts backward at level P.  Equal
+     leading collating elements of two strings can then be skipped by
+     strcoll at that level.  */
+  uint32_t prefix_skip_levels;
 };
 
 /* LC_CTYPE specific:
@@ -21,6 +21,7 @@
 #include <malloc-internal.h>
 #include <resolv/resolv-internal.h>
 #include <rpc/rpc.h>
+#include <stdio.h>
 #include <string.h>
 #include <tls-internal.h>
 #include <shlib-compat.h>
@@ -38,6 +39,7 @@ __libc_thread_freeres (void)
   call_function_static_weak (__res_thread_freeres);
   call_function_static_weak (__glibc_tls_internal_free);
   call_function_static_weak (__libc_dlerror_result_free);
+  call_function_static_weak (__libio_threadbuf_freeres);
 
   /* This should come last because it shuts down malloc for this
      thread and the other shutdown functions might well call free.  */
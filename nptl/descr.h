@@ -402,6 +402,12 @@ struct pthread
   /* Used on strsignal.  */
   struct tls_internal_t tls_state;
 
+  /* Nonzero while dl_iterate_phdr reports the objects in a snapshot
+     without holding _dl_load_write_lock: the value of
+     GL(dl_phdr_generation) at the start, possibly with
+     DL_PHDR_READER_WAITING.  */
+  unsigned int dl_phdr_reader;
+
   /* rseq area registered with the kernel.  */
   struct rseq rseq_area;
 
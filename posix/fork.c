@@ -63,6 +63,8 @@ __libc_fork (void)
 				 &nss_database_data);
 
       _IO_list_lock ();
+      call_function_static_weak (__libio_async_fork_lock);
+      __libio_threadbuf_fork_lock ();
 
       /* Acquire malloc locks.  This needs to come last because fork
 	 handlers may use malloc, and the libio list lock has an
@@ -89,8 +91,10 @@ __libc_fork (void)
 
 	  /* Reset the file list.  These are recursive mutexes.  */
 	  fresetlockfiles ();
+	  __libio_threadbuf_fork_unlock_child ();
 
 	  /* Reset locks in the I/O code.  */
+	  call_function_static_weak (__libio_async_fork_unlock_child);
 	  _IO_list_resetlock ();
 
 	  call_function_static_weak (__nss_database_fork_subprocess,
@@ -120,6 +124,8 @@ __libc_fork (void)
 	  call_function_static_weak (__malloc_fork_unlock_parent);
 
 	  /* We execute this even if the 'fork' call failed.  */
+	  __libio_threadbuf_fork_unlock_parent ();
+	  call_function_static_weak (__libio_async_fork_unlock_parent);
 	  _IO_list_unlock ();
 	}
 
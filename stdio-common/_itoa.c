@@ -19,6 +19,7 @@
 #include <gmp-mparam.h>
 #include <gmp.h>
 #include <limits.h>
+#include <string.h>
 #include <stdlib/gmp-impl.h>
 #include <stdlib/longlong.h>
 
@@ -157,6 +158,20 @@ const struct base_table_t _itoa_base_table[] attribute_hidden =
 };
 #endif
 
+/* The decimal numbers from 00 to 99, for converting two digits at a
+   time.  */
+static const char decimal_pairs[200] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
 char *
 _itoa_word (_ITOA_WORD_TYPE value, char *buflim,
 	    unsigned int base, int upper_case)
@@ -174,8 +189,38 @@ _itoa_word (_ITOA_WORD_TYPE value, char *buflim,
       while ((value /= Base) != 0);					      \
       break
 
-      SPECIAL (10);
-      SPECIAL (16);
+    case 10:
+      /* Halve the number of divisions by producing two digits per
+	 step.  */
+      while (value >= 100)
+	{
+	  unsigned int pair = value % 100;
+	  value /= 100;
+	  buflim -= 2;
+	  memcpy (buflim, &decimal_pairs[2 * pair], 2);
+	}
+      if (value >= 10)
+	{
+	  buflim -= 2;
+	  memcpy (buflim, &decimal_pairs[2 * value], 2);
+	}
+      else
+	*--buflim = '0' + value;
+      break;
+
+    case 16:
+      /* Two digits per byte.  */
+      while (value > 0xff)
+	{
+	  *--buflim = digits[value & 0xf];
+	  *--buflim = digits[(value >> 4) & 0xf];
+	  value >>= 8;
+	}
+      do
+	*--buflim = digits[value & 0xf];
+      while ((value >>= 4) != 0);
+      break;
+
       SPECIAL (8);
     default:
       do
@@ -21,3 +21,7 @@
 #endif
 
 __LDBL_REDIR_DECL (printf_size)
+__LDBL_REDIR_DECL (vfprintf_compiled)
+__LDBL_REDIR_DECL (fprintf_compiled)
+__LDBL_REDIR_DECL (vsnprintf_compiled)
+__LDBL_REDIR_DECL (snprintf_compiled)
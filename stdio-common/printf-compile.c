@@ -0,0 +1,133 @@
+/* Parse a printf format string once for repeated use.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <printf.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+
+#define CHAR_T		char
+#define UCHAR_T		unsigned char
+#define L_(Str)		Str
+
+#define DONT_NEED_READ_INT
+#include "printf-parse.h"
+
+
+struct printf_compiled *
+printf_compile (const char *format)
+{
+  const unsigned char *lead_end = __find_specmb ((const unsigned char *)
+						 format);
+  size_t format_size = strlen (format) + 1;
+  size_t nspecs = 0;
+  size_t nargs = 0;
+  size_t max_ref_arg = 0;
+  struct printf_spec spec;
+
+  /* Count the format specifiers and arguments first, so that
+     everything fits into a single allocation.  */
+  for (const unsigned char *f = lead_end; *f != '\0'; f = spec.next_fmt)
+    {
+      nargs += __parse_one_specmb (f, nargs, &spec, &max_ref_arg);
+      ++nspecs;
+    }
+  nargs = MAX (nargs, max_ref_arg);
+
+  /* The format specifiers come right after the header and the argument
+     types and sizes after them, which keeps all of them aligned.  */
+  size_t size;
+  if (__builtin_mul_overflow (nargs, 2 * sizeof (int), &size)
+      || __builtin_add_overflow (size, format_size, &size)
+      || __builtin_add_overflow (size, (sizeof (struct printf_compiled)
+					+ nspecs * sizeof (spec)), &size))
+    {
+      __set_errno (ENOMEM);
+      return NULL;
+    }
+
+  struct printf_compiled *cf = malloc (size);
+  if (cf == NULL)
+    return NULL;
+
+  struct printf_spec *specs = (struct printf_spec *) (cf + 1);
+  int *args_type = (int *) (specs + nspecs);
+  int *args_size = args_type + nargs;
+  char *copy = (char *) (args_size + nargs);
+  memset (args_type, '\0', 2 * nargs * sizeof (int));
+  memcpy (copy, format, format_size);
+
+  cf->format = copy;
+  cf->lead_len = (const char *) lead_end - format;
+  cf->specs = specs;
+  cf->nspecs = nspecs;
+  cf->args_type = args_type;
+  cf->args_size = args_size;
+  cf->nargs = nargs;
+  cf->group = 0;
+  cf->sequential = (max_ref_arg == 0 && __printf_function_table == NULL
+		    && __printf_modifier_table == NULL
+		    && __printf_va_arg_table == NULL);
+
+  /* Parse the copy, so that the specifiers point into it.  */
+  size_t cnt = 0;
+  size_t nargs_seen = 0;
+  max_ref_arg = 0;
+  for (const unsigned char *f = (const unsigned char *) copy + cf->lead_len;
+       *f != '\0'; f = specs[cnt++].next_fmt)
+    nargs_seen += __parse_one_specmb (f, nargs_seen, &specs[cnt],
+				      &max_ref_arg);
+
+  /* Fill in the types of all the arguments, as printf_positional
+     does.  */
+  for (cnt = 0; cnt < nspecs; ++cnt)
+    {
+      if (specs[cnt].width_arg != -1)
+	args_type[specs[cnt].width_arg] = PA_INT;
+
+      if (specs[cnt].prec_arg != -1)
+	args_type[specs[cnt].prec_arg] = PA_INT;
+
+      switch (specs[cnt].ndata_args)
+	{
+	case 0:
+	  break;
+	case 1:
+	  args_type[specs[cnt].data_arg] = specs[cnt].data_arg_type;
+	  args_size[specs[cnt].data_arg] = specs[cnt].size;
+	  break;
+	default:
+	  (void) (*__printf_arginfo_table[specs[cnt].info.spec])
+	    (&specs[cnt].info,
+	     specs[cnt].ndata_args, &args_type[specs[cnt].data_arg],
+	     &args_size[specs[cnt].data_arg]);
+	  break;
+	}
+
+      cf->group |= specs[cnt].info.group;
+    }
+
+  return cf;
+}
+
+void
+printf_compiled_free (struct printf_compiled *cf)
+{
+  free (cf);
+}
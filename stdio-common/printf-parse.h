@@ -44,6 +44,34 @@ struct printf_spec
     int size;
   };
 
+#ifndef COMPILE_WPRINTF
+/* A format string parsed by printf_compile.  The arrays and the copy of
+   the format string they point to are part of the same allocation.  */
+struct printf_compiled
+  {
+    /* The format string, and the length of the text before the first
+       format specifier.  */
+    const char *format;
+    size_t lead_len;
+
+    /* The parsed format specifiers.  */
+    const struct printf_spec *specs;
+    size_t nspecs;
+
+    /* Type and size of each argument, as for printf_positional.  */
+    const int *args_type;
+    const int *args_size;
+    size_t nargs;
+
+    /* Nonzero if a specifier uses the thousands grouping flag.  */
+    int group;
+
+    /* Nonzero if the arguments are used in order and no registered
+       handler was involved, so that they can be read one by one.  */
+    int sequential;
+  };
+#endif
+
 #ifndef DONT_NEED_READ_INT
 /* Read a simple integer from a string and update the string pointer.
    It is assumed that the first character is a digit.  */
@@ -182,6 +182,39 @@ extern int printf_size_info (const struct printf_info *__restrict
 			     __info, size_t __n, int *__restrict __argtypes)
      __THROW;
 
+/* Parsed format strings.  */
+
+struct printf_compiled;
+
+/* Parse the format string FORMAT once, so that it can be used with the
+   functions below without parsing it on every call.  The result keeps
+   a copy of FORMAT.  It describes the printf handlers registered at the
+   time of the call.  Return NULL and set errno if there is not enough
+   memory.  */
+extern struct printf_compiled *printf_compile (const char *__format)
+     __THROW __wur __nonnull ((1));
+
+/* Free the parsed format string CF.  */
+extern void printf_compiled_free (struct printf_compiled *__cf) __THROW;
+
+/* Like vfprintf and fprintf, but with a format string parsed by
+   `printf_compile'.  */
+extern int vfprintf_compiled (FILE *__restrict __stream,
+			      const struct printf_compiled *__restrict __cf,
+			      __gnuc_va_list __arg);
+extern int fprintf_compiled (FILE *__restrict __stream,
+			     const struct printf_compiled *__restrict __cf,
+			     ...);
+
+/* Like vsnprintf and snprintf, but with a format string parsed by
+   `printf_compile'.  */
+extern int vsnprintf_compiled (char *__restrict __s, size_t __maxlen,
+			       const struct printf_compiled *__restrict __cf,
+			       __gnuc_va_list __arg) __THROW;
+extern int snprintf_compiled (char *__restrict __s, size_t __maxlen,
+			      const struct printf_compiled *__restrict __cf,
+			      ...) __THROW;
+
 #include <bits/floatn.h>
 #if defined __LDBL_COMPAT || __LDOUBLE_REDIRECTS_TO_FLOAT128_ABI == 1
 # include <bits/printf-ldbl.h>
@@ -31,6 +31,7 @@
 #include <stdlib/gmp-impl.h>
 #include <stdlib/longlong.h>
 #include <stdlib/fpioconst.h>
+#include <stdlib/grisu.h>
 #include <locale/localeinfo.h>
 #include <limits.h>
 #include <math.h>
@@ -163,6 +164,10 @@ struct hack_digit_param
   MPN_VAR(scale);
   /* Temporary bignum value.  */
   MPN_VAR(tmp);
+  /* If not NULL, the significant digits are already known and are taken
+     from here instead of being computed from FRAC and SCALE.  */
+  const char *digits;
+  const char *digits_end;
 };
 
 static wchar_t
@@ -172,6 +177,8 @@ hack_digit (struct hack_digit_param *p)
 
   if (p->expsign != 0 && p->type == 'f' && p->exponent-- > 0)
     hi = 0;
+  else if (p->digits != NULL)
+    return p->digits < p->digits_end ? (wchar_t) *p->digits++ : L'0';
   else if (p->scalesize == 0)
     {
       hi = p->frac[p->fracsize - 1];
@@ -209,10 +216,83 @@ hack_digit (struct hack_digit_param *p)
   return L'0' + hi;
 }
 
-int
-__printf_fp_l (FILE *fp, locale_t loc,
-	       const struct printf_info *info,
-	       const void *const *args)
+/* Return true if there are nonzero digits left to be generated.  */
+static inline bool
+more_digits (const struct hack_digit_param *p)
+{
+  if (p->digits != NULL)
+    return p->digits < p->digits_end;
+  return p->fracsize > 1 || p->frac[0] != 0;
+}
+
+/* Use the NDIGITS digits at DIGITS as the significant digits of the
+   number, the last of which has the decimal exponent EXP10.  */
+static void
+set_digits (struct hack_digit_param *p, const char *digits, int ndigits,
+	    int exp10)
+{
+  int exponent = exp10 + ndigits - 1;
+
+  /* Trailing zeros are implied.  */
+  while (ndigits > 0 && digits[ndigits - 1] == '0')
+    --ndigits;
+  p->digits = digits;
+  p->digits_end = digits + ndigits;
+  p->expsign = exponent < 0;
+  p->exponent = exponent < 0 ? -exponent : exponent;
+}
+
+/* Try to compute the significant digits of the double VALUE needed for
+   the conversion INFO with __grisu_fixed and store them in DIGITS.
+   Return the number of digits or zero if the multi-precision code has
+   to be used.  */
+static int
+fast_digits (double value, int exponent, const struct printf_info *info,
+	     char *digits, int *exp10)
+{
+  int prec = info->prec < 0 ? 6 : info->prec;
+  int ndigits;
+  int len;
+
+  switch (info->spec)
+    {
+    case 'e':
+    case 'E':
+      ndigits = prec + 1;
+      break;
+    case 'g':
+    case 'G':
+      ndigits = prec == 0 ? 1 : prec;
+      break;
+    case 'f':
+    case 'F':
+      /* The number of digits depends on the decimal exponent of the
+	 leading digit.  Start with an estimate based on the binary
+	 EXPONENT and correct it with the one __grisu_fixed found.  */
+      ndigits = prec + 1 + ((exponent * 78913) >> 18);
+      if (ndigits < 1 || ndigits > GRISU_FIXED_MAX_DIGITS)
+	return 0;
+      len = __grisu_fixed (value, ndigits, digits, exp10);
+      if (len == 0 || *exp10 == -prec)
+	return len;
+      ndigits += *exp10 + prec;
+      if (ndigits < 1 || ndigits > GRISU_FIXED_MAX_DIGITS)
+	return 0;
+      len = __grisu_fixed (value, ndigits, digits, exp10);
+      return *exp10 == -prec ? len : 0;
+    default:
+      return 0;
+    }
+
+  if (ndigits > GRISU_FIXED_MAX_DIGITS)
+    return 0;
+  return __grisu_fixed (value, ndigits, digits, exp10);
+}
+
+static int
+printf_fp (FILE *fp, locale_t loc, const struct printf_info *info,
+	   const void *const *args, const char *digits, int ndigits,
+	   int exp10)
 {
   /* The floating-point value to output.  */
   union
@@ -271,7 +351,12 @@ __printf_fp_l (FILE *fp, locale_t loc,
   /* Flag whether wbuffer and buffer are malloc'ed or not.  */
   int buffer_malloced = 0;
 
+  /* Digits computed without multi-precision arithmetic.  */
+  char fast_buf[GRISU_FIXED_MAX_DIGITS + 1];
+  bool is_double = false;
+
   p.expsign = 0;
+  p.digits = NULL;
 
   /* Figure out the decimal point character.  */
   if (info->extra == 0)
@@ -393,7 +478,10 @@ __printf_fp_l (FILE *fp, locale_t loc,
     PRINTF_FP_FETCH (long double, fpnum.ldbl, long_double, LDBL_MANT_DIG)
   else
 #endif
-    PRINTF_FP_FETCH (double, fpnum.dbl, double, DBL_MANT_DIG)
+    {
+      PRINTF_FP_FETCH (double, fpnum.dbl, double, DBL_MANT_DIG)
+      is_double = true;
+    }
 
 #undef PRINTF_FP_FETCH
 
@@ -423,6 +511,28 @@ __printf_fp_l (FILE *fp, locale_t loc,
       return done;
     }
 
+  if (digits != NULL)
+    {
+      /* The caller has chosen the digits.  */
+      set_digits (&p, digits, ndigits, exp10);
+      goto digits_known;
+    }
+
+  /* Most double conversions need no more than 17 significant digits.
+     These can usually be computed with 64-bit arithmetic; only if that
+     cannot decide the rounding, or in other rounding modes, are the
+     exact multi-precision computations below needed.  */
+  if (is_double && fpnum.dbl != 0.0
+      && get_rounding_mode () == FE_TONEAREST)
+    {
+      ndigits = fast_digits (fabs (fpnum.dbl), p.exponent, info, fast_buf,
+			     &exp10);
+      if (ndigits != 0)
+	{
+	  set_digits (&p, fast_buf, ndigits, exp10);
+	  goto digits_known;
+	}
+    }
 
   /* We need three multiprecision variables.  Now that we have the p.exponent
      of the number we can allocate the needed memory.  It would be more
@@ -827,6 +937,7 @@ __printf_fp_l (FILE *fp, locale_t loc,
       p.exponent = 0;
     }
 
+ digits_known:
   {
     int width = info->width;
     wchar_t *wstartp, *wcp;
@@ -944,7 +1055,7 @@ __printf_fp_l (FILE *fp, locale_t loc,
 	significant = 1;
 	if (info->alt
 	    || fracdig_min > 0
-	    || (fracdig_max > 0 && (p.fracsize > 1 || p.frac[0] != 0)))
+	    || (fracdig_max > 0 && more_digits (&p)))
 	  *wcp++ = decimalwc;
       }
     else
@@ -960,7 +1071,7 @@ __printf_fp_l (FILE *fp, locale_t loc,
     int fracdig_no = 0;
     int added_zeros = 0;
     while (fracdig_no < fracdig_min + added_zeros
-	   || (fracdig_no < fracdig_max && (p.fracsize > 1 || p.frac[0] != 0)))
+	   || (fracdig_no < fracdig_max && more_digits (&p)))
       {
 	++fracdig_no;
 	*wcp = hack_digit (&p);
@@ -980,10 +1091,10 @@ __printf_fp_l (FILE *fp, locale_t loc,
     bool more_bits;
     if (next_digit != L'0' && next_digit != L'5')
       more_bits = true;
-    else if (p.fracsize == 1 && p.frac[0] == 0)
+    else if (!more_digits (&p))
       /* Rest of the number is zero.  */
       more_bits = false;
-    else if (p.scalesize == 0)
+    else if (p.digits == NULL && p.scalesize == 0)
       {
 	/* Here we have to see whether all limbs are zero since no
 	   normalization happened.  */
@@ -1270,8 +1381,25 @@ __printf_fp_l (FILE *fp, locale_t loc,
   }
   return done;
 }
+
+int
+__printf_fp_l (FILE *fp, locale_t loc,
+	       const struct printf_info *info,
+	       const void *const *args)
+{
+  return printf_fp (fp, loc, info, args, NULL, 0, 0);
+}
 libc_hidden_def (__printf_fp_l)
 
+int
+__printf_fp_digits_l (FILE *fp, locale_t loc,
+		      const struct printf_info *info,
+		      const void *const *args, const char *digits,
+		      int ndigits, int exp10)
+{
+  return printf_fp (fp, loc, info, args, digits, ndigits, exp10);
+}
+
 int
 ___printf_fp (FILE *fp, const struct printf_info *info,
 	      const void *const *args)
@@ -38,6 +38,37 @@ enum
 #define FSETLOCKING_BYCALLER	FSETLOCKING_BYCALLER
 };
 
+#ifdef __USE_GNU
+enum
+{
+  /* Query whether the stream uses per-thread buffers.  */
+  FSETTHREADBUF_QUERY = 0,
+# define FSETTHREADBUF_QUERY	FSETTHREADBUF_QUERY
+  /* All threads write into the buffer of the stream.  */
+  FSETTHREADBUF_SHARED,
+# define FSETTHREADBUF_SHARED	FSETTHREADBUF_SHARED
+  /* Each thread writes into a buffer of its own, which is written to the
+     file descriptor in whole lines.  Writes take a lock of the buffer of
+     the thread instead of the lock of the stream.  */
+  FSETTHREADBUF_PERTHREAD
+# define FSETTHREADBUF_PERTHREAD	FSETTHREADBUF_PERTHREAD
+};
+
+enum
+{
+  /* Query whether the stream is written in the background.  */
+  FSETASYNC_QUERY = 0,
+# define FSETASYNC_QUERY	FSETASYNC_QUERY
+  /* Output is written by the thread which flushes the buffer.  */
+  FSETASYNC_DIRECT,
+# define FSETASYNC_DIRECT	FSETASYNC_DIRECT
+  /* Output is handed to a helper thread, which writes it to the file
+     descriptor.  Write errors are reported by fflush and fclose.  */
+  FSETASYNC_BACKGROUND
+# define FSETASYNC_BACKGROUND	FSETASYNC_BACKGROUND
+};
+#endif
+
 
 __BEGIN_DECLS
 
@@ -81,6 +112,16 @@ extern void _flushlbf (void);
 /* Set locking status of stream FP to TYPE.  */
 extern int __fsetlocking (FILE *__fp, int __type) __THROW;
 
+#ifdef __USE_GNU
+/* Set the buffering of the output stream FP to TYPE and return the
+   previous type, or -1 if FP cannot use per-thread buffers.  */
+extern int __fsetthreadbuf (FILE *__fp, int __type) __THROW;
+
+/* Set how the output of the stream FP is written to TYPE and return the
+   previous type, or -1 if FP cannot be written in the background.  */
+extern int __fsetasync (FILE *__fp, int __type) __THROW;
+#endif
+
 __END_DECLS
 
 #endif	/* stdio_ext.h */
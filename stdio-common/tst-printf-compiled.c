@@ -0,0 +1,186 @@
+/* Test printf_compile and the functions using its result.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <locale.h>
+#include <printf.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/xstdio.h>
+
+/* Compare the output of snprintf_compiled and fprintf_compiled for
+   FORMAT with that of snprintf, for buffers of several sizes.  */
+#define CHECK(format, ...)						\
+  do									\
+    {									\
+      char expected[256];						\
+      char buf[256];							\
+      errno = EINVAL;							\
+      int len = snprintf (expected, sizeof expected, format, __VA_ARGS__); \
+      struct printf_compiled *cf = printf_compile (format);		\
+      TEST_VERIFY_EXIT (cf != NULL);					\
+      static const size_t sizes[] = { sizeof buf, 5, 1, 0 };		\
+      for (size_t i = 0; i < sizeof (sizes) / sizeof (sizes[0]); ++i)	\
+	{								\
+	  memset (buf, 'x', sizeof buf);				\
+	  errno = EINVAL;						\
+	  TEST_COMPARE (snprintf_compiled (buf, sizes[i], cf, __VA_ARGS__), \
+			len);						\
+	  if (sizes[i] > 0)						\
+	    {								\
+	      char prefix[256];						\
+	      snprintf (prefix, sizes[i], "%s", expected);		\
+	      TEST_COMPARE_STRING (buf, prefix);			\
+	    }								\
+	  else								\
+	    TEST_COMPARE (buf[0], 'x');					\
+	}								\
+									\
+      char *ptr;							\
+      size_t size;							\
+      FILE *fp = open_memstream (&ptr, &size);				\
+      TEST_VERIFY_EXIT (fp != NULL);					\
+      errno = EINVAL;							\
+      TEST_COMPARE (fprintf_compiled (fp, cf, __VA_ARGS__), len);	\
+      xfclose (fp);							\
+      TEST_COMPARE_STRING (ptr, expected);				\
+      free (ptr);							\
+      printf_compiled_free (cf);					\
+    }									\
+  while (0)
+
+static int
+print_pair (FILE *fp, const struct printf_info *info,
+	    const void *const *args)
+{
+  return fprintf (fp, "<%d,%d>", *(const int *) args[0],
+		  *(const int *) args[1]);
+}
+
+static int
+print_pair_arginfo (const struct printf_info *info, size_t n, int *argtypes,
+		    int *size)
+{
+  if (n > 0)
+    argtypes[0] = PA_INT;
+  if (n > 1)
+    argtypes[1] = PA_INT;
+  return 2;
+}
+
+static void
+check_formats (void)
+{
+  CHECK ("%d", 42);
+  CHECK ("lead %d trail", -42);
+  CHECK ("%s and %s", "one", "two");
+  CHECK ("%5d|%-5d|%05d|%+d|% d", 1, 2, 3, 4, 5);
+  CHECK ("%x %X %#o %#x %p", 255u, 255u, 8u, 16u, (void *) 0x1234);
+  CHECK ("%ld %lld %hd %hhd %zu %jd", -1L, -2LL, (short) 3, (char) 4,
+	 (size_t) 5, (intmax_t) -6);
+  CHECK ("%c%c%c", 'a', 'b', 'c');
+  CHECK ("%f %e %g %a", 1.5, 2.5, 3.5, 4.5);
+  CHECK ("%.3f %10.2e %-8g|", 3.14159, 2.71828, 1e-5);
+  CHECK ("%Lf %Lg", 1.25L, 1e100L);
+  CHECK ("%*d|%-*d|%.*f", 6, 1, 6, 2, 3, 1.0);
+  CHECK ("%2$s %1$s", "world", "hello");
+  CHECK ("%3$*1$.*2$f", 10, 2, 3.14159);
+  CHECK ("%1$d %1$x %1$o", 100);
+  CHECK ("%%d %s %%", "percent");
+  CHECK ("%ls", L"wide");
+  CHECK ("%.2s|%10.3s|", "abcdef", "ghijkl");
+  CHECK ("%m %d", 1);
+  CHECK ("%'d %'.2f", 1234567, 1234567.891);
+  CHECK ("%s", "a long string which is longer than some of the buffers");
+}
+
+static int
+do_test (void)
+{
+  check_formats ();
+
+  /* The grouping information is looked up when printing, not when
+     compiling.  */
+  TEST_VERIFY_EXIT (setlocale (LC_ALL, "de_DE.UTF-8") != NULL);
+  check_formats ();
+  TEST_VERIFY_EXIT (setlocale (LC_ALL, "C") != NULL);
+
+  /* A format without specifiers.  */
+  {
+    struct printf_compiled *cf = printf_compile ("no specifiers");
+    TEST_VERIFY_EXIT (cf != NULL);
+    char buf[16];
+    TEST_COMPARE (snprintf_compiled (buf, sizeof buf, cf), 13);
+    TEST_COMPARE_STRING (buf, "no specifiers");
+    TEST_COMPARE (snprintf_compiled (buf, 3, cf), 13);
+    TEST_COMPARE_STRING (buf, "no");
+    printf_compiled_free (cf);
+  }
+
+  /* %n stores the number of characters written so far.  */
+  {
+    struct printf_compiled *cf = printf_compile ("abc%n%s%n");
+    TEST_VERIFY_EXIT (cf != NULL);
+    char buf[16];
+    int n1 = -1;
+    int n2 = -1;
+    TEST_COMPARE (snprintf_compiled (buf, sizeof buf, cf, &n1, "de", &n2), 5);
+    TEST_COMPARE_STRING (buf, "abcde");
+    TEST_COMPARE (n1, 3);
+    TEST_COMPARE (n2, 5);
+    printf_compiled_free (cf);
+  }
+
+  /* Unbuffered streams.  */
+  {
+    struct printf_compiled *cf = printf_compile ("[%d:%s]");
+    TEST_VERIFY_EXIT (cf != NULL);
+    FILE *fp = tmpfile ();
+    TEST_VERIFY_EXIT (fp != NULL);
+    TEST_COMPARE (setvbuf (fp, NULL, _IONBF, 0), 0);
+    TEST_COMPARE (fprintf_compiled (fp, cf, 7, "seven"), 9);
+    rewind (fp);
+    char buf[16] = { 0 };
+    TEST_COMPARE (fread (buf, 1, sizeof buf, fp), 9);
+    TEST_COMPARE_STRING (buf, "[7:seven]");
+    xfclose (fp);
+    printf_compiled_free (cf);
+  }
+
+  /* A registered handler with two arguments.  It has to be registered
+     before the format is compiled, but formats compiled earlier which
+     do not use it keep working.  */
+  struct printf_compiled *early = printf_compile ("%d|%s");
+  TEST_VERIFY_EXIT (early != NULL);
+  TEST_COMPARE (register_printf_specifier ('P', print_pair,
+					   print_pair_arginfo), 0);
+  {
+    char buf[16];
+    TEST_COMPARE (snprintf_compiled (buf, sizeof buf, early, 5, "five"), 6);
+    TEST_COMPARE_STRING (buf, "5|five");
+    printf_compiled_free (early);
+  }
+  CHECK ("%d %P %s", 1, 2, 3, "four");
+
+  return 0;
+}
+
+#include <support/test-driver.c>
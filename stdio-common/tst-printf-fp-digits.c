@@ -0,0 +1,167 @@
+/* Test the fast digit generation for double in __printf_fp.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <float.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <support/check.h>
+
+/* Results computed with the exact conversion, including halfway cases
+   which the fast path must leave to it.  */
+static const struct
+{
+  const char *format;
+  double value;
+  const char *expected;
+} tests[] =
+  {
+    { "%.0f", 0.5, "0" },
+    { "%.0f", 1.5, "2" },
+    { "%.0f", 2.5, "2" },
+    { "%.1f", 0.25, "0.2" },
+    { "%.1f", 0.35, "0.3" },
+    { "%.2f", 1.005, "1.00" },
+    { "%.3e", 1.0625, "1.062e+00" },
+    { "%.1f", 9.96, "10.0" },
+    { "%.2e", 9.996, "1.00e+01" },
+    { "%.3g", 9.9951, "10" },
+    { "%g", 0.0001, "0.0001" },
+    { "%.2g", 0.000099999, "0.0001" },
+    { "%#.3g", 0.99951, "1.00" },
+    { "%g", 100000.0, "100000" },
+    { "%g", 999999.5, "1e+06" },
+    { "%.17g", 0.1, "0.10000000000000001" },
+    { "%.17g", 1e23, "9.9999999999999992e+22" },
+    { "%.16e", 5e-324, "4.9406564584124654e-324" },
+    { "%.17g", DBL_MAX, "1.7976931348623157e+308" },
+    { "%.17g", DBL_MIN, "2.2250738585072014e-308" },
+    { "%f", 1e15, "1000000000000000.000000" },
+    { "%.10f", 1.0 / 3, "0.3333333333" },
+    { "%'.2f", 1234567.891, "1234567.89" },
+    { "%+012.4e", -3.14159265358979, "-03.1416e+00" },
+    { "%-10.3g|", 2.0 / 3, "0.667     |" },
+    { "%G", 1e-10, "1E-10" },
+  };
+
+/* A simple generator, so that the sequence is the same everywhere.  */
+static uint64_t
+next_random (uint64_t *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static const char *const formats[] =
+  { "%.0e", "%.3e", "%e", "%.10e", "%.15e", "%.16e", "%.20e",
+    "%.0f", "%.2f", "%f", "%.12f", "%.17f", "%.30f",
+    "%g", "%.1g", "%.5g", "%.15g", "%.16g", "%.17g", "%#.10g" };
+
+static void
+compare_with_long_double (double value)
+{
+#if LDBL_MANT_DIG > DBL_MANT_DIG
+  /* Long double values are always converted with multi-precision
+     arithmetic, so they provide the reference.  */
+  for (size_t i = 0; i < sizeof (formats) / sizeof (formats[0]); ++i)
+    {
+      char format[16];
+      char buf[512];
+      char ref[512];
+
+      snprintf (buf, sizeof buf, formats[i], value);
+      strcpy (format, formats[i]);
+      /* Insert the L modifier before the conversion.  */
+      size_t len = strlen (format);
+      format[len + 1] = '\0';
+      format[len] = format[len - 1];
+      format[len - 1] = 'L';
+      snprintf (ref, sizeof ref, format, (long double) value);
+      if (strcmp (buf, ref) != 0)
+	{
+	  support_record_failure ();
+	  printf ("error: %s of %a: \"%s\", expected \"%s\"\n",
+		  formats[i], value, buf, ref);
+	}
+    }
+#endif
+}
+
+static int
+do_test (void)
+{
+  for (size_t i = 0; i < sizeof (tests) / sizeof (tests[0]); ++i)
+    {
+      char buf[128];
+      wchar_t wbuf[128];
+      wchar_t wformat[32];
+      wchar_t wexpected[128];
+
+      snprintf (buf, sizeof buf, tests[i].format, tests[i].value);
+      if (strcmp (buf, tests[i].expected) != 0)
+	{
+	  support_record_failure ();
+	  printf ("error: %s of %a: \"%s\", expected \"%s\"\n",
+		  tests[i].format, tests[i].value, buf, tests[i].expected);
+	}
+
+      mbstowcs (wformat, tests[i].format, 32);
+      mbstowcs (wexpected, tests[i].expected, 128);
+      swprintf (wbuf, 128, wformat, tests[i].value);
+      if (wcscmp (wbuf, wexpected) != 0)
+	{
+	  support_record_failure ();
+	  printf ("error: wide %s of %a: \"%ls\"\n", tests[i].format,
+		  tests[i].value, wbuf);
+	}
+
+      compare_with_long_double (tests[i].value);
+    }
+
+  uint64_t state = 0x9e3779b97f4a7c15ULL;
+  for (int i = 0; i < 100000; ++i)
+    {
+      double value;
+      uint64_t bits = next_random (&state);
+
+      if (i % 2 == 0)
+	{
+	  /* Any finite value.  */
+	  if ((bits >> 52 & 0x7ff) == 0x7ff)
+	    continue;
+	  memcpy (&value, &bits, sizeof (value));
+	}
+      else
+	{
+	  /* Short decimal fractions, which are close to halfway cases of
+	     the conversions with few digits.  */
+	  static const double scale[] = { 1e-9, 1e-5, 1e-3, 1e-1, 1, 1e5 };
+	  value = (double) (bits % 100000000) / 8
+		  * scale[(bits >> 40) % (sizeof (scale) / sizeof (scale[0]))];
+	}
+      compare_with_long_double (value);
+    }
+
+  return 0;
+}
+
+#include <support/test-driver.c>
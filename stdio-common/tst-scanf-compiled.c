@@ -0,0 +1,233 @@
+/* Test scanf_compile and the numeric fast paths of scanf.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <limits.h>
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/xstdio.h>
+
+/* Scan INPUT with FORMAT, which has one conversion followed by %n,
+   through sscanf, sscanf_compiled and fscanf_compiled, and check that
+   all of them return RET, store VALUE of TYPE and count N characters.  */
+#define CHECK(type, format, input, ret, value, n)			\
+  do									\
+    {									\
+      struct scanf_compiled *cf = scanf_compile (format);		\
+      TEST_VERIFY_EXIT (cf != NULL);					\
+      for (int i = 0; i < 3; ++i)					\
+	{								\
+	  type v = 0;							\
+	  int count = -1;						\
+	  int r;							\
+	  if (i == 0)							\
+	    r = sscanf (input, format, &v, &count);			\
+	  else if (i == 1)						\
+	    r = sscanf_compiled (input, cf, &v, &count);		\
+	  else								\
+	    {								\
+	      FILE *fp = fmemopen ((char *) input, strlen (input), "r"); \
+	      TEST_VERIFY_EXIT (fp != NULL);				\
+	      r = fscanf_compiled (fp, cf, &v, &count);			\
+	      xfclose (fp);						\
+	    }								\
+	  if (r != (ret) || (r > 0 && (v != (value) || count != (n))))	\
+	    {								\
+	      support_record_failure ();				\
+	      printf ("error: line %d, call %d: \"%s\" with \"%s\"\n",	\
+		      __LINE__, i, format, input);			\
+	    }								\
+	}								\
+      scanf_compiled_free (cf);						\
+    }									\
+  while (0)
+
+static void
+check_numbers (void)
+{
+  CHECK (int, "%d%n", "123", 1, 123, 3);
+  CHECK (int, "%d%n", "  -42x", 1, -42, 5);
+  CHECK (int, "%d%n", "+7", 1, 7, 2);
+  CHECK (int, "%d%n", "+-5", 0, 0, 0);
+  CHECK (int, "%d%n", "-", 0, 0, 0);
+  CHECK (int, "%3d%n", "12345", 1, 123, 3);
+  CHECK (int, "%i%n", "017", 1, 15, 3);
+  CHECK (int, "%i%n", "08", 1, 0, 1);
+  CHECK (int, "%i%n", "0x1f", 1, 31, 4);
+  CHECK (int, "%i%n", "0xg", 1, 0, 2);
+  CHECK (int, "%i%n", "1e+", 1, 1, 1);
+  CHECK (unsigned int, "%x%n", "1e", 1, 30, 2);
+  CHECK (unsigned int, "%x%n", "08", 1, 8, 2);
+  CHECK (unsigned int, "%x%n", "0x", 1, 0, 2);
+  CHECK (unsigned int, "%o%n", "778", 1, 63, 2);
+  CHECK (unsigned int, "%u%n", "-1", 1, UINT_MAX, 2);
+  CHECK (unsigned long int, "%lu%n", "-5", 1, -5UL, 2);
+  CHECK (signed char, "%hhd%n", "300", 1, 44, 3);
+  CHECK (short int, "%hd%n", "-32769", 1, 32767, 6);
+  CHECK (long int, "%ld%n", "123456789", 1, 123456789, 9);
+  CHECK (long long int, "%lld%n", "-123456789012345678", 1,
+	 -123456789012345678LL, 19);
+  CHECK (long long int, "%lld%n", "9223372036854775807", 1,
+	 LLONG_MAX, 19);
+  CHECK (long long int, "%lld%n", "-9223372036854775808", 1,
+	 LLONG_MIN, 20);
+  CHECK (long long int, "%lld%n", "99999999999999999999", 1,
+	 LLONG_MAX, 20);
+  CHECK (unsigned long long int, "%llu%n", "18446744073709551615", 1,
+	 ULLONG_MAX, 20);
+  CHECK (long int, "%ld%n", "-2147483648", 1, -2147483648L, 11);
+
+  CHECK (double, "%lf%n", "1.5e3x", 1, 1500, 5);
+  CHECK (double, "%lf%n", "-.5x", 1, -0.5, 3);
+  CHECK (double, "%lf%n", "5.", 1, 5, 2);
+  CHECK (double, "%lf%n", "1e", 1, 1, 2);
+  CHECK (double, "%lf%n", "1e+", 1, 1, 3);
+  CHECK (double, "%lf%n", "0x1p3", 1, 8, 5);
+  CHECK (double, "%lf%n", "inf", 1, __builtin_inf (), 3);
+  CHECK (double, "%lf%n", "0x", 0, 0, 0);
+  CHECK (double, "%lf%n", ".e1", 0, 0, 0);
+  CHECK (double, "%4lf%n", "1.2345", 1, 1.23, 4);
+  CHECK (float, "%f%n", "0.1", 1, 0.1f, 3);
+  CHECK (float, "%e%n", "3.4e38", 1, 3.4e38f, 6);
+}
+
+/* The input of sscanf is read in pieces, and numbers and strings
+   crossing the end of a piece are converted as a whole.  */
+static void
+check_long_input (void)
+{
+  struct scanf_compiled *cf = scanf_compile ("%d%s%n");
+  TEST_VERIFY_EXIT (cf != NULL);
+  for (size_t spaces = 1000; spaces < 1030; ++spaces)
+    {
+      size_t size = spaces + 2000;
+      char *input = xmalloc (size + 1);
+      memset (input, ' ', spaces);
+      strcpy (input + spaces, "123456789 ");
+      size_t len = strlen (input);
+      memset (input + len, 'a', size - len);
+      input[size] = '\0';
+
+      char *word = xmalloc (size);
+      int v = 0;
+      int n = 0;
+      TEST_COMPARE (sscanf_compiled (input, cf, &v, word, &n), 2);
+      TEST_COMPARE (v, 123456789);
+      TEST_COMPARE (strlen (word), size - len);
+      TEST_COMPARE (n, size);
+      v = 0;
+      TEST_COMPARE (sscanf (input, "%d", &v), 1);
+      TEST_COMPARE (v, 123456789);
+      free (word);
+      free (input);
+    }
+  scanf_compiled_free (cf);
+}
+
+static void
+check_formats (void)
+{
+  char a[8], b[8];
+  int x, y;
+
+  struct scanf_compiled *cf = scanf_compile ("%7[a-c]%7[^,],%*d %d");
+  TEST_VERIFY_EXIT (cf != NULL);
+  TEST_COMPARE (sscanf_compiled ("abcxyz,1 2", cf, a, b, &x), 3);
+  TEST_COMPARE_STRING (a, "abc");
+  TEST_COMPARE_STRING (b, "xyz");
+  TEST_COMPARE (x, 2);
+  TEST_COMPARE (sscanf_compiled ("xyz", cf, a, b, &x), 0);
+  /* The compiled sets are reused.  */
+  TEST_COMPARE (sscanf_compiled ("cab]^,3 4", cf, a, b, &x), 3);
+  TEST_COMPARE_STRING (a, "cab");
+  TEST_COMPARE_STRING (b, "]^");
+  TEST_COMPARE (x, 4);
+  scanf_compiled_free (cf);
+
+  cf = scanf_compile ("%2$d:%1$d");
+  TEST_VERIFY_EXIT (cf != NULL);
+  TEST_COMPARE (sscanf_compiled ("1:2", cf, &x, &y), 2);
+  TEST_COMPARE (x, 2);
+  TEST_COMPARE (y, 1);
+  scanf_compiled_free (cf);
+
+  /* An unterminated set makes the conversion fail.  */
+  cf = scanf_compile ("%d %[abc");
+  TEST_VERIFY_EXIT (cf != NULL);
+  TEST_COMPARE (sscanf_compiled ("1 a", cf, &x, a), 1);
+  TEST_COMPARE (x, 1);
+  scanf_compiled_free (cf);
+
+  /* %a is always a floating-point conversion.  */
+  cf = scanf_compile ("%a");
+  TEST_VERIFY_EXIT (cf != NULL);
+  float f = 0;
+  TEST_COMPARE (sscanf_compiled ("0x1.8p1", cf, &f), 1);
+  TEST_VERIFY (f == 3);
+  scanf_compiled_free (cf);
+
+  /* Literal text and end of input.  */
+  cf = scanf_compile ("x=%d, y=%d");
+  TEST_VERIFY_EXIT (cf != NULL);
+  TEST_COMPARE (sscanf_compiled ("x=1, y=2", cf, &x, &y), 2);
+  TEST_COMPARE (x, 1);
+  TEST_COMPARE (y, 2);
+  TEST_COMPARE (sscanf_compiled ("x=3, z=4", cf, &x, &y), 1);
+  TEST_COMPARE (x, 3);
+  TEST_COMPARE (sscanf_compiled ("", cf, &x, &y), EOF);
+  TEST_COMPARE (sscanf_compiled ("x=", cf, &x, &y), EOF);
+  scanf_compiled_free (cf);
+}
+
+/* The ' flag uses the grouping of the locale at the time of the call.  */
+static void
+check_grouping (void)
+{
+  struct scanf_compiled *cf = scanf_compile ("%'d%n");
+  TEST_VERIFY_EXIT (cf != NULL);
+  int x = 0;
+  int n = 0;
+  TEST_COMPARE (sscanf_compiled ("1.234.567", cf, &x, &n), 1);
+  TEST_COMPARE (x, 1);
+  TEST_COMPARE (n, 1);
+  if (setlocale (LC_ALL, "de_DE.UTF-8") == NULL)
+    FAIL_EXIT1 ("setlocale (LC_ALL, \"de_DE.UTF-8\"): %m");
+  TEST_COMPARE (sscanf_compiled ("1.234.567", cf, &x, &n), 1);
+  TEST_COMPARE (x, 1234567);
+  TEST_COMPARE (n, 9);
+  double d = 0;
+  TEST_COMPARE (sscanf ("2,5", "%lf", &d), 1);
+  TEST_VERIFY (d == 2.5);
+  setlocale (LC_ALL, "C");
+  scanf_compiled_free (cf);
+}
+
+static int
+do_test (void)
+{
+  check_numbers ();
+  check_long_input ();
+  check_formats ();
+  check_grouping ();
+  return 0;
+}
+
+#include <support/test-driver.c>
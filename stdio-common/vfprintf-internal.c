@@ -671,6 +671,20 @@ static int printf_positional (FILE *s,
 			      THOUSANDS_SEP_T thousands_sep,
 			      unsigned int mode_flags);
 
+/* Fetch the arguments for the parsed format specifiers and process
+   them.  */
+static int printf_positional_run (FILE *s,
+				  const CHAR_T *format, int readonly_format,
+				  const struct printf_spec *specs,
+				  size_t nspecs, int nspecs_done,
+				  size_t nargs, union printf_arg *args_value,
+				  const int *args_type, const int *args_size,
+				  va_list *ap_savep, int done,
+				  CHAR_T *work_buffer, int save_errno,
+				  const char *grouping,
+				  THOUSANDS_SEP_T thousands_sep,
+				  unsigned int mode_flags);
+
 /* Handle unknown format specifier.  */
 static int printf_unknown (FILE *, const struct printf_info *) __THROW;
 
@@ -722,6 +736,11 @@ vfprintf (FILE *s, const CHAR_T *format, va_list ap, unsigned int mode_flags)
   ORIENT;
 #endif
 
+#ifndef COMPILE_WPRINTF
+  /* Write to the buffer of the calling thread if S has one.  */
+  s = _IO_threadbuf_stream (s);
+#endif
+
   /* Sanity check of arguments.  */
   ARGCHECK (s, format);
 
@@ -1114,6 +1133,263 @@ do_positional:
   return done;
 }
 
+#ifndef COMPILE_WPRINTF
+/* Process the format specifiers of CF, which only refers to its
+   arguments in order.  This reads them directly from AP, as the loop
+   in vfprintf does.  */
+static int
+printf_compiled_sequential (FILE *s, const struct printf_compiled *cf,
+			    va_list ap, int done, CHAR_T *work_buffer,
+			    int save_errno, unsigned int mode_flags)
+{
+  /* Only used for %n in fortified mode.  */
+  const CHAR_T *format = cf->format;
+  int readonly_format = 0;
+
+  THOUSANDS_SEP_T thousands_sep = 0;
+  const char *grouping = NULL;
+  if (cf->group)
+    {
+      thousands_sep = _NL_CURRENT (LC_NUMERIC, THOUSANDS_SEP);
+      grouping = _NL_CURRENT (LC_NUMERIC, GROUPING);
+      if (*grouping == '\0' || *grouping == CHAR_MAX)
+	grouping = NULL;
+    }
+
+  for (size_t cnt = 0; cnt < cf->nspecs; ++cnt)
+    {
+      STEP4_TABLE;
+
+      const struct printf_spec *spec_p = &cf->specs[cnt];
+      int is_negative;
+      union
+      {
+	unsigned long long int longlong;
+	unsigned long int word;
+      } number;
+      int base;
+      union printf_arg the_arg;
+      CHAR_T *string;		/* Pointer to argument string.  */
+
+      int alt = spec_p->info.alt;
+      int space = spec_p->info.space;
+      int left = spec_p->info.left;
+      int showsign = spec_p->info.showsign;
+      int group = spec_p->info.group;
+      int is_long_double __attribute__ ((unused))
+	= spec_p->info.is_long_double;
+      int is_short = spec_p->info.is_short;
+      int is_char = spec_p->info.is_char;
+      int is_long = spec_p->info.is_long;
+      int width = spec_p->info.width;
+      int prec = spec_p->info.prec;
+      int use_outdigits = spec_p->info.i18n;
+      UCHAR_T pad = spec_p->info.pad;
+      CHAR_T spec = spec_p->info.spec;
+
+      CHAR_T *workend = work_buffer + WORK_BUFFER_SIZE;
+
+      /* The width and precision arguments come before the value.  */
+      if (spec_p->width_arg != -1)
+	{
+	  width = va_arg (ap, int);
+
+	  /* Negative width means left justified.  */
+	  if (width < 0)
+	    {
+	      width = -width;
+	      pad = L_(' ');
+	      left = 1;
+	    }
+	}
+
+      if (spec_p->prec_arg != -1)
+	{
+	  prec = va_arg (ap, int);
+
+	  /* If the precision is negative the precision is omitted.  */
+	  if (prec < 0)
+	    prec = -1;
+	}
+
+      /* Process format specifiers.  */
+      while (1)
+	{
+	  JUMP (spec, step4_jumps);
+
+#define process_arg_int() va_arg (ap, int)
+#define process_arg_long_int() va_arg (ap, long int)
+#define process_arg_long_long_int() va_arg (ap, long long int)
+#define process_arg_pointer() va_arg (ap, void *)
+#define process_arg_string() va_arg (ap, const char *)
+#define process_arg_unsigned_int() va_arg (ap, unsigned int)
+#define process_arg_unsigned_long_int() va_arg (ap, unsigned long int)
+#define process_arg_unsigned_long_long_int() va_arg (ap, unsigned long long int)
+#define process_arg_wchar_t() va_arg (ap, wchar_t)
+#define process_arg_wstring() va_arg (ap, const wchar_t *)
+#include "vfprintf-process-arg.c"
+#undef process_arg_int
+#undef process_arg_long_int
+#undef process_arg_long_long_int
+#undef process_arg_pointer
+#undef process_arg_string
+#undef process_arg_unsigned_int
+#undef process_arg_unsigned_long_int
+#undef process_arg_unsigned_long_long_int
+#undef process_arg_wchar_t
+#undef process_arg_wstring
+
+	  LABEL (form_float):
+	  LABEL (form_floathex):
+	  {
+	    if (__glibc_unlikely ((mode_flags & PRINTF_LDBL_IS_DBL) != 0))
+	      is_long_double = 0;
+
+	    struct printf_info info = spec_p->info;
+	    info.prec = prec;
+	    info.width = width;
+	    info.left = left;
+	    info.pad = pad;
+	    info.is_long_double = is_long_double;
+
+	    PARSE_FLOAT_VA_ARG_EXTENDED (info);
+	    const void *ptr = &the_arg;
+
+	    int function_done = __printf_fp_spec (s, &info, &ptr);
+	    if (function_done < 0)
+	      {
+		done = -1;
+		goto all_done;
+	      }
+	    done_add (function_done);
+	  }
+	  break;
+
+	  LABEL (form_unknown):
+	  if (spec == L_('\0'))
+	    {
+	      /* The format string ended before the specifier is
+		 complete.  */
+	      __set_errno (EINVAL);
+	      done = -1;
+	      goto all_done;
+	    }
+
+	  {
+	    struct printf_info info = spec_p->info;
+	    info.prec = prec;
+	    info.width = width;
+	    info.left = left;
+
+	    int function_done = printf_unknown (s, &info);
+
+	    /* If an error occurred we don't have information about #
+	       of chars.  */
+	    if (function_done < 0)
+	      {
+		/* Function has set errno.  */
+		done = -1;
+		goto all_done;
+	      }
+
+	    done_add (function_done);
+	  }
+	  break;
+	}
+
+      /* Write the following constant string.  */
+      outstring (spec_p->end_of_fmt,
+		 spec_p->next_fmt - spec_p->end_of_fmt);
+    }
+ all_done:
+  return done;
+}
+/* Like vfprintf, but for a format string which printf_compile has
+   already parsed.  */
+int
+__vfprintf_compiled_internal (FILE *s, const struct printf_compiled *cf,
+			      va_list ap, unsigned int mode_flags)
+{
+  /* Place to accumulate the result.  */
+  int done = 0;
+
+  /* Buffer intermediate results.  */
+  CHAR_T work_buffer[WORK_BUFFER_SIZE];
+
+  /* Storage for the argument values.  */
+  struct scratch_buffer argsbuf;
+
+  /* We have to save the original argument pointer.  */
+  va_list ap_save;
+
+  /* For the %m format we may need the current `errno' value.  */
+  int save_errno = errno;
+
+  /* Orient the stream.  */
+  ORIENT;
+
+  /* Write to the buffer of the calling thread if S has one.  */
+  s = _IO_threadbuf_stream (s);
+
+  /* Sanity check of arguments.  */
+  ARGCHECK (s, cf);
+
+  if (UNBUFFERED_P (s))
+    /* Parsing the format again costs little compared to writing to an
+       unbuffered stream.  */
+    return buffered_vfprintf (s, cf->format, ap, mode_flags);
+
+  __va_copy (ap_save, ap);
+  scratch_buffer_init (&argsbuf);
+
+  /* Lock stream.  */
+  _IO_cleanup_region_start ((void (*) (void *)) &_IO_funlockfile, s);
+  _IO_flockfile (s);
+
+  /* Write the literal text before the first format.  */
+  outstring ((const UCHAR_T *) cf->format, cf->lead_len);
+
+  if (cf->nspecs == 0)
+    goto all_done;
+
+  /* Like vfprintf, leave registered handlers to the positional code,
+     even if none was registered when the format was compiled.  */
+  if (cf->sequential
+      && __glibc_likely (__printf_function_table == NULL
+			 && __printf_modifier_table == NULL
+			 && __printf_va_arg_table == NULL))
+    {
+      done = printf_compiled_sequential (s, cf, ap, done, work_buffer,
+					 save_errno, mode_flags);
+      goto all_done;
+    }
+
+  if (!scratch_buffer_set_array_size (&argsbuf, cf->nargs,
+				      sizeof (union printf_arg)))
+    {
+      done = -1;
+      goto all_done;
+    }
+
+  /* The locale may have changed since the format was compiled, so
+     look up the grouping information here, but only if needed.  */
+  done = printf_positional_run (s, cf->format, 0, cf->specs, cf->nspecs, 0,
+				cf->nargs, argsbuf.data, cf->args_type,
+				cf->args_size, &ap_save, done, work_buffer,
+				save_errno,
+				cf->group ? (const char *) -1 : NULL, NULL,
+				mode_flags);
+
+ all_done:
+  /* Unlock the stream.  */
+  _IO_funlockfile (s);
+  _IO_cleanup_region_end (0);
+  scratch_buffer_free (&argsbuf);
+
+  return done;
+}
+#endif
+
 static int
 printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
 		   va_list ap, va_list *ap_savep, int done, int nspecs_done,
@@ -1150,20 +1426,6 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
   /* Just a counter.  */
   size_t cnt;
 
-  if (grouping == (const char *) -1)
-    {
-#ifdef COMPILE_WPRINTF
-      thousands_sep = _NL_CURRENT_WORD (LC_NUMERIC,
-					_NL_NUMERIC_THOUSANDS_SEP_WC);
-#else
-      thousands_sep = _NL_CURRENT (LC_NUMERIC, THOUSANDS_SEP);
-#endif
-
-      grouping = _NL_CURRENT (LC_NUMERIC, GROUPING);
-      if (*grouping == '\0' || *grouping == CHAR_MAX)
-	grouping = NULL;
-    }
-
   for (const UCHAR_T *f = lead_str_end; *f != L_('\0');
        f = specs[nspecs++].next_fmt)
     {
@@ -1248,9 +1510,44 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
 	}
     }
 
+  done = printf_positional_run (s, format, readonly_format, specs, nspecs,
+				nspecs_done, nargs, args_value, args_type,
+				args_size, ap_savep, done, work_buffer,
+				save_errno, grouping, thousands_sep, mode_flags);
+
+ all_done:
+  scratch_buffer_free (&argsbuf);
+  scratch_buffer_free (&specsbuf);
+  return done;
+}
+
+static int
+printf_positional_run (FILE *s, const CHAR_T *format, int readonly_format,
+		       const struct printf_spec *specs, size_t nspecs,
+		       int nspecs_done, size_t nargs,
+		       union printf_arg *args_value, const int *args_type,
+		       const int *args_size, va_list *ap_savep, int done,
+		       CHAR_T *work_buffer, int save_errno,
+		       const char *grouping, THOUSANDS_SEP_T thousands_sep,
+		       unsigned int mode_flags)
+{
+  if (grouping == (const char *) -1)
+    {
+#ifdef COMPILE_WPRINTF
+      thousands_sep = _NL_CURRENT_WORD (LC_NUMERIC,
+					_NL_NUMERIC_THOUSANDS_SEP_WC);
+#else
+      thousands_sep = _NL_CURRENT (LC_NUMERIC, THOUSANDS_SEP);
+#endif
+
+      grouping = _NL_CURRENT (LC_NUMERIC, GROUPING);
+      if (*grouping == '\0' || *grouping == CHAR_MAX)
+	grouping = NULL;
+    }
+
   /* Now we know all the types and the order.  Fill in the argument
      values.  */
-  for (cnt = 0; cnt < nargs; ++cnt)
+  for (size_t cnt = 0; cnt < nargs; ++cnt)
     switch (args_type[cnt])
       {
 #define T(tag, mem, type)				\
@@ -1278,7 +1575,6 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
 	if (__glibc_unlikely ((mode_flags & PRINTF_LDBL_IS_DBL) != 0))
 	  {
 	    args_value[cnt].pa_double = va_arg (*ap_savep, double);
-	    args_type[cnt] &= ~PA_FLAG_LONG_DOUBLE;
 	  }
 #if __HAVE_FLOAT128_UNLIKE_LDBL
 	else if ((mode_flags & PRINTF_LDBL_USES_FLOAT128) != 0)
@@ -1316,6 +1612,10 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
     {
       STEP4_TABLE;
 
+      /* The width, precision and floating-point flags are filled in
+	 below, so work on a copy.  */
+      struct printf_spec this_spec = specs[nspecs_done];
+
       int is_negative;
       union
       {
@@ -1326,53 +1626,51 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
       CHAR_T *string;		/* Pointer to argument string.  */
 
       /* Fill variables from values in struct.  */
-      int alt = specs[nspecs_done].info.alt;
-      int space = specs[nspecs_done].info.space;
-      int left = specs[nspecs_done].info.left;
-      int showsign = specs[nspecs_done].info.showsign;
-      int group = specs[nspecs_done].info.group;
+      int alt = this_spec.info.alt;
+      int space = this_spec.info.space;
+      int left = this_spec.info.left;
+      int showsign = this_spec.info.showsign;
+      int group = this_spec.info.group;
       int is_long_double __attribute__ ((unused))
-	= specs[nspecs_done].info.is_long_double;
-      int is_short = specs[nspecs_done].info.is_short;
-      int is_char = specs[nspecs_done].info.is_char;
-      int is_long = specs[nspecs_done].info.is_long;
-      int width = specs[nspecs_done].info.width;
-      int prec = specs[nspecs_done].info.prec;
-      int use_outdigits = specs[nspecs_done].info.i18n;
-      char pad = specs[nspecs_done].info.pad;
-      CHAR_T spec = specs[nspecs_done].info.spec;
+	= this_spec.info.is_long_double;
+      int is_short = this_spec.info.is_short;
+      int is_char = this_spec.info.is_char;
+      int is_long = this_spec.info.is_long;
+      int width = this_spec.info.width;
+      int prec = this_spec.info.prec;
+      int use_outdigits = this_spec.info.i18n;
+      char pad = this_spec.info.pad;
+      CHAR_T spec = this_spec.info.spec;
 
       CHAR_T *workend = work_buffer + WORK_BUFFER_SIZE;
 
       /* Fill in last information.  */
-      if (specs[nspecs_done].width_arg != -1)
+      if (this_spec.width_arg != -1)
 	{
 	  /* Extract the field width from an argument.  */
-	  specs[nspecs_done].info.width =
-	    args_value[specs[nspecs_done].width_arg].pa_int;
+	  this_spec.info.width = args_value[this_spec.width_arg].pa_int;
 
-	  if (specs[nspecs_done].info.width < 0)
+	  if (this_spec.info.width < 0)
 	    /* If the width value is negative left justification is
 	       selected and the value is taken as being positive.  */
 	    {
-	      specs[nspecs_done].info.width *= -1;
-	      left = specs[nspecs_done].info.left = 1;
+	      this_spec.info.width *= -1;
+	      left = this_spec.info.left = 1;
 	    }
-	  width = specs[nspecs_done].info.width;
+	  width = this_spec.info.width;
 	}
 
-      if (specs[nspecs_done].prec_arg != -1)
+      if (this_spec.prec_arg != -1)
 	{
 	  /* Extract the precision from an argument.  */
-	  specs[nspecs_done].info.prec =
-	    args_value[specs[nspecs_done].prec_arg].pa_int;
+	  this_spec.info.prec = args_value[this_spec.prec_arg].pa_int;
 
-	  if (specs[nspecs_done].info.prec < 0)
+	  if (this_spec.info.prec < 0)
 	    /* If the precision is negative the precision is
 	       omitted.  */
-	    specs[nspecs_done].info.prec = -1;
+	    this_spec.info.prec = -1;
 
-	  prec = specs[nspecs_done].info.prec;
+	  prec = this_spec.info.prec;
 	}
 
       /* Process format specifiers.  */
@@ -1384,17 +1682,16 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
 	      && __printf_function_table != NULL
 	      && __printf_function_table[(size_t) spec] != NULL)
 	    {
-	      const void **ptr = alloca (specs[nspecs_done].ndata_args
+	      const void **ptr = alloca (this_spec.ndata_args
 					 * sizeof (const void *));
 
 	      /* Fill in an array of pointers to the argument values.  */
-	      for (unsigned int i = 0; i < specs[nspecs_done].ndata_args;
-		   ++i)
-		ptr[i] = &args_value[specs[nspecs_done].data_arg + i];
+	      for (unsigned int i = 0; i < this_spec.ndata_args; ++i)
+		ptr[i] = &args_value[this_spec.data_arg + i];
 
 	      /* Call the function.  */
 	      function_done = __printf_function_table[(size_t) spec]
-		(s, &specs[nspecs_done].info, ptr);
+		(s, &this_spec.info, ptr);
 
 	      if (function_done != -2)
 		{
@@ -1414,7 +1711,7 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
 
 	  JUMP (spec, step4_jumps);
 
-#define process_arg_data args_value[specs[nspecs_done].data_arg]
+#define process_arg_data args_value[this_spec.data_arg]
 #define process_arg_int() process_arg_data.pa_int
 #define process_arg_long_int() process_arg_data.pa_long_int
 #define process_arg_long_long_int() process_arg_data.pa_long_long_int
@@ -1442,16 +1739,16 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
 	  LABEL (form_floathex):
 	  {
 	    const void *ptr
-	      = (const void *) &args_value[specs[nspecs_done].data_arg];
+	      = (const void *) &args_value[this_spec.data_arg];
 	    if (__glibc_unlikely ((mode_flags & PRINTF_LDBL_IS_DBL) != 0))
 	      {
-		specs[nspecs_done].data_arg_type = PA_DOUBLE;
-		specs[nspecs_done].info.is_long_double = 0;
+		this_spec.data_arg_type = PA_DOUBLE;
+		this_spec.info.is_long_double = 0;
 	      }
-	    SETUP_FLOAT128_INFO (specs[nspecs_done].info);
+	    SETUP_FLOAT128_INFO (this_spec.info);
 
 	    int function_done
-	      = __printf_fp_spec (s, &specs[nspecs_done].info, &ptr);
+	      = __printf_fp_spec (s, &this_spec.info, &ptr);
 	    if (function_done < 0)
 	      {
 		/* Error in print handler; up to handler to set errno.  */
@@ -1464,7 +1761,7 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
 
 	  LABEL (form_unknown):
 	  {
-	    int function_done = printf_unknown (s, &specs[nspecs_done].info);
+	    int function_done = printf_unknown (s, &this_spec.info);
 
 	    /* If an error occurred we don't have information about #
 	       of chars.  */
@@ -1481,13 +1778,10 @@ printf_positional (FILE *s, const CHAR_T *format, int readonly_format,
 	}
 
       /* Write the following constant string.  */
-      outstring (specs[nspecs_done].end_of_fmt,
-		 specs[nspecs_done].next_fmt
-		 - specs[nspecs_done].end_of_fmt);
+      outstring (this_spec.end_of_fmt,
+		 this_spec.next_fmt - this_spec.end_of_fmt);
     }
  all_done:
-  scratch_buffer_free (&argsbuf);
-  scratch_buffer_free (&specsbuf);
   return done;
 }
 
@@ -0,0 +1,42 @@
+/* Formatted input with a parsed format string.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <libioP.h>
+
+int
+vfscanf_compiled (FILE *s, const struct scanf_compiled *cf, va_list ap)
+{
+  return __vfscanf_compiled_internal (s, cf, ap, 0);
+}
+
+/* Read formatted input from S according to the parsed format string
+   CF.  */
+int
+fscanf_compiled (FILE *s, const struct scanf_compiled *cf, ...)
+{
+  va_list arg;
+  int done;
+
+  va_start (arg, cf);
+  done = __vfscanf_compiled_internal (s, cf, arg, 0);
+  va_end (arg);
+
+  return done;
+}
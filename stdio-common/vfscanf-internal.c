@@ -263,18 +263,345 @@ char_buffer_add (struct char_buffer *buffer, CHAR_T ch)
     *buffer->current++ = ch;
 }
 
+/* A conversion specification.  */
+struct scanf_spec
+{
+  /* The '%' which starts the specification, and the rest of the format
+     string after it.  */
+  const UCHAR_T *start;
+  const UCHAR_T *next;
+  /* The argument position of %N$, or 0.  */
+  unsigned int argpos;
+  /* The maximum field width, or -1.  */
+  int width;
+  /* The flags.  GROUP is set for the ' flag even if the locale has no
+     thousands separator.  */
+  int flags;
+  /* The conversion specifier, or '\0' if the format string ends before
+     it.  */
+  UCHAR_T conv;
+#ifndef COMPILE_WSCANF
+  /* For %[ specifications parsed by scanf_compile, whether the set is
+     negated, and byte flags indexed by character for the characters in
+     the scanlist.  NEXT then points after the scanlist.  Otherwise
+     SET is NULL.  */
+  bool not_in;
+  const char *set;
+#endif
+};
+
+/* Parse the conversion specification which starts with the '%' at
+   START into SPEC.  */
+static void
+parse_spec (const UCHAR_T *start, struct scanf_spec *spec,
+	    unsigned int mode_flags)
+{
+  const UCHAR_T *f = start + 1;
+  unsigned int argpos = 0;
+  int flags = 0;
+  int width;
+
+  /* Check for a positional parameter specification.  */
+  if (ISDIGIT (*f))
+    {
+      argpos = read_int (&f);
+      if (*f == L_('$'))
+	++f;
+      else
+	{
+	  /* Oops; that was actually the field width.  */
+	  width = argpos;
+	  argpos = 0;
+	  goto got_width;
+	}
+    }
+
+  /* Check for the assignment-suppressing, the number grouping flag,
+     and the signal to use the locale's digit representation.  */
+  while (*f == L_('*') || *f == L_('\'') || *f == L_('I'))
+    switch (*f++)
+      {
+      case L_('*'):
+	flags |= SUPPRESS;
+	break;
+      case L_('\''):
+	flags |= GROUP;
+	break;
+      case L_('I'):
+	flags |= I18N;
+	break;
+      }
+
+  /* Find the maximum field width.  */
+  width = 0;
+  if (ISDIGIT (*f))
+    width = read_int (&f);
+ got_width:
+  if (width == 0)
+    width = -1;
+
+  /* Check for type modifiers.  */
+  switch (*f++)
+    {
+    case L_('h'):
+      /* ints are short ints or chars.  */
+      if (*f == L_('h'))
+	{
+	  ++f;
+	  flags |= CHAR;
+	}
+      else
+	flags |= SHORT;
+      break;
+    case L_('l'):
+      if (*f == L_('l'))
+	{
+	  /* A double `l' is equivalent to an `L'.  */
+	  ++f;
+	  flags |= LONGDBL | LONG;
+	}
+      else
+	/* ints are long ints.  */
+	flags |= LONG;
+      break;
+    case L_('q'):
+    case L_('L'):
+      /* doubles are long doubles, and ints are long long ints.  */
+      flags |= LONGDBL | LONG;
+      break;
+    case L_('a'):
+      /* The `a' is used as a flag only if followed by `s', `S' or
+	 `['.  */
+      if (*f != L_('s') && *f != L_('S') && *f != L_('['))
+	{
+	  --f;
+	  break;
+	}
+      /* In __isoc99_*scanf %as, %aS and %a[ extension is not
+	 supported at all.  */
+      if (__glibc_likely ((mode_flags & SCANF_ISOC99_A) != 0))
+	{
+	  --f;
+	  break;
+	}
+      /* String conversions (%s, %[) take a `char **'
+	 arg and fill it in with a malloc'd pointer.  */
+      flags |= GNU_MALLOC;
+      break;
+    case L_('m'):
+      flags |= POSIX_MALLOC;
+      if (*f == L_('l'))
+	{
+	  ++f;
+	  flags |= LONG;
+	}
+      break;
+    case L_('z'):
+      if (need_longlong && sizeof (size_t) > sizeof (unsigned long int))
+	flags |= LONGDBL;
+      else if (sizeof (size_t) > sizeof (unsigned int))
+	flags |= LONG;
+      break;
+    case L_('j'):
+      if (need_longlong && sizeof (uintmax_t) > sizeof (unsigned long int))
+	flags |= LONGDBL;
+      else if (sizeof (uintmax_t) > sizeof (unsigned int))
+	flags |= LONG;
+      break;
+    case L_('t'):
+      if (need_longlong && sizeof (ptrdiff_t) > sizeof (long int))
+	flags |= LONGDBL;
+      else if (sizeof (ptrdiff_t) > sizeof (int))
+	flags |= LONG;
+      break;
+    default:
+      /* Not a recognized modifier.  Backup.  */
+      --f;
+      break;
+    }
+
+  spec->start = start;
+  spec->argpos = argpos;
+  spec->width = width;
+  spec->flags = flags;
+  spec->conv = *f;
+  if (*f != L_('\0'))
+    ++f;
+  spec->next = f;
+#ifndef COMPILE_WSCANF
+  spec->set = NULL;
+#endif
+}
+
+#ifndef COMPILE_WSCANF
+/* Fill TABLE with byte flags indexed by character for the scanlist of
+   a %[ conversion which starts at F, after the '^' if there is one.
+   Return a pointer after the closing ']', or NULL if there is none.  */
+static const unsigned char *
+fill_scanlist (const unsigned char *f, char *table)
+{
+  unsigned char fc;
+
+  memset (table, '\0', UCHAR_MAX + 1);
+
+  fc = *f;
+  if (fc == ']' || fc == '-')
+    {
+      /* If ] or - appears before any char in the set, it is not
+	 the terminator or separator, but the first char in the
+	 set.  */
+      table[fc] = 1;
+      ++f;
+    }
+
+  while ((fc = *f++) != '\0' && fc != ']')
+    if (fc == '-' && *f != '\0' && *f != ']' && f[-2] <= *f)
+      {
+	/* Add all characters from the one before the '-'
+	   up to (but not including) the next format char.  */
+	for (fc = f[-2]; fc < *f; ++fc)
+	  table[fc] = 1;
+      }
+    else
+      /* Add the character to the flag map.  */
+      table[fc] = 1;
+
+  return fc == '\0' ? NULL : f;
+}
+
+/* A format string parsed by scanf_compile.  The specifications, the
+   scanlists and the copy of the format string they point into are part
+   of the same allocation.  */
+struct scanf_compiled
+{
+  const char *format;
+  /* The conversion specifications in the order of the format string,
+     followed by one whose START is NULL.  */
+  const struct scanf_spec *specs;
+};
+
+/* Numbers which are in the buffer of the stream as a whole are
+   converted directly from there, rather than after copying them one
+   character at a time.  The functions below find the end of such
+   numbers, as the loops of the general code would.  */
+
+/* Return the end of the characters in the get area of S which can be
+   examined directly.  For the string streams of sscanf this includes
+   the character at _IO_read_end, which is either the null character
+   which ends the input or the first one not in the get area yet.  */
+static inline const char *
+direct_end (FILE *s)
+{
+  const char *end = s->_IO_read_end;
+
+  if (_IO_vtable_offset (s) == 0
+      && _IO_JUMPS_FILE_plus (s) == &_IO_strread_jumps
+      && !_IO_in_backup (s))
+    ++end;
+  return end;
+}
+
+/* Return the first character in [P, END) which is not a decimal digit,
+   or END.  Long runs of digits are checked eight at a time.  */
+static inline const char *
+skip_digits (const char *p, const char *end)
+{
+  while (end - p >= 8)
+    {
+      uint64_t v;
+      memcpy (&v, p, sizeof (v));
+      /* A byte is a digit if it and the byte plus 6 both have 3 in
+	 their high nibble.  A carry out of a byte only happens if the
+	 byte itself is not a digit.  */
+      if (((v & 0xf0f0f0f0f0f0f0f0ULL)
+	   | (((v + 0x0606060606060606ULL) & 0xf0f0f0f0f0f0f0f0ULL) >> 4))
+	  != 0x3333333333333333ULL)
+	break;
+      p += 8;
+    }
+  while (p < end && (unsigned char) (*p - '0') < 10)
+    ++p;
+  return p;
+}
+
+/* Return the end of the integer in BASE at P if it ends before END, or
+   NULL.  Numbers with a prefix which determines or changes the base
+   are left to the general code.  A BASE of 0 is changed to 10.  */
+static const char *
+scan_integer (const char *p, const char *end, int *base)
+{
+  if (p < end && (*p == '-' || *p == '+'))
+    ++p;
+  if (p < end && *p == '0'
+      && (*base == 0
+	  || (*base == 16 && (p + 1 == end || (p[1] | 0x20) == 'x'))))
+    return NULL;
+
+  const char *digits = p;
+  switch (*base)
+    {
+    case 0:
+      *base = 10;
+      /* Fall through.  */
+    case 10:
+      p = skip_digits (p, end);
+      break;
+    case 16:
+      while (p < end && ((unsigned char) (*p - '0') < 10
+			 || (unsigned char) ((*p | 0x20) - 'a') < 6))
+	++p;
+      break;
+    default:
+      while (p < end && (unsigned char) (*p - '0') < 8)
+	++p;
+      break;
+    }
+  return p > digits && p < end ? p : NULL;
+}
+
+/* Return the end of the decimal floating-point number at P if it ends
+   before END, or NULL.  DECIMAL is the decimal point.  Hexadecimal
+   numbers, infinities and NaNs are left to the general code.  */
+static const char *
+scan_float (const char *p, const char *end, char decimal)
+{
+  bool got_digit;
+
+  if (p < end && (*p == '-' || *p == '+'))
+    ++p;
+  if (p < end && *p == '0' && (p + 1 == end || (p[1] | 0x20) == 'x'))
+    return NULL;
+
+  const char *digits = p;
+  p = skip_digits (p, end);
+  got_digit = p > digits;
+  if (p < end && *p == decimal)
+    {
+      digits = ++p;
+      p = skip_digits (p, end);
+      got_digit |= p > digits;
+    }
+  if (!got_digit)
+    return NULL;
+
+  if (p < end && (*p | 0x20) == 'e')
+    {
+      ++p;
+      if (p < end && (*p == '-' || *p == '+'))
+	++p;
+      p = skip_digits (p, end);
+    }
+  return p < end ? p : NULL;
+}
+#endif
+
 /* Read formatted input from S according to the format string
-   FORMAT, using the argument list in ARG.
+   FORMAT, using the argument list in ARG.  SPECS, if not NULL, are the
+   conversion specifications of FORMAT parsed by scanf_compile.
    Return the number of assignments made, or -1 for an input error.  */
-#ifdef COMPILE_WSCANF
-int
-__vfwscanf_internal (FILE *s, const wchar_t *format, va_list argptr,
-		     unsigned int mode_flags)
-#else
-int
-__vfscanf_internal (FILE *s, const char *format, va_list argptr,
-		    unsigned int mode_flags)
-#endif
+static int
+vfscanf_run (FILE *s, const CHAR_T *format, const struct scanf_spec *specs,
+	     va_list argptr, unsigned int mode_flags)
 {
   va_list arg;
   const UCHAR_T *f = (const UCHAR_T *) format;
@@ -332,6 +659,10 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
   int skip_space = 0;
   /* Workspace.  */
   CHAR_T *tw;			/* Temporary pointer.  */
+  CHAR_T *numstart;		/* The number to convert.  */
+#ifndef COMPILE_WSCANF
+  const char *charset;		/* The flag map of a scanlist.  */
+#endif
   struct char_buffer charbuf;
   scratch_buffer_init (&charbuf.scratch);
 
@@ -381,6 +712,8 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
   while (*f != '\0')
     {
       unsigned int argpos;
+      const struct scanf_spec *spec;
+      struct scanf_spec spec_buf;
       /* Extract the next argument, which is of type TYPE.
 	 For a %N$... spec, this is the Nth argument from the beginning;
 	 otherwise it is the next argument after the state now in ARG.  */
@@ -475,162 +808,73 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	  continue;
 	}
 
-      /* This is the start of the conversion string. */
-      flags = 0;
-
-      /* Initialize state of modifiers.  */
-      argpos = 0;
-
-      /* Prepare temporary buffer.  */
-      char_buffer_rewind (&charbuf);
-
-      /* Check for a positional parameter specification.  */
-      if (ISDIGIT (*f))
+      /* This is the start of the conversion string.  Use the
+	 specification parsed by scanf_compile if there is one.  */
+      if (specs != NULL)
+	while (specs->start != NULL && specs->start < f - 1)
+	  ++specs;
+      if (specs != NULL && specs->start == f - 1)
+	spec = specs++;
+      else
 	{
-	  argpos = read_int (&f);
-	  if (*f == L_('$'))
-	    ++f;
-	  else
-	    {
-	      /* Oops; that was actually the field width.  */
-	      width = argpos;
-	      argpos = 0;
-	      goto got_width;
-	    }
+	  parse_spec (f - 1, &spec_buf, mode_flags);
+	  spec = &spec_buf;
 	}
-
-      /* Check for the assignment-suppressing, the number grouping flag,
-	 and the signal to use the locale's digit representation.  */
-      while (*f == L_('*') || *f == L_('\'') || *f == L_('I'))
-	switch (*f++)
-	  {
-	  case L_('*'):
-	    flags |= SUPPRESS;
-	    break;
-	  case L_('\''):
+      f = spec->next;
+      argpos = spec->argpos;
+      width = spec->width;
+      flags = spec->flags;
 #ifdef COMPILE_WSCANF
-	    if (thousands != L'\0')
+      if (thousands == L'\0')
 #else
-	    if (thousands != NULL)
+      if (thousands == NULL)
 #endif
-	      flags |= GROUP;
-	    break;
-	  case L_('I'):
-	    flags |= I18N;
-	    break;
-	  }
-
-      /* Find the maximum field width.  */
-      width = 0;
-      if (ISDIGIT (*f))
-	width = read_int (&f);
-    got_width:
-      if (width == 0)
-	width = -1;
+	flags &= ~GROUP;
 
-      /* Check for type modifiers.  */
-      switch (*f++)
-	{
-	case L_('h'):
-	  /* ints are short ints or chars.  */
-	  if (*f == L_('h'))
-	    {
-	      ++f;
-	      flags |= CHAR;
-	    }
-	  else
-	    flags |= SHORT;
-	  break;
-	case L_('l'):
-	  if (*f == L_('l'))
-	    {
-	      /* A double `l' is equivalent to an `L'.  */
-	      ++f;
-	      flags |= LONGDBL | LONG;
-	    }
-	  else
-	    /* ints are long ints.  */
-	    flags |= LONG;
-	  break;
-	case L_('q'):
-	case L_('L'):
-	  /* doubles are long doubles, and ints are long long ints.  */
-	  flags |= LONGDBL | LONG;
-	  break;
-	case L_('a'):
-	  /* The `a' is used as a flag only if followed by `s', `S' or
-	     `['.  */
-	  if (*f != L_('s') && *f != L_('S') && *f != L_('['))
-	    {
-	      --f;
-	      break;
-	    }
-	  /* In __isoc99_*scanf %as, %aS and %a[ extension is not
-	     supported at all.  */
-	  if (__glibc_likely ((mode_flags & SCANF_ISOC99_A) != 0))
-	    {
-	      --f;
-	      break;
-	    }
-	  /* String conversions (%s, %[) take a `char **'
-	     arg and fill it in with a malloc'd pointer.  */
-	  flags |= GNU_MALLOC;
-	  break;
-	case L_('m'):
-	  flags |= POSIX_MALLOC;
-	  if (*f == L_('l'))
-	    {
-	      ++f;
-	      flags |= LONG;
-	    }
-	  break;
-	case L_('z'):
-	  if (need_longlong && sizeof (size_t) > sizeof (unsigned long int))
-	    flags |= LONGDBL;
-	  else if (sizeof (size_t) > sizeof (unsigned int))
-	    flags |= LONG;
-	  break;
-	case L_('j'):
-	  if (need_longlong && sizeof (uintmax_t) > sizeof (unsigned long int))
-	    flags |= LONGDBL;
-	  else if (sizeof (uintmax_t) > sizeof (unsigned int))
-	    flags |= LONG;
-	  break;
-	case L_('t'):
-	  if (need_longlong && sizeof (ptrdiff_t) > sizeof (long int))
-	    flags |= LONGDBL;
-	  else if (sizeof (ptrdiff_t) > sizeof (int))
-	    flags |= LONG;
-	  break;
-	default:
-	  /* Not a recognized modifier.  Backup.  */
-	  --f;
-	  break;
-	}
+      /* Prepare temporary buffer.  */
+      char_buffer_rewind (&charbuf);
 
       /* End of the format string?  */
-      if (__glibc_unlikely (*f == L_('\0')))
+      if (__glibc_unlikely (spec->conv == L_('\0')))
 	conv_error ();
 
       /* Find the conversion specifier.  */
-      fc = *f++;
+      fc = spec->conv;
       if (skip_space || (fc != L_('[') && fc != L_('c')
 			 && fc != L_('C') && fc != L_('n')))
 	{
-	  /* Eat whitespace.  */
-	  int save_errno = errno;
-	  __set_errno (0);
-	  do
-	    /* We add the additional test for EOF here since otherwise
-	       inchar will restore the old errno value which might be
-	       EINTR but does not indicate an interrupt since nothing
-	       was read at this time.  */
-	    if (__builtin_expect ((c == EOF || inchar () == EOF)
-				  && errno == EINTR, 0))
-	      input_error ();
-	  while (ISSPACE (c));
-	  __set_errno (save_errno);
-	  ungetc (c, s);
+#ifndef COMPILE_WSCANF
+	  /* Skip the white space in the buffer of the stream directly.
+	     If another character follows there, it is the one the loop
+	     below would read and push back.  */
+	  if (c != EOF)
+	    {
+	      const char *p = s->_IO_read_ptr;
+	      while (p < s->_IO_read_end && ISSPACE ((unsigned char) *p))
+		++p;
+	      read_in += p - s->_IO_read_ptr;
+	      s->_IO_read_ptr = (char *) p;
+	    }
+	  if (c != EOF && s->_IO_read_ptr < s->_IO_read_end)
+	    c = (unsigned char) *s->_IO_read_ptr;
+	  else
+#endif
+	    {
+	      /* Eat whitespace.  */
+	      int save_errno = errno;
+	      __set_errno (0);
+	      do
+		/* We add the additional test for EOF here since otherwise
+		   inchar will restore the old errno value which might be
+		   EINTR but does not indicate an interrupt since nothing
+		   was read at this time.  */
+		if (__builtin_expect ((c == EOF || inchar () == EOF)
+				      && errno == EINTR, 0))
+		  input_error ();
+	      while (ISSPACE (c));
+	      __set_errno (save_errno);
+	      ungetc (c, s);
+	    }
 	  skip_space = 0;
 	}
 
@@ -1395,6 +1639,41 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	  flags |= NUMBER_SIGNED;
 
 	number:
+#ifndef COMPILE_WSCANF
+	  if (width == -1 && (flags & (GROUP | I18N)) == 0 && c != EOF)
+	    {
+	      const char *p = s->_IO_read_ptr;
+	      const char *q = scan_integer (p, direct_end (s), &base);
+	      if (q != NULL)
+		{
+		  read_in += q - p;
+		  s->_IO_read_ptr = (char *) q;
+		  c = (unsigned char) *q;
+
+		  /* Decimal numbers which are too short to overflow are
+		     converted right here.  */
+		  const char *digits = p + (*p == '-' || *p == '+');
+		  if (base == 10
+		      && q - digits <= ((need_longlong && (flags & LONGDBL))
+					|| sizeof (long int) == 8 ? 18 : 9))
+		    {
+		      uint64_t v = 0;
+		      for (; digits < q; ++digits)
+			v = v * 10 + (*digits - '0');
+		      if (*p == '-')
+			v = -v;
+		      if (need_longlong && (flags & LONGDBL))
+			num.uq = v;
+		      else
+			num.ul = v;
+		      goto store_number;
+		    }
+
+		  numstart = (char *) p;
+		  goto convert_number;
+		}
+	    }
+#endif
 	  c = inchar ();
 	  if (__glibc_unlikely (c == EOF))
 	    input_error ();
@@ -1847,26 +2126,31 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	      done = EOF;
 	      goto errout;
 	    }
+	  numstart = char_buffer_start (&charbuf);
+#ifndef COMPILE_WSCANF
+	convert_number:
+#endif
 	  if (need_longlong && (flags & LONGDBL))
 	    {
 	      if (flags & NUMBER_SIGNED)
-		num.q = __strtoll_internal
-		  (char_buffer_start (&charbuf), &tw, base, flags & GROUP);
+		num.q = __strtoll_internal (numstart, &tw, base, flags & GROUP);
 	      else
-		num.uq = __strtoull_internal
-		  (char_buffer_start (&charbuf), &tw, base, flags & GROUP);
+		num.uq = __strtoull_internal (numstart, &tw, base,
+					      flags & GROUP);
 	    }
 	  else
 	    {
 	      if (flags & NUMBER_SIGNED)
-		num.l = __strtol_internal
-		  (char_buffer_start (&charbuf), &tw, base, flags & GROUP);
+		num.l = __strtol_internal (numstart, &tw, base, flags & GROUP);
 	      else
-		num.ul = __strtoul_internal
-		  (char_buffer_start (&charbuf), &tw, base, flags & GROUP);
+		num.ul = __strtoul_internal (numstart, &tw, base,
+					     flags & GROUP);
 	    }
-	  if (__glibc_unlikely (char_buffer_start (&charbuf) == tw))
+	  if (__glibc_unlikely (numstart == tw))
 	    conv_error ();
+#ifndef COMPILE_WSCANF
+	store_number:
+#endif
 
 	  if (!(flags & SUPPRESS))
 	    {
@@ -1909,6 +2193,22 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	case L_('G'):
 	case L_('a'):
 	case L_('A'):
+#ifndef COMPILE_WSCANF
+	  if (width == -1 && (flags & (GROUP | I18N)) == 0 && c != EOF
+	      && decimal[0] != '\0' && decimal[1] == '\0')
+	    {
+	      const char *p = s->_IO_read_ptr;
+	      const char *q = scan_float (p, direct_end (s), decimal[0]);
+	      if (q != NULL)
+		{
+		  read_in += q - p;
+		  s->_IO_read_ptr = (char *) q;
+		  c = (unsigned char) *q;
+		  numstart = (char *) p;
+		  goto convert_float;
+		}
+	    }
+#endif
 	  c = inchar ();
 	  if (width > 0)
 	    --width;
@@ -2424,13 +2724,17 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	      done = EOF;
 	      goto errout;
 	    }
+	  numstart = char_buffer_start (&charbuf);
+#ifndef COMPILE_WSCANF
+	convert_float:
+#endif
 #if __HAVE_FLOAT128_UNLIKE_LDBL
 	  if ((flags & LONGDBL) \
 	       && (mode_flags & SCANF_LDBL_USES_FLOAT128) != 0)
 	    {
 	      _Float128 d = __strtof128_internal
-		(char_buffer_start (&charbuf), &tw, flags & GROUP);
-	      if (!(flags & SUPPRESS) && tw != char_buffer_start (&charbuf))
+		(numstart, &tw, flags & GROUP);
+	      if (!(flags & SUPPRESS) && tw != numstart)
 		*ARG (_Float128 *) = d;
 	    }
 	  else
@@ -2439,26 +2743,26 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	      && __glibc_likely ((mode_flags & SCANF_LDBL_IS_DBL) == 0))
 	    {
 	      long double d = __strtold_internal
-		(char_buffer_start (&charbuf), &tw, flags & GROUP);
-	      if (!(flags & SUPPRESS) && tw != char_buffer_start (&charbuf))
+		(numstart, &tw, flags & GROUP);
+	      if (!(flags & SUPPRESS) && tw != numstart)
 		*ARG (long double *) = d;
 	    }
 	  else if (flags & (LONG | LONGDBL))
 	    {
 	      double d = __strtod_internal
-		(char_buffer_start (&charbuf), &tw, flags & GROUP);
-	      if (!(flags & SUPPRESS) && tw != char_buffer_start (&charbuf))
+		(numstart, &tw, flags & GROUP);
+	      if (!(flags & SUPPRESS) && tw != numstart)
 		*ARG (double *) = d;
 	    }
 	  else
 	    {
 	      float d = __strtof_internal
-		(char_buffer_start (&charbuf), &tw, flags & GROUP);
-	      if (!(flags & SUPPRESS) && tw != char_buffer_start (&charbuf))
+		(numstart, &tw, flags & GROUP);
+	      if (!(flags & SUPPRESS) && tw != numstart)
 		*ARG (float *) = d;
 	    }
 
-	  if (__glibc_unlikely (tw == char_buffer_start (&charbuf)))
+	  if (__glibc_unlikely (tw == numstart))
 	    conv_error ();
 
 	  if (!(flags & SUPPRESS))
@@ -2471,6 +2775,7 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	  else
 	    STRING_ARG (str, char, 100);
 
+#ifdef COMPILE_WSCANF
 	  if (*f == L_('^'))
 	    {
 	      ++f;
@@ -2479,8 +2784,6 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	  else
 	    not_in = 0;
 
-
-#ifdef COMPILE_WSCANF
 	  /* Find the beginning and the end of the scanlist.  We are not
 	     creating a lookup table since it would have to be too large.
 	     Instead we search each time through the string.  This is not
@@ -2497,40 +2800,36 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 	    conv_error ();
 	  wchar_t *twend = (wchar_t *) f - 1;
 #else
-	  /* Fill WP with byte flags indexed by character.
-	     We will use this flag map for matching input characters.  */
-	  if (!scratch_buffer_set_array_size
-	      (&charbuf.scratch, UCHAR_MAX + 1, 1))
+	  if (spec->set != NULL)
 	    {
-	      done = EOF;
-	      goto errout;
+	      /* The scanlist has been parsed by scanf_compile.  */
+	      not_in = spec->not_in;
+	      charset = spec->set;
 	    }
-	  memset (charbuf.scratch.data, '\0', UCHAR_MAX + 1);
-
-	  fc = *f;
-	  if (fc == ']' || fc == '-')
+	  else
 	    {
-	      /* If ] or - appears before any char in the set, it is not
-		 the terminator or separator, but the first char in the
-		 set.  */
-	      ((char *)charbuf.scratch.data)[fc] = 1;
-	      ++f;
-	    }
-
-	  while ((fc = *f++) != '\0' && fc != ']')
-	    if (fc == '-' && *f != '\0' && *f != ']' && f[-2] <= *f)
-	      {
-		/* Add all characters from the one before the '-'
-		   up to (but not including) the next format char.  */
-		for (fc = f[-2]; fc < *f; ++fc)
-		  ((char *)charbuf.scratch.data)[fc] = 1;
-	      }
-	    else
-	      /* Add the character to the flag map.  */
-	      ((char *)charbuf.scratch.data)[fc] = 1;
+	      if (*f == '^')
+		{
+		  ++f;
+		  not_in = 1;
+		}
+	      else
+		not_in = 0;
 
-	  if (__glibc_unlikely (fc == '\0'))
-	    conv_error();
+	      /* Fill the scratch buffer with byte flags indexed by
+		 character.  We will use this flag map for matching input
+		 characters.  */
+	      if (!scratch_buffer_set_array_size
+		  (&charbuf.scratch, UCHAR_MAX + 1, 1))
+		{
+		  done = EOF;
+		  goto errout;
+		}
+	      f = fill_scanlist (f, charbuf.scratch.data);
+	      if (__glibc_unlikely (f == NULL))
+		conv_error ();
+	      charset = charbuf.scratch.data;
+	    }
 #endif
 
 	  if (flags & LONG)
@@ -2656,7 +2955,7 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 
 	      do
 		{
-		  if (((char *) charbuf.scratch.data)[c] == not_in)
+		  if (charset[c] == not_in)
 		    {
 		      ungetc_not_eof (c, s);
 		      break;
@@ -2884,7 +3183,7 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 #else
 	      do
 		{
-		  if (((char *) charbuf.scratch.data)[c] == not_in)
+		  if (charset[c] == not_in)
 		    {
 		      ungetc_not_eof (c, s);
 		      break;
@@ -3050,3 +3349,134 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
     }
   return done;
 }
+
+#ifdef COMPILE_WSCANF
+int
+__vfwscanf_internal (FILE *s, const wchar_t *format, va_list argptr,
+		     unsigned int mode_flags)
+{
+  return vfscanf_run (s, format, NULL, argptr, mode_flags);
+}
+#else
+int
+__vfscanf_internal (FILE *s, const char *format, va_list argptr,
+		    unsigned int mode_flags)
+{
+  return vfscanf_run (s, format, NULL, argptr, mode_flags);
+}
+
+/* The compiled format strings use the ISO C99 meaning of %a.  */
+int
+__vfscanf_compiled_internal (FILE *s, const struct scanf_compiled *cf,
+			     va_list argptr, unsigned int mode_flags)
+{
+  return vfscanf_run (s, cf->format, cf->specs, argptr,
+		      mode_flags | SCANF_ISOC99_A);
+}
+
+/* Parse the conversion specifications of FORMAT the way vfscanf_run
+   finds them, and store them in SPECS and the flag maps of their
+   scanlists in SETS, unless SPECS is NULL.  Return the number of
+   specifications and store the number of scanlists in *NSETS.  */
+static size_t
+parse_format (const char *format, struct scanf_spec *specs, char *sets,
+	      size_t *nsets)
+{
+  const unsigned char *f = (const unsigned char *) format;
+  struct scanf_spec spec;
+  mbstate_t state;
+  char table[UCHAR_MAX + 1];
+  size_t nspecs = 0;
+
+  *nsets = 0;
+  memset (&state, '\0', sizeof (state));
+  while (*f != '\0')
+    {
+      if (!isascii (*f))
+	{
+	  int len = __mbrlen ((const char *) f, strlen ((const char *) f),
+			      &state);
+	  if (len > 0)
+	    {
+	      f += len;
+	      continue;
+	    }
+	}
+
+      if (*f++ != '%')
+	continue;
+
+      parse_spec (f - 1, &spec, SCANF_ISOC99_A);
+      f = spec.next;
+      if (spec.conv == '[')
+	{
+	  spec.not_in = *f == '^';
+	  f = fill_scanlist (f + spec.not_in, table);
+	  if (f == NULL)
+	    /* The conversion fails, so the rest of the format string is
+	       never used.  */
+	    break;
+	  spec.next = f;
+	  if (specs != NULL)
+	    {
+	      spec.set = memcpy (sets, table, sizeof (table));
+	      sets += sizeof (table);
+	    }
+	  ++*nsets;
+	}
+      if (specs != NULL)
+	specs[nspecs] = spec;
+      ++nspecs;
+      if (spec.conv == '\0')
+	break;
+    }
+
+  return nspecs;
+}
+
+struct scanf_compiled *
+scanf_compile (const char *format)
+{
+  size_t format_size = strlen (format) + 1;
+  size_t nsets;
+
+  /* Count the conversion specifications first, so that everything fits
+     into a single allocation.  */
+  size_t nspecs = parse_format (format, NULL, NULL, &nsets);
+
+  size_t size;
+  if (__builtin_mul_overflow (nsets, UCHAR_MAX + 1, &size)
+      || __builtin_add_overflow (size, format_size, &size)
+      || __builtin_add_overflow (size, (sizeof (struct scanf_compiled)
+					+ ((nspecs + 1)
+					   * sizeof (struct scanf_spec))),
+				 &size))
+    {
+      __set_errno (ENOMEM);
+      return NULL;
+    }
+
+  struct scanf_compiled *cf = malloc (size);
+  if (cf == NULL)
+    return NULL;
+
+  struct scanf_spec *specs = (struct scanf_spec *) (cf + 1);
+  char *sets = (char *) (specs + nspecs + 1);
+  char *copy = sets + nsets * (UCHAR_MAX + 1);
+  memcpy (copy, format, format_size);
+  cf->format = copy;
+  cf->specs = specs;
+
+  /* Parse the copy, so that the specifications point into it.  */
+  nspecs = parse_format (copy, specs, sets, &nsets);
+  specs[nspecs].start = NULL;
+
+  return cf;
+}
+
+void
+scanf_compiled_free (struct scanf_compiled *cf)
+{
+  free (cf);
+}
+#endif
@@ -0,0 +1,441 @@
+/* Fast binary to decimal conversion of float and double values.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <ieee754.h>
+#include <stdint.h>
+#include <stdlib/grisu.h>
+
+/* A floating-point number F * 2^E with a 64-bit significand and
+   unlimited exponent range ("do-it-yourself floating point").  */
+struct diy_fp
+{
+  uint64_t f;
+  int e;
+};
+
+/* The scaled value W * 10^K is generated with its binary exponent in
+   this range, so that the integral part fits into 32 bits and there are
+   enough fraction bits to generate digits one at a time.  */
+#define MIN_TARGET_EXP	-60
+#define MAX_TARGET_EXP	-32
+
+/* Normalized approximations of 10^K for K = -348, -340, ..., 340,
+   rounded to nearest.  The step of eight decimal exponents is less than
+   the 28 binary exponents wide target range.  */
+static const struct
+{
+  uint64_t f;
+  int16_t e;
+  int16_t k;
+} cached_powers[] =
+  {
+  { 0xfa8fd5a0081c0288ULL, -1220, -348 },
+  { 0xbaaee17fa23ebf76ULL, -1193, -340 },
+  { 0x8b16fb203055ac76ULL, -1166, -332 },
+  { 0xcf42894a5dce35eaULL, -1140, -324 },
+  { 0x9a6bb0aa55653b2dULL, -1113, -316 },
+  { 0xe61acf033d1a45dfULL, -1087, -308 },
+  { 0xab70fe17c79ac6caULL, -1060, -300 },
+  { 0xff77b1fcbebcdc4fULL, -1034, -292 },
+  { 0xbe5691ef416bd60cULL, -1007, -284 },
+  { 0x8dd01fad907ffc3cULL, -980, -276 },
+  { 0xd3515c2831559a83ULL, -954, -268 },
+  { 0x9d71ac8fada6c9b5ULL, -927, -260 },
+  { 0xea9c227723ee8bcbULL, -901, -252 },
+  { 0xaecc49914078536dULL, -874, -244 },
+  { 0x823c12795db6ce57ULL, -847, -236 },
+  { 0xc21094364dfb5637ULL, -821, -228 },
+  { 0x9096ea6f3848984fULL, -794, -220 },
+  { 0xd77485cb25823ac7ULL, -768, -212 },
+  { 0xa086cfcd97bf97f4ULL, -741, -204 },
+  { 0xef340a98172aace5ULL, -715, -196 },
+  { 0xb23867fb2a35b28eULL, -688, -188 },
+  { 0x84c8d4dfd2c63f3bULL, -661, -180 },
+  { 0xc5dd44271ad3cdbaULL, -635, -172 },
+  { 0x936b9fcebb25c996ULL, -608, -164 },
+  { 0xdbac6c247d62a584ULL, -582, -156 },
+  { 0xa3ab66580d5fdaf6ULL, -555, -148 },
+  { 0xf3e2f893dec3f126ULL, -529, -140 },
+  { 0xb5b5ada8aaff80b8ULL, -502, -132 },
+  { 0x87625f056c7c4a8bULL, -475, -124 },
+  { 0xc9bcff6034c13053ULL, -449, -116 },
+  { 0x964e858c91ba2655ULL, -422, -108 },
+  { 0xdff9772470297ebdULL, -396, -100 },
+  { 0xa6dfbd9fb8e5b88fULL, -369, -92 },
+  { 0xf8a95fcf88747d94ULL, -343, -84 },
+  { 0xb94470938fa89bcfULL, -316, -76 },
+  { 0x8a08f0f8bf0f156bULL, -289, -68 },
+  { 0xcdb02555653131b6ULL, -263, -60 },
+  { 0x993fe2c6d07b7facULL, -236, -52 },
+  { 0xe45c10c42a2b3b06ULL, -210, -44 },
+  { 0xaa242499697392d3ULL, -183, -36 },
+  { 0xfd87b5f28300ca0eULL, -157, -28 },
+  { 0xbce5086492111aebULL, -130, -20 },
+  { 0x8cbccc096f5088ccULL, -103, -12 },
+  { 0xd1b71758e219652cULL, -77, -4 },
+  { 0x9c40000000000000ULL, -50, 4 },
+  { 0xe8d4a51000000000ULL, -24, 12 },
+  { 0xad78ebc5ac620000ULL, 3, 20 },
+  { 0x813f3978f8940984ULL, 30, 28 },
+  { 0xc097ce7bc90715b3ULL, 56, 36 },
+  { 0x8f7e32ce7bea5c70ULL, 83, 44 },
+  { 0xd5d238a4abe98068ULL, 109, 52 },
+  { 0x9f4f2726179a2245ULL, 136, 60 },
+  { 0xed63a231d4c4fb27ULL, 162, 68 },
+  { 0xb0de65388cc8ada8ULL, 189, 76 },
+  { 0x83c7088e1aab65dbULL, 216, 84 },
+  { 0xc45d1df942711d9aULL, 242, 92 },
+  { 0x924d692ca61be758ULL, 269, 100 },
+  { 0xda01ee641a708deaULL, 295, 108 },
+  { 0xa26da3999aef774aULL, 322, 116 },
+  { 0xf209787bb47d6b85ULL, 348, 124 },
+  { 0xb454e4a179dd1877ULL, 375, 132 },
+  { 0x865b86925b9bc5c2ULL, 402, 140 },
+  { 0xc83553c5c8965d3dULL, 428, 148 },
+  { 0x952ab45cfa97a0b3ULL, 455, 156 },
+  { 0xde469fbd99a05fe3ULL, 481, 164 },
+  { 0xa59bc234db398c25ULL, 508, 172 },
+  { 0xf6c69a72a3989f5cULL, 534, 180 },
+  { 0xb7dcbf5354e9beceULL, 561, 188 },
+  { 0x88fcf317f22241e2ULL, 588, 196 },
+  { 0xcc20ce9bd35c78a5ULL, 614, 204 },
+  { 0x98165af37b2153dfULL, 641, 212 },
+  { 0xe2a0b5dc971f303aULL, 667, 220 },
+  { 0xa8d9d1535ce3b396ULL, 694, 228 },
+  { 0xfb9b7cd9a4a7443cULL, 720, 236 },
+  { 0xbb764c4ca7a44410ULL, 747, 244 },
+  { 0x8bab8eefb6409c1aULL, 774, 252 },
+  { 0xd01fef10a657842cULL, 800, 260 },
+  { 0x9b10a4e5e9913129ULL, 827, 268 },
+  { 0xe7109bfba19c0c9dULL, 853, 276 },
+  { 0xac2820d9623bf429ULL, 880, 284 },
+  { 0x80444b5e7aa7cf85ULL, 907, 292 },
+  { 0xbf21e44003acdd2dULL, 933, 300 },
+  { 0x8e679c2f5e44ff8fULL, 960, 308 },
+  { 0xd433179d9c8cb841ULL, 986, 316 },
+  { 0x9e19db92b4e31ba9ULL, 1013, 324 },
+  { 0xeb96bf6ebadf77d9ULL, 1039, 332 },
+  { 0xaf87023b9bf0ee6bULL, 1066, 340 }
+  };
+#define CACHED_POWERS_OFFSET	348
+#define CACHED_POWERS_STEP	8
+
+/* Return X * Y rounded to 64 bits.  The error is at most half a unit in
+   the last place.  */
+static struct diy_fp
+diy_mul (struct diy_fp x, struct diy_fp y)
+{
+  uint64_t a = x.f >> 32;
+  uint64_t b = x.f & 0xffffffff;
+  uint64_t c = y.f >> 32;
+  uint64_t d = y.f & 0xffffffff;
+  uint64_t ac = a * c;
+  uint64_t bc = b * c;
+  uint64_t ad = a * d;
+  uint64_t bd = b * d;
+  uint64_t tmp = (bd >> 32) + (ad & 0xffffffff) + (bc & 0xffffffff);
+  /* Round to nearest.  */
+  tmp += 1U << 31;
+  return (struct diy_fp) { ac + (ad >> 32) + (bc >> 32) + (tmp >> 32),
+			   x.e + y.e + 64 };
+}
+
+static struct diy_fp
+diy_normalize (struct diy_fp x)
+{
+  int shift = __builtin_clzll (x.f);
+  return (struct diy_fp) { x.f << shift, x.e - shift };
+}
+
+/* Return the cached power of ten 10^*K which scales a normalized
+   number with exponent E into the target range.  */
+static struct diy_fp
+cached_power (int e, int *k)
+{
+  /* X * 78913 / 2^18 approximates X * log10(2); the quotient rounded
+     up is the smallest decimal exponent which reaches the target.  */
+  int x = MIN_TARGET_EXP - (e + 64) + 63;
+  int dk = -((-x * 78913) >> 18);
+  int index = (CACHED_POWERS_OFFSET + dk - 1) / CACHED_POWERS_STEP + 1;
+  *k = cached_powers[index].k;
+  return (struct diy_fp) { cached_powers[index].f, cached_powers[index].e };
+}
+
+/* Return the number of decimal digits of N, which is not zero, and
+   store the largest power of ten not exceeding N into *POWER.  */
+static int
+biggest_power_ten (uint32_t n, uint32_t *power)
+{
+  uint32_t p = 1;
+  int digits = 1;
+  while (n / 10 >= p)
+    {
+      p *= 10;
+      ++digits;
+    }
+  *power = p;
+  return digits;
+}
+
+/* Decompose VALUE, a finite positive double, into an integer significand
+   and a binary exponent.  Set *LOWER_CLOSER if the next smaller
+   representable number is closer than the next larger one, which is
+   the case for normalized powers of two.  */
+static struct diy_fp
+dbl_to_diy (double value, bool *lower_closer)
+{
+  union ieee754_double u = { .d = value };
+  uint64_t f = ((uint64_t) u.ieee.mantissa0 << 32) | u.ieee.mantissa1;
+  *lower_closer = f == 0 && u.ieee.exponent > 1;
+  if (u.ieee.exponent != 0)
+    return (struct diy_fp) { f | (1ULL << 52),
+			     u.ieee.exponent - IEEE754_DOUBLE_BIAS - 52 };
+  return (struct diy_fp) { f, 1 - IEEE754_DOUBLE_BIAS - 52 };
+}
+
+static struct diy_fp
+flt_to_diy (float value, bool *lower_closer)
+{
+  union ieee754_float u = { .f = value };
+  uint64_t f = u.ieee.mantissa;
+  *lower_closer = f == 0 && u.ieee.exponent > 1;
+  if (u.ieee.exponent != 0)
+    return (struct diy_fp) { f | (1ULL << 23),
+			     u.ieee.exponent - IEEE754_FLOAT_BIAS - 23 };
+  return (struct diy_fp) { f, 1 - IEEE754_FLOAT_BIAS - 23 };
+}
+
+/* Round the counted digits in DIGITS (LEN of them) according to REST,
+   the remainder below the last digit in units of TEN_KAPPA, which is
+   known only up to an error of UNIT.  Return the number of digits, or
+   zero if the direction of rounding cannot be determined.  */
+static int
+round_weed_counted (char *digits, int len, uint64_t rest,
+		    uint64_t ten_kappa, uint64_t unit)
+{
+  /* The tests are ordered so that none of them can overflow.  If the
+     error is half of TEN_KAPPA or more the rounding is unknowable.  */
+  if (unit >= ten_kappa || ten_kappa - unit <= unit)
+    return 0;
+
+  /* If 2 * (REST + UNIT) <= TEN_KAPPA we can safely round down.  */
+  if (ten_kappa - rest > rest && ten_kappa - 2 * rest >= 2 * unit)
+    return len;
+
+  /* If 2 * (REST - UNIT) >= TEN_KAPPA we can safely round up.  */
+  if (rest > unit && ten_kappa - (rest - unit) <= rest - unit)
+    {
+      int i = len - 1;
+      while (i > 0 && digits[i] == '9')
+	digits[i--] = '0';
+      if (digits[i] != '9')
+	++digits[i];
+      else
+	{
+	  /* All digits were nines.  Keep the position of the last digit
+	     and add a new leading one instead.  */
+	  digits[0] = '1';
+	  digits[len++] = '0';
+	}
+      return len;
+    }
+
+  /* Too close to a tie to decide.  */
+  return 0;
+}
+
+int
+__grisu_fixed (double value, int ndigits, char *digits, int *exp10)
+{
+  bool lower_closer;
+  struct diy_fp w = diy_normalize (dbl_to_diy (value, &lower_closer));
+  int k;
+  struct diy_fp c = cached_power (w.e, &k);
+  w = diy_mul (w, c);
+
+  /* W is now within one unit of VALUE * 10^K.  Split it into integral
+     and fractional part.  */
+  uint64_t one = 1ULL << -w.e;
+  uint64_t unit = 1;
+  uint32_t integrals = w.f >> -w.e;
+  uint64_t fractionals = w.f & (one - 1);
+  uint32_t divisor;
+  int kappa = biggest_power_ten (integrals, &divisor);
+  int len = 0;
+
+  while (kappa > 0)
+    {
+      digits[len++] = '0' + integrals / divisor;
+      integrals %= divisor;
+      --kappa;
+      if (len == ndigits)
+	{
+	  *exp10 = kappa - k;
+	  return round_weed_counted (digits, len,
+				     ((uint64_t) integrals << -w.e)
+				     + fractionals,
+				     (uint64_t) divisor << -w.e, unit);
+	}
+      divisor /= 10;
+    }
+
+  while (len < ndigits)
+    {
+      /* Once the error exceeds the remainder the digits are garbage.  */
+      if (fractionals <= unit)
+	return 0;
+      fractionals *= 10;
+      unit *= 10;
+      digits[len++] = '0' + (fractionals >> -w.e);
+      fractionals &= one - 1;
+      --kappa;
+    }
+  *exp10 = kappa - k;
+  return round_weed_counted (digits, len, fractionals, one, unit);
+}
+
+/* Adjust the last generated digit of a shortest conversion so that it
+   is closest to the real value W, and check that the result is within
+   the rounding interval.  DISTANCE_TOO_HIGH_W is the distance of W from
+   the upper end of the unsafe interval, REST the distance of the
+   digits from that end and TEN_KAPPA the value of the last digit.  All
+   of these are known up to an error of UNIT.  */
+static bool
+round_weed (char *digits, int len, uint64_t distance_too_high_w,
+	    uint64_t unsafe_interval, uint64_t rest, uint64_t ten_kappa,
+	    uint64_t unit)
+{
+  uint64_t small_distance = distance_too_high_w - unit;
+  uint64_t big_distance = distance_too_high_w + unit;
+
+  /* Move the digits towards the smallest possible W while that gets
+     them closer.  */
+  while (rest < small_distance
+	 && unsafe_interval - rest >= ten_kappa
+	 && (rest + ten_kappa < small_distance
+	     || small_distance - rest >= rest + ten_kappa - small_distance))
+    {
+      --digits[len - 1];
+      rest += ten_kappa;
+    }
+
+  /* If another step would get closer to the largest possible W, we
+     cannot tell which of the two candidates is the right one.  */
+  if (rest < big_distance
+      && unsafe_interval - rest >= ten_kappa
+      && (rest + ten_kappa < big_distance
+	  || big_distance - rest > rest + ten_kappa - big_distance))
+    return false;
+
+  /* Make sure the result is safely inside the rounding interval.  */
+  return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+/* Generate the shortest digits of the value W, whose rounding interval
+   is LOW to HIGH.  All three have been scaled into the target range and
+   are known up to one unit.  */
+static int
+digit_gen (struct diy_fp low, struct diy_fp w, struct diy_fp high,
+	   char *digits, int *kappa_out)
+{
+  uint64_t unit = 1;
+  /* Everything in the unsafe interval might be inside the real
+     rounding interval.  */
+  uint64_t too_low = low.f - unit;
+  uint64_t too_high = high.f + unit;
+  uint64_t unsafe_interval = too_high - too_low;
+  uint64_t one = 1ULL << -w.e;
+  uint32_t integrals = too_high >> -w.e;
+  uint64_t fractionals = too_high & (one - 1);
+  uint32_t divisor;
+  int kappa = biggest_power_ten (integrals, &divisor);
+  int len = 0;
+
+  while (kappa > 0)
+    {
+      digits[len++] = '0' + integrals / divisor;
+      integrals %= divisor;
+      --kappa;
+      uint64_t rest = ((uint64_t) integrals << -w.e) + fractionals;
+      if (rest < unsafe_interval)
+	{
+	  *kappa_out = kappa;
+	  return round_weed (digits, len, too_high - w.f, unsafe_interval,
+			     rest, (uint64_t) divisor << -w.e, unit)
+		 ? len : 0;
+	}
+      divisor /= 10;
+    }
+
+  while (true)
+    {
+      fractionals *= 10;
+      unit *= 10;
+      unsafe_interval *= 10;
+      digits[len++] = '0' + (fractionals >> -w.e);
+      fractionals &= one - 1;
+      --kappa;
+      if (fractionals < unsafe_interval)
+	{
+	  *kappa_out = kappa;
+	  return round_weed (digits, len, (too_high - w.f) * unit,
+			     unsafe_interval, fractionals, one, unit)
+		 ? len : 0;
+	}
+    }
+}
+
+static int
+shortest (struct diy_fp v, bool lower_closer, char *digits, int *exp10)
+{
+  /* The boundaries are halfway between V and its neighbors.  */
+  struct diy_fp plus
+    = diy_normalize ((struct diy_fp) { (v.f << 1) + 1, v.e - 1 });
+  struct diy_fp minus;
+  if (lower_closer)
+    minus = (struct diy_fp) { (v.f << 2) - 1, v.e - 2 };
+  else
+    minus = (struct diy_fp) { (v.f << 1) - 1, v.e - 1 };
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+  struct diy_fp w = diy_normalize (v);
+
+  int k;
+  struct diy_fp c = cached_power (w.e, &k);
+  int kappa;
+  int len = digit_gen (diy_mul (minus, c), diy_mul (w, c),
+		       diy_mul (plus, c), digits, &kappa);
+  *exp10 = kappa - k;
+  return len;
+}
+
+int
+__grisu_shortest (double value, char *digits, int *exp10)
+{
+  bool lower_closer;
+  struct diy_fp v = dbl_to_diy (value, &lower_closer);
+  return shortest (v, lower_closer, digits, exp10);
+}
+
+int
+__grisu_shortestf (float value, char *digits, int *exp10)
+{
+  bool lower_closer;
+  struct diy_fp v = flt_to_diy (value, &lower_closer);
+  return shortest (v, lower_closer, digits, exp10);
+}
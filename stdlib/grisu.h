@@ -0,0 +1,59 @@
+/* Fast binary to decimal conversion of float and double values.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _GRISU_H
+#define _GRISU_H	1
+
+#include <stdbool.h>
+
+/* These functions implement the Grisu3 algorithm by Florian Loitsch
+   ("Printing Floating-Point Numbers Quickly and Accurately with
+   Integers", PLDI 2010).  They only use 64-bit integer arithmetic and
+   keep track of the approximation error; whenever the error could
+   affect the result they give up, and the caller has to fall back to
+   an exact multi-precision conversion.  This happens for roughly 0.5%
+   of all inputs.
+
+   VALUE must be finite and strictly positive.  The digits are stored
+   as ASCII characters without a terminating null byte; the decimal
+   exponent *EXP10 is that of the last digit stored, i.e. the result is
+   DIGITS * 10^*EXP10.  */
+
+/* The maximum number of digits supported by __grisu_fixed.  */
+#define GRISU_FIXED_MAX_DIGITS	17
+
+/* Store into DIGITS the first NDIGITS (at most GRISU_FIXED_MAX_DIGITS)
+   significant decimal digits of VALUE correctly rounded to nearest.  If
+   the rounding carries into a new leading digit, NDIGITS + 1 digits are
+   stored (a one followed by NDIGITS zeros), so *EXP10 never depends on
+   the rounding.  Return the number of digits stored, or zero if the
+   result could not be determined, including exact ties.  */
+extern int __grisu_fixed (double value, int ndigits, char *digits,
+			  int *exp10) attribute_hidden;
+
+/* Store into DIGITS the shortest digit string which reads back as VALUE
+   when rounded to nearest, choosing the one closest to VALUE if there
+   are several.  DIGITS must have room for 17 characters (9 for the
+   float variant).  Return the number of digits, or zero if the result
+   could not be determined.  */
+extern int __grisu_shortest (double value, char *digits, int *exp10)
+     attribute_hidden;
+extern int __grisu_shortestf (float value, char *digits, int *exp10)
+     attribute_hidden;
+
+#endif /* grisu.h */
@@ -0,0 +1,88 @@
+/* Convert eight decimal digits at a time.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _PARSE_DIGITS_H
+#define _PARSE_DIGITS_H
+
+#include <endian.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* The eight bytes are loaded with one unaligned read, which must not
+   cross into a page that might not be mapped.  No target has pages
+   smaller than this.  */
+#define PARSE_DIGITS_PAGE_SIZE 4096
+
+/* Load the eight characters at S into *CHUNK, the first character in
+   the lowest byte, and return true if they are all decimal digits.
+   Otherwise return false.  S may point to fewer than eight characters
+   before the end of the string; the characters after the terminating
+   null byte are only read if they are on the same page.  */
+static inline bool
+load_eight_digits (const char *s, uint64_t *chunk)
+{
+  if (((uintptr_t) s & (PARSE_DIGITS_PAGE_SIZE - 1))
+      > PARSE_DIGITS_PAGE_SIZE - 8)
+    return false;
+
+  memcpy (chunk, s, sizeof (*chunk));
+#if __BYTE_ORDER == __BIG_ENDIAN
+  *chunk = __builtin_bswap64 (*chunk);
+#endif
+
+  /* A byte is a digit if its high nibble is 3, and it stays below 0x3a
+     when 6 is added to it.  */
+  return (((*chunk & 0xf0f0f0f0f0f0f0f0ULL)
+	   | (((*chunk + 0x0606060606060606ULL) & 0xf0f0f0f0f0f0f0f0ULL)
+	      >> 4))
+	  == 0x3333333333333333ULL);
+}
+
+/* Return true if S starts with at least eight decimal digits, under
+   the same conditions as load_eight_digits.  */
+static inline bool
+has_eight_digits (const char *s)
+{
+  uint64_t chunk;
+  return load_eight_digits (s, &chunk);
+}
+
+/* If the eight characters at S are all decimal digits, store their
+   value in *VALUE and return true.  Otherwise return false, under the
+   same conditions as load_eight_digits.  */
+static inline bool
+parse_eight_digits (const char *s, uint32_t *value)
+{
+  uint64_t chunk;
+  if (!load_eight_digits (s, &chunk))
+    return false;
+
+  /* Combine adjacent digits into pairs, then pairs into groups of four
+     and the two groups into the result.  The first character is in the
+     lowest byte.  */
+  chunk -= 0x3030303030303030ULL;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & 0x000000ff000000ffULL) * (100 + (1000000ULL << 32)))
+	   + (((chunk >> 16) & 0x000000ff000000ffULL)
+	      * (1 + (10000ULL << 32)))) >> 32;
+  *value = chunk;
+  return true;
+}
+
+#endif /* parse-digits.h */
@@ -24,17 +24,48 @@
 #include <ctype.h>
 #include "../libio/libioP.h"
 #include "../libio/strfile.h"
+#include <fenv.h>
+#include <float.h>
+#include <get-rounding-mode.h>
+#include <math.h>
 #include <printf.h>
+#include <stdbool.h>
 #include <string.h>
 #include <locale/localeinfo.h>
+#include <stdlib/grisu.h>
 
 #define UCHAR_T char
 #define L_(Str) Str
 #define ISDIGIT(Ch) isdigit (Ch)
 #include "stdio-common/printf-parse.h"
 
-int
-STRFROM (char *dest, size_t size, const char *format, FLOAT f)
+/* Single-precision values need to be stored in a double type, because
+   __printf_fp_l and __printf_fphex do not accept the float type.  */
+union fpnum
+{
+  double flt;
+  FLOAT value;
+};
+
+static void
+set_fpnum (union fpnum *fpnum, FLOAT f)
+{
+  /* Single-precision values need to be converted into double-precision,
+     because __printf_fp and __printf_fphex only accept double and long double
+     as the floating-point argument.  */
+  if (__builtin_types_compatible_p (FLOAT, float))
+    fpnum->flt = f;
+  else
+    fpnum->value = f;
+}
+
+/* Print the number at FPPTR as described by INFO into the SIZE bytes at
+   DEST.  If DIGITS is not NULL, print the NDIGITS digits at DIGITS
+   instead of converting the number, see __printf_fp_digits_l.  */
+static int
+print_to_string (char *dest, size_t size, locale_t loc,
+		 const struct printf_info *info, const void *fpptr,
+		 const char *digits, int ndigits, int exp10)
 {
   _IO_strnfile sfile;
 #ifdef _IO_MTSAFE_IO
@@ -43,27 +74,179 @@ STRFROM (char *dest, size_t size, const char *format, FLOAT f)
 
   int done;
 
-  /* Single-precision values need to be stored in a double type, because
-     __printf_fp_l and __printf_fphex do not accept the float type.  */
-  union {
-    double flt;
-    FLOAT value;
-  } fpnum;
+  /* The following code to prepare the virtual file has been adapted from the
+     function __vsnprintf_internal from libio.  */
+
+  if (size == 0)
+    {
+    /* When size is zero, nothing is written and dest may be a null pointer.
+       This is specified for snprintf in ISO/IEC 9899:2011, Section 7.21.6.5,
+       in the second paragraph.  Thus, if size is zero, prepare to use the
+       overflow buffer right from the start.  */
+      dest = sfile.overflow_buf;
+      size = sizeof (sfile.overflow_buf);
+    }
+
+  /* Prepare the virtual string file.  */
+  _IO_no_init (&sfile.f._sbf._f, _IO_USER_LOCK, -1, NULL, NULL);
+  _IO_JUMPS (&sfile.f._sbf) = &_IO_strn_jumps;
+  _IO_str_init_static_internal (&sfile.f, dest, size - 1, dest);
+
+  if (digits != NULL)
+    done = __printf_fp_digits_l (&sfile.f._sbf._f, loc, info, &fpptr,
+				 digits, ndigits, exp10);
+  else if (info->spec != 'a' && info->spec != 'A')
+    done = __printf_fp_l (&sfile.f._sbf._f, loc, info, &fpptr);
+  else
+    done = __printf_fphex (&sfile.f._sbf._f, info, &fpptr);
+
+  /* Terminate the string.  */
+  if (sfile.f._sbf._f._IO_buf_base != sfile.overflow_buf)
+    *sfile.f._sbf._f._IO_write_ptr = '\0';
+
+  return done;
+}
+
+/* Add DELTA, which is 1 or -1, to the last of the NDIGITS digits at
+   DIGITS.  Return false if that would change the number of digits.  */
+static bool
+step_digits (char *digits, int ndigits, int delta)
+{
+  char wrap = delta > 0 ? '9' : '0';
+  int i = ndigits - 1;
+
+  while (i >= 0 && digits[i] == wrap)
+    digits[i--] = delta > 0 ? '0' : '9';
+  if (i < 0 || (i == 0 && delta < 0 && digits[0] == '1' && ndigits > 1))
+    return false;
+  digits[i] += delta;
+  return true;
+}
+
+/* Print F, which is finite and positive, with NDIGITS significant
+   digits into BUF using the exact conversion of __printf_fp_l, and
+   store the digits and the exponent of the last one.  */
+static void
+exact_digits (FLOAT f, int ndigits, char *buf, size_t size, char *digits,
+	      int *exp10)
+{
+  union fpnum fpnum;
+  struct printf_info info;
+
+  set_fpnum (&fpnum, f);
+  memset (&info, '\0', sizeof (info));
+  info.is_long_double = __builtin_types_compatible_p (FLOAT, long double);
+#if __HAVE_DISTINCT_FLOAT128
+  info.is_binary128 = __builtin_types_compatible_p (FLOAT, _Float128);
+#endif
+  info.spec = 'e';
+  info.prec = ndigits - 1;
+  print_to_string (buf, size, _nl_C_locobj_ptr, &info, &fpnum, NULL, 0, 0);
+
+  const char *cp = buf;
+  for (int i = 0; i < ndigits; ++i)
+    {
+      if (*cp == '.')
+	++cp;
+      digits[i] = *cp++;
+    }
+  /* Skip the 'e'.  */
+  ++cp;
+  int sign = *cp++ == '-' ? -1 : 1;
+  int exponent = 0;
+  while (ISDIGIT (*cp))
+    exponent = exponent * 10 + *cp++ - '0';
+  *exp10 = sign * exponent - (ndigits - 1);
+}
+
+/* Find the shortest digit string which reads back as F, which is finite
+   and positive, using exact conversions.  The correctly rounded
+   FLOAT_DIG digits are the shortest string if any string of up to
+   FLOAT_DIG digits reads back as F; beyond that try one more digit at a
+   time.  If the correctly rounded string does not read back, the next
+   string on the other side of F might, because the rounding interval of
+   a power of two is asymmetric, and because in the directed rounding
+   modes both conversions round the same way.  */
+static int
+exact_shortest (FLOAT f, char *digits, int *exp10)
+{
+  /* "d.ddde-XXXXX" plus the terminating null byte.  */
+  char buf[FLOAT_DECIMAL_DIG + 10];
+  int ndigits;
+
+  for (ndigits = FLOAT_DIG; ndigits <= FLOAT_DECIMAL_DIG; ++ndigits)
+    {
+      exact_digits (f, ndigits, buf, sizeof (buf), digits, exp10);
+
+      /* Check whether the digits read back.  */
+      for (int delta = 0; delta <= 1; ++delta)
+	{
+	  char *cp = buf;
+	  for (int i = 0; i < ndigits; ++i)
+	    {
+	      if (*cp == '.')
+		++cp;
+	      *cp++ = digits[i];
+	    }
+	  FLOAT g = STRTOF (buf, NULL, 0, _nl_C_locobj_ptr);
+	  if (g == f)
+	    return ndigits;
+	  if (delta != 0 || !step_digits (digits, ndigits, g < f ? 1 : -1))
+	    break;
+	}
+    }
+
+  /* Not reached; FLOAT_DECIMAL_DIG digits always suffice.  */
+  exact_digits (f, FLOAT_DECIMAL_DIG, buf, sizeof (buf), digits, exp10);
+  return FLOAT_DECIMAL_DIG;
+}
+
+/* Store into DIGITS the shortest decimal digit string which reads back
+   as F, which is finite, and into *EXP10 the decimal exponent of its
+   last digit.  Return the number of digits.  */
+static int
+shortest_digits (FLOAT f, char *digits, int *exp10)
+{
+  int ndigits = 0;
+
+  if (f == 0)
+    {
+      digits[0] = '0';
+      *exp10 = 0;
+      return 1;
+    }
+  if (f < 0)
+    f = -f;
+
+#ifdef GRISU_SHORTEST
+  if (get_rounding_mode () == FE_TONEAREST)
+    ndigits = GRISU_SHORTEST (f, digits, exp10);
+#endif
+  if (ndigits == 0)
+    ndigits = exact_shortest (f, digits, exp10);
+
+  while (ndigits > 1 && digits[ndigits - 1] == '0')
+    {
+      --ndigits;
+      ++*exp10;
+    }
+  return ndigits;
+}
+
+int
+STRFROM (char *dest, size_t size, const char *format, FLOAT f)
+{
+  union fpnum fpnum;
   const void *fpptr;
   fpptr = &fpnum;
 
   /* Variables to control the output format.  */
   int precision = -1; /* printf_fp and printf_fphex treat this internally.  */
+  bool shortest = false;
   int specifier;
   struct printf_info info;
 
-  /* Single-precision values need to be converted into double-precision,
-     because __printf_fp and __printf_fphex only accept double and long double
-     as the floating-point argument.  */
-  if (__builtin_types_compatible_p (FLOAT, float))
-    fpnum.flt = f;
-  else
-    fpnum.value = f;
+  set_fpnum (&fpnum, f);
 
   /* Check if the first character in the format string is indeed the '%'
      character.  Otherwise, abort.  */
@@ -72,9 +255,16 @@ STRFROM (char *dest, size_t size, const char *format, FLOAT f)
   else
     abort ();
 
+  /* As a GNU extension, an 'R' instead of the precision requests the
+     shortest output which reads back as the same value.  */
+  if (*format == 'R')
+    {
+      format++;
+      shortest = true;
+    }
   /* The optional precision specification always starts with a '.'.  If such
      character is present, read the precision.  */
-  if (*format == '.')
+  else if (*format == '.')
     {
       format++;
 
@@ -93,6 +283,9 @@ STRFROM (char *dest, size_t size, const char *format, FLOAT f)
     {
     case 'a':
     case 'A':
+      if (shortest)
+	abort ();
+      /* Fall through.  */
     case 'e':
     case 'E':
     case 'f':
@@ -105,24 +298,6 @@ STRFROM (char *dest, size_t size, const char *format, FLOAT f)
       abort ();
     }
 
-  /* The following code to prepare the virtual file has been adapted from the
-     function __vsnprintf_internal from libio.  */
-
-  if (size == 0)
-    {
-    /* When size is zero, nothing is written and dest may be a null pointer.
-       This is specified for snprintf in ISO/IEC 9899:2011, Section 7.21.6.5,
-       in the second paragraph.  Thus, if size is zero, prepare to use the
-       overflow buffer right from the start.  */
-      dest = sfile.overflow_buf;
-      size = sizeof (sfile.overflow_buf);
-    }
-
-  /* Prepare the virtual string file.  */
-  _IO_no_init (&sfile.f._sbf._f, _IO_USER_LOCK, -1, NULL, NULL);
-  _IO_JUMPS (&sfile.f._sbf) = &_IO_strn_jumps;
-  _IO_str_init_static_internal (&sfile.f, dest, size - 1, dest);
-
   /* Prepare the format specification for printf_fp.  */
   memset (&info, '\0', sizeof (info));
 
@@ -142,14 +317,26 @@ STRFROM (char *dest, size_t size, const char *format, FLOAT f)
   info.prec = precision;
   info.spec = specifier;
 
-  if (info.spec != 'a' && info.spec != 'A')
-    done = __printf_fp_l (&sfile.f._sbf._f, _NL_CURRENT_LOCALE, &info, &fpptr);
-  else
-    done = __printf_fphex (&sfile.f._sbf._f, &info, &fpptr);
+  if (shortest && isfinite (f))
+    {
+      char digits[FLOAT_DECIMAL_DIG];
+      int exp10;
+      int ndigits = shortest_digits (f, digits, &exp10);
 
-  /* Terminate the string.  */
-  if (sfile.f._sbf._f._IO_buf_base != sfile.overflow_buf)
-    *sfile.f._sbf._f._IO_write_ptr = '\0';
+      /* Choose the precision which shows exactly these digits.  The %g
+	 style switches to exponential notation at the same magnitude as
+	 it does for FLOAT_DECIMAL_DIG digits.  */
+      if (specifier == 'e' || specifier == 'E')
+	info.prec = ndigits - 1;
+      else if (specifier == 'f' || specifier == 'F')
+	info.prec = exp10 < 0 ? -exp10 : 0;
+      else
+	info.prec = FLOAT_DECIMAL_DIG;
 
-  return done;
+      return print_to_string (dest, size, _NL_CURRENT_LOCALE, &info, fpptr,
+			      digits, ndigits, exp10);
+    }
+
+  return print_to_string (dest, size, _NL_CURRENT_LOCALE, &info, fpptr,
+			  NULL, 0, 0);
 }
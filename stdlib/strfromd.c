@@ -19,7 +19,11 @@
 #include <bits/floatn.h>
 
 #define FLOAT		double
+#define FLOAT_DIG	DBL_DIG
+#define FLOAT_DECIMAL_DIG DBL_DECIMAL_DIG
 #define STRFROM		strfromd
+#define STRTOF		____strtod_l_internal
+#define GRISU_SHORTEST	__grisu_shortest
 
 #if __HAVE_FLOAT64 && !__HAVE_DISTINCT_FLOAT64
 # define strfromf64 __hide_strfromf64
@@ -19,7 +19,11 @@
 #include <bits/floatn.h>
 
 #define FLOAT		float
+#define FLOAT_DIG	FLT_DIG
+#define FLOAT_DECIMAL_DIG FLT_DECIMAL_DIG
 #define STRFROM		strfromf
+#define STRTOF		____strtof_l_internal
+#define GRISU_SHORTEST	__grisu_shortestf
 
 #if __HAVE_FLOAT32 && !__HAVE_DISTINCT_FLOAT32
 # define strfromf32 __hide_strfromf32
@@ -19,7 +19,10 @@
 #include <bits/floatn.h>
 
 #define FLOAT		long double
+#define FLOAT_DIG	LDBL_DIG
+#define FLOAT_DECIMAL_DIG LDBL_DECIMAL_DIG
 #define STRFROM		strfroml
+#define STRTOF		____strtold_l_internal
 
 #if __HAVE_FLOAT128 && !__HAVE_DISTINCT_FLOAT128
 # define strfromf128 __hide_strfromf128
@@ -487,6 +487,212 @@ str_to_mpn (const STRING_TYPE *str, int digcnt, mp_limb_t *n, mp_size_t *nsize,
   while (0)
 
 
+/* Decimal numbers with few significant digits, which are the common
+   case, do not need multi-precision arithmetic.  The following fast
+   paths handle float and double; anything they cannot decide is left to
+   the exact code.  */
+#if MANT_DIG == 24 || MANT_DIG == 53
+# include "strtod_pow5.h"
+
+/* The number of leading digits which always fit into a uint64_t.  */
+# define FAST_MAX_DIGITS	19
+
+/* The powers of ten below are exact in FLOAT up to this exponent.  */
+# if MANT_DIG == 53
+#  define EXACT_POW10_MAX	22
+# else
+#  define EXACT_POW10_MAX	10
+# endif
+
+static const double exact_pow10[] =
+  {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+/* Return the high half of the 128-bit product of X and Y and store the
+   low half in *LOW.  */
+static inline uint64_t
+mul_64x64 (uint64_t x, uint64_t y, uint64_t *low)
+{
+# if BITS_PER_MP_LIMB == 64
+  mp_limb_t hi, lo;
+  umul_ppmm (hi, lo, x, y);
+  *low = lo;
+  return hi;
+# else
+  uint64_t a = x >> 32;
+  uint64_t b = x & 0xffffffff;
+  uint64_t c = y >> 32;
+  uint64_t d = y & 0xffffffff;
+  uint64_t ac = a * c;
+  uint64_t bc = b * c;
+  uint64_t ad = a * d;
+  uint64_t bd = b * d;
+  uint64_t mid = (bd >> 32) + (ad & 0xffffffff) + (bc & 0xffffffff);
+  *low = (mid << 32) | (bd & 0xffffffff);
+  return ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+# endif
+}
+
+/* Compute the binary representation of W * 10^Q for nonzero W and Q in
+   the range of __strtod_pow5, following Eisel and Lemire.  Store the
+   first MANT_DIG bits in *MANT, the exponent of the first bit in *BEXP,
+   the next bit in *HALF and whether any of the remaining bits is set in
+   *MORE.  Return false if the approximation of 5^Q is not precise enough
+   to tell.  */
+static bool
+fast_mul_pow10 (uint64_t w, int q, uint64_t *mant, intmax_t *bexp,
+		bool *half, bool *more)
+{
+  const uint64_t *pow5 = __strtod_pow5[q - STRTOD_POW5_MIN_EXP];
+  int lz = __builtin_clzll (w);
+  w <<= lz;
+
+  /* Both factors are normalized, so the product has 191 or 192 bits and
+     the result bits all come from its most significant word P2.  The K
+     bits of P2 below the half bit are the start of the remainder.  */
+  uint64_t p1, p0;
+  uint64_t p2 = mul_64x64 (w, pow5[0], &p1);
+  int upper = p2 >> 63;
+  int k = 62 - MANT_DIG + upper;
+  uint64_t mask = (UINT64_C (1) << k) - 1;
+
+  /* The low half of the table entry and its error add less than 2^129
+     to the product, i.e. at most 2 to the remainder bits of P2.  Unless
+     those are near zero or their maximum this cannot change the result,
+     and the remainder is not zero.  */
+  if ((p2 & mask) == 0 || (p2 & mask) >= mask - 1)
+    {
+      uint64_t hi = mul_64x64 (w, pow5[1], &p0);
+      p1 += hi;
+      p2 += p1 < hi;
+      upper = p2 >> 63;
+      k = 62 - MANT_DIG + upper;
+      mask = (UINT64_C (1) << k) - 1;
+
+      if (q >= 0 && q <= STRTOD_POW5_MAX_EXACT)
+	/* The product is exact.  */
+	*more = (p2 & mask) != 0 || p1 != 0 || p0 != 0;
+      else
+	{
+	  /* The exact product is larger than P2:P1:P0 by less than W.
+	     Give up if this could carry into the result bits.  */
+	  if ((p2 & mask) == mask && p1 == UINT64_MAX && p0 > UINT64_MAX - w)
+	    return false;
+	  *more = true;
+	}
+    }
+  else
+    *more = true;
+
+  *mant = p2 >> (k + 1);
+  *half = (p2 >> k) & 1;
+  /* (Q * 217706) >> 16 is floor (log2 (10^Q)) for |Q| < 400.  */
+  *bexp = 63 + upper - lz + ((q * 217706) >> 16);
+  return true;
+}
+
+/* Try to convert the DIGCNT significant digits starting at STR, scaled
+   by 10^Q, without multi-precision arithmetic.  Return true and store
+   the result with the sign given by NEGATIVE in *RESULT on success.  */
+static bool
+fast_decimal (const STRING_TYPE *str, size_t digcnt, intmax_t q,
+	      int negative, FLOAT *result
+# ifndef USE_WIDE_CHAR
+	      , size_t decimal_len, const char *thousands
+# endif
+	      )
+{
+  uint64_t w = 0;
+  bool truncated = false;
+
+  for (size_t i = 0; i < digcnt; ++i)
+    {
+      /* Skip thousands separators and the radix character, as in
+	 str_to_mpn.  */
+# ifdef USE_WIDE_CHAR
+      if (*str < L'0' || *str > L'9')
+	++str;
+# else
+      if (*str < '0' || *str > '9')
+	{
+	  int inner = 0;
+	  if (thousands != NULL && *str == *thousands
+	      && ({ for (inner = 1; thousands[inner] != '\0'; ++inner)
+		      if (thousands[inner] != str[inner])
+			break;
+		    thousands[inner] == '\0'; }))
+	    str += inner;
+	  else
+	    str += decimal_len;
+	}
+# endif
+      if (i < FAST_MAX_DIGITS)
+	w = w * 10 + *str - L_('0');
+      else if (*str != L_('0'))
+	{
+	  /* The value lies strictly between W * 10^Q and (W + 1) * 10^Q.  */
+	  truncated = true;
+	  break;
+	}
+      ++str;
+    }
+  if (digcnt > FAST_MAX_DIGITS)
+    q += (intmax_t) (digcnt - FAST_MAX_DIGITS);
+
+# if FLT_EVAL_METHOD == 0
+  /* If W and 10^|Q| are exact, one correctly rounded operation gives the
+     result in every rounding mode and raises the right exceptions.  */
+  if (!truncated && w <= (UINT64_C (1) << MANT_DIG)
+      && q >= -EXACT_POW10_MAX && q <= EXACT_POW10_MAX)
+    {
+      FLOAT x = negative ? -(FLOAT) w : (FLOAT) w;
+      if (q < 0)
+	*result = x / (FLOAT) exact_pow10[-q];
+      else
+	*result = x * (FLOAT) exact_pow10[q];
+      return true;
+    }
+# endif
+
+  if (q < STRTOD_POW5_MIN_EXP || q > STRTOD_POW5_MAX_EXP)
+    return false;
+
+  uint64_t mant;
+  intmax_t bexp;
+  bool half, more;
+  if (!fast_mul_pow10 (w, q, &mant, &bexp, &half, &more))
+    return false;
+  if (truncated)
+    {
+      /* The result is known if both bounds agree.  */
+      uint64_t mant2;
+      intmax_t bexp2;
+      bool half2, more2;
+      if (!fast_mul_pow10 (w + 1, q, &mant2, &bexp2, &half2, &more2)
+	  || mant2 != mant || bexp2 != bexp || half2 != half)
+	return false;
+      more = true;
+    }
+
+  /* Leave results which may be subnormal to the exact code.  */
+  if (bexp < MIN_EXP - 1)
+    return false;
+
+  mp_limb_t retval[RETURN_LIMB_SIZE];
+# if RETURN_LIMB_SIZE == 1
+  retval[0] = mant;
+# else
+  retval[0] = mant & 0xffffffff;
+  retval[1] = mant >> 32;
+# endif
+  *result = round_and_return (retval, bexp, negative, half, 0, more);
+  return true;
+}
+#endif
+
+
 #define INTERNAL(x) INTERNAL1(x)
 #define INTERNAL1(x) __##x##_internal
 #ifndef ____STRTOF_INTERNAL
@@ -1165,6 +1371,20 @@ ____STRTOF_INTERNAL (const STRING_TYPE *nptr, STRING_TYPE **endptr, int group,
       return round_and_return (retval, exponent, negative, 0, 0, 0);
     }
 
+#if MANT_DIG == 24 || MANT_DIG == 53
+  {
+    FLOAT result;
+    if (fast_decimal (startp, dig_no,
+		      exponent - ((intmax_t) dig_no - (intmax_t) int_no),
+		      negative, &result
+# ifndef USE_WIDE_CHAR
+		      , decimal_len, thousands
+# endif
+		      ))
+      return result;
+  }
+#endif
+
   /* Now we have the number of digits in total and the integer digits as well
      as the exponent and its sign.  We can decide whether the read digits are
      really integer digits or belong to the fractional part; i.e. we normalize
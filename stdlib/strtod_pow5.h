@@ -0,0 +1,40 @@
+/* Table of 128-bit approximations of powers of five for strtod.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _STRTOD_POW5_H
+#define _STRTOD_POW5_H	1
+
+#include <stdint.h>
+
+/* The range of decimal exponents covered by the table.  Any decimal
+   number with at most 19 significant digits and an exponent outside of
+   it overflows or underflows a double.  */
+#define STRTOD_POW5_MIN_EXP	(-342)
+#define STRTOD_POW5_MAX_EXP	308
+
+/* The largest exponent for which the table entry is exact.  */
+#define STRTOD_POW5_MAX_EXACT	55
+
+/* Entry Q - STRTOD_POW5_MIN_EXP holds 5^Q scaled by a power of two into
+   [2^127, 2^128) and rounded down, most significant half first.  The
+   power of two is 2^(127 - floor (log2 (5^Q))).  */
+extern const uint64_t __strtod_pow5[STRTOD_POW5_MAX_EXP
+				    - STRTOD_POW5_MIN_EXP + 1][2]
+     attribute_hidden;
+
+#endif /* strtod_pow5.h */
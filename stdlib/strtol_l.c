@@ -161,6 +161,35 @@
 # include "grouping.h"
 #endif
 
+#ifndef USE_WIDE_CHAR
+# include "parse-digits.h"
+
+struct digit_chunks
+{
+  const char *end;
+  unsigned long int value;
+};
+
+/* Convert the decimal digits at S eight at a time as long as the
+   result fits into an `unsigned long int'.  This is kept out of line,
+   and returns its results in registers, so that it does not slow down
+   the conversion of numbers with fewer than eight digits.  */
+static struct digit_chunks __attribute_noinline__
+parse_digit_chunks (const char *s)
+{
+  unsigned long int i = 0;
+  uint32_t digits;
+
+  while (i <= (ULONG_MAX - 99999999) / 100000000
+	 && parse_eight_digits (s, &digits))
+    {
+      i = i * 100000000 + digits;
+      s += 8;
+    }
+  return (struct digit_chunks) { s, i };
+}
+#endif
+
 
 /* Define tables of maximum values and remainders in order to detect
    overflow.  Do this at compile-time in order to avoid the runtime
@@ -374,10 +403,21 @@ INTERNAL (__strtol_l) (const STRING_TYPE *nptr, STRING_TYPE **endptr,
 
   overflow = 0;
   i = 0;
+#ifndef USE_WIDE_CHAR
+  /* Without grouping, long decimal numbers are converted eight digits
+     at a time.  Numbers with fewer than eight digits, the most common
+     ones, go straight to the loop below.  */
+  if (base == 10 && end == NULL && has_eight_digits (s))
+    {
+      struct digit_chunks chunks = parse_digit_chunks (s);
+      s = chunks.end;
+      i = chunks.value;
+    }
+#endif
   c = *s;
   if (sizeof (long int) != sizeof (LONG int))
     {
-      unsigned long int j = 0;
+      unsigned long int j = i;
       unsigned long int jmax = jmax_tab[base - 2];
 
       for (;c != L_('\0'); c = *++s)
@@ -0,0 +1,228 @@
+/* Test the shortest round-trip conversions of the strfrom functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <fenv.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+
+static const struct
+{
+  const char *format;
+  double value;
+  const char *expected;
+} dtests[] =
+  {
+    { "%Rg", 0.1, "0.1" },
+    { "%Rg", 0.3, "0.3" },
+    { "%Rg", 1.0 / 3, "0.3333333333333333" },
+    { "%Rg", 100, "100" },
+    { "%Rg", 1e16, "10000000000000000" },
+    { "%Rg", 1e17, "1e+17" },
+    { "%Rg", 1e23, "1e+23" },
+    { "%Rg", 0.0001, "0.0001" },
+    { "%Rg", 0.00001, "1e-05" },
+    { "%RG", 1e-300, "1E-300" },
+    { "%Rg", 5e-324, "5e-324" },
+    { "%Rg", DBL_MAX, "1.7976931348623157e+308" },
+    { "%Rg", DBL_MIN, "2.2250738585072014e-308" },
+    { "%Rg", 9007199254740993.0, "9007199254740992" },
+    { "%Rg", 0x1p-1022 * 3, "6.675221575521604e-308" },
+    { "%Rg", 0.0, "0" },
+    { "%Rg", -0.0, "-0" },
+    { "%Rg", -1.5, "-1.5" },
+    { "%Re", 0.0, "0e+00" },
+    { "%Re", 123, "1.23e+02" },
+    { "%Re", 1, "1e+00" },
+    { "%RE", 2.5e-10, "2.5E-10" },
+    { "%Rf", 1e-7, "0.0000001" },
+    { "%Rf", 1e22, "10000000000000000000000" },
+    { "%Rf", 123.456, "123.456" },
+    { "%RF", -0.5, "-0.5" },
+    { "%Rg", INFINITY, "inf" },
+    { "%RG", -INFINITY, "-INF" },
+    { "%Rf", NAN, "nan" },
+  };
+
+static const struct
+{
+  const char *format;
+  float value;
+  const char *expected;
+} ftests[] =
+  {
+    { "%Rg", 0.1f, "0.1" },
+    { "%Rg", 16777216.0f, "16777216" },
+    { "%Rg", 1e10f, "1e+10" },
+    { "%Rg", FLT_MAX, "3.4028235e+38" },
+    { "%Rg", FLT_MIN, "1.1754944e-38" },
+    { "%Rg", 0x1p-149f, "1e-45" },
+    { "%Re", 1.0f / 3, "3.3333334e-01" },
+  };
+
+/* A simple generator, so that the sequence is the same everywhere.  */
+static uint64_t
+next_random (uint64_t *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+/* Check that the %Re output for VALUE reads back and is shorter than
+   the correctly rounded strings which do not.  */
+static void
+check_double (double value)
+{
+  char buf[64];
+  char shorter[64];
+
+  strfromd (buf, sizeof buf, "%Re", value);
+  if (strtod (buf, NULL) != value)
+    {
+      support_record_failure ();
+      printf ("error: %a: %s does not read back\n", value, buf);
+      return;
+    }
+  const char *digits = buf[0] == '-' ? buf + 1 : buf;
+  int ndigits = strchr (digits, 'e') - digits - (digits[1] == '.');
+  if (ndigits > 1)
+    {
+      snprintf (shorter, sizeof shorter, "%.*e", ndigits - 2, value);
+      if (strtod (shorter, NULL) == value)
+	{
+	  support_record_failure ();
+	  printf ("error: %a: %s is not the shortest, %s also reads back\n",
+		  value, buf, shorter);
+	}
+    }
+}
+
+static void
+check_float (float value)
+{
+  char buf[64];
+
+  strfromf (buf, sizeof buf, "%Rg", value);
+  if (strtof (buf, NULL) != value)
+    {
+      support_record_failure ();
+      printf ("error: %a: %s does not read back\n", value, buf);
+    }
+}
+
+static void
+check_long_double (long double value)
+{
+  char buf[64];
+
+  strfroml (buf, sizeof buf, "%Rg", value);
+  if (strtold (buf, NULL) != value)
+    {
+      support_record_failure ();
+      printf ("error: %La: %s does not read back\n", value, buf);
+    }
+}
+
+static int
+do_test (void)
+{
+  char buf[64];
+
+  for (size_t i = 0; i < sizeof (dtests) / sizeof (dtests[0]); ++i)
+    {
+      int len = strfromd (buf, sizeof buf, dtests[i].format, dtests[i].value);
+      if (strcmp (buf, dtests[i].expected) != 0
+	  || len != strlen (dtests[i].expected))
+	{
+	  support_record_failure ();
+	  printf ("error: %s of %a: \"%s\" (%d), expected \"%s\"\n",
+		  dtests[i].format, dtests[i].value, buf, len,
+		  dtests[i].expected);
+	}
+
+      /* In other rounding modes the output reads back in that mode,
+	 but need not be the shortest.  */
+#ifdef FE_TOWARDZERO
+      if (isfinite (dtests[i].value) && fesetround (FE_TOWARDZERO) == 0)
+	{
+	  strfromd (buf, sizeof buf, dtests[i].format, dtests[i].value);
+	  double back = strtod (buf, NULL);
+	  fesetround (FE_TONEAREST);
+	  if (back != dtests[i].value)
+	    {
+	      support_record_failure ();
+	      printf ("error: %s of %a rounding towards zero: \"%s\"\n",
+		      dtests[i].format, dtests[i].value, buf);
+	    }
+	}
+#endif
+    }
+
+  for (size_t i = 0; i < sizeof (ftests) / sizeof (ftests[0]); ++i)
+    {
+      strfromf (buf, sizeof buf, ftests[i].format, ftests[i].value);
+      if (strcmp (buf, ftests[i].expected) != 0)
+	{
+	  support_record_failure ();
+	  printf ("error: %s of %a: \"%s\", expected \"%s\"\n",
+		  ftests[i].format, ftests[i].value, buf,
+		  ftests[i].expected);
+	}
+    }
+
+  strfroml (buf, sizeof buf, "%Rg", 0.1L);
+  TEST_COMPARE_STRING (buf, "0.1");
+
+  /* Truncated output still returns the full length.  */
+  TEST_COMPARE (strfromd (buf, 4, "%Rf", 0.125), 5);
+  TEST_COMPARE_STRING (buf, "0.1");
+
+  uint64_t state = 0x9e3779b97f4a7c15ULL;
+  for (int i = 0; i < 200000; ++i)
+    {
+      uint64_t bits = next_random (&state);
+      double d;
+      float f;
+
+      if ((bits >> 52 & 0x7ff) != 0x7ff)
+	{
+	  memcpy (&d, &bits, sizeof (d));
+	  check_double (d);
+	  if (i % 16 == 0)
+	    check_long_double (d * (1 + 0x1p-60L));
+	}
+      /* Short decimal numbers.  */
+      check_double ((double) (bits % 1000000) / 1000);
+      uint32_t fbits = bits >> 32;
+      if ((fbits >> 23 & 0xff) != 0xff)
+	{
+	  memcpy (&f, &fbits, sizeof (f));
+	  check_float (f);
+	}
+    }
+
+  return 0;
+}
+
+#include <support/test-driver.c>
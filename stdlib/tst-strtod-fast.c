@@ -0,0 +1,234 @@
+/* Test the fast conversion paths of strtod and strtof.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define __STDC_WANT_IEC_60559_TYPES_EXT__
+#include <fenv.h>
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <support/check.h>
+
+/* The reference values are computed with a wider format, which only
+   uses the multi-precision code.  Rounding them once more is correct
+   unless they are representable in the narrow format or halfway between
+   two such values; the tests skip those cases.  */
+#if __HAVE_FLOAT128
+typedef _Float128 wide_t;
+# define STRTOWIDE(s) strtof128 (s, NULL)
+# define WIDEFROM(buf, size, format, x) strfromf128 (buf, size, format, x)
+#elif LDBL_MANT_DIG >= 113
+typedef long double wide_t;
+# define STRTOWIDE(s) strtold (s, NULL)
+# define WIDEFROM(buf, size, format, x) strfroml (buf, size, format, x)
+#endif
+
+#ifdef STRTOWIDE
+
+/* The rounding modes and the direction of each one: nearest, towards
+   negative or positive infinity, or towards zero.  */
+static const struct
+{
+  int mode;
+  int dir;
+} modes[] =
+  {
+    { FE_TONEAREST, 0 },
+# ifdef FE_DOWNWARD
+    { FE_DOWNWARD, -1 },
+# endif
+# ifdef FE_UPWARD
+    { FE_UPWARD, 1 },
+# endif
+# ifdef FE_TOWARDZERO
+    { FE_TOWARDZERO, 2 },
+# endif
+  };
+
+static int tests_run;
+
+/* Compare the conversions of S in all rounding modes against the
+   reference value.  The expected results are computed without relying
+   on the rounding mode, because the compiler may move conversions
+   across fesetround.  */
+#define DEFINE_CHECK(SUFFIX, FLOAT, STRTO, WCSTO, MAX, NEXTAFTER)	\
+static void								\
+check_##SUFFIX (const char *s)						\
+{									\
+  wide_t ref = STRTOWIDE (s);						\
+  FLOAT nearest = (FLOAT) ref;						\
+  if ((wide_t) nearest == ref || isinf (nearest)			\
+      || ref > MAX || ref < -MAX)					\
+    return;								\
+  FLOAT other = NEXTAFTER (nearest, (wide_t) nearest < ref		\
+			   ? INFINITY : -INFINITY);			\
+  if (ref == ((wide_t) nearest + other) / 2)				\
+    return;								\
+  FLOAT lo = nearest < other ? nearest : other;				\
+  FLOAT hi = nearest < other ? other : nearest;				\
+  ++tests_run;								\
+									\
+  for (size_t i = 0; i < sizeof (modes) / sizeof (modes[0]); ++i)	\
+    {									\
+      wchar_t ws[128];							\
+      FLOAT expected;							\
+      switch (modes[i].dir)						\
+	{								\
+	case 0:								\
+	  expected = nearest;						\
+	  break;							\
+	case -1:							\
+	  expected = lo;						\
+	  break;							\
+	case 1:								\
+	  expected = hi;						\
+	  break;							\
+	default:							\
+	  expected = ref < 0 ? hi : lo;					\
+	  break;							\
+	}								\
+      if (fesetround (modes[i].mode) != 0)				\
+	continue;							\
+      feclearexcept (FE_ALL_EXCEPT);					\
+      FLOAT result = STRTO (s, NULL);					\
+      bool inexact = fetestexcept (FE_INEXACT) != 0;			\
+      mbstowcs (ws, s, 128);						\
+      FLOAT wresult = WCSTO (ws, NULL);					\
+      fesetround (FE_TONEAREST);					\
+      if (memcmp (&result, &expected, sizeof (FLOAT)) != 0		\
+	  || memcmp (&wresult, &expected, sizeof (FLOAT)) != 0)	\
+	{								\
+	  support_record_failure ();					\
+	  printf ("error: " #STRTO " (\"%s\") rounding %d: %a, "	\
+		  "expected %a\n", s, modes[i].dir, result, expected);	\
+	}								\
+      if (!inexact && FE_INEXACT != 0)					\
+	{								\
+	  support_record_failure ();					\
+	  printf ("error: " #STRTO " (\"%s\") rounding %d: inexact "	\
+		  "not raised\n", s, modes[i].dir);			\
+	}								\
+    }									\
+}
+
+DEFINE_CHECK (double, double, strtod, wcstod, DBL_MAX, nextafter)
+DEFINE_CHECK (float, float, strtof, wcstof, FLT_MAX, nextafterf)
+
+/* A simple generator, so that the sequence is the same everywhere.  */
+static uint64_t
+next_random (uint64_t *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static void
+check_string (const char *s)
+{
+  check_double (s);
+  check_float (s);
+}
+
+static int
+do_test (void)
+{
+  static const char *const strings[] =
+    {
+      "0.1", "0.3", "1.5", "3.14159", "-2.5e-3", "1e23", "8.5e-324",
+      "9007199254740993", "9007199254740992.5", "2.2250738585072011e-308",
+      "2.2250738585072014e-308", "1.7976931348623157e308",
+      "1.7976931348623158e308", "4.9406564584124654e-324",
+      "123456789012345678901234567890", "0.000000000000000000000000001",
+      "1.00000000000000011102230246251565404236316680908203125",
+      "1.00000000000000011102230246251565404236316680908203124",
+      "1.00000000000000011102230246251565404236316680908203126",
+      "3.4028235677973366e38", "1.1754943508222875e-38", "16777217",
+      "7.038531e-26", "1e-45", "1e-46", "3.4e38", "1e308", "1e-320",
+    };
+  for (size_t i = 0; i < sizeof (strings) / sizeof (strings[0]); ++i)
+    check_string (strings[i]);
+
+  uint64_t state = 0x9e3779b97f4a7c15ULL;
+  for (int i = 0; i < 40000; ++i)
+    {
+      char buf[128];
+      uint64_t bits = next_random (&state);
+      double d;
+
+      /* The shortest and longer representations of random values.  */
+      memcpy (&d, &bits, sizeof (d));
+      if (isfinite (d))
+	{
+	  snprintf (buf, sizeof buf, "%.*e", (int) (bits >> 58) % 20,
+		    fabs (d));
+	  check_string (buf);
+	  snprintf (buf, sizeof buf, "%.*g", (int) (bits >> 53) % 25, d);
+	  check_string (buf);
+	}
+
+      /* Values close to halfway between two doubles or floats.  */
+      if (isnormal (d))
+	{
+	  wide_t mid = (wide_t) d + ((wide_t) nextafter (d, 0) - d) / 2;
+	  WIDEFROM (buf, sizeof buf, "%.40e", mid);
+	  check_string (buf);
+	  float f = d;
+	  if (isnormal (f))
+	    {
+	      mid = (wide_t) f + ((wide_t) nextafterf (f, 0) - f) / 2;
+	      WIDEFROM (buf, sizeof buf, "%.25e", mid);
+	      check_string (buf);
+	    }
+	}
+
+      /* Random digit strings of various lengths and exponents.  */
+      uint64_t r = next_random (&state);
+      int ndigits = 1 + r % 24;
+      int point = (r >> 8) % (ndigits + 1);
+      char *p = buf;
+      for (int j = 0; j < ndigits; ++j)
+	{
+	  if (j == point)
+	    *p++ = '.';
+	  *p++ = '0' + next_random (&state) % 10;
+	}
+      sprintf (p, "e%d", (int) ((r >> 16) % 700) - 350);
+      check_string (buf);
+    }
+
+  printf ("info: %d strings checked\n", tests_run);
+  return 0;
+}
+
+#else
+
+static int
+do_test (void)
+{
+  FAIL_UNSUPPORTED ("no floating-point format wider than double");
+}
+
+#endif
+
+#include <support/test-driver.c>
@@ -0,0 +1,180 @@
+/* Test the conversion of eight digits at a time in strtol and of two
+   digits at a time in printf.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/next_to_fault.h>
+
+/* Write VALUE in BASE into BUF one digit at a time.  */
+static void
+reference (unsigned long long int value, unsigned int base, char *buf)
+{
+  char tmp[64];
+  char *p = tmp + sizeof (tmp);
+  *--p = '\0';
+  do
+    *--p = "0123456789abcdef"[value % base];
+  while ((value /= base) != 0);
+  strcpy (buf, p);
+}
+
+/* Check strtoul, strtol and strtoll on the digits of VALUE, followed by
+   SUFFIX.  */
+static void
+check_value (unsigned long long int value, const char *suffix)
+{
+  char digits[64];
+  char input[80];
+  char *end;
+
+  reference (value, 10, digits);
+  size_t len = strlen (digits);
+  strcpy (input, digits);
+  strcat (input, suffix);
+
+  errno = 0;
+  unsigned long int ul = strtoul (input, &end, 10);
+  if (value <= ULONG_MAX)
+    {
+      TEST_COMPARE (ul, value);
+      TEST_COMPARE (errno, 0);
+    }
+  else
+    {
+      TEST_COMPARE (ul, ULONG_MAX);
+      TEST_COMPARE (errno, ERANGE);
+    }
+  TEST_COMPARE (end - input, len);
+
+  errno = 0;
+  long long int ll = strtoll (input, &end, 10);
+  if (value <= LLONG_MAX)
+    {
+      TEST_COMPARE (ll, value);
+      TEST_COMPARE (errno, 0);
+    }
+  else
+    {
+      TEST_COMPARE (ll, LLONG_MAX);
+      TEST_COMPARE (errno, ERANGE);
+    }
+  TEST_COMPARE (end - input, len);
+
+  input[0] = '-';
+  strcpy (input + 1, digits);
+  strcat (input, suffix);
+  errno = 0;
+  long int l = strtol (input, &end, 10);
+  if (value <= (unsigned long int) LONG_MAX + 1)
+    {
+      TEST_COMPARE (l, (long int) -value);
+      TEST_COMPARE (errno, 0);
+    }
+  else
+    {
+      TEST_COMPARE (l, LONG_MIN);
+      TEST_COMPARE (errno, ERANGE);
+    }
+  TEST_COMPARE (end - input, len + 1);
+}
+
+/* Check the output of printf for VALUE.  */
+static void
+check_printf (unsigned long long int value)
+{
+  char expected[64];
+  char buf[64];
+
+  reference (value, 10, expected);
+  snprintf (buf, sizeof (buf), "%llu", value);
+  TEST_COMPARE_STRING (buf, expected);
+  reference (value, 16, expected);
+  snprintf (buf, sizeof (buf), "%llx", value);
+  TEST_COMPARE_STRING (buf, expected);
+  if (value <= UINT_MAX)
+    {
+      snprintf (buf, sizeof (buf), "%x", (unsigned int) value);
+      TEST_COMPARE_STRING (buf, expected);
+      reference (value, 10, expected);
+      snprintf (buf, sizeof (buf), "%u", (unsigned int) value);
+      TEST_COMPARE_STRING (buf, expected);
+    }
+}
+
+static int
+do_test (void)
+{
+  static const char *const suffixes[] =
+    { "", "x", " 1", "a2345678", "/0", ":9", "\xff" "1234567" };
+
+  /* Numbers of all lengths, around powers of ten and of two.  */
+  unsigned long long int power = 1;
+  for (int i = 0; i < 20; ++i, power *= 10)
+    for (int delta = -2; delta <= 2; ++delta)
+      {
+	unsigned long long int value = power + delta;
+	if (delta < 0 && power == 1)
+	  continue;
+	for (size_t j = 0; j < sizeof (suffixes) / sizeof (suffixes[0]); ++j)
+	  check_value (value, suffixes[j]);
+	check_printf (value);
+	check_printf (value * 7);
+      }
+  for (int i = 0; i < 64; ++i)
+    {
+      check_printf (1ULL << i);
+      check_printf ((1ULL << i) - 1);
+    }
+  check_value (ULLONG_MAX, "");
+  check_value (ULONG_MAX, " ");
+  check_printf (ULLONG_MAX);
+
+  /* Digits after leading zeros, and more digits than fit.  */
+  char *end;
+  TEST_COMPARE (strtoul ("0000000000000000000000000000001234", &end, 10),
+		1234);
+  TEST_COMPARE (*end, '\0');
+  errno = 0;
+  TEST_COMPARE (strtoul ("123456789012345678901234567890", &end, 10),
+		ULONG_MAX);
+  TEST_COMPARE (errno, ERANGE);
+  TEST_COMPARE (*end, '\0');
+
+  /* Numbers at the end of a page are not read past their end.  */
+  unsigned long long int sevens = 0;
+  for (size_t len = 1; len <= 19; ++len)
+    {
+      sevens = sevens * 10 + 7;
+      struct support_next_to_fault ntf
+	= support_next_to_fault_allocate (len + 1);
+      memset (ntf.buffer, '7', len);
+      ntf.buffer[len] = '\0';
+      TEST_COMPARE (strtoull (ntf.buffer, &end, 10), sevens);
+      TEST_COMPARE (end - ntf.buffer, len);
+      support_next_to_fault_free (&ntf);
+    }
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,58 @@
+/* Copy memory with hints about the use of the caches.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <string.h>
+#include <memcpy-hint.h>
+
+/* The source is prefetched one block at a time.  */
+#define PREFETCH_BLOCK 2048
+#define CACHE_LINE 64
+
+void *
+memcpy_hint (void *__restrict dest, const void *__restrict src, size_t n,
+	     unsigned int flags)
+{
+  if ((flags & MEMCPY_HINT_DEST_HOT) != 0)
+    return memcpy_temporal (dest, src, n);
+
+  if ((flags & MEMCPY_HINT_NONTEMPORAL) != 0
+      && n >= MEMCPY_NONTEMPORAL_MIN)
+    return memcpy_nontemporal (dest, src, n);
+
+  /* Inverse of MEMCPY_HINT_PREFETCH.  */
+  size_t distance = ((flags >> 8) & 0x3ff) * CACHE_LINE;
+  if (distance == 0 || n <= distance + PREFETCH_BLOCK)
+    return memcpy (dest, src, n);
+
+  char *d = dest;
+  const char *s = src;
+  while (n > PREFETCH_BLOCK)
+    {
+      /* Prefetch the part of the block DISTANCE bytes ahead which is
+	 in SRC.  */
+      for (size_t i = distance; i < distance + PREFETCH_BLOCK && i < n;
+	   i += CACHE_LINE)
+	__builtin_prefetch (s + i, 0, 3);
+      memcpy (d, s, PREFETCH_BLOCK);
+      d += PREFETCH_BLOCK;
+      s += PREFETCH_BLOCK;
+      n -= PREFETCH_BLOCK;
+    }
+  memcpy (d, s, n);
+  return dest;
+}
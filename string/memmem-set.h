@@ -0,0 +1,98 @@
+/* Internal representation of compiled sets of memmem needles.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _MEMMEM_SET_H
+#define _MEMMEM_SET_H 1
+
+#include <stddef.h>
+#include <string.h>
+
+/* Number of leading needle bytes checked by the bucket filter.  */
+#define MEMMEM_SET_FILTER_LEN 3
+
+/* The bucket filter is only used for sets of at most this many
+   needles, since larger sets make most positions candidates.  */
+#define MEMMEM_SET_FILTER_MAX 64
+
+struct memmem_set_needle
+{
+  const unsigned char *ptr;
+  size_t len;
+  /* One plus the index of the next nonempty needle with the same first
+     byte, or 0.  */
+  size_t next;
+};
+
+struct memmem_set
+{
+  /* Number of needles.  */
+  size_t count;
+  /* Length of the shortest needle.  */
+  size_t min_len;
+  /* Lowest index of an empty needle, or COUNT if there is none.  */
+  size_t empty;
+  /* Nonzero if the bucket filter below can be used.  It requires
+     MIN_LEN to be at least 1.  */
+  int use_filter;
+  /* For each byte, one plus the index of the first nonempty needle
+     starting with it, or 0.  The needles with the same first byte are
+     chained through their NEXT member in increasing order of index.  */
+  size_t first[256];
+  /* If MIN_LEN is at least 2, bit B * 256 + C is set if some needle
+     starts with bytes B and C.  */
+  unsigned char pairs[256 * 256 / 8];
+  /* Vectorized implementations find candidate positions with a Teddy
+     style filter.  Each needle is assigned to one of eight buckets.
+     For the Kth byte C of a needle in bucket B, bit B is set in
+     LO[K][C & 15] and HI[K][C >> 4].  A position is a candidate if the
+     AND of the table entries for the bytes at offsets 0 to
+     MEMMEM_SET_FILTER_LEN - 1 is not zero.  All bits are set for the
+     offsets past the end of the shortest needle.  */
+  unsigned char lo[MEMMEM_SET_FILTER_LEN][16];
+  unsigned char hi[MEMMEM_SET_FILTER_LEN][16];
+  struct memmem_set_needle needles[];
+};
+
+/* Return the lowest index of a nonempty needle of SET which occurs at
+   S, where AVAIL >= 1 bytes are available, or SET->count if there is
+   none.  */
+static inline size_t
+memmem_set_match (const struct memmem_set *set, const unsigned char *s,
+		  size_t avail)
+{
+  for (size_t i = set->first[*s]; i != 0; i = set->needles[i - 1].next)
+    {
+      const struct memmem_set_needle *n = &set->needles[i - 1];
+      if (n->len <= avail && memcmp (s + 1, n->ptr + 1, n->len - 1) == 0)
+	return i - 1;
+    }
+  return set->count;
+}
+
+/* Return nonzero if a nonempty needle of SET may occur at S, where at
+   least SET->min_len bytes are available.  */
+static inline int
+memmem_set_maybe (const struct memmem_set *set, const unsigned char *s)
+{
+  if (set->min_len < 2)
+    return set->first[s[0]] != 0;
+  unsigned int pair = s[0] * 256 + s[1];
+  return (set->pairs[pair / 8] >> (pair % 8)) & 1;
+}
+
+#endif /* memmem-set.h */
@@ -0,0 +1,128 @@
+/* Compile a set of needles for memmem_set_search.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memmem-set.h"
+
+/* Return the bucket of the filter for NEEDLE, the Ith of COUNT needles,
+   whose first LEN bytes are checked by the filter.  */
+static unsigned int
+filter_bucket (const unsigned char *needle, size_t len, size_t i,
+	       size_t count)
+{
+  /* With at most eight needles each one gets its own bucket.
+     Otherwise needles with the same prefix share a bucket, which avoids
+     candidates which combine the bytes of different needles.  */
+  if (count <= 8)
+    return i;
+  unsigned int hash = 0;
+  for (size_t k = 0; k < len; k++)
+    hash = hash * 31 + needle[k];
+  return hash % 8;
+}
+
+struct memmem_set *
+memmem_set_compile (const void *const *needles, const size_t *needlelens,
+		    size_t nneedles)
+{
+  size_t size;
+  if (__builtin_mul_overflow (nneedles, sizeof (struct memmem_set_needle),
+			      &size)
+      || __builtin_add_overflow (size, sizeof (struct memmem_set), &size))
+    {
+      __set_errno (ENOMEM);
+      return NULL;
+    }
+  for (size_t i = 0; i < nneedles; i++)
+    if (__builtin_add_overflow (size, needlelens[i], &size))
+      {
+	__set_errno (ENOMEM);
+	return NULL;
+      }
+
+  struct memmem_set *set = malloc (size);
+  if (set == NULL)
+    return NULL;
+
+  /* Without needles MIN_LEN is SIZE_MAX, so that nothing matches.  */
+  set->count = nneedles;
+  set->min_len = SIZE_MAX;
+  set->empty = nneedles;
+  memset (set->first, 0, sizeof (set->first));
+
+  unsigned char *bytes = (unsigned char *) &set->needles[nneedles];
+  for (size_t i = 0; i < nneedles; i++)
+    {
+      set->needles[i].ptr = bytes;
+      set->needles[i].len = needlelens[i];
+      bytes = __mempcpy (bytes, needles[i], needlelens[i]);
+      if (needlelens[i] < set->min_len)
+	set->min_len = needlelens[i];
+      if (needlelens[i] == 0 && set->empty == nneedles)
+	set->empty = i;
+    }
+
+  /* Chain the needles in decreasing order of index, so that the chains
+     are sorted in increasing order.  */
+  for (size_t i = nneedles; i-- > 0; )
+    if (set->needles[i].len != 0)
+      {
+	unsigned char c = set->needles[i].ptr[0];
+	set->needles[i].next = set->first[c];
+	set->first[c] = i + 1;
+      }
+
+  memset (set->pairs, 0, sizeof (set->pairs));
+  if (set->min_len >= 2)
+    for (size_t i = 0; i < nneedles; i++)
+      {
+	unsigned int pair = set->needles[i].ptr[0] * 256
+			    + set->needles[i].ptr[1];
+	set->pairs[pair / 8] |= 1 << (pair % 8);
+      }
+
+  /* A single needle is searched for with memmem.  */
+  set->use_filter = (nneedles > 1 && nneedles <= MEMMEM_SET_FILTER_MAX
+		     && set->min_len > 0);
+  size_t filter_len = set->min_len;
+  if (filter_len > MEMMEM_SET_FILTER_LEN)
+    filter_len = MEMMEM_SET_FILTER_LEN;
+  memset (set->lo, 0, sizeof (set->lo));
+  memset (set->hi, 0, sizeof (set->hi));
+  for (size_t k = filter_len; k < MEMMEM_SET_FILTER_LEN; k++)
+    {
+      memset (set->lo[k], 0xff, sizeof (set->lo[k]));
+      memset (set->hi[k], 0xff, sizeof (set->hi[k]));
+    }
+  if (set->use_filter)
+    for (size_t i = 0; i < nneedles; i++)
+      {
+	const unsigned char *p = set->needles[i].ptr;
+	unsigned char bit = 1 << filter_bucket (p, filter_len, i, nneedles);
+	for (size_t k = 0; k < filter_len; k++)
+	  {
+	    set->lo[k][p[k] & 15] |= bit;
+	    set->hi[k][p[k] >> 4] |= bit;
+	  }
+      }
+
+  return set;
+}
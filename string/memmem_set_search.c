@@ -0,0 +1,75 @@
+/* Search for the first occurrence of any needle of a set.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <string.h>
+#include "memmem-set.h"
+
+#ifndef MEMMEM_SET_SEARCH
+# define MEMMEM_SET_SEARCH memmem_set_search
+#endif
+
+void *
+MEMMEM_SET_SEARCH (const struct memmem_set *set, const void *haystack,
+		   size_t haystacklen, size_t *index)
+{
+  const unsigned char *hs = haystack;
+  size_t i;
+
+  /* An empty needle matches at the start of HAYSTACK.  A nonempty
+     needle with a lower index may match there as well.  */
+  if (set->empty < set->count)
+    {
+      i = set->empty;
+      if (haystacklen > 0)
+	{
+	  size_t j = memmem_set_match (set, hs, haystacklen);
+	  if (j < i)
+	    i = j;
+	}
+      goto found;
+    }
+
+  if (haystacklen < set->min_len)
+    return NULL;
+
+  /* The two-way algorithm of memmem is faster for a single needle.  */
+  if (set->count == 1)
+    {
+      i = 0;
+      hs = __memmem (hs, haystacklen, set->needles[0].ptr,
+		     set->needles[0].len);
+      if (hs == NULL)
+	return NULL;
+      goto found;
+    }
+
+  const unsigned char *end = hs + haystacklen - set->min_len;
+  for (; hs <= end; hs++)
+    if (memmem_set_maybe (set, hs))
+      {
+	i = memmem_set_match (set, hs, end - hs + set->min_len);
+	if (i < set->count)
+	  goto found;
+      }
+  return NULL;
+
+ found:
+  if (index != NULL)
+    *index = i;
+  return (void *) hs;
+}
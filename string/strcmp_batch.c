@@ -0,0 +1,34 @@
+/* Compare the strings of two arrays pairwise.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <string.h>
+
+#ifndef STRCMP_BATCH
+# define STRCMP_BATCH strcmp_batch
+#endif
+
+void
+STRCMP_BATCH (int *results, const char *const *s1, const char *const *s2,
+	      size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    {
+      int r = strcmp (s1[i], s2[i]);
+      results[i] = (r > 0) - (r < 0);
+    }
+}
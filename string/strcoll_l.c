@@ -203,6 +203,60 @@ get_next_seq (coll_seq *seq, int nrules, const unsigned char *rulesets,
   seq->idx = idx;
 }
 
+#ifndef WIDE_CHAR_VERSION
+/* Loads of a word from a string must not cross a boundary of this
+   size, which is not larger than the page size of any target.  */
+# define PREFIX_PAGE_SIZE 4096
+
+/* Return the length of the longest common prefix of S1 and S2 which
+   consists of complete collating elements, such that the elements of
+   both strings start at its end.  DATA, TABLE, INDIRECT and EXTRA
+   describe the locale.  */
+static size_t
+common_prefix (const unsigned char *s1, const unsigned char *s2,
+	       const struct lc_collate_data *data, const int32_t *table,
+	       const unsigned char *extra, const int32_t *indirect)
+{
+  const unsigned long int ones = (unsigned long int) -1 / 0xff;
+  const unsigned long int highs = ones << 7;
+  size_t len = 0;
+
+  /* Find the equal bytes, a word at a time as long as the loads do not
+     cross a page boundary.  */
+  while ((uintptr_t) (s1 + len) % PREFIX_PAGE_SIZE
+	 <= PREFIX_PAGE_SIZE - sizeof (unsigned long int)
+	 && (uintptr_t) (s2 + len) % PREFIX_PAGE_SIZE
+	 <= PREFIX_PAGE_SIZE - sizeof (unsigned long int))
+    {
+      unsigned long int w1, w2;
+      memcpy (&w1, s1 + len, sizeof (w1));
+      memcpy (&w2, s2 + len, sizeof (w2));
+      if (w1 != w2 || ((w1 - ones) & ~w1 & highs) != 0)
+	break;
+      len += sizeof (w1);
+    }
+  while (s1[len] == s2[len] && s1[len] != '\0')
+    ++len;
+
+  /* Find the end of the last collating element of the equal bytes.
+     Each element must be found without looking at the bytes after
+     them, which may differ.  */
+  const unsigned char *us = s1;
+  const unsigned char *end = s1 + len;
+  while (us < end)
+    {
+      size_t lookahead = data->lookahead[*us];
+      if (lookahead == 0)
+	++us;
+      else if (lookahead < end - us)
+	findidx (table, indirect, extra, &us, -1);
+      else
+	break;
+    }
+  return us - s1;
+}
+#endif
+
 /* Compare two sequences.  */
 static __always_inline int
 do_compare (coll_seq *seq1, coll_seq *seq2, int position,
@@ -291,6 +345,24 @@ STRCOLL (const STRING_TYPE *s1, const STRING_TYPE *s2, locale_t l)
 
   int result = 0, rule = 0;
 
+  /* The collating elements of a common prefix have the same weights in
+     both strings.  They can be skipped at the levels at which they are
+     compared in forward order.  Skipping them does not change the
+     difference of the positions of the following elements either.  */
+  size_t prefix = 0;
+  uint32_t skip_levels = 0;
+#ifndef WIDE_CHAR_VERSION
+  const struct lc_collate_data *data = current->private;
+  if (data != NULL && data->prefix_skip_levels != 0 && *s1 == *s2)
+    {
+      prefix = common_prefix ((const unsigned char *) s1,
+			      (const unsigned char *) s2, data, table, extra,
+			      indirect);
+      if (prefix != 0)
+	skip_levels = data->prefix_skip_levels;
+    }
+#endif
+
   /* With GCC 7 when compiling with -Os the compiler warns that
      seq1.back_us and seq2.back_us might be used uninitialized.
      Sometimes this warning appears at locations in locale/weightwc.h
@@ -323,6 +395,11 @@ STRCOLL (const STRING_TYPE *s1, const STRING_TYPE *s2, locale_t l)
 	 are used as indices.  */
       seq1.us = (const USTRING_TYPE *) s1;
       seq2.us = (const USTRING_TYPE *) s2;
+      if ((skip_levels >> pass) & 1)
+	{
+	  seq1.us += prefix;
+	  seq2.us += prefix;
+	}
 
       /* We assume that if a rule has defined `position' in one section
 	 this is true for all of them.  Please note that the localedef programs
@@ -362,6 +439,15 @@ STRCOLL (const STRING_TYPE *s1, const STRING_TYPE *s2, locale_t l)
 	}
 
       rule = seq1.rule;
+#ifndef WIDE_CHAR_VERSION
+      /* The ruleset is that of the first element of S1, which is not
+	 looked at if it was skipped.  */
+      if (pass == 0 && (skip_levels & 1) != 0)
+	{
+	  const unsigned char *us = (const unsigned char *) s1;
+	  rule = findidx (table, indirect, extra, &us, -1) >> 24;
+	}
+#endif
     }
 
   return result;
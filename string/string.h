@@ -400,6 +400,47 @@ extern void *__mempcpy (void *__restrict __dest,
 extern void *mempcpy (void *__restrict __dest,
 		      const void *__restrict __src, size_t __n)
      __THROW __nonnull ((1, 2));
+
+struct memmem_set;
+
+/* Compile the NNEEDLES byte strings NEEDLES, whose lengths are given
+   by NEEDLELENS, into a set for use with `memmem_set_search'.  The
+   needles are copied.  Return NULL if there is not enough memory.  */
+extern struct memmem_set *memmem_set_compile (const void *const *__needles,
+					      const size_t *__needlelens,
+					      size_t __nneedles)
+     __THROW __wur;
+
+/* Find the first occurrence of any needle of SET in HAYSTACK, which is
+   HAYSTACKLEN bytes long.  If INDEX is not null, store the index of
+   the needle found in *INDEX.  If several needles occur at the first
+   position, the one with the lowest index is found.  */
+extern void *memmem_set_search (const struct memmem_set *__set,
+				const void *__haystack, size_t __haystacklen,
+				size_t *__index)
+     __THROW __nonnull ((1, 2))
+    __attr_access ((__read_only__, 2, 3));
+
+/* Free the set SET returned by `memmem_set_compile'.  */
+extern void memmem_set_free (struct memmem_set *__set) __THROW;
+
+/* Hints for `memcpy_hint'.  */
+# define MEMCPY_HINT_NONTEMPORAL	0x1	/* DEST is not read soon.  */
+# define MEMCPY_HINT_DEST_HOT		0x2	/* DEST is read soon.  */
+/* Prefetch SRC DISTANCE bytes ahead of the copy.  DISTANCE is rounded
+   down to a multiple of 64 and must be less than 64 KiB.  */
+# define MEMCPY_HINT_PREFETCH(distance) \
+  ((((unsigned int) (distance) >> 6) & 0x3ff) << 8)
+
+/* Copy N bytes of SRC to DEST like `memcpy', using the hints in FLAGS
+   to choose how the copy goes through the caches.  If both
+   MEMCPY_HINT_NONTEMPORAL and MEMCPY_HINT_DEST_HOT are given,
+   MEMCPY_HINT_DEST_HOT takes precedence.  Unknown hints are ignored.
+   Return DEST.  */
+extern void *memcpy_hint (void *__restrict __dest,
+			  const void *__restrict __src, size_t __n,
+			  unsigned int __flags)
+     __THROW __nonnull ((1, 2));
 #endif
 
 
@@ -414,6 +455,13 @@ extern size_t strnlen (const char *__string, size_t __maxlen)
      __THROW __attribute_pure__ __nonnull ((1));
 #endif
 
+#ifdef __USE_GNU
+/* Store the lengths of the N strings STRINGS in LENGTHS.  */
+extern void strlen_batch (size_t *__restrict __lengths,
+			  const char *const *__restrict __strings, size_t __n)
+     __THROW __nonnull ((1, 2));
+#endif
+
 
 /* Return a string describing the meaning of the `errno' code in ERRNUM.  */
 extern char *strerror (int __errnum) __THROW;
@@ -502,6 +550,13 @@ extern char *stpncpy (char *__restrict __dest,
 #endif
 
 #ifdef	__USE_GNU
+/* Compare the N strings S1 with the N strings S2 pairwise like `strcmp'
+   and store -1, 0 or 1 in RESULTS.  */
+extern void strcmp_batch (int *__restrict __results,
+			  const char *const *__s1, const char *const *__s2,
+			  size_t __n)
+     __THROW __nonnull ((1, 2, 3));
+
 /* Compare S1 and S2 as strings holding name & indices/version numbers.  */
 extern int strverscmp (const char *__s1, const char *__s2)
      __THROW __attribute_pure__ __nonnull ((1, 2));
@@ -20,6 +20,10 @@
 #undef __strsep
 #undef strsep
 
+#ifdef STRSEP
+# define __strsep STRSEP
+#endif
+
 char *
 __strsep (char **stringp, const char *delim)
 {
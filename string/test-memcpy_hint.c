@@ -0,0 +1,138 @@
+/* Test memcpy_hint.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "memcpy_hint"
+#include "test-string.h"
+
+#include <array_length.h>
+
+typedef void *(*proto_t) (void *, const void *, size_t, unsigned int);
+
+IMPL (memcpy_hint, 1)
+
+static const unsigned int hints[] =
+{
+  0,
+  MEMCPY_HINT_NONTEMPORAL,
+  MEMCPY_HINT_DEST_HOT,
+  MEMCPY_HINT_NONTEMPORAL | MEMCPY_HINT_DEST_HOT,
+  MEMCPY_HINT_PREFETCH (64),
+  MEMCPY_HINT_PREFETCH (1000),
+  MEMCPY_HINT_PREFETCH (4096) | MEMCPY_HINT_NONTEMPORAL,
+  MEMCPY_HINT_PREFETCH (65535),
+  /* Unknown hints.  */
+  0xfffc0000,
+};
+
+/* Large enough for the non-temporal copies of memcpy.  */
+#define MAX_LEN (8 * 1024 * 1024)
+#define GUARD 64
+#define FILL 0xa5
+
+static unsigned char *src_buf;
+static unsigned char *dst_buf;
+
+static void
+do_one_test (impl_t *impl, size_t src_align, size_t dst_align,
+	     size_t len, unsigned int flags)
+{
+  unsigned char *src = src_buf + src_align;
+  unsigned char *dst = dst_buf + GUARD + dst_align;
+  size_t i;
+
+  memset (dst - GUARD, FILL, len + 2 * GUARD);
+  void *res = CALL (impl, dst, src, len, flags);
+  if (res != dst)
+    {
+      error (0, 0, "Wrong result in function %s (%zu, %zu, %zu, %#x): "
+	     "%p != %p", impl->name, src_align, dst_align, len, flags,
+	     res, dst);
+      ret = 1;
+      return;
+    }
+  if (memcmp (dst, src, len) != 0)
+    {
+      error (0, 0, "Wrong copy in function %s (%zu, %zu, %zu, %#x)",
+	     impl->name, src_align, dst_align, len, flags);
+      ret = 1;
+      return;
+    }
+  for (i = 0; i < GUARD; i++)
+    if (dst[-1 - i] != FILL || dst[len + i] != FILL)
+      {
+	error (0, 0, "Function %s (%zu, %zu, %zu, %#x) wrote outside of "
+	       "the destination", impl->name, src_align, dst_align, len,
+	       flags);
+	ret = 1;
+	return;
+      }
+}
+
+static void
+do_test (size_t src_align, size_t dst_align, size_t len)
+{
+  FOR_EACH_IMPL (impl, 0)
+    for (size_t i = 0; i < array_length (hints); i++)
+      do_one_test (impl, src_align, dst_align, len, hints[i]);
+}
+
+int
+test_main (void)
+{
+  static const size_t large[] =
+    {
+      4096 * 4 + 63, 4096 * 4 + 64, 4096 * 4 + 65, 20000, 65536 + 37,
+      262144 + 3, 1024 * 1024, 3 * 1024 * 1024 + 4097, MAX_LEN
+    };
+  size_t i, len;
+
+  test_init ();
+
+  src_buf = xmalloc (MAX_LEN + 4096);
+  dst_buf = xmalloc (MAX_LEN + 4096 + 2 * GUARD);
+  for (i = 0; i < MAX_LEN + 4096; i++)
+    src_buf[i] = i * 7 + (i >> 12);
+
+  printf ("%23s", "");
+  FOR_EACH_IMPL (impl, 0)
+    printf ("\t%s", impl->name);
+  putchar ('\n');
+
+  for (len = 0; len < 600; len++)
+    {
+      do_test (0, 0, len);
+      do_test (len % 61, len % 37, len);
+    }
+  for (len = 600; len < 20000; len += len / 3)
+    do_test (len % 61, len % 37, len);
+
+  for (i = 0; i < array_length (large); i++)
+    {
+      do_test (0, 0, large[i]);
+      do_test (1, 63, large[i]);
+      do_test (33, 5, large[i]);
+      do_test (4095, 17, large[i]);
+    }
+
+  free (dst_buf);
+  free (src_buf);
+  return ret;
+}
+
+#include <support/test-driver.c>
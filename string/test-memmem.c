@@ -142,6 +142,45 @@ check1 (void)
 		  pattern, sizeof pattern, exp_result);
 }
 
+static void
+check_all (const char *hs, size_t hs_len, const char *ne, size_t ne_len)
+{
+  void *exp_result = simple_memmem (hs, hs_len, ne, ne_len);
+  FOR_EACH_IMPL (impl, 0)
+    check_result (impl, hs, hs_len, ne, ne_len, exp_result);
+}
+
+/* Check matches at the end of the haystack, and haystacks for which
+   almost every position is a candidate for a match.  */
+static void
+check2 (void)
+{
+  char *hs = (char *) buf1;
+  char ne[64];
+
+  for (size_t ne_len = 1; ne_len < sizeof ne; ne_len += 3)
+    for (size_t hs_len = ne_len; hs_len < 300; ++hs_len)
+      {
+	memset (hs, 'a', hs_len);
+	memset (ne, 'a', ne_len);
+	ne[ne_len / 2] = 'b';
+	hs[hs_len - ne_len + ne_len / 2] = 'b';
+	check_all (hs, hs_len, ne, ne_len);
+	/* Without a match.  */
+	hs[hs_len - ne_len + ne_len / 2] = 'a';
+	check_all (hs, hs_len, ne, ne_len);
+      }
+
+  /* A long haystack which makes the vectorized versions give up on
+     their candidate filter.  */
+  size_t hs_len = 16 * page_size;
+  memset (hs, 'a', hs_len);
+  memset (ne, 'a', sizeof ne);
+  ne[sizeof ne / 2] = 'b';
+  memcpy (hs + hs_len - sizeof ne - 7, ne, sizeof ne);
+  check_all (hs, hs_len, ne, sizeof ne);
+}
+
 static const char *const strs[] =
   {
     "00000", "00112233", "0123456789", "0000111100001111",
@@ -158,6 +197,7 @@ test_main (void)
   test_init ();
 
   check1 ();
+  check2 ();
 
   printf ("%23s", "");
   FOR_EACH_IMPL (impl, 0)
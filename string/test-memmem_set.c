@@ -0,0 +1,215 @@
+/* Test memmem_set_search functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "memmem_set_search"
+#include "test-string.h"
+
+#include <stdint.h>
+
+typedef void *(*proto_t) (const struct memmem_set *, const void *, size_t,
+			  size_t *);
+
+IMPL (memmem_set_search, 1)
+
+#define MAX_NEEDLES 100
+#define MAX_NEEDLE_LEN 40
+
+static const unsigned char *needles[MAX_NEEDLES];
+static size_t needlelens[MAX_NEEDLES];
+static unsigned char needle_buf[MAX_NEEDLES][MAX_NEEDLE_LEN];
+
+/* Naive implementation to verify results.  */
+static const void *
+simple_memmem_set_search (size_t nneedles, const void *haystack,
+			  size_t haystack_len, size_t *index)
+{
+  const unsigned char *hs = haystack;
+  for (size_t pos = 0; pos <= haystack_len; pos++)
+    for (size_t i = 0; i < nneedles; i++)
+      if (needlelens[i] <= haystack_len - pos
+	  && memcmp (hs + pos, needles[i], needlelens[i]) == 0)
+	{
+	  *index = i;
+	  return hs + pos;
+	}
+  return NULL;
+}
+
+static void
+do_one_test (impl_t *impl, const struct memmem_set *set, size_t nneedles,
+	     const void *haystack, size_t haystack_len)
+{
+  size_t exp_index = SIZE_MAX;
+  const void *expected = simple_memmem_set_search (nneedles, haystack,
+						   haystack_len, &exp_index);
+  size_t index = SIZE_MAX;
+  void *res = CALL (impl, set, haystack, haystack_len, &index);
+  if (res != expected || (res != NULL && index != exp_index))
+    {
+      error (0, 0, "Wrong result in function %s %p %zu %p %zu (length %zu, "
+	     "%zu needles)", impl->name, res, index, expected, exp_index,
+	     haystack_len, nneedles);
+      ret = 1;
+      return;
+    }
+  /* INDEX may be null.  */
+  if (CALL (impl, set, haystack, haystack_len, NULL) != expected)
+    {
+      error (0, 0, "Wrong result in function %s without index",
+	     impl->name);
+      ret = 1;
+    }
+}
+
+static void
+check_all (const struct memmem_set *set, size_t nneedles,
+	   const void *haystack, size_t haystack_len)
+{
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (impl, set, nneedles, haystack, haystack_len);
+}
+
+static struct memmem_set *
+compile (size_t nneedles)
+{
+  struct memmem_set *set = memmem_set_compile ((const void *const *) needles,
+						needlelens, nneedles);
+  if (set == NULL)
+    {
+      error (0, errno, "memmem_set_compile failed");
+      exit (1);
+    }
+  return set;
+}
+
+/* Needles and haystacks made of few distinct bytes, so that there are
+   many partial matches.  The haystacks end at the end of BUF1.  */
+static void
+do_random_tests (void)
+{
+  static const size_t counts[] = { 1, 2, 3, 8, 9, 20, 64, 65, 100 };
+
+  for (size_t n = 0; n < ITERATIONS; n++)
+    {
+      size_t nneedles
+	= counts[random () % (sizeof counts / sizeof counts[0])];
+      unsigned int alphabet = 2 + random () % 6;
+      size_t max_len = 1 + random () % MAX_NEEDLE_LEN;
+      for (size_t i = 0; i < nneedles; i++)
+	{
+	  needlelens[i] = 1 + random () % max_len;
+	  for (size_t j = 0; j < needlelens[i]; j++)
+	    needle_buf[i][j] = 'a' + random () % alphabet;
+	  needles[i] = needle_buf[i];
+	}
+      struct memmem_set *set = compile (nneedles);
+
+      size_t len = random () % 600;
+      unsigned char *hs = buf1 + page_size - len;
+      for (size_t j = 0; j < len; j++)
+	hs[j] = 'a' + random () % alphabet;
+      check_all (set, nneedles, hs, len);
+
+      /* Plant a needle near the end.  */
+      if (len > MAX_NEEDLE_LEN)
+	{
+	  size_t i = random () % nneedles;
+	  memcpy (hs + len - needlelens[i] - random () % 4, needles[i],
+		  needlelens[i]);
+	  check_all (set, nneedles, hs, len);
+	}
+
+      memmem_set_free (set);
+    }
+}
+
+static void
+check1 (void)
+{
+  /* A set without needles never matches.  */
+  struct memmem_set *set = compile (0);
+  check_all (set, 0, "abc", 3);
+  check_all (set, 0, "", 0);
+  memmem_set_free (set);
+
+  /* An empty needle matches at the start, unless a needle with a lower
+     index matches there as well.  */
+  needle_buf[0][0] = 'b';
+  needle_buf[1][0] = 'a';
+  for (size_t i = 0; i < 3; i++)
+    needles[i] = needle_buf[i];
+  needlelens[0] = 1;
+  needlelens[1] = 1;
+  needlelens[2] = 0;
+  set = compile (3);
+  check_all (set, 3, "xab", 3);
+  check_all (set, 3, "ab", 2);
+  check_all (set, 3, "", 0);
+  memmem_set_free (set);
+
+  /* With several needles at the same position, the lowest index wins
+     over the longest.  */
+  static const char *const words[] = { "foobar", "foo", "oba", "bar" };
+  for (size_t i = 0; i < 4; i++)
+    {
+      needles[i] = (const unsigned char *) words[i];
+      needlelens[i] = strlen (words[i]);
+    }
+  set = compile (4);
+  static const char text[] = "a long text which contains foobar once";
+  check_all (set, 4, text, strlen (text));
+  memmem_set_free (set);
+  set = compile (4);
+  check_all (set, 4, "fo ob foba", 10);
+  memmem_set_free (set);
+
+  /* Needles containing all byte values.  */
+  for (size_t i = 0; i < 8; i++)
+    {
+      for (size_t j = 0; j < 4; j++)
+	needle_buf[i][j] = i * 37 + j * 101;
+      needles[i] = needle_buf[i];
+      needlelens[i] = 4;
+    }
+  set = compile (8);
+  unsigned char *hs = buf1;
+  for (size_t i = 0; i < 1024; i++)
+    hs[i] = i * 7;
+  check_all (set, 8, hs, 1024);
+  memcpy (hs + 700, needle_buf[5], 4);
+  check_all (set, 8, hs, 1024);
+  memmem_set_free (set);
+}
+
+int
+test_main (void)
+{
+  test_init ();
+
+  printf ("%23s", "");
+  FOR_EACH_IMPL (impl, 0)
+    printf ("\t%s", impl->name);
+  putchar ('\n');
+
+  check1 ();
+  do_random_tests ();
+  return ret;
+}
+
+#include <support/test-driver.c>
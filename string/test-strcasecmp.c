@@ -254,6 +254,15 @@ test_locale (const char *locale, int extra_tests)
       do_test (2 * i, i, 8 << i, 254, -1);
     }
 
+  /* Characters above 127 which only differ in case, close to the end of
+     a page.  */
+  for (i = 1; i < 64; ++i)
+    {
+      do_test (getpagesize () - i, 0, 2 * i, 254, 0);
+      do_test (0, getpagesize () - i, 2 * i, 254, 1);
+      do_test (getpagesize () - 2 * i, getpagesize () - i, 3 * i, 254, 0);
+    }
+
   for (j = 0; extra_tests && j < 160; ++j)
     {
       for (i = 0; i < test_len;)
@@ -18,6 +18,7 @@
 
 #define TEST_MAIN
 #define TEST_NAME "strcasestr"
+#define BUF1PAGES 5
 #include "test-string.h"
 
 
@@ -133,12 +134,75 @@ check1 (void)
     check_result (impl, s1, s2, exp_result);
 }
 
+static void
+check_all (const char *s1, const char *s2)
+{
+  char *exp_result = simple_strcasestr (s1, s2);
+  FOR_EACH_IMPL (impl, 0)
+    check_result (impl, s1, s2, exp_result);
+}
+
+/* Check that only letters are folded, and haystacks for which almost
+   every position is a candidate for a match.  */
+static void
+check2 (void)
+{
+  char *s1 = (char *) buf1;
+  char s2[64];
+
+  for (size_t i = 0; i < 160; i += 2)
+    {
+      s1[i] = '`';
+      s1[i + 1] = '{';
+    }
+  strcpy (s1 + 160, "@[");
+  check_all (s1, "@[");
+  check_all (s1, "`[");
+  check_all (s1, "`{");
+
+  size_t len1 = 4 * page_size;
+  memset (s1, 'A', len1);
+  s1[len1] = '\0';
+  memset (s2, 'a', sizeof s2 - 1);
+  s2[sizeof s2 - 1] = '\0';
+  s2[sizeof s2 / 2] = 'b';
+  check_all (s1, s2);
+  s1[len1 - 9 - sizeof s2 / 2] = 'B';
+  check_all (s1, s2);
+}
+
+/* Check matches at every position of a long haystack, including
+   those which straddle the boundaries at which an implementation may
+   stop scanning for the end of the haystack.  */
+static void
+check3 (void)
+{
+  char *s1 = (char *) buf1;
+  static const char needle[] = "NeedLE";
+  size_t len1 = 2000;
+
+  memset (s1, 'x', len1);
+  s1[len1] = '\0';
+  check_all (s1, needle);
+  for (size_t pos = 0; pos + strlen (needle) <= len1; ++pos)
+    {
+      memcpy (s1 + pos, "nEEDle", strlen (needle));
+      check_all (s1, needle);
+      check_all (s1 + pos, needle);
+      s1[pos + strlen (needle) - 1] = '\0';
+      check_all (s1, needle);
+      memset (s1 + pos, 'x', strlen (needle));
+    }
+}
+
 static int
 test_main (void)
 {
   test_init ();
 
   check1 ();
+  check2 ();
+  check3 ();
 
   printf ("%23s", "");
   FOR_EACH_IMPL (impl, 0)
@@ -0,0 +1,165 @@
+/* Test strcmp_batch functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "strcmp_batch"
+#define BUF1PAGES 16
+#include "test-string.h"
+
+typedef void (*proto_t) (int *, const char *const *, const char *const *,
+			 size_t);
+
+IMPL (strcmp_batch, 1)
+
+#define MAX_PAIRS 64
+
+static const char *s1[MAX_PAIRS];
+static const char *s2[MAX_PAIRS];
+static int results[MAX_PAIRS];
+
+static int
+sign (int x)
+{
+  return (x > 0) - (x < 0);
+}
+
+static void
+do_one_test (impl_t *impl, size_t n)
+{
+  for (size_t i = 0; i < MAX_PAIRS; i++)
+    results[i] = 0x12345;
+  CALL (impl, results, s1, s2, n);
+  for (size_t i = 0; i < n; i++)
+    if (results[i] != sign (strcmp (s1[i], s2[i])))
+      {
+	error (0, 0, "Wrong result in function %s: pair %zu result %d, "
+	       "expected %d", impl->name, i, results[i],
+	       sign (strcmp (s1[i], s2[i])));
+	ret = 1;
+	return;
+      }
+  if (n < MAX_PAIRS && results[n] != 0x12345)
+    {
+      error (0, 0, "Function %s wrote past the end of the results",
+	     impl->name);
+      ret = 1;
+    }
+}
+
+static void
+check_all (size_t n)
+{
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (impl, n);
+}
+
+/* Pairs of strings of length LEN with alignments ALIGN1 and ALIGN2
+   which differ at all positions, or are equal, in BUF1 and BUF2.
+   The strings of pair I are 512 bytes apart.  */
+static void
+do_test (size_t align1, size_t align2, size_t len)
+{
+  for (size_t i = 0; i < MAX_PAIRS; i++)
+    {
+      char *p1 = (char *) buf1 + i * 512 + align1;
+      char *p2 = (char *) buf1 + (MAX_PAIRS + i) * 512 + align2;
+      for (size_t j = 0; j < len; j++)
+	p1[j] = p2[j] = 1 + (i + j) % 254;
+      p1[len] = p2[len] = '\0';
+      /* Make pair I differ at position I * LEN / MAX_PAIRS, except
+	 for the last pair.  */
+      if (i < MAX_PAIRS - 1 && len > 0)
+	{
+	  size_t pos = i * len / MAX_PAIRS;
+	  p2[pos] = i % 2 ? p1[pos] + 1 : (i % 4 ? '\0' : 0xff);
+	}
+      s1[i] = p1;
+      s2[i] = p2;
+    }
+  check_all (MAX_PAIRS);
+}
+
+/* Strings which end at the end of BUF1 and BUF2, so that the
+   comparison crosses into the protected page if it reads too far.  */
+static void
+do_page_end_test (void)
+{
+  char *end1 = (char *) buf1 + BUF1PAGES * page_size;
+  char *end2 = (char *) buf2 + page_size;
+  for (size_t len1 = 0; len1 < 160; len1++)
+    for (size_t len2 = len1; len2 < len1 + 2 * 32 + 2; len2++)
+      {
+	char *p1 = end1 - len1 - 1;
+	char *p2 = end2 - len2 - 1;
+	memset (p1, 'x', len1);
+	memset (p2, 'x', len2);
+	p1[len1] = p2[len2] = '\0';
+	s1[0] = p1;
+	s2[0] = p2;
+	s1[1] = p2;
+	s2[1] = p1;
+	check_all (2);
+      }
+}
+
+static void
+do_random_tests (void)
+{
+  char *base = (char *) buf1;
+  for (size_t n = 0; n < ITERATIONS; n++)
+    {
+      size_t count = random () % MAX_PAIRS;
+      for (size_t i = 0; i < count; i++)
+	{
+	  size_t len = random () % 8 == 0 ? random () % 1000
+		       : random () % 40;
+	  char *p1 = base + i * 1024 + random () % 16;
+	  char *p2 = base + (MAX_PAIRS + i) * 1024 + random () % 16;
+	  for (size_t j = 0; j < len; j++)
+	    p1[j] = p2[j] = 'a' + random () % 4;
+	  p1[len] = p2[len] = '\0';
+	  if (len > 0 && random () % 2)
+	    p2[random () % len] = 'a' + random () % 4;
+	  s1[i] = p1;
+	  s2[i] = p2;
+	}
+      check_all (count);
+    }
+}
+
+int
+test_main (void)
+{
+  test_init ();
+
+  printf ("%23s", "");
+  FOR_EACH_IMPL (impl, 0)
+    printf ("\t%s", impl->name);
+  putchar ('\n');
+
+  check_all (0);
+  for (size_t len = 0; len < 300; len += 7)
+    for (size_t align1 = 0; align1 < 64; align1 += 5)
+      for (size_t align2 = 0; align2 < 64; align2 += 9)
+	do_test (align1, align2, len);
+  do_page_end_test ();
+  do_random_tests ();
+  return ret;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,134 @@
+/* Test strlen_batch functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "strlen_batch"
+#define BUF1PAGES 16
+#include "test-string.h"
+
+typedef void (*proto_t) (size_t *, const char *const *, size_t);
+
+IMPL (strlen_batch, 1)
+
+#define MAX_STRINGS 64
+
+static const char *strings[MAX_STRINGS];
+static size_t lengths[MAX_STRINGS];
+
+static void
+do_one_test (impl_t *impl, size_t n)
+{
+  memset (lengths, 0xff, sizeof (lengths));
+  CALL (impl, lengths, strings, n);
+  for (size_t i = 0; i < n; i++)
+    if (lengths[i] != strlen (strings[i]))
+      {
+	error (0, 0, "Wrong result in function %s: string %zu length %zu, "
+	       "expected %zu", impl->name, i, lengths[i],
+	       strlen (strings[i]));
+	ret = 1;
+	return;
+      }
+  if (n < MAX_STRINGS && lengths[n] != (size_t) -1)
+    {
+      error (0, 0, "Function %s wrote past the end of the lengths",
+	     impl->name);
+      ret = 1;
+    }
+}
+
+static void
+check_all (size_t n)
+{
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (impl, n);
+}
+
+/* Strings of all lengths below 320 with all alignments.  */
+static void
+do_test (size_t align)
+{
+  for (size_t len = 0; len < 320; len += MAX_STRINGS)
+    {
+      for (size_t i = 0; i < MAX_STRINGS; i++)
+	{
+	  char *p = (char *) buf1 + i * 512 + align;
+	  memset (p, 'x', len + i);
+	  p[len + i] = '\0';
+	  strings[i] = p;
+	}
+      check_all (MAX_STRINGS);
+    }
+}
+
+/* Strings which end at the end of BUF1.  */
+static void
+do_page_end_test (void)
+{
+  char *end = (char *) buf1 + BUF1PAGES * page_size;
+  for (size_t len = 0; len < 320; len++)
+    {
+      char *p = end - len - 1;
+      memset (p, 'x', len);
+      p[len] = '\0';
+      strings[0] = p;
+      check_all (1);
+    }
+}
+
+static void
+do_random_tests (void)
+{
+  char *base = (char *) buf1;
+  for (size_t n = 0; n < ITERATIONS; n++)
+    {
+      size_t count = random () % MAX_STRINGS;
+      for (size_t i = 0; i < count; i++)
+	{
+	  size_t len = random () % 8 == 0 ? random () % 2000
+		       : random () % 40;
+	  size_t start = random () % (BUF1PAGES * page_size - len);
+	  memset (base + start, 'a' + random () % 26, len);
+	  base[start + len] = '\0';
+	  strings[i] = base + start;
+	}
+      /* Later strings may have overwritten earlier ones, which only
+	 changes the expected lengths.  */
+      check_all (count);
+    }
+}
+
+int
+test_main (void)
+{
+  test_init ();
+
+  printf ("%23s", "");
+  FOR_EACH_IMPL (impl, 0)
+    printf ("\t%s", impl->name);
+  putchar ('\n');
+
+  check_all (0);
+  for (size_t align = 0; align < 64; align++)
+    do_test (align);
+  do_page_end_test ();
+  do_random_tests ();
+  return ret;
+}
+
+#include <support/test-driver.c>
@@ -212,6 +212,45 @@ do_random_tests (void)
     }
 }
 
+static void
+do_test_all (const CHAR *s, const CHAR *rej, RES_TYPE exp_res)
+{
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (impl, s, rej, exp_res);
+}
+
+/* Check every character value below 256 against a set of all the
+   other such values.  For wide characters, also check characters
+   whose low byte is in the set.  */
+static void
+do_test_char_values (void)
+{
+  CHAR *rej = (CHAR *) buf2;
+  CHAR *s = (CHAR *) buf1;
+
+  for (size_t c = 1; c < 256; ++c)
+    {
+      size_t n = 0;
+      for (size_t i = 1; i < 256; ++i)
+	if (i != c)
+	  rej[n++] = (CHAR) i;
+      rej[n] = '\0';
+
+      for (size_t i = 0; i < 100; ++i)
+	s[i] = (CHAR) c;
+#ifdef WIDE
+      for (size_t i = 0; i < 100; i += 3)
+	s[i] = rej[(i + c) % n] | 0x100;
+#endif
+      s[100] = rej[c % n];
+      s[101] = (CHAR) c;
+      s[102] = '\0';
+      do_test_all (s, rej, STRPBRK_RESULT (s, 100));
+      s[100] = (CHAR) c;
+      do_test_all (s, rej, STRPBRK_RESULT (s, 102));
+    }
+}
+
 int
 test_main (void)
 {
@@ -242,6 +281,7 @@ test_main (void)
   for (i = 0; i < 64; ++i)
     do_test (0, i, 6);
 
+  do_test_char_values ();
   do_random_tests ();
   return ret;
 }
@@ -0,0 +1,98 @@
+/* Test strsep functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "strsep"
+#include "test-string.h"
+
+typedef char *(*proto_t) (char **, const char *);
+
+IMPL (strsep, 1)
+
+/* Naive implementation to verify results.  */
+static char *
+simple_strsep (char **stringp, const char *delim)
+{
+  char *begin = *stringp;
+  char *end;
+
+  if (begin == NULL)
+    return NULL;
+  for (end = begin; *end != '\0' && strchr (delim, *end) == NULL; ++end)
+    ;
+  if (*end == '\0')
+    *stringp = NULL;
+  else
+    {
+      *end = '\0';
+      *stringp = end + 1;
+    }
+  return begin;
+}
+
+#define MAX_TOKENS 1025
+
+/* Split S with FN and record the offsets of the tokens and of the
+   string pointers in TOKENS.  Return the number of calls.  */
+static size_t
+split (proto_t fn, char *s, const char *delim, ptrdiff_t *tokens)
+{
+  char *p = s;
+  size_t n = 0;
+  char *tok;
+
+  do
+    {
+      tok = fn (&p, delim);
+      tokens[2 * n] = tok != NULL ? tok - s : -1;
+      tokens[2 * n + 1] = p != NULL ? p - s : -1;
+      ++n;
+    }
+  while (tok != NULL && n < MAX_TOKENS);
+  return n;
+}
+
+#define SIMPLE_IMPL simple_strsep
+
+/* Check that empty fields are returned, that the delimiters may change
+   between calls, and that a null string pointer ends the splitting.  */
+static void
+do_semantics_test (void)
+{
+  FOR_EACH_IMPL (impl, 0)
+    {
+      proto_t fn = (proto_t) impl->fn;
+      char s[] = ",a,,b c";
+      char *p = s;
+      char *tok;
+
+      if ((tok = fn (&p, ",")) == NULL || strcmp (tok, "") != 0
+	  || (tok = fn (&p, ",")) == NULL || strcmp (tok, "a") != 0
+	  || (tok = fn (&p, ",")) == NULL || strcmp (tok, "") != 0
+	  || (tok = fn (&p, " ")) == NULL || strcmp (tok, "b") != 0
+	  || (tok = fn (&p, " ")) == NULL || strcmp (tok, "c") != 0
+	  || p != NULL || fn (&p, " ") != NULL || p != NULL)
+	{
+	  error (0, 0, "Wrong result in function %s for empty fields",
+		 impl->name);
+	  ret = 1;
+	}
+    }
+}
+
+#include "test-strtok-support.h"
@@ -185,6 +185,43 @@ do_random_tests (void)
     }
 }
 
+static void
+do_test_all (const CHAR *s, const CHAR *acc, size_t exp_res)
+{
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (impl, s, acc, exp_res);
+}
+
+/* Check every character value below 256 against a set of all the
+   other such values.  For wide characters, also check characters
+   whose low byte is in the set.  */
+static void
+do_test_char_values (void)
+{
+  CHAR *acc = (CHAR *) buf2;
+  CHAR *s = (CHAR *) buf1;
+
+  for (size_t c = 1; c < 256; ++c)
+    {
+      size_t n = 0;
+      for (size_t i = 1; i < 256; ++i)
+	if (i != c)
+	  acc[n++] = (CHAR) i;
+      acc[n] = '\0';
+
+      for (size_t i = 0; i < 100; ++i)
+	s[i] = acc[(i * 7 + c) % n];
+      s[100] = (CHAR) c;
+      s[101] = acc[0];
+      s[102] = '\0';
+      do_test_all (s, acc, 100);
+#ifdef WIDE
+      s[100] = acc[c % n] | 0x100;
+      do_test_all (s, acc, 100);
+#endif
+    }
+}
+
 int
 test_main (void)
 {
@@ -215,6 +252,7 @@ test_main (void)
   for (i = 0; i < 64; ++i)
     do_test (0, i, 6);
 
+  do_test_char_values ();
   do_random_tests ();
   return ret;
 }
@@ -0,0 +1,98 @@
+/* Support for testing strsep and strtok_r functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* This file is included at the end of test-strsep.c and
+   test-strtok_r.c.  The includer defines proto_t, SIMPLE_IMPL (the
+   reference implementation), MAX_TOKENS, the function
+
+     size_t split (proto_t fn, char *s, const char *delim,
+		   ptrdiff_t *tokens)
+
+   which splits S at DELIM with FN, records the offset of each token
+   and of the position at which the next call continues in TOKENS, and
+   returns the number of calls, and do_semantics_test, which checks the
+   behavior specific to the function.  */
+
+#include <array_length.h>
+
+static const char *const delims[] =
+{
+  "", " ", ",", " ,", " \t,;:", "\x80\xff", "a", "abcdefghijklmnopq"
+};
+
+/* Split a string of LEN characters which ends ALIGN bytes before the
+   end of the buffer, so that the implementations read up to the
+   protected page.  */
+static void
+do_test (size_t align, size_t len, const char *delim)
+{
+  static const char chars[] = "abcz ,;\t\x80\xff";
+  char *s = (char *) buf1 + page_size - len - 1 - align;
+  char *exp = (char *) buf2;
+  char *input = (char *) buf2 + page_size / 2;
+  ptrdiff_t exp_tokens[2 * MAX_TOKENS], tokens[2 * MAX_TOKENS];
+  size_t exp_n, n, i;
+
+  for (i = 0; i < len; ++i)
+    input[i] = chars[random () % (sizeof (chars) - 1)];
+  input[len] = '\0';
+  memcpy (exp, input, len + 1);
+  exp_n = split (SIMPLE_IMPL, exp, delim, exp_tokens);
+
+  FOR_EACH_IMPL (impl, 0)
+    {
+      memcpy (s, input, len + 1);
+      n = split ((proto_t) impl->fn, s, delim, tokens);
+      if (n != exp_n
+	  || memcmp (tokens, exp_tokens, 2 * n * sizeof (tokens[0])) != 0
+	  || memcmp (s, exp, len + 1) != 0)
+	{
+	  error (0, 0, "Wrong result in function %s (%zu, %zu, \"%s\")",
+		 impl->name, align, len, delim);
+	  ret = 1;
+	}
+    }
+}
+
+int
+test_main (void)
+{
+  size_t i, align, len;
+
+  test_init ();
+
+  do_semantics_test ();
+
+  printf ("%23s", "");
+  FOR_EACH_IMPL (impl, 0)
+    printf ("\t%s", impl->name);
+  putchar ('\n');
+
+  for (i = 0; i < array_length (delims); ++i)
+    for (align = 0; align < 64; ++align)
+      {
+	for (len = 0; len < 128; ++len)
+	  do_test (align, len, delims[i]);
+	for (len = 128; len < 1024; len += 61)
+	  do_test (align, len, delims[i]);
+      }
+
+  return ret;
+}
+
+#include <support/test-driver.c>
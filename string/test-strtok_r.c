@@ -0,0 +1,105 @@
+/* Test strtok_r functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "strtok_r"
+#include "test-string.h"
+
+typedef char *(*proto_t) (char *, const char *, char **);
+
+IMPL (strtok_r, 1)
+
+/* Naive implementation to verify results.  */
+static char *
+simple_strtok_r (char *s, const char *delim, char **save_ptr)
+{
+  char *end;
+
+  if (s == NULL)
+    s = *save_ptr;
+  while (*s != '\0' && strchr (delim, *s) != NULL)
+    ++s;
+  if (*s == '\0')
+    {
+      *save_ptr = s;
+      return NULL;
+    }
+  for (end = s; *end != '\0' && strchr (delim, *end) == NULL; ++end)
+    ;
+  if (*end == '\0')
+    *save_ptr = end;
+  else
+    {
+      *end = '\0';
+      *save_ptr = end + 1;
+    }
+  return s;
+}
+
+#define MAX_TOKENS 1024
+
+/* Split S with FN and record the offsets of the tokens and of the
+   saved pointers in TOKENS.  Return the number of calls.  */
+static size_t
+split (proto_t fn, char *s, const char *delim, ptrdiff_t *tokens)
+{
+  char *save = NULL;
+  size_t n = 0;
+  char *tok;
+
+  do
+    {
+      tok = fn (n == 0 ? s : NULL, delim, &save);
+      tokens[2 * n] = tok != NULL ? tok - s : -1;
+      tokens[2 * n + 1] = save - s;
+      ++n;
+    }
+  while (tok != NULL && n < MAX_TOKENS);
+  return n;
+}
+
+#define SIMPLE_IMPL simple_strtok_r
+
+/* Check that runs of delimiters are skipped, that the delimiters may
+   change between calls, and that calls after the last token keep
+   returning NULL.  */
+static void
+do_semantics_test (void)
+{
+  FOR_EACH_IMPL (impl, 0)
+    {
+      proto_t fn = (proto_t) impl->fn;
+      char s[] = ",,a,,b c,";
+      char *save = NULL;
+      char *tok;
+
+      if ((tok = fn (s, ",", &save)) == NULL || strcmp (tok, "a") != 0
+	  || (tok = fn (NULL, " ", &save)) == NULL
+	  || strcmp (tok, ",b") != 0
+	  || (tok = fn (NULL, ",", &save)) == NULL || strcmp (tok, "c") != 0
+	  || fn (NULL, ",", &save) != NULL || *save != '\0'
+	  || fn (NULL, ",", &save) != NULL || *save != '\0')
+	{
+	  error (0, 0, "Wrong result in function %s for delimiter runs",
+		 impl->name);
+	  ret = 1;
+	}
+    }
+}
+
+#include "test-strtok-support.h"
@@ -0,0 +1,118 @@
+/* Test strcoll on strings with a common prefix.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <support/check.h>
+#include <support/next_to_fault.h>
+
+/* strcoll skips the collating elements of a common prefix.  Check it
+   against wcscoll, which does not, with strings built from pieces
+   which include contractions, ignored characters and characters with
+   accents.  */
+
+static const char *const pieces[] =
+{
+  "a", "b", "c", "h", "ch", "C", "H", "e", "é", "è", "E",
+  "É", "l", "L", "ll", "l·l", "L·", "·", "-", " ",
+  "'", ".", "z", "ž", "s", "š", "ss", "ß", "o", "ö",
+  "1", "2", "aa", "å", "ø", "A", "Ä", "dž",
+  "é", "č", "_", "/"
+};
+#define NPIECES (sizeof (pieces) / sizeof (pieces[0]))
+
+static void
+generate (char *buf, int n)
+{
+  buf[0] = '\0';
+  for (int i = 0; i < n; i++)
+    strcat (buf, pieces[random () % NPIECES]);
+}
+
+static int
+sign (int x)
+{
+  return (x > 0) - (x < 0);
+}
+
+static void
+check (const char *s1, const char *s2)
+{
+  wchar_t w1[512], w2[512];
+  TEST_VERIFY_EXIT (mbstowcs (w1, s1, 512) < 512);
+  TEST_VERIFY_EXIT (mbstowcs (w2, s2, 512) < 512);
+
+  int expected = sign (wcscoll (w1, w2));
+  if (sign (strcoll (s1, s2)) != expected
+      || sign (strcoll (s2, s1)) != -expected)
+    {
+      printf ("error: strcoll (\"%s\", \"%s\") != %d\n", s1, s2, expected);
+      support_record_failure ();
+    }
+}
+
+static void
+test_locale (const char *locale, struct support_next_to_fault ntf)
+{
+  if (setlocale (LC_ALL, locale) == NULL)
+    FAIL_EXIT1 ("setlocale (LC_ALL, \"%s\"): %m", locale);
+
+  for (int n = 0; n < 20000; n++)
+    {
+      char prefix[256], suffix1[64], suffix2[64], s1[512], s2[512];
+      generate (prefix, random () % 24);
+      generate (suffix1, random () % 4);
+      if (random () % 4 == 0)
+	strcpy (suffix2, suffix1);
+      else
+	generate (suffix2, random () % 4);
+      strcpy (s1, prefix);
+      strcat (s1, suffix1);
+      strcpy (s2, prefix);
+      strcat (s2, suffix2);
+      check (s1, s2);
+
+      /* Place one of the strings at the end of a page.  */
+      size_t len = strlen (s1) + 1;
+      if (len <= ntf.length)
+	{
+	  char *p = ntf.buffer + ntf.length - len;
+	  memcpy (p, s1, len);
+	  check (p, s2);
+	}
+    }
+}
+
+static int
+do_test (void)
+{
+  struct support_next_to_fault ntf = support_next_to_fault_allocate (512);
+
+  test_locale ("en_US.UTF-8", ntf);
+  test_locale ("cs_CZ.UTF-8", ntf);
+  test_locale ("de_DE.UTF-8", ntf);
+  test_locale ("en_GB.UTF-8", ntf);
+
+  support_next_to_fault_free (&ntf);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -105,6 +105,29 @@ typedef struct link_map *lookup_t;
    DT_PREINIT_ARRAY.  */
 typedef void (*dl_init_t) (int, char **, char **);
 
+/* A set of objects whose initializers do not depend on each other and
+   may therefore run concurrently.  See _dl_init and the
+   glibc.rtld.parallel_init tunable.  */
+struct dl_init_batch
+{
+  /* The objects in the batch and their number.  */
+  struct link_map **maps;
+  unsigned int nmaps;
+  /* Maximum number of threads (including the calling thread) which
+     may run initializers.  */
+  unsigned int nthreads;
+  /* Index of the next object whose initializer has not been claimed
+     yet.  Accessed atomically.  */
+  unsigned int next;
+  /* Arguments for the initializers.  */
+  int argc;
+  char **argv;
+  char **env;
+  /* Claims objects from the batch and runs their initializers until
+     none are left.  Called on each worker thread.  */
+  void (*run) (struct dl_init_batch *);
+};
+
 /* On some architectures a pointer to a function is not just a pointer
    to the actual code of the function but rather an architecture
    specific descriptor. */
@@ -278,6 +301,22 @@ uint64_t _dl_strtoul (const char *, char **) attribute_hidden;
    arguments are the error code, error string, and the objname the
    error occurred in.  */
 typedef void (*receiver_fct) (int, const char *, const char *);
+
+/* The objects of the base namespace at some point in time, in load
+   order.  See _dl_phdr_snapshot_update.  */
+struct dl_phdr_snapshot
+{
+  /* Next snapshot on the list of retired snapshots.  */
+  struct dl_phdr_snapshot *next;
+  /* Value of _dl_load_adds when the snapshot was taken.  */
+  unsigned long long int adds;
+  size_t count;
+  struct link_map *maps[];
+};
+
+/* Set in the dl_phdr_reader member of a thread if another thread waits
+   for it to stop using a snapshot.  */
+#define DL_PHDR_READER_WAITING 0x80000000U
 
 /* Internal functions of the run-time dynamic linker.
    These can be accessed if you link again the dynamic linker
@@ -377,6 +416,19 @@ struct rtld_global
   /* Incremented whenever something may have been added to dl_loaded.  */
   EXTERN unsigned long long _dl_load_adds;
 
+#ifdef SHARED
+  /* The objects which dl_iterate_phdr reports without taking
+     _dl_load_write_lock, or NULL if it has to take the lock.  */
+  EXTERN struct dl_phdr_snapshot *_dl_phdr_snapshot;
+  /* Replaced snapshots which readers may still use.  */
+  EXTERN struct dl_phdr_snapshot *_dl_phdr_retired;
+  /* Incremented whenever retired snapshots are reclaimed.  Zero until
+     snapshots are published.  */
+  EXTERN unsigned int _dl_phdr_generation;
+  /* Incremented by readers which another thread waits for.  */
+  EXTERN unsigned int _dl_phdr_wakeups;
+#endif
+
   /* The object to be initialized first.  */
   EXTERN struct link_map *_dl_initfirst;
 
@@ -398,6 +450,13 @@ struct rtld_global
   struct auditstate _dl_rtld_auditstate[DL_NNS];
 #endif
 
+#if PTHREAD_IN_LIBC && defined SHARED
+  /* Run the initializers in a batch on worker threads and wait for
+     their completion.  Installed by __libc_early_init in the initial
+     namespace.  NULL until libc.so has been initialized.  */
+  EXTERN void (*_dl_init_parallel) (struct dl_init_batch *);
+#endif
+
 #if !PTHREAD_IN_LIBC && defined SHARED \
     && defined __rtld_lock_default_lock_recursive
   EXTERN void (*_dl_rtld_lock_recursive) (void *);
@@ -443,6 +502,9 @@ struct rtld_global
   /* Remaining amount of static TLS that may be used for optimizing
      dynamic TLS access (e.g. with TLSDESC).  */
   EXTERN size_t _dl_tls_static_optional;
+  /* Remaining amount of static TLS that may be used for the TLS blocks
+     of dlopen'd objects which do not require static TLS.  */
+  EXTERN size_t _dl_tls_static_promoted;
 
 /* Number of additional entries in the slotinfo array of each slotinfo
    list element.  A large number makes it almost certain take we never
@@ -539,8 +601,9 @@ struct rtld_global_ro
 #define DL_DEBUG_STATISTICS (1 << 7)
 #define DL_DEBUG_UNUSED	    (1 << 8)
 #define DL_DEBUG_SCOPES	    (1 << 9)
-/* These two are used only internally.  */
-#define DL_DEBUG_HELP       (1 << 10)
+#define DL_DEBUG_TIMING	    (1 << 10)
+/* Only used internally, to print the LD_DEBUG options.  */
+#define DL_DEBUG_HELP       (1 << 11)
 
   /* Platform name.  */
   EXTERN const char *_dl_platform;
@@ -780,6 +843,50 @@ extern void _dl_dprintf (int fd, const char *fmt, ...)
 ssize_t _dl_write (int fd, const void *buffer, size_t length)
   attribute_hidden;
 
+/* A named counter reported with an LD_DEBUG=timing event.  */
+struct dl_timing_field
+{
+  const char *name;
+  uint64_t value;
+};
+
+/* Return a time stamp for LD_DEBUG=timing events.  Time stamps are in
+   the units of HP_TIMING_NOW, and zero if the target does not have an
+   inline high-precision timer.  */
+static inline uint64_t
+_dl_timing_now (void)
+{
+#if HP_TIMING_INLINE
+  hp_timing_t now;
+  HP_TIMING_NOW (now);
+  return now;
+#else
+  return 0;
+#endif
+}
+
+/* Return the start time stamp for an LD_DEBUG=timing event, or zero if
+   LD_DEBUG=timing is not enabled, so that the timer is not read on
+   every dlopen and relocation.  */
+static inline uint64_t
+_dl_timing_start (void)
+{
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_TIMING))
+    return _dl_timing_now ();
+  return 0;
+}
+
+/* Write the LD_DEBUG=timing event EVENT as one line of JSON to the
+   debug output.  MAP is the object the event applies to.  If it has
+   already been freed, MAP is NULL and OBJECT is its name instead.  FILE
+   is the name passed by the caller.  MAP, OBJECT and FILE can be NULL.
+   START is the value of _dl_timing_start at the beginning of the event.
+   The NFIELDS counters in FIELDS are added to the event.  */
+void _dl_timing_event (const char *event, struct link_map *map,
+		       const char *object, const char *file, uint64_t start,
+		       const struct dl_timing_field *fields, size_t nfields)
+  attribute_hidden;
+
 /* Write a message on the specified descriptor standard output.  The
    parameters are interpreted as for a `printf' call.  */
 void _dl_printf (const char *fmt, ...)
@@ -1005,6 +1112,16 @@ const ElfW(Sym) *_dl_lookup_direct (struct link_map *map,
 extern void _dl_add_to_namespace_list (struct link_map *new, Lmid_t nsid)
      attribute_hidden;
 
+/* Publish the objects of the base namespace in GL(dl_phdr_snapshot),
+   retiring the previous snapshot.  Called with _dl_load_write_lock
+   held.  */
+extern void _dl_phdr_snapshot_update (void) attribute_hidden;
+
+/* Free the retired snapshots once no other thread uses them.  If WAIT,
+   wait for such threads, otherwise keep the snapshots until the next
+   call.  */
+extern void _dl_phdr_snapshot_reclaim (bool wait) attribute_hidden;
+
 /* Allocate a `struct link_map' for a new object being loaded.  */
 extern struct link_map *_dl_new_object (char *realname, const char *libname,
 					int type, struct link_map *loader,
@@ -0,0 +1,46 @@
+/* Cache bypassing copies for memcpy_hint.  Generic version.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _MEMCPY_HINT_H
+#define _MEMCPY_HINT_H 1
+
+#include <stdint.h>
+#include <string.h>
+
+/* Copies of at least this many bytes are done with memcpy_nontemporal
+   for MEMCPY_HINT_NONTEMPORAL.  There are no non-temporal copies in
+   the generic version.  */
+#define MEMCPY_NONTEMPORAL_MIN SIZE_MAX
+
+static inline void *
+memcpy_nontemporal (void *__restrict dest, const void *__restrict src,
+		    size_t n)
+{
+  return memcpy (dest, src, n);
+}
+
+/* Copy N bytes from SRC to DEST for MEMCPY_HINT_DEST_HOT, keeping DEST
+   in the cache even if memcpy would bypass it for large N.  */
+static inline void *
+memcpy_temporal (void *__restrict dest, const void *__restrict src,
+		 size_t n)
+{
+  return memcpy (dest, src, n);
+}
+
+#endif /* memcpy-hint.h */
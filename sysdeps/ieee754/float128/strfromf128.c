@@ -19,7 +19,10 @@
 #include <bits/floatn.h>
 
 #define	FLOAT		_Float128
+#define FLOAT_DIG	FLT128_DIG
+#define FLOAT_DECIMAL_DIG FLT128_DECIMAL_DIG
 #define STRFROM		strfromf128
+#define STRTOF		____strtof128_l_internal
 
 #if __HAVE_FLOAT64X && !__HAVE_FLOAT64X_LONG_DOUBLE
 # define strfromf64x __hide_strfromf64x
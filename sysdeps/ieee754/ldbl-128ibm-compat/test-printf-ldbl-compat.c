@@ -17,6 +17,7 @@
    <https://www.gnu.org/licenses/>.  */
 
 #include <stdarg.h>
+#include <printf.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -75,6 +76,25 @@ do_test_call_varg (FILE *stream, const char *format, ...)
   va_end (args);
   printf ("%s", string);
   printf ("\n");
+
+  struct printf_compiled *cf = printf_compile (format);
+  if (cf == NULL)
+    FAIL_EXIT1 ("printf_compile (\"%s\") failed", format);
+
+  printf ("%15s", "vfprintf_compiled: ");
+  va_start (args, format);
+  vfprintf_compiled (stream, cf, args);
+  va_end (args);
+  printf ("\n");
+
+  printf ("%15s", "vsnprintf_compiled: ");
+  va_start (args, format);
+  vsnprintf_compiled (string, 127, cf, args);
+  va_end (args);
+  printf ("%s", string);
+  printf ("\n");
+
+  printf_compiled_free (cf);
 }
 
 static void
@@ -115,6 +135,21 @@ do_test_call_rarg (FILE *stream, const char *format, long double ld, double d)
   sprintf (string, format, ld, d);
   printf ("%s", string);
   printf ("\n");
+
+  struct printf_compiled *cf = printf_compile (format);
+  if (cf == NULL)
+    FAIL_EXIT1 ("printf_compile (\"%s\") failed", format);
+
+  printf ("%15s", "fprintf_compiled: ");
+  fprintf_compiled (stream, cf, ld, d);
+  printf ("\n");
+
+  printf ("%15s", "snprintf_compiled: ");
+  snprintf_compiled (string, 127, cf, ld, d);
+  printf ("%s", string);
+  printf ("\n");
+
+  printf_compiled_free (cf);
 }
 
 static void
@@ -150,30 +185,40 @@ do_test (void)
     "       printf: -1.0000000000, -1.0000000000\n"
     "     snprintf: -1.0000000000, -1.0000000000\n"
     "      sprintf: -1.0000000000, -1.0000000000\n"
+    "fprintf_compiled: -1.0000000000, -1.0000000000\n"
+    "snprintf_compiled: -1.0000000000, -1.0000000000\n"
     "    vasprintf: -1.0000000000, -1.0000000000\n"
     "     vdprintf: -1.0000000000, -1.0000000000\n"
     "     vfprintf: -1.0000000000, -1.0000000000\n"
     "      vprintf: -1.0000000000, -1.0000000000\n"
     "    vsnprintf: -1.0000000000, -1.0000000000\n"
     "     vsprintf: -1.0000000000, -1.0000000000\n"
+    "vfprintf_compiled: -1.0000000000, -1.0000000000\n"
+    "vsnprintf_compiled: -1.0000000000, -1.0000000000\n"
     "     asprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "      dprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "      fprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "       printf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "     snprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "      sprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
+    "fprintf_compiled: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
+    "snprintf_compiled: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "    vasprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "     vdprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "     vfprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "      vprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "    vsnprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "     vsprintf: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
+    "vfprintf_compiled: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
+    "vsnprintf_compiled: -0x1.0000000000p+0, -0x1.0000000000p+0\n"
     "    vasprintf: 3.000000, 2.000000, 1.000000\n"
     "     vdprintf: 3.000000, 2.000000, 1.000000\n"
     "     vfprintf: 3.000000, 2.000000, 1.000000\n"
     "      vprintf: 3.000000, 2.000000, 1.000000\n"
     "    vsnprintf: 3.000000, 2.000000, 1.000000\n"
-    "     vsprintf: 3.000000, 2.000000, 1.000000\n";
+    "     vsprintf: 3.000000, 2.000000, 1.000000\n"
+    "vfprintf_compiled: 3.000000, 2.000000, 1.000000\n"
+    "vsnprintf_compiled: 3.000000, 2.000000, 1.000000\n";
   TEST_COMPARE_STRING (expected, result.out.buffer);
 
   return 0;
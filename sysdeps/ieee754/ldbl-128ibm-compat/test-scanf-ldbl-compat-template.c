@@ -62,6 +62,9 @@ do_test_call (FILE *stream, CHAR *string, const CHAR *format, ...)
   float *fptr;
   long double *ldptr;
   va_list args;
+#ifdef SSCANF_COMPILED
+  struct scanf_compiled *cf;
+#endif
 
   CLEAR_VALUE
   printf ("fscanf: ");
@@ -98,6 +101,30 @@ do_test_call (FILE *stream, CHAR *string, const CHAR *format, ...)
   VSSCANF (string, format, args);
   va_end (args);
   CHECK_VARGS
+
+#ifdef SSCANF_COMPILED
+  /* The expected output is shared with the wide character tests, so
+     only report failures here.  */
+  cf = scanf_compile (format);
+  if (cf == NULL)
+    FAIL_EXIT1 ("scanf_compile (\"%s\") failed", format);
+
+  CLEAR_VALUE
+  SSCANF_COMPILED (string, cf, &ld, &f);
+  TEST_VERIFY (ld == -1 && f == -2);
+
+  CLEAR_VARGS
+  va_start (args, format);
+  VSSCANF_COMPILED (string, cf, args);
+  va_end (args);
+  va_start (args, format);
+  ldptr = va_arg (args, long double *);
+  fptr = va_arg (args, float *);
+  va_end (args);
+  TEST_VERIFY (*ldptr == -1 && *fptr == -2);
+
+  scanf_compiled_free (cf);
+#endif
 }
 
 static int
@@ -11,5 +11,7 @@
 #define VFSCANF vfscanf
 #define VSSCANF vsscanf
 #define VSCANF vscanf
+#define SSCANF_COMPILED sscanf_compiled
+#define VSSCANF_COMPILED vsscanf_compiled
 #define STRCPY strcpy
 #include <test-scanf-ldbl-compat-template.c>
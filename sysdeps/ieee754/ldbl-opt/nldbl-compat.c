@@ -1093,6 +1093,94 @@ __nldbl_error_at_line (int status, int errnum, const char *file_name,
   va_end (ap);
 }
 
+int
+__nldbl_vfprintf_compiled (FILE *s, const struct printf_compiled *cf,
+			   va_list ap)
+{
+  return __vfprintf_compiled_internal (s, cf, ap, PRINTF_LDBL_IS_DBL);
+}
+
+int
+__nldbl_fprintf_compiled (FILE *s, const struct printf_compiled *cf, ...)
+{
+  va_list ap;
+  int ret;
+
+  va_start (ap, cf);
+  ret = __vfprintf_compiled_internal (s, cf, ap, PRINTF_LDBL_IS_DBL);
+  va_end (ap);
+
+  return ret;
+}
+
+int
+__nldbl_vsnprintf_compiled (char *string, size_t maxlen,
+			    const struct printf_compiled *cf, va_list ap)
+{
+  return __vsnprintf_compiled_internal (string, maxlen, cf, ap,
+					PRINTF_LDBL_IS_DBL);
+}
+
+int
+__nldbl_snprintf_compiled (char *string, size_t maxlen,
+			   const struct printf_compiled *cf, ...)
+{
+  va_list ap;
+  int ret;
+
+  va_start (ap, cf);
+  ret = __vsnprintf_compiled_internal (string, maxlen, cf, ap,
+				       PRINTF_LDBL_IS_DBL);
+  va_end (ap);
+
+  return ret;
+}
+
+int
+__nldbl_vfscanf_compiled (FILE *s, const struct scanf_compiled *cf,
+			  va_list ap)
+{
+  return __vfscanf_compiled_internal (s, cf, ap, SCANF_LDBL_IS_DBL);
+}
+
+int
+__nldbl_fscanf_compiled (FILE *s, const struct scanf_compiled *cf, ...)
+{
+  va_list ap;
+  int ret;
+
+  va_start (ap, cf);
+  ret = __vfscanf_compiled_internal (s, cf, ap, SCANF_LDBL_IS_DBL);
+  va_end (ap);
+
+  return ret;
+}
+
+int
+__nldbl_vsscanf_compiled (const char *string, const struct scanf_compiled *cf,
+			  va_list ap)
+{
+  _IO_strfile sf;
+  FILE *f = _IO_strfile_read (&sf, string);
+  return __vfscanf_compiled_internal (f, cf, ap, SCANF_LDBL_IS_DBL);
+}
+
+int
+__nldbl_sscanf_compiled (const char *string, const struct scanf_compiled *cf,
+			 ...)
+{
+  va_list ap;
+  int ret;
+  _IO_strfile sf;
+  FILE *f = _IO_strfile_read (&sf, string);
+
+  va_start (ap, cf);
+  ret = __vfscanf_compiled_internal (f, cf, ap, SCANF_LDBL_IS_DBL);
+  va_end (ap);
+
+  return ret;
+}
+
 #if LONG_DOUBLE_COMPAT(libc, GLIBC_2_0)
 compat_symbol (libc, __nldbl__IO_printf, _IO_printf, GLIBC_2_0);
 compat_symbol (libc, __nldbl__IO_sprintf, _IO_sprintf, GLIBC_2_0);
@@ -90,6 +90,14 @@ NLDBL_DECL (errx);
 NLDBL_DECL (verrx);
 NLDBL_DECL (error);
 NLDBL_DECL (error_at_line);
+NLDBL_DECL (vfprintf_compiled);
+NLDBL_DECL (fprintf_compiled);
+NLDBL_DECL (vsnprintf_compiled);
+NLDBL_DECL (snprintf_compiled);
+NLDBL_DECL (vfscanf_compiled);
+NLDBL_DECL (fscanf_compiled);
+NLDBL_DECL (vsscanf_compiled);
+NLDBL_DECL (sscanf_compiled);
 
 /* These do not exist in the normal interface, but must exist in the
    __nldbl interface so that they can be called from libnldbl.  */
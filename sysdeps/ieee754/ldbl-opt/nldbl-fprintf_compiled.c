@@ -0,0 +1,15 @@
+#include "nldbl-compat.h"
+
+int
+attribute_hidden
+fprintf_compiled (FILE *s, const struct printf_compiled *cf, ...)
+{
+  va_list arg;
+  int done;
+
+  va_start (arg, cf);
+  done = __nldbl_vfprintf_compiled (s, cf, arg);
+  va_end (arg);
+
+  return done;
+}
@@ -0,0 +1,15 @@
+#include "nldbl-compat.h"
+
+int
+attribute_hidden
+fscanf_compiled (FILE *s, const struct scanf_compiled *cf, ...)
+{
+  va_list arg;
+  int done;
+
+  va_start (arg, cf);
+  done = __nldbl_vfscanf_compiled (s, cf, arg);
+  va_end (arg);
+
+  return done;
+}
@@ -0,0 +1,16 @@
+#include "nldbl-compat.h"
+
+int
+attribute_hidden
+snprintf_compiled (char *s, size_t maxlen, const struct printf_compiled *cf,
+		   ...)
+{
+  va_list arg;
+  int done;
+
+  va_start (arg, cf);
+  done = __nldbl_vsnprintf_compiled (s, maxlen, cf, arg);
+  va_end (arg);
+
+  return done;
+}
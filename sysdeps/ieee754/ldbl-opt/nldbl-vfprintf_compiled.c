@@ -0,0 +1,8 @@
+#include "nldbl-compat.h"
+
+int
+attribute_hidden
+vfprintf_compiled (FILE *s, const struct printf_compiled *cf, va_list ap)
+{
+  return __nldbl_vfprintf_compiled (s, cf, ap);
+}
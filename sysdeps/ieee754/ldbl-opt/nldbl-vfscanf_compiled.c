@@ -0,0 +1,8 @@
+#include "nldbl-compat.h"
+
+int
+attribute_hidden
+vfscanf_compiled (FILE *s, const struct scanf_compiled *cf, va_list ap)
+{
+  return __nldbl_vfscanf_compiled (s, cf, ap);
+}
@@ -0,0 +1,9 @@
+#include "nldbl-compat.h"
+
+int
+attribute_hidden
+vsnprintf_compiled (char *string, size_t maxlen,
+		    const struct printf_compiled *cf, va_list ap)
+{
+  return __nldbl_vsnprintf_compiled (string, maxlen, cf, ap);
+}
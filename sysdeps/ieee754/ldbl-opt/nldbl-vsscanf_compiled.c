@@ -0,0 +1,9 @@
+#include "nldbl-compat.h"
+
+int
+attribute_hidden
+vsscanf_compiled (const char *string, const struct scanf_compiled *cf,
+		  va_list ap)
+{
+  return __nldbl_vsscanf_compiled (string, cf, ap);
+}
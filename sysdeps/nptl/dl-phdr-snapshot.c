@@ -0,0 +1,191 @@
+/* Snapshots of the loaded objects for dl_iterate_phdr.  NPTL version.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* dl_iterate_phdr reports the objects of the base namespace from
+   GL(dl_phdr_snapshot) without taking _dl_load_write_lock.  A new
+   snapshot is published with a release store whenever the list of
+   loaded objects changes, and the old one is put on the list of retired
+   snapshots.
+
+   A reading thread stores the current value of GL(dl_phdr_generation)
+   in its dl_phdr_reader member before it loads the snapshot, and clears
+   the member once its callbacks have returned.  To reclaim the retired
+   snapshots, the dynamic linker increments the generation.  A thread
+   which is not reading, or which started reading under the new
+   generation, can only see the current snapshot.  Once no other thread
+   reads under an older generation, the retired snapshots, and the
+   objects which were only reachable from them, are no longer in use.
+
+   Before dlclose unmaps objects, it waits for such readers.  A thread
+   calling dlclose from a dl_iterate_phdr callback does not wait for
+   itself, as with the locked iteration, but keeps the retired snapshots
+   until a later call.  */
+
+#include <nptl/descr.h>
+#include <atomic.h>
+#include <futex-internal.h>
+#include <ldsodefs.h>
+#include <libc-pointer-arith.h>
+#include <list.h>
+#include <lowlevellock.h>
+#include <sys/mman.h>
+
+/* Return the size of the mapping for a snapshot of COUNT objects.  */
+static size_t
+snapshot_size (size_t count)
+{
+  return ALIGN_UP (sizeof (struct dl_phdr_snapshot)
+		   + count * sizeof (struct link_map *), GLRO(dl_pagesize));
+}
+
+void
+_dl_phdr_snapshot_update (void)
+{
+  /* Not yet initialized.  */
+  if (GL(dl_phdr_generation) == 0)
+    return;
+
+  /* The snapshot cannot tell which namespace the caller of
+     dl_iterate_phdr belongs to.  */
+  struct dl_phdr_snapshot *snapshot = NULL;
+  if (GL(dl_nns) == 1)
+    {
+      size_t count = 0;
+      for (struct link_map *l = GL(dl_ns)[LM_ID_BASE]._ns_loaded;
+	   l != NULL; l = l->l_next)
+	if (!l->l_removed)
+	  ++count;
+
+      /* malloc is not used because it may be interposed and call
+	 dlopen or dlclose.  */
+      snapshot = __mmap (NULL, snapshot_size (count),
+			 PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE,
+			 -1, 0);
+      if (snapshot == MAP_FAILED)
+	/* Use the lock until the next update.  */
+	snapshot = NULL;
+      else
+	{
+	  snapshot->adds = GL(dl_load_adds);
+	  snapshot->count = count;
+	  count = 0;
+	  for (struct link_map *l = GL(dl_ns)[LM_ID_BASE]._ns_loaded;
+	       l != NULL; l = l->l_next)
+	    if (!l->l_removed)
+	      snapshot->maps[count++] = l;
+	}
+    }
+
+  /* Pairs with the acquire load in __dl_iterate_phdr.  */
+  struct dl_phdr_snapshot *old = GL(dl_phdr_snapshot);
+  atomic_store_release (&GL(dl_phdr_snapshot), snapshot);
+  if (old != NULL)
+    {
+      old->next = GL(dl_phdr_retired);
+      GL(dl_phdr_retired) = old;
+    }
+}
+
+/* Return true if a thread in LIST other than SELF reads under a
+   generation other than GENERATION.  If WAIT, mark it as waited
+   for.  */
+static bool
+find_reader (list_t *list, struct pthread *self, unsigned int generation,
+	     bool wait)
+{
+  list_t *runp;
+  list_for_each (runp, list)
+    {
+      struct pthread *t = list_entry (runp, struct pthread, list);
+      if (t == self)
+	continue;
+
+      unsigned int reader = atomic_load_acquire (&t->dl_phdr_reader);
+      while (reader != 0
+	     && (reader & ~DL_PHDR_READER_WAITING) != generation)
+	{
+	  if (!wait || (reader & DL_PHDR_READER_WAITING))
+	    return true;
+	  if (atomic_compare_exchange_weak_acquire
+	      (&t->dl_phdr_reader, &reader,
+	       reader | DL_PHDR_READER_WAITING))
+	    return true;
+	}
+    }
+  return false;
+}
+
+void
+_dl_phdr_snapshot_reclaim (bool wait)
+{
+  if (GL(dl_phdr_retired) == NULL)
+    return;
+
+  /* Readers which load this generation also load the current
+     snapshot.  */
+  unsigned int generation = GL(dl_phdr_generation) + 1;
+  if ((generation & ~DL_PHDR_READER_WAITING) == 0)
+    generation = 1;
+  atomic_store_release (&GL(dl_phdr_generation), generation);
+
+  /* Pairs with the barrier in __dl_iterate_phdr.  Either the reader
+     observes the new snapshot, or its dl_phdr_reader value is observed
+     below.  */
+  atomic_full_barrier ();
+
+  struct pthread *self = THREAD_SELF;
+  while (true)
+    {
+      /* A reader which is marked below and finishes before the
+	 futex_wait call changes the value.  */
+      unsigned int wakeups = atomic_load_acquire (&GL(dl_phdr_wakeups));
+
+      lll_lock (GL (dl_stack_cache_lock), LLL_PRIVATE);
+      bool found = (find_reader (&GL (dl_stack_used), self, generation,
+				 wait)
+		    || find_reader (&GL (dl_stack_user), self, generation,
+				    wait));
+      lll_unlock (GL (dl_stack_cache_lock), LLL_PRIVATE);
+
+      if (!found)
+	break;
+      if (!wait)
+	/* Try again on the next update.  */
+	return;
+
+      /* Do not wait with the stack cache lock held because the
+	 callbacks of the reader may create threads.  The thread may
+	 exit once it is done, so wait on a global word instead of its
+	 dl_phdr_reader member.  */
+      futex_wait_simple (&GL(dl_phdr_wakeups), wakeups, FUTEX_PRIVATE);
+    }
+
+  /* A callback of dl_iterate_phdr may still use a retired snapshot in
+     this thread.  */
+  if (self->dl_phdr_reader == 0)
+    {
+      struct dl_phdr_snapshot *snapshot = GL(dl_phdr_retired);
+      GL(dl_phdr_retired) = NULL;
+      while (snapshot != NULL)
+	{
+	  struct dl_phdr_snapshot *next = snapshot->next;
+	  __munmap (snapshot, snapshot_size (snapshot->count));
+	  snapshot = next;
+	}
+    }
+}
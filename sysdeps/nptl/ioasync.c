@@ -0,0 +1,383 @@
+/* Background writing of output streams.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* A stream marked with _IO_FLAGS2_ASYNC does not write to its file
+   descriptor itself.  _IO_new_file_write copies the data into a queue
+   instead, and a helper thread writes the queue to the file descriptor.
+   The queue and the buffer the helper thread is writing are swapped
+   whenever the helper thread has finished a write, so the stream only
+   waits if it produces more than a whole queue while the helper thread
+   is still busy with the previous one.
+
+   Write errors are recorded and reported by the next fflush, fclose or
+   switch back to synchronous mode.  Seeking waits until all queued data
+   has been written, so that the file offset is right.  */
+
+#include <errno.h>
+#include <internal-signals.h>
+#include <libc-lock.h>
+#include <pthreadP.h>
+#include <sigsetops.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <not-cancel.h>
+#include <libio/libioP.h>
+
+/* The size of the queue and of the buffer being written.  */
+#define ASYNC_BUFSIZE (64 * 1024)
+
+struct asyncwriter
+{
+  /* The stream whose output is written, and its file descriptor.  */
+  FILE *fp;
+  int fd;
+  /* The next writer on the list of all writers.  */
+  struct asyncwriter *next;
+  pthread_mutex_t lock;
+  /* Signalled when data has been queued or the helper thread should
+     exit.  */
+  pthread_cond_t queued;
+  /* Signalled when the helper thread has finished writing.  */
+  pthread_cond_t written;
+  pthread_t thread;
+  /* True if the helper thread has been started.  */
+  bool running;
+  /* True if the helper thread should exit once the queue is empty.  */
+  bool exiting;
+  /* True while the helper thread writes the other buffer.  */
+  bool busy;
+  /* True if the data is written directly, after exit has waited for
+     the queue.  */
+  bool direct;
+  /* The errno value of the first failed write not yet reported.  */
+  int error;
+  /* The queued data.  */
+  char *queue;
+  size_t queue_len;
+  /* The buffer written by the helper thread.  */
+  char *other;
+};
+
+/* All writers.  Protected by writers_lock.  */
+static struct asyncwriter *writers;
+__libc_lock_define_initialized (static, writers_lock);
+
+/* Write the LEN bytes at DATA to FD.  Return 0 or an errno value.  */
+static int
+write_all (int fd, const char *data, size_t len)
+{
+  while (len > 0)
+    {
+      ssize_t count = __write_nocancel (fd, data, len);
+      if (count < 0)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  return errno;
+	}
+      data += count;
+      len -= count;
+    }
+  return 0;
+}
+
+static void *
+writer_thread (void *closure)
+{
+  struct asyncwriter *aw = closure;
+
+  __pthread_mutex_lock (&aw->lock);
+  while (true)
+    {
+      while (aw->queue_len == 0 && !aw->exiting)
+	__pthread_cond_wait (&aw->queued, &aw->lock);
+      if (aw->queue_len == 0)
+	break;
+
+      /* Swap the buffers, so that the stream can fill the queue while
+	 its previous contents are written.  */
+      char *data = aw->queue;
+      size_t len = aw->queue_len;
+      aw->queue = aw->other;
+      aw->queue_len = 0;
+      aw->other = data;
+      aw->busy = true;
+      __pthread_mutex_unlock (&aw->lock);
+
+      int error = write_all (aw->fd, data, len);
+
+      __pthread_mutex_lock (&aw->lock);
+      aw->busy = false;
+      if (error != 0 && aw->error == 0)
+	aw->error = error;
+      __pthread_cond_broadcast (&aw->written);
+    }
+  __pthread_mutex_unlock (&aw->lock);
+  return NULL;
+}
+
+/* Start the helper thread of AW.  Return 0 or an errno value.  */
+static int
+start_thread (struct asyncwriter *aw)
+{
+  pthread_attr_t attr;
+  __pthread_attr_init (&attr);
+  __pthread_attr_setstacksize (&attr, __pthread_get_minstack (&attr));
+
+  /* Signals are left to the threads of the application.  */
+  sigset_t ss;
+  __sigfillset (&ss);
+  clear_internal_signals (&ss);
+  int ret = __pthread_attr_setsigmask_internal (&attr, &ss);
+  if (ret == 0)
+    ret = __pthread_create (&aw->thread, &attr, writer_thread, aw);
+  __pthread_attr_destroy (&attr);
+
+  aw->running = ret == 0;
+  return ret;
+}
+
+/* Wait on COND for AW.  The wait is not a cancellation point, because
+   the stream functions are not cancelled with LOCK held.  */
+static void
+writer_wait (struct asyncwriter *aw, pthread_cond_t *cond)
+{
+  int oldstate;
+  __pthread_setcancelstate (PTHREAD_CANCEL_DISABLE, &oldstate);
+  __pthread_cond_wait (cond, &aw->lock);
+  __pthread_setcancelstate (oldstate, NULL);
+}
+
+/* Wait until all queued data of AW has been written.  */
+static void
+writer_drain (struct asyncwriter *aw)
+{
+  while (aw->queue_len > 0 || aw->busy)
+    writer_wait (aw, &aw->written);
+}
+
+/* Return the writer of FP.  FP must be locked.  */
+static struct asyncwriter *
+writer_lookup (FILE *fp)
+{
+  struct asyncwriter *aw;
+
+  __libc_lock_lock (writers_lock);
+  for (aw = writers; aw != NULL; aw = aw->next)
+    if (aw->fp == fp)
+      break;
+  __libc_lock_unlock (writers_lock);
+  return aw;
+}
+
+int
+__libio_async_start (FILE *fp)
+{
+  struct asyncwriter *aw = malloc (sizeof (*aw) + 2 * ASYNC_BUFSIZE);
+  if (aw == NULL)
+    return -1;
+  aw->fp = fp;
+  aw->fd = fp->_fileno;
+  __pthread_mutex_init (&aw->lock, NULL);
+  __pthread_cond_init (&aw->queued, NULL);
+  __pthread_cond_init (&aw->written, NULL);
+  aw->exiting = false;
+  aw->busy = false;
+  aw->direct = false;
+  aw->error = 0;
+  aw->queue = (char *) (aw + 1);
+  aw->queue_len = 0;
+  aw->other = aw->queue + ASYNC_BUFSIZE;
+
+  int ret = start_thread (aw);
+  if (ret != 0)
+    {
+      free (aw);
+      __set_errno (ret);
+      return -1;
+    }
+
+  __libc_lock_lock (writers_lock);
+  aw->next = writers;
+  writers = aw;
+  __libc_lock_unlock (writers_lock);
+  return 0;
+}
+
+ssize_t
+__libio_async_write (FILE *fp, const void *data, size_t n)
+{
+  struct asyncwriter *aw = writer_lookup (fp);
+  const char *s = data;
+  size_t to_do = n;
+
+  __pthread_mutex_lock (&aw->lock);
+  /* After a fork, the helper thread is started again in the child.  If
+     that is not possible, or after exit has waited for the queue, the
+     data is written directly.  */
+  if (!aw->running && !aw->direct && start_thread (aw) != 0)
+    aw->direct = true;
+  if (aw->direct)
+    {
+      __pthread_mutex_unlock (&aw->lock);
+      int error = write_all (fp->_fileno, s, n);
+      if (error != 0)
+	{
+	  fp->_flags |= _IO_ERR_SEEN;
+	  __set_errno (error);
+	  return 0;
+	}
+      return n;
+    }
+
+  while (to_do > 0)
+    {
+      size_t count = ASYNC_BUFSIZE - aw->queue_len;
+      if (count == 0)
+	{
+	  /* The helper thread has not caught up yet.  */
+	  writer_wait (aw, &aw->written);
+	  continue;
+	}
+      if (count > to_do)
+	count = to_do;
+      memcpy (aw->queue + aw->queue_len, s, count);
+      aw->queue_len += count;
+      s += count;
+      to_do -= count;
+      __pthread_cond_signal (&aw->queued);
+    }
+  __pthread_mutex_unlock (&aw->lock);
+  return n;
+}
+
+/* Report the recorded error of AW, if any, on its stream.  AW must be
+   locked.  */
+static int
+writer_report (struct asyncwriter *aw)
+{
+  if (aw->error == 0)
+    return 0;
+  aw->fp->_flags |= _IO_ERR_SEEN;
+  __set_errno (aw->error);
+  aw->error = 0;
+  return EOF;
+}
+
+int
+__libio_async_sync (FILE *fp)
+{
+  struct asyncwriter *aw = writer_lookup (fp);
+  __pthread_mutex_lock (&aw->lock);
+  int result = writer_report (aw);
+  __pthread_mutex_unlock (&aw->lock);
+  return result;
+}
+
+void
+__libio_async_wait (FILE *fp)
+{
+  struct asyncwriter *aw = writer_lookup (fp);
+  __pthread_mutex_lock (&aw->lock);
+  writer_drain (aw);
+  __pthread_mutex_unlock (&aw->lock);
+}
+
+int
+__libio_async_release (FILE *fp)
+{
+  struct asyncwriter *aw;
+
+  __libc_lock_lock (writers_lock);
+  struct asyncwriter **prevp = &writers;
+  while (*prevp != NULL && (*prevp)->fp != fp)
+    prevp = &(*prevp)->next;
+  aw = *prevp;
+  *prevp = aw->next;
+  __libc_lock_unlock (writers_lock);
+
+  __pthread_mutex_lock (&aw->lock);
+  writer_drain (aw);
+  aw->exiting = true;
+  __pthread_cond_signal (&aw->queued);
+  int result = writer_report (aw);
+  bool running = aw->running;
+  __pthread_mutex_unlock (&aw->lock);
+
+  if (running)
+    __pthread_join (aw->thread, NULL);
+  __pthread_cond_destroy (&aw->queued);
+  __pthread_cond_destroy (&aw->written);
+  __pthread_mutex_destroy (&aw->lock);
+  free (aw);
+
+  fp->_flags2 &= ~_IO_FLAGS2_ASYNC;
+  return result;
+}
+
+void
+__libio_async_flush_all (void)
+{
+  /* The queues are written before the process exits.  Output produced
+     after this point, for example by destructors, is written
+     directly.  */
+  __libc_lock_lock (writers_lock);
+  for (struct asyncwriter *aw = writers; aw != NULL; aw = aw->next)
+    {
+      __pthread_mutex_lock (&aw->lock);
+      writer_drain (aw);
+      aw->direct = true;
+      __pthread_mutex_unlock (&aw->lock);
+    }
+  __libc_lock_unlock (writers_lock);
+}
+
+void
+__libio_async_fork_lock (void)
+{
+  __libc_lock_lock (writers_lock);
+  for (struct asyncwriter *aw = writers; aw != NULL; aw = aw->next)
+    __pthread_mutex_lock (&aw->lock);
+}
+
+void
+__libio_async_fork_unlock_parent (void)
+{
+  for (struct asyncwriter *aw = writers; aw != NULL; aw = aw->next)
+    __pthread_mutex_unlock (&aw->lock);
+  __libc_lock_unlock (writers_lock);
+}
+
+void
+__libio_async_fork_unlock_child (void)
+{
+  /* The helper threads do not exist in the child.  The data they have
+     been given is written by the parent, so it is dropped here, and new
+     helper threads are started when the streams are written to.  */
+  for (struct asyncwriter *aw = writers; aw != NULL; aw = aw->next)
+    {
+      __pthread_mutex_init (&aw->lock, NULL);
+      __pthread_cond_init (&aw->queued, NULL);
+      __pthread_cond_init (&aw->written, NULL);
+      aw->running = false;
+      aw->busy = false;
+      aw->queue_len = 0;
+    }
+  __libc_lock_init (writers_lock);
+}
@@ -0,0 +1,301 @@
+/* Calibrate the x86 string function thresholds.  Linux/x86-64 version.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <hp-timing.h>
+#include <libc-pointer-arith.h>
+#include <sys/mman.h>
+#include <sysdep.h>
+
+/* The strategies used by memmove and memset for large sizes.  They are
+   implemented with inline assembly so that the measurement doesn't
+   depend on relocations or IFUNC selection, both of which may not have
+   been done yet.  */
+enum calibrate_strategy
+{
+  calibrate_vec_copy,
+  calibrate_nt_copy,
+  calibrate_rep_movsb,
+  calibrate_vec_set,
+  calibrate_rep_stosb
+};
+
+/* Number of timed runs of each strategy at each size.  The fastest run
+   is used so that interrupts and migrations are filtered out.  */
+#define CALIBRATE_RUNS 4
+
+/* The largest size at which REP MOVSB and REP STOSB are compared with
+   the vector loops.  */
+#define CALIBRATE_REP_MAX (256 * 1024)
+
+/* The largest size at which non-temporal stores are compared with the
+   vector loop.  */
+#define CALIBRATE_NT_MAX (64 * 1024 * 1024)
+
+/* Run STRATEGY once on N bytes.  N must be a multiple of 4 * VEC_SIZE
+   and DST must be aligned to VEC_SIZE.  */
+static void
+calibrate_run (enum calibrate_strategy strategy, char *dst, const char *src,
+	       size_t n, unsigned int vec_size)
+{
+  char *end = dst + n;
+
+  switch (strategy)
+    {
+    case calibrate_vec_copy:
+      if (vec_size == 64)
+	{
+	  for (; dst < end; dst += 4 * 64, src += 4 * 64)
+	    asm volatile ("vmovdqu64 (%1), %%zmm0\n\t"
+			  "vmovdqu64 64(%1), %%zmm1\n\t"
+			  "vmovdqu64 128(%1), %%zmm2\n\t"
+			  "vmovdqu64 192(%1), %%zmm3\n\t"
+			  "vmovdqu64 %%zmm0, (%0)\n\t"
+			  "vmovdqu64 %%zmm1, 64(%0)\n\t"
+			  "vmovdqu64 %%zmm2, 128(%0)\n\t"
+			  "vmovdqu64 %%zmm3, 192(%0)"
+			  : : "r" (dst), "r" (src)
+			  : "xmm0", "xmm1", "xmm2", "xmm3", "memory");
+	  asm volatile ("vzeroupper");
+	}
+      else if (vec_size == 32)
+	{
+	  for (; dst < end; dst += 4 * 32, src += 4 * 32)
+	    asm volatile ("vmovdqu (%1), %%ymm0\n\t"
+			  "vmovdqu 32(%1), %%ymm1\n\t"
+			  "vmovdqu 64(%1), %%ymm2\n\t"
+			  "vmovdqu 96(%1), %%ymm3\n\t"
+			  "vmovdqu %%ymm0, (%0)\n\t"
+			  "vmovdqu %%ymm1, 32(%0)\n\t"
+			  "vmovdqu %%ymm2, 64(%0)\n\t"
+			  "vmovdqu %%ymm3, 96(%0)"
+			  : : "r" (dst), "r" (src)
+			  : "xmm0", "xmm1", "xmm2", "xmm3", "memory");
+	  asm volatile ("vzeroupper");
+	}
+      else
+	for (; dst < end; dst += 4 * 16, src += 4 * 16)
+	  asm volatile ("movdqu (%1), %%xmm0\n\t"
+			"movdqu 16(%1), %%xmm1\n\t"
+			"movdqu 32(%1), %%xmm2\n\t"
+			"movdqu 48(%1), %%xmm3\n\t"
+			"movdqu %%xmm0, (%0)\n\t"
+			"movdqu %%xmm1, 16(%0)\n\t"
+			"movdqu %%xmm2, 32(%0)\n\t"
+			"movdqu %%xmm3, 48(%0)"
+			: : "r" (dst), "r" (src)
+			: "xmm0", "xmm1", "xmm2", "xmm3", "memory");
+      break;
+
+    case calibrate_nt_copy:
+      /* memmove only uses 16-byte and 32-byte non-temporal stores.  */
+      if (vec_size >= 32)
+	{
+	  for (; dst < end; dst += 4 * 32, src += 4 * 32)
+	    asm volatile ("prefetcht0 512(%1)\n\t"
+			  "vmovdqu (%1), %%ymm0\n\t"
+			  "vmovdqu 32(%1), %%ymm1\n\t"
+			  "vmovdqu 64(%1), %%ymm2\n\t"
+			  "vmovdqu 96(%1), %%ymm3\n\t"
+			  "vmovntdq %%ymm0, (%0)\n\t"
+			  "vmovntdq %%ymm1, 32(%0)\n\t"
+			  "vmovntdq %%ymm2, 64(%0)\n\t"
+			  "vmovntdq %%ymm3, 96(%0)"
+			  : : "r" (dst), "r" (src)
+			  : "xmm0", "xmm1", "xmm2", "xmm3", "memory");
+	  asm volatile ("sfence\n\tvzeroupper" : : : "memory");
+	}
+      else
+	{
+	  for (; dst < end; dst += 4 * 16, src += 4 * 16)
+	    asm volatile ("prefetcht0 512(%1)\n\t"
+			  "movdqu (%1), %%xmm0\n\t"
+			  "movdqu 16(%1), %%xmm1\n\t"
+			  "movdqu 32(%1), %%xmm2\n\t"
+			  "movdqu 48(%1), %%xmm3\n\t"
+			  "movntdq %%xmm0, (%0)\n\t"
+			  "movntdq %%xmm1, 16(%0)\n\t"
+			  "movntdq %%xmm2, 32(%0)\n\t"
+			  "movntdq %%xmm3, 48(%0)"
+			  : : "r" (dst), "r" (src)
+			  : "xmm0", "xmm1", "xmm2", "xmm3", "memory");
+	  asm volatile ("sfence" : : : "memory");
+	}
+      break;
+
+    case calibrate_rep_movsb:
+      asm volatile ("rep movsb"
+		    : "+D" (dst), "+S" (src), "+c" (n) : : "memory");
+      break;
+
+    case calibrate_vec_set:
+      if (vec_size == 64)
+	{
+	  asm volatile ("vpxorq %%zmm0, %%zmm0, %%zmm0" : : : "xmm0");
+	  for (; dst < end; dst += 4 * 64)
+	    asm volatile ("vmovdqu64 %%zmm0, (%0)\n\t"
+			  "vmovdqu64 %%zmm0, 64(%0)\n\t"
+			  "vmovdqu64 %%zmm0, 128(%0)\n\t"
+			  "vmovdqu64 %%zmm0, 192(%0)"
+			  : : "r" (dst) : "memory");
+	  asm volatile ("vzeroupper");
+	}
+      else if (vec_size == 32)
+	{
+	  asm volatile ("vpxor %%xmm0, %%xmm0, %%xmm0" : : : "xmm0");
+	  for (; dst < end; dst += 4 * 32)
+	    asm volatile ("vmovdqu %%ymm0, (%0)\n\t"
+			  "vmovdqu %%ymm0, 32(%0)\n\t"
+			  "vmovdqu %%ymm0, 64(%0)\n\t"
+			  "vmovdqu %%ymm0, 96(%0)"
+			  : : "r" (dst) : "memory");
+	  asm volatile ("vzeroupper");
+	}
+      else
+	{
+	  asm volatile ("pxor %%xmm0, %%xmm0" : : : "xmm0");
+	  for (; dst < end; dst += 4 * 16)
+	    asm volatile ("movdqu %%xmm0, (%0)\n\t"
+			  "movdqu %%xmm0, 16(%0)\n\t"
+			  "movdqu %%xmm0, 32(%0)\n\t"
+			  "movdqu %%xmm0, 48(%0)"
+			  : : "r" (dst) : "memory");
+	}
+      break;
+
+    case calibrate_rep_stosb:
+      asm volatile ("rep stosb"
+		    : "+D" (dst), "+c" (n) : "a" (0) : "memory");
+      break;
+    }
+}
+
+/* Return the fastest time of STRATEGY on N bytes.  */
+static hp_timing_t
+calibrate_time (enum calibrate_strategy strategy, char *dst,
+		const char *src, size_t n, unsigned int vec_size)
+{
+  hp_timing_t best = (hp_timing_t) -1;
+  for (int i = 0; i < CALIBRATE_RUNS; i++)
+    {
+      hp_timing_t start, stop;
+      HP_TIMING_NOW (start);
+      calibrate_run (strategy, dst, src, n, vec_size);
+      HP_TIMING_NOW (stop);
+      if (stop - start < best)
+	best = stop - start;
+    }
+  return best;
+}
+
+/* Return the smallest size between LOW and HIGH from which strategy
+   NEW is faster than strategy OLD at two consecutive measured sizes,
+   or 0 if there is none.  LOW and HIGH must be powers of 2 no smaller
+   than 4 * VEC_SIZE.  The measured sizes are the powers of 2 and the
+   midpoints between them, rounded up to a multiple of 4 * VEC_SIZE as
+   required by calibrate_run.  A size which rounds up to the previous
+   measured size is not measured again.  */
+static size_t
+calibrate_crossover (enum calibrate_strategy old,
+		     enum calibrate_strategy new, char *dst,
+		     const char *src, size_t low, size_t high,
+		     unsigned int vec_size)
+{
+  size_t found = 0;
+  size_t last = 0;
+  for (size_t n = low; n <= high;
+       n = (n & (n - 1)) == 0 ? n + n / 2 : n / 3 * 4)
+    {
+      size_t size = ALIGN_UP (n, 4 * vec_size);
+      if (size == last)
+	continue;
+      last = size;
+      if (calibrate_time (new, dst, src, size, vec_size)
+	  < calibrate_time (old, dst, src, size, vec_size))
+	{
+	  if (found != 0)
+	    return found;
+	  found = size;
+	}
+      else
+	found = 0;
+    }
+  return found;
+}
+
+/* Measure the sizes at which memmove and memset should switch to REP
+   MOVSB, REP STOSB and non-temporal stores and update the thresholds
+   pointed to by the arguments.  VEC_SIZE is the vector size used by
+   memmove.  */
+static void
+dl_calibrate_thresholds (const struct cpu_features *cpu_features,
+			 unsigned int vec_size,
+			 unsigned long int *non_temporal_threshold,
+			 unsigned int *rep_movsb_threshold,
+			 unsigned long int *rep_stosb_threshold)
+{
+  /* Search for the non-temporal threshold from about a quarter of the
+     default up to about four times the default.  */
+  size_t nt_low = 4 * 64;
+  while (nt_low * 8 <= *non_temporal_threshold)
+    nt_low *= 2;
+  size_t nt_high = nt_low * 16;
+  if (nt_high > CALIBRATE_NT_MAX)
+    nt_high = CALIBRATE_NT_MAX;
+
+  size_t size = nt_high > CALIBRATE_REP_MAX ? nt_high : CALIBRATE_REP_MAX;
+  long int ret = INTERNAL_SYSCALL_CALL (mmap, NULL, 2 * size,
+					PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS
+					| MAP_POPULATE, -1, 0);
+  if (INTERNAL_SYSCALL_ERROR_P (ret))
+    return;
+  char *dst = (char *) ret;
+  char *src = dst + size;
+
+  /* Use the measured crossover only if non-temporal stores become
+     faster within the searched range.  Otherwise the copy still fits
+     in the cache at four times the default and the default is kept,
+     since temporal stores beyond it would evict the data of the other
+     threads sharing the cache.  */
+  size_t n = calibrate_crossover (calibrate_vec_copy, calibrate_nt_copy,
+				  dst, src, nt_low, nt_high, vec_size);
+  if (n != 0)
+    *non_temporal_threshold = n < 0x4040 ? 0x4040 : n;
+
+  /* REP MOVSB and REP STOSB are used only with Enhanced REP MOVSB and
+     STOSB.  If they aren't faster than the vector loops at any
+     measured size, set the thresholds so that they aren't used.  */
+  size_t rep_low = 8 * vec_size;
+  if (CPU_FEATURE_USABLE_P (cpu_features, ERMS)
+      || CPU_FEATURE_USABLE_P (cpu_features, FSRM))
+    {
+      n = calibrate_crossover (calibrate_vec_copy, calibrate_rep_movsb,
+			       dst, src, rep_low, CALIBRATE_REP_MAX,
+			       vec_size);
+      *rep_movsb_threshold = n != 0 ? n : *non_temporal_threshold;
+    }
+  if (CPU_FEATURE_USABLE_P (cpu_features, ERMS))
+    {
+      n = calibrate_crossover (calibrate_vec_set, calibrate_rep_stosb,
+			       dst, src, rep_low, CALIBRATE_REP_MAX,
+			       vec_size);
+      *rep_stosb_threshold = n != 0 ? n : SIZE_MAX;
+    }
+
+  INTERNAL_SYSCALL_CALL (munmap, dst, 2 * size);
+}
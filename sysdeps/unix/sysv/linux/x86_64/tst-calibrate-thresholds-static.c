@@ -0,0 +1 @@
+#include "tst-calibrate-thresholds.c"
@@ -0,0 +1,61 @@
+/* Test that calibrated x86 string thresholds are passed to children.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <cpu-features.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+
+/* Return the value of the last setting of tunable NAME in TUNABLES, or
+   -1 if there is none.  */
+static long long int
+last_value (const char *tunables, const char *name)
+{
+  long long int value = -1;
+  size_t len = strlen (name);
+  for (const char *p = tunables; (p = strstr (p, name)) != NULL; p += len)
+    if ((p == tunables || p[-1] == ':') && p[len] == '=')
+      value = strtoull (p + len + 1, NULL, 10);
+  return value;
+}
+
+static int
+do_test (void)
+{
+  /* The test runs with glibc.cpu.x86_calibrate_thresholds=1.  */
+  const char *tunables = getenv ("GLIBC_TUNABLES");
+  TEST_VERIFY_EXIT (tunables != NULL);
+  printf ("info: GLIBC_TUNABLES=%s\n", tunables);
+
+  /* Child processes do not calibrate again, and use the thresholds
+     which this process uses.  */
+  TEST_COMPARE (last_value (tunables, "glibc.cpu.x86_calibrate_thresholds"),
+		0);
+  const struct cpu_features *cpu_features = __get_cpu_features ();
+  TEST_COMPARE (last_value (tunables, "glibc.cpu.x86_non_temporal_threshold"),
+		cpu_features->non_temporal_threshold);
+  TEST_COMPARE (last_value (tunables, "glibc.cpu.x86_rep_movsb_threshold"),
+		cpu_features->rep_movsb_threshold);
+  TEST_COMPARE (last_value (tunables, "glibc.cpu.x86_rep_stosb_threshold"),
+		cpu_features->rep_stosb_threshold);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
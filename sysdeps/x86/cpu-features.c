@@ -17,15 +17,19 @@
    <https://www.gnu.org/licenses/>.  */
 
 #include <dl-hwcap.h>
+#include <array_length.h>
 #include <libc-pointer-arith.h>
 #include <get-isa-level.h>
 #include <cacheinfo.h>
+#include <cpu-profiles.h>
 #include <dl-cacheinfo.h>
 #include <dl-minsigstacksize.h>
 
 #if HAVE_TUNABLES
 extern void TUNABLE_CALLBACK (set_hwcaps) (tunable_val_t *)
   attribute_hidden;
+extern void TUNABLE_CALLBACK (set_x86_profile) (tunable_val_t *)
+  attribute_hidden;
 
 # if CET_ENABLED
 extern void TUNABLE_CALLBACK (set_x86_ibt) (tunable_val_t *)
@@ -395,6 +399,30 @@ _Static_assert (((index_arch_Fast_Unaligned_Load
 		     == index_arch_Fast_Copy_Backward)),
 		"Incorrect index_arch_Fast_Unaligned_Load");
 
+/* Return the index of the first profile in cpu_profile_models which
+   matches the processor.  */
+static unsigned int
+find_cpu_profile (const struct cpu_features *cpu_features,
+		  enum cpu_features_kind kind, unsigned int family,
+		  unsigned int model)
+{
+  for (size_t i = 0; i < array_length (cpu_profile_models); i++)
+    {
+      const struct cpu_profile_model *m = &cpu_profile_models[i];
+      if (m->kind != kind || m->family != family
+	  || model < m->first_model || model > m->last_model)
+	continue;
+      if (m->need == cpu_profile_need_avx
+	  && !CPU_FEATURES_CPU_P (cpu_features, AVX))
+	continue;
+      if (m->need == cpu_profile_need_hybrid
+	  && !CPU_FEATURES_CPU_P (cpu_features, HYBRID))
+	continue;
+      return m->profile;
+    }
+  return cpu_profile_generic;
+}
+
 static inline void
 init_cpu_features (struct cpu_features *cpu_features)
 {
@@ -431,81 +459,6 @@ init_cpu_features (struct cpu_features *cpu_features)
       if (family == 0x06)
 	{
 	  model += extended_model;
-	  switch (model)
-	    {
-	    case 0x1c:
-	    case 0x26:
-	      /* BSF is slow on Atom.  */
-	      cpu_features->preferred[index_arch_Slow_BSF]
-		|= bit_arch_Slow_BSF;
-	      break;
-
-	    case 0x57:
-	      /* Knights Landing.  Enable Silvermont optimizations.  */
-
-	    case 0x7a:
-	      /* Unaligned load versions are faster than SSSE3
-		 on Goldmont Plus.  */
-
-	    case 0x5c:
-	    case 0x5f:
-	      /* Unaligned load versions are faster than SSSE3
-		 on Goldmont.  */
-
-	    case 0x4c:
-	    case 0x5a:
-	    case 0x75:
-	      /* Airmont is a die shrink of Silvermont.  */
-
-	    case 0x37:
-	    case 0x4a:
-	    case 0x4d:
-	    case 0x5d:
-	      /* Unaligned load versions are faster than SSSE3
-		 on Silvermont.  */
-	      cpu_features->preferred[index_arch_Fast_Unaligned_Load]
-		|= (bit_arch_Fast_Unaligned_Load
-		    | bit_arch_Fast_Unaligned_Copy
-		    | bit_arch_Prefer_PMINUB_for_stringop
-		    | bit_arch_Slow_SSE4_2);
-	      break;
-
-	    case 0x86:
-	    case 0x96:
-	    case 0x9c:
-	      /* Enable rep string instructions, unaligned load, unaligned
-	         copy, pminub and avoid SSE 4.2 on Tremont.  */
-	      cpu_features->preferred[index_arch_Fast_Rep_String]
-		|= (bit_arch_Fast_Rep_String
-		    | bit_arch_Fast_Unaligned_Load
-		    | bit_arch_Fast_Unaligned_Copy
-		    | bit_arch_Prefer_PMINUB_for_stringop
-		    | bit_arch_Slow_SSE4_2);
-	      break;
-
-	    default:
-	      /* Unknown family 0x06 processors.  Assuming this is one
-		 of Core i3/i5/i7 processors if AVX is available.  */
-	      if (!CPU_FEATURES_CPU_P (cpu_features, AVX))
-		break;
-	      /* Fall through.  */
-
-	    case 0x1a:
-	    case 0x1e:
-	    case 0x1f:
-	    case 0x25:
-	    case 0x2c:
-	    case 0x2e:
-	    case 0x2f:
-	      /* Rep string instructions, unaligned load, unaligned copy,
-		 and pminub are fast on Intel Core i3, i5 and i7.  */
-	      cpu_features->preferred[index_arch_Fast_Rep_String]
-		|= (bit_arch_Fast_Rep_String
-		    | bit_arch_Fast_Unaligned_Load
-		    | bit_arch_Fast_Unaligned_Copy
-		    | bit_arch_Prefer_PMINUB_for_stringop);
-	      break;
-	    }
 
 	 /* Disable TSX on some processors to avoid TSX on kernels that
 	    weren't updated with the latest microcode package (which
@@ -608,20 +561,6 @@ disable_tsx:
 	  CPU_FEATURE_SET_ACTIVE (cpu_features, FMA4);
 	}
 
-      if (family == 0x15)
-	{
-	  /* "Excavator"   */
-	  if (model >= 0x60 && model <= 0x7f)
-	  {
-	    cpu_features->preferred[index_arch_Fast_Unaligned_Load]
-	      |= (bit_arch_Fast_Unaligned_Load
-		  | bit_arch_Fast_Copy_Backward);
-
-	    /* Unaligned AVX loads are slower.*/
-	    cpu_features->preferred[index_arch_AVX_Fast_Unaligned_Load]
-	      &= ~bit_arch_AVX_Fast_Unaligned_Load;
-	  }
-	}
     }
   /* This spells out "CentaurHauls" or " Shanghai ".  */
   else if ((ebx == 0x746e6543 && ecx == 0x736c7561 && edx == 0x48727561)
@@ -683,6 +622,18 @@ disable_tsx:
       update_active (cpu_features);
     }
 
+  cpu_features->profile = find_cpu_profile (cpu_features, kind, family,
+					     model);
+#if HAVE_TUNABLES
+  TUNABLE_GET (x86_profile, tunable_val_t *,
+	       TUNABLE_CALLBACK (set_x86_profile));
+#endif
+  const struct cpu_profile *profile = &cpu_profiles[cpu_features->profile];
+  cpu_features->preferred[index_arch_Fast_Rep_String]
+    = ((cpu_features->preferred[index_arch_Fast_Rep_String]
+	| profile->preferred_set)
+       & ~profile->preferred_clear);
+
   /* Support i586 if CX8 is available.  */
   if (CPU_FEATURES_CPU_P (cpu_features, CX8))
     cpu_features->preferred[index_arch_I586] |= bit_arch_I586;
@@ -0,0 +1,201 @@
+/* Microarchitecture profiles for x86 memory and string functions.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _CPU_PROFILES_H
+#define _CPU_PROFILES_H
+
+#include <stdint.h>
+#include <cpu-features.h>
+
+/* A profile selects the preferred features, and with them the memmove,
+   memset and memcmp variants, together with the thresholds of the
+   string functions for a group of processors.  It is looked up in
+   cpu_profile_models by vendor, family and model, and can be
+   overridden with the glibc.cpu.x86_profile tunable.  */
+enum cpu_profile_index
+{
+  cpu_profile_generic,
+  cpu_profile_bonnell,
+  cpu_profile_silvermont,
+  cpu_profile_tremont,
+  cpu_profile_core,
+  cpu_profile_hybrid,
+  cpu_profile_excavator,
+  cpu_profile_zen,
+  cpu_profile_zen3,
+  cpu_profile_max
+};
+
+/* The names used by the tunable and ld.so --list-diagnostics.  This is
+   not an array of pointers, which would need relocations, because
+   init_cpu_features runs before relocation in static PIE.  */
+static const char cpu_profile_names[cpu_profile_max][12] =
+{
+  [cpu_profile_generic] = "generic",
+  [cpu_profile_bonnell] = "bonnell",
+  [cpu_profile_silvermont] = "silvermont",
+  [cpu_profile_tremont] = "tremont",
+  [cpu_profile_core] = "core",
+  [cpu_profile_hybrid] = "hybrid",
+  [cpu_profile_excavator] = "excavator",
+  [cpu_profile_zen] = "zen",
+  [cpu_profile_zen3] = "zen3",
+};
+
+struct cpu_profile
+{
+  /* Preferred features to set and to clear.  They all have the index
+     index_arch_Fast_Rep_String.  */
+  unsigned int preferred_set;
+  unsigned int preferred_clear;
+  /* If not zero, these replace the default thresholds derived from the
+     vector size and the cache sizes.  */
+  unsigned int rep_movsb_threshold;
+  unsigned long int rep_stosb_threshold;
+};
+
+_Static_assert (PREFERRED_FEATURE_INDEX_MAX == 1,
+		"cpu_profile only covers one preferred feature index");
+
+static const struct cpu_profile cpu_profiles[cpu_profile_max] =
+{
+  [cpu_profile_bonnell] =
+    {
+      /* BSF is slow on Atom.  */
+      .preferred_set = bit_arch_Slow_BSF,
+    },
+  [cpu_profile_silvermont] =
+    {
+      /* Unaligned load versions are faster than SSSE3 on Silvermont,
+	 Airmont, Goldmont, Goldmont Plus and Knights Landing.  */
+      .preferred_set = (bit_arch_Fast_Unaligned_Load
+			| bit_arch_Fast_Unaligned_Copy
+			| bit_arch_Prefer_PMINUB_for_stringop
+			| bit_arch_Slow_SSE4_2),
+    },
+  [cpu_profile_tremont] =
+    {
+      /* Enable rep string instructions, unaligned load, unaligned
+	 copy, pminub and avoid SSE 4.2 on Tremont.  */
+      .preferred_set = (bit_arch_Fast_Rep_String
+			| bit_arch_Fast_Unaligned_Load
+			| bit_arch_Fast_Unaligned_Copy
+			| bit_arch_Prefer_PMINUB_for_stringop
+			| bit_arch_Slow_SSE4_2),
+    },
+  [cpu_profile_core] =
+    {
+      /* Rep string instructions, unaligned load, unaligned copy, and
+	 pminub are fast on Intel Core i3, i5 and i7.  */
+      .preferred_set = (bit_arch_Fast_Rep_String
+			| bit_arch_Fast_Unaligned_Load
+			| bit_arch_Fast_Unaligned_Copy
+			| bit_arch_Prefer_PMINUB_for_stringop),
+    },
+  [cpu_profile_hybrid] =
+    {
+      /* Processors with performance and efficient cores.  The string
+	 functions must suit both kinds of cores, so they use the same
+	 settings as Core.  */
+      .preferred_set = (bit_arch_Fast_Rep_String
+			| bit_arch_Fast_Unaligned_Load
+			| bit_arch_Fast_Unaligned_Copy
+			| bit_arch_Prefer_PMINUB_for_stringop),
+    },
+  [cpu_profile_excavator] =
+    {
+      /* Unaligned AVX loads are slower on Excavator.  */
+      .preferred_set = (bit_arch_Fast_Unaligned_Load
+			| bit_arch_Fast_Copy_Backward),
+      .preferred_clear = bit_arch_AVX_Fast_Unaligned_Load,
+    },
+  [cpu_profile_zen3] =
+    {
+      /* The vector loop of memset is faster than REP STOSB on Zen 3
+	 and later.  */
+      .rep_stosb_threshold = SIZE_MAX,
+    },
+};
+
+/* The profile is only selected if the processor has this feature.  */
+enum
+{
+  cpu_profile_need_none,
+  cpu_profile_need_avx,
+  cpu_profile_need_hybrid
+};
+
+struct cpu_profile_model
+{
+  enum cpu_features_kind kind;
+  unsigned char family;
+  unsigned char first_model;
+  unsigned char last_model;
+  unsigned char need;
+  unsigned char profile;
+};
+
+/* The first matching entry is used.  The model of Intel family 0x06
+   processors includes the extended model.  */
+static const struct cpu_profile_model cpu_profile_models[] =
+{
+  { arch_kind_intel, 0x06, 0x1c, 0x1c, 0, cpu_profile_bonnell },
+  { arch_kind_intel, 0x06, 0x26, 0x26, 0, cpu_profile_bonnell },
+  /* Knights Landing.  */
+  { arch_kind_intel, 0x06, 0x57, 0x57, 0, cpu_profile_silvermont },
+  /* Goldmont Plus.  */
+  { arch_kind_intel, 0x06, 0x7a, 0x7a, 0, cpu_profile_silvermont },
+  /* Goldmont.  */
+  { arch_kind_intel, 0x06, 0x5c, 0x5c, 0, cpu_profile_silvermont },
+  { arch_kind_intel, 0x06, 0x5f, 0x5f, 0, cpu_profile_silvermont },
+  /* Airmont.  */
+  { arch_kind_intel, 0x06, 0x4c, 0x4c, 0, cpu_profile_silvermont },
+  { arch_kind_intel, 0x06, 0x5a, 0x5a, 0, cpu_profile_silvermont },
+  { arch_kind_intel, 0x06, 0x75, 0x75, 0, cpu_profile_silvermont },
+  /* Silvermont.  */
+  { arch_kind_intel, 0x06, 0x37, 0x37, 0, cpu_profile_silvermont },
+  { arch_kind_intel, 0x06, 0x4a, 0x4a, 0, cpu_profile_silvermont },
+  { arch_kind_intel, 0x06, 0x4d, 0x4d, 0, cpu_profile_silvermont },
+  { arch_kind_intel, 0x06, 0x5d, 0x5d, 0, cpu_profile_silvermont },
+  /* Tremont.  */
+  { arch_kind_intel, 0x06, 0x86, 0x86, 0, cpu_profile_tremont },
+  { arch_kind_intel, 0x06, 0x96, 0x96, 0, cpu_profile_tremont },
+  { arch_kind_intel, 0x06, 0x9c, 0x9c, 0, cpu_profile_tremont },
+  /* Nehalem and Westmere.  */
+  { arch_kind_intel, 0x06, 0x1a, 0x1a, 0, cpu_profile_core },
+  { arch_kind_intel, 0x06, 0x1e, 0x1f, 0, cpu_profile_core },
+  { arch_kind_intel, 0x06, 0x25, 0x25, 0, cpu_profile_core },
+  { arch_kind_intel, 0x06, 0x2c, 0x2c, 0, cpu_profile_core },
+  { arch_kind_intel, 0x06, 0x2e, 0x2f, 0, cpu_profile_core },
+  /* Alder Lake, Raptor Lake, Meteor Lake and later.  */
+  { arch_kind_intel, 0x06, 0x00, 0xff, cpu_profile_need_hybrid,
+    cpu_profile_hybrid },
+  /* Unknown family 0x06 processors.  Assume that this is one of the
+     Core i3/i5/i7 processors if AVX is available.  */
+  { arch_kind_intel, 0x06, 0x00, 0xff, cpu_profile_need_avx,
+    cpu_profile_core },
+  { arch_kind_amd, 0x15, 0x60, 0x7f, 0, cpu_profile_excavator },
+  /* Zen, Zen+ and Zen 2, and Hygon Dhyana.  */
+  { arch_kind_amd, 0x17, 0x00, 0xff, 0, cpu_profile_zen },
+  { arch_kind_amd, 0x18, 0x00, 0xff, 0, cpu_profile_zen },
+  /* Zen 3, Zen 4 and Zen 5.  */
+  { arch_kind_amd, 0x19, 0x00, 0xff, 0, cpu_profile_zen3 },
+  { arch_kind_amd, 0x1a, 0x00, 0xff, 0, cpu_profile_zen3 },
+};
+
+#endif /* cpu-profiles.h */
@@ -24,6 +24,7 @@
 # include <elf/dl-tunables.h>
 # include <string.h>
 # include <cpu-features.h>
+# include <cpu-profiles.h>
 # include <ldsodefs.h>
 
 /* We can't use IFUNC memcmp nor strlen in init_cpu_features from libc.a
@@ -286,6 +287,30 @@ TUNABLE_CALLBACK (set_hwcaps) (tunable_val_t *valp)
   while (*p != '\0');
 }
 
+/* This runs before IRELATIVE relocations are processed in static
+   binaries, so the loop must not be turned into a call to strlen.  */
+attribute_hidden inhibit_loop_to_libcall
+void
+TUNABLE_CALLBACK (set_x86_profile) (tunable_val_t *valp)
+{
+  /* GLIBC_TUNABLES=glibc.cpu.x86_profile=name selects the profile NAME
+     from cpu_profile_names instead of the one which matches the
+     processor.  Unknown names are ignored.  */
+  const char *p = valp->strval;
+  size_t len = 0;
+  while (p[len] != '\0')
+    len++;
+  if (len >= sizeof (cpu_profile_names[0]))
+    return;
+
+  for (unsigned int i = 0; i < cpu_profile_max; i++)
+    if (!DEFAULT_MEMCMP (p, cpu_profile_names[i], len + 1))
+      {
+	GLRO(dl_x86_cpu_features).profile = i;
+	break;
+      }
+}
+
 # if CET_ENABLED
 
 attribute_hidden
@@ -16,6 +16,10 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <array_length.h>
+#include <cpu-profiles.h>
+#include <dl-calibrate-thresholds.h>
+
 static const struct intel_02_cache_info
 {
   unsigned char idx;
@@ -865,6 +869,8 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
 #if HAVE_TUNABLES
   /* NB: The REP MOVSB threshold must be greater than VEC_SIZE * 8.  */
   unsigned int minimum_rep_movsb_threshold;
+  /* The vector size used by memmove, for threshold calibration.  */
+  unsigned int vec_size;
 #endif
   /* NB: The default REP MOVSB threshold is 4096 * (VEC_SIZE / 16) for
      VEC_SIZE == 64 or 32.  For VEC_SIZE == 16, the default REP MOVSB
@@ -875,6 +881,7 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
     {
       rep_movsb_threshold = 4096 * (64 / 16);
 #if HAVE_TUNABLES
+      vec_size = 64;
       minimum_rep_movsb_threshold = 64 * 8;
 #endif
     }
@@ -883,6 +890,7 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
     {
       rep_movsb_threshold = 4096 * (32 / 16);
 #if HAVE_TUNABLES
+      vec_size = 32;
       minimum_rep_movsb_threshold = 32 * 8;
 #endif
     }
@@ -890,6 +898,7 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
     {
       rep_movsb_threshold = 2048 * (16 / 16);
 #if HAVE_TUNABLES
+      vec_size = 16;
       minimum_rep_movsb_threshold = 16 * 8;
 #endif
     }
@@ -901,6 +910,13 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
   /* The default threshold to use Enhanced REP STOSB.  */
   unsigned long int rep_stosb_threshold = 2048;
 
+  /* The microarchitecture profile may replace the defaults.  */
+  const struct cpu_profile *profile = &cpu_profiles[cpu_features->profile];
+  if (profile->rep_movsb_threshold != 0)
+    rep_movsb_threshold = profile->rep_movsb_threshold;
+  if (profile->rep_stosb_threshold != 0)
+    rep_stosb_threshold = profile->rep_stosb_threshold;
+
 #if HAVE_TUNABLES
   long int tunable_size;
 
@@ -914,6 +930,14 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
   if (tunable_size != 0)
     shared = tunable_size;
 
+  /* Replace the defaults derived from the cache sizes with thresholds
+     measured on this machine if requested.  Thresholds set explicitly
+     by the tunables below still take precedence.  */
+  bool calibrate = TUNABLE_GET (x86_calibrate_thresholds, int32_t, NULL) != 0;
+  if (calibrate)
+    dl_calibrate_thresholds (cpu_features, vec_size, &non_temporal_threshold,
+			     &rep_movsb_threshold, &rep_stosb_threshold);
+
   tunable_size = TUNABLE_GET (x86_non_temporal_threshold, long int, NULL);
   /* NB: Ignore the default value 0.  */
   if (tunable_size != 0)
@@ -923,11 +947,10 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
   if (tunable_size > minimum_rep_movsb_threshold)
     rep_movsb_threshold = tunable_size;
 
-  /* NB: The default value of the x86_rep_stosb_threshold tunable is the
-     same as the default value of __x86_rep_stosb_threshold and the
-     minimum value is fixed.  */
-  rep_stosb_threshold = TUNABLE_GET (x86_rep_stosb_threshold,
-				     long int, NULL);
+  tunable_size = TUNABLE_GET (x86_rep_stosb_threshold, long int, NULL);
+  /* NB: Ignore the default value 0.  The minimum value is fixed.  */
+  if (tunable_size != 0)
+    rep_stosb_threshold = tunable_size;
 
   TUNABLE_SET_WITH_BOUNDS (x86_data_cache_size, data, 0, SIZE_MAX);
   TUNABLE_SET_WITH_BOUNDS (x86_shared_cache_size, shared, 0, SIZE_MAX);
@@ -943,6 +966,21 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
 			   minimum_rep_movsb_threshold, SIZE_MAX);
   TUNABLE_SET_WITH_BOUNDS (x86_rep_stosb_threshold, rep_stosb_threshold, 1,
 			   SIZE_MAX);
+
+  /* Pass the measured thresholds to child processes in GLIBC_TUNABLES,
+     so that they do not have to be measured again.  */
+  if (calibrate)
+    {
+      static const tunable_id_t measured[] =
+	{
+	  TUNABLE_ENUM_NAME (glibc, cpu, x86_calibrate_thresholds),
+	  TUNABLE_ENUM_NAME (glibc, cpu, x86_non_temporal_threshold),
+	  TUNABLE_ENUM_NAME (glibc, cpu, x86_rep_movsb_threshold),
+	  TUNABLE_ENUM_NAME (glibc, cpu, x86_rep_stosb_threshold),
+	};
+      TUNABLE_SET (x86_calibrate_thresholds, 0);
+      __tunables_export (measured, array_length (measured));
+    }
 #endif
 
   unsigned long int rep_movsb_stop_threshold;
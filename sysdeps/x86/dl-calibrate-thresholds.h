@@ -0,0 +1,31 @@
+/* Calibrate the x86 string function thresholds.  Generic version.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Measure the sizes at which memmove and memset should switch to REP
+   MOVSB, REP STOSB and non-temporal stores and update the thresholds
+   pointed to by the arguments.  VEC_SIZE is the vector size used by
+   memmove.  Calibration isn't supported here, so the thresholds derived
+   from the cache sizes are kept.  */
+static inline void
+dl_calibrate_thresholds (const struct cpu_features *cpu_features,
+			 unsigned int vec_size,
+			 unsigned long int *non_temporal_threshold,
+			 unsigned int *rep_movsb_threshold,
+			 unsigned long int *rep_stosb_threshold)
+{
+}
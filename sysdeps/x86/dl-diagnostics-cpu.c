@@ -16,6 +16,7 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <cpu-profiles.h>
 #include <dl-diagnostics.h>
 #include <ldsodefs.h>
 
@@ -73,6 +74,13 @@ _dl_diagnostics_cpu (void)
 #include "cpu-features-preferred_feature_index_1.def"
 #undef BIT
 
+  print_cpu_features_value ("profile", cpu_features->profile);
+  if (cpu_features->profile < cpu_profile_max)
+    {
+      _dl_printf ("x86.cpu_features.");
+      _dl_diagnostics_print_labeled_string
+        ("profile_name", cpu_profile_names[cpu_features->profile]);
+    }
   print_cpu_features_value ("isa_1", cpu_features->isa_1);
   print_cpu_features_value ("xsave_state_size",
                             cpu_features->xsave_state_size);
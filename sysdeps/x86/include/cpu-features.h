@@ -865,6 +865,8 @@ struct cpu_features
   struct cpu_features_basic basic;
   struct cpuid_feature_internal features[CPUID_INDEX_MAX];
   unsigned int preferred[PREFERRED_FEATURE_INDEX_MAX];
+  /* Index of the microarchitecture profile in cpu_profiles.  */
+  unsigned int profile;
   /* X86 micro-architecture ISA levels.  */
   unsigned int isa_1;
   /* The state size for XSAVEC or XSAVE.  The type must be unsigned long
@@ -0,0 +1 @@
+#include "tst-x86-profile.c"
@@ -0,0 +1,116 @@
+/* Test the glibc.cpu.x86_profile tunable.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <cpu-profiles.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <support/capture_subprocess.h>
+#include <support/check.h>
+#include <support/support.h>
+
+static int restart;
+#define CMDLINE_OPTIONS \
+  { "restart", no_argument, &restart, 1 },
+
+/* Check that the process runs with profile EXPECTED and that the
+   profile has been applied.  */
+static int
+handle_restart (unsigned int expected)
+{
+  const struct cpu_features *cpu_features = __get_cpu_features ();
+  TEST_COMPARE (cpu_features->profile, expected);
+  TEST_VERIFY_EXIT (expected < cpu_profile_max);
+
+  const struct cpu_profile *profile = &cpu_profiles[expected];
+  unsigned int preferred
+    = cpu_features->preferred[index_arch_Fast_Rep_String];
+  TEST_COMPARE (preferred & profile->preferred_set, profile->preferred_set);
+  TEST_COMPARE (preferred & profile->preferred_clear, 0);
+  if (profile->rep_movsb_threshold != 0)
+    TEST_COMPARE (cpu_features->rep_movsb_threshold,
+		  profile->rep_movsb_threshold);
+  if (profile->rep_stosb_threshold != 0)
+    TEST_COMPARE (cpu_features->rep_stosb_threshold,
+		  profile->rep_stosb_threshold);
+
+  return 0;
+}
+
+/* Run the test again with glibc.cpu.x86_profile set to NAME, and check
+   that it uses profile EXPECTED.  ARGV is the command which runs the
+   test.  */
+static void
+check_profile (char **argv, int argc, const char *name, unsigned int expected)
+{
+  char *tunables = xasprintf ("glibc.cpu.x86_profile=%s", name);
+  setenv ("GLIBC_TUNABLES", tunables, 1);
+  char *index = xasprintf ("%u", expected);
+
+  char *spargv[10];
+  int i = 0;
+  for (; i < argc - 1; i++)
+    spargv[i] = argv[i + 1];
+  spargv[i++] = (char *) "--direct";
+  spargv[i++] = (char *) "--restart";
+  spargv[i++] = index;
+  spargv[i] = NULL;
+  TEST_VERIFY_EXIT (i < array_length (spargv));
+
+  printf ("info: checking %s\n", tunables);
+  struct support_capture_subprocess result
+    = support_capture_subprogram (spargv[0], spargv);
+  support_capture_subprocess_check (&result, name, 0, sc_allow_stdout);
+  support_capture_subprocess_free (&result);
+
+  free (index);
+  free (tunables);
+}
+
+static int
+do_test (int argc, char *argv[])
+{
+  /* We must have either:
+     - One or four parameters left if called initially:
+       + path to ld.so         optional
+       + "--library-path"      optional
+       + the library path      optional
+       + the application name
+     - The expected profile if restarted.  */
+
+  if (restart)
+    {
+      TEST_COMPARE (argc, 2);
+      return handle_restart (atoi (argv[1]));
+    }
+
+  for (unsigned int i = 0; i < cpu_profile_max; i++)
+    check_profile (argv, argc, cpu_profile_names[i], i);
+
+  /* An unknown name keeps the profile which matches the processor.  */
+  unsigned int detected = __get_cpu_features ()->profile;
+  printf ("info: detected profile %s\n", cpu_profile_names[detected]);
+  check_profile (argv, argc, "nosuchcpu", detected);
+  check_profile (argv, argc, "zen3x", detected);
+
+  return 0;
+}
+
+#define TEST_FUNCTION_ARGV do_test
+#include <support/test-driver.c>
@@ -109,6 +109,17 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     1,
 				     __memcmp_sse2))
 
+  /* Support sysdeps/x86_64/multiarch/memccpy.c.  */
+  IFUNC_IMPL (i, name, memccpy,
+	      IFUNC_IMPL_ADD (array, i, memccpy,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __memccpy_evex)
+	      IFUNC_IMPL_ADD (array, i, memccpy, CPU_FEATURE_USABLE (AVX2),
+			      __memccpy_avx2)
+	      IFUNC_IMPL_ADD (array, i, memccpy, 1, __memccpy_generic))
+
 #ifdef SHARED
   /* Support sysdeps/x86_64/multiarch/memmove_chk.c.  */
   IFUNC_IMPL (i, name, __memmove_chk,
@@ -157,6 +168,30 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     __memmove_chk_sse2_unaligned_erms))
 #endif
 
+  /* Support sysdeps/x86_64/multiarch/memmem.c.  */
+  IFUNC_IMPL (i, name, memmem,
+	      IFUNC_IMPL_ADD (array, i, memmem,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __memmem_evex)
+	      IFUNC_IMPL_ADD (array, i, memmem, CPU_FEATURE_USABLE (AVX2),
+			      __memmem_avx2)
+	      IFUNC_IMPL_ADD (array, i, memmem, 1, __memmem_generic))
+
+  /* Support sysdeps/x86_64/multiarch/memmem_set_search.c.  */
+  IFUNC_IMPL (i, name, memmem_set_search,
+	      IFUNC_IMPL_ADD (array, i, memmem_set_search,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __memmem_set_search_evex)
+	      IFUNC_IMPL_ADD (array, i, memmem_set_search,
+			      CPU_FEATURE_USABLE (AVX2),
+			      __memmem_set_search_avx2)
+	      IFUNC_IMPL_ADD (array, i, memmem_set_search, 1,
+			      __memmem_set_search_generic))
+
   /* Support sysdeps/x86_64/multiarch/memmove.c.  */
   IFUNC_IMPL (i, name, memmove,
 	      IFUNC_IMPL_ADD (array, i, memmove, 1,
@@ -374,6 +409,19 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     1,
 				     __strlen_sse2))
 
+  /* Support sysdeps/x86_64/multiarch/strlen_batch.c.  */
+  IFUNC_IMPL (i, name, strlen_batch,
+	      IFUNC_IMPL_ADD (array, i, strlen_batch,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __strlen_batch_evex)
+	      IFUNC_IMPL_ADD (array, i, strlen_batch,
+			      CPU_FEATURE_USABLE (AVX2),
+			      __strlen_batch_avx2)
+	      IFUNC_IMPL_ADD (array, i, strlen_batch, 1,
+			      __strlen_batch_generic))
+
   /* Support sysdeps/x86_64/multiarch/strnlen.c.  */
   IFUNC_IMPL (i, name, strnlen,
 	      X86_IFUNC_IMPL_ADD_V4 (array, i, strnlen,
@@ -488,6 +536,17 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     1,
 				     __strcasecmp_l_sse2))
 
+  /* Support sysdeps/x86_64/multiarch/strcasestr.c.  */
+  IFUNC_IMPL (i, name, strcasestr,
+	      IFUNC_IMPL_ADD (array, i, strcasestr,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __strcasestr_evex)
+	      IFUNC_IMPL_ADD (array, i, strcasestr, CPU_FEATURE_USABLE (AVX2),
+			      __strcasestr_avx2)
+	      IFUNC_IMPL_ADD (array, i, strcasestr, 1, __strcasestr_generic))
+
   /* Support sysdeps/x86_64/multiarch/strcat.c.  */
   IFUNC_IMPL (i, name, strcat,
 	      X86_IFUNC_IMPL_ADD_V4 (array, i, strcat,
@@ -603,6 +662,19 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     1,
 				     __strcmp_sse2))
 
+  /* Support sysdeps/x86_64/multiarch/strcmp_batch.c.  */
+  IFUNC_IMPL (i, name, strcmp_batch,
+	      IFUNC_IMPL_ADD (array, i, strcmp_batch,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __strcmp_batch_evex)
+	      IFUNC_IMPL_ADD (array, i, strcmp_batch,
+			      CPU_FEATURE_USABLE (AVX2),
+			      __strcmp_batch_avx2)
+	      IFUNC_IMPL_ADD (array, i, strcmp_batch, 1,
+			      __strcmp_batch_generic))
+
   /* Support sysdeps/x86_64/multiarch/strcpy.c.  */
   IFUNC_IMPL (i, name, strcpy,
 	      X86_IFUNC_IMPL_ADD_V4 (array, i, strcpy,
@@ -630,6 +702,13 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
   IFUNC_IMPL (i, name, strcspn,
 	      /* All implementations of strcspn are built at all ISA
 	         levels.  */
+	      IFUNC_IMPL_ADD (array, i, strcspn,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __strcspn_evex)
+	      IFUNC_IMPL_ADD (array, i, strcspn, CPU_FEATURE_USABLE (AVX2),
+			      __strcspn_avx2)
 	      IFUNC_IMPL_ADD (array, i, strcspn, CPU_FEATURE_USABLE (SSE4_2),
 			      __strcspn_sse42)
 	      IFUNC_IMPL_ADD (array, i, strcspn, 1, __strcspn_generic))
@@ -722,6 +801,13 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
   IFUNC_IMPL (i, name, strpbrk,
 	      /* All implementations of strpbrk are built at all ISA
 	         levels.  */
+	      IFUNC_IMPL_ADD (array, i, strpbrk,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __strpbrk_evex)
+	      IFUNC_IMPL_ADD (array, i, strpbrk, CPU_FEATURE_USABLE (AVX2),
+			      __strpbrk_avx2)
 	      IFUNC_IMPL_ADD (array, i, strpbrk, CPU_FEATURE_USABLE (SSE4_2),
 			      __strpbrk_sse42)
 	      IFUNC_IMPL_ADD (array, i, strpbrk, 1, __strpbrk_generic))
@@ -731,10 +817,39 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
   IFUNC_IMPL (i, name, strspn,
 	      /* All implementations of strspn are built at all ISA
 	         levels.  */
+	      IFUNC_IMPL_ADD (array, i, strspn,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __strspn_evex)
+	      IFUNC_IMPL_ADD (array, i, strspn, CPU_FEATURE_USABLE (AVX2),
+			      __strspn_avx2)
 	      IFUNC_IMPL_ADD (array, i, strspn, CPU_FEATURE_USABLE (SSE4_2),
 			      __strspn_sse42)
 	      IFUNC_IMPL_ADD (array, i, strspn, 1, __strspn_generic))
 
+  /* Support sysdeps/x86_64/multiarch/strsep.c.  */
+  IFUNC_IMPL (i, name, strsep,
+	      IFUNC_IMPL_ADD (array, i, strsep,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __strsep_evex)
+	      IFUNC_IMPL_ADD (array, i, strsep, CPU_FEATURE_USABLE (AVX2),
+			      __strsep_avx2)
+	      IFUNC_IMPL_ADD (array, i, strsep, 1, __strsep_generic))
+
+  /* Support sysdeps/x86_64/multiarch/strtok_r.c.  */
+  IFUNC_IMPL (i, name, strtok_r,
+	      IFUNC_IMPL_ADD (array, i, strtok_r,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __strtok_r_evex)
+	      IFUNC_IMPL_ADD (array, i, strtok_r, CPU_FEATURE_USABLE (AVX2),
+			      __strtok_r_avx2)
+	      IFUNC_IMPL_ADD (array, i, strtok_r, 1, __strtok_r_generic))
+
   /* Support sysdeps/x86_64/multiarch/strstr.c.  */
   IFUNC_IMPL (i, name, strstr,
               IFUNC_IMPL_ADD (array, i, strstr,
@@ -768,6 +883,17 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     1,
 				     __wcschr_sse2))
 
+  /* Support sysdeps/x86_64/multiarch/wcspbrk.c.  */
+  IFUNC_IMPL (i, name, wcspbrk,
+	      IFUNC_IMPL_ADD (array, i, wcspbrk,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __wcspbrk_evex)
+	      IFUNC_IMPL_ADD (array, i, wcspbrk, CPU_FEATURE_USABLE (AVX2),
+			      __wcspbrk_avx2)
+	      IFUNC_IMPL_ADD (array, i, wcspbrk, 1, __wcspbrk_generic))
+
   /* Support sysdeps/x86_64/multiarch/wcsrchr.c.  */
   IFUNC_IMPL (i, name, wcsrchr,
 	      X86_IFUNC_IMPL_ADD_V4 (array, i, wcsrchr,
@@ -808,6 +934,17 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     1,
 				     __wcscmp_sse2))
 
+  /* Support sysdeps/x86_64/multiarch/wcsspn.c.  */
+  IFUNC_IMPL (i, name, wcsspn,
+	      IFUNC_IMPL_ADD (array, i, wcsspn,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __wcsspn_evex)
+	      IFUNC_IMPL_ADD (array, i, wcsspn, CPU_FEATURE_USABLE (AVX2),
+			      __wcsspn_avx2)
+	      IFUNC_IMPL_ADD (array, i, wcsspn, 1, __wcsspn_generic))
+
   /* Support sysdeps/x86_64/multiarch/wcsncmp.c.  */
   IFUNC_IMPL (i, name, wcsncmp,
 	      X86_IFUNC_IMPL_ADD_V4 (array, i, wcsncmp,
@@ -833,6 +970,13 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 	      /* ISA V4 wrapper for SSSE3 implementation because
 	         the SSSE3 implementation is also used at ISA
 	         level 3/4.  */
+	      IFUNC_IMPL_ADD (array, i, wcscpy,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __wcscpy_evex)
+	      IFUNC_IMPL_ADD (array, i, wcscpy, CPU_FEATURE_USABLE (AVX2),
+			      __wcscpy_avx2)
 	      X86_IFUNC_IMPL_ADD_V4 (array, i, wcscpy,
 				     CPU_FEATURE_USABLE (SSSE3),
 				     __wcscpy_ssse3)
@@ -840,6 +984,61 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     1,
 				     __wcscpy_generic))
 
+  /* Support sysdeps/x86_64/multiarch/wcpcpy.c.  */
+  IFUNC_IMPL (i, name, wcpcpy,
+	      IFUNC_IMPL_ADD (array, i, wcpcpy,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __wcpcpy_evex)
+	      IFUNC_IMPL_ADD (array, i, wcpcpy, CPU_FEATURE_USABLE (AVX2),
+			      __wcpcpy_avx2)
+	      IFUNC_IMPL_ADD (array, i, wcpcpy, 1, __wcpcpy_generic))
+
+  /* Support sysdeps/x86_64/multiarch/wcscat.c.  */
+  IFUNC_IMPL (i, name, wcscat,
+	      IFUNC_IMPL_ADD (array, i, wcscat,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __wcscat_evex)
+	      IFUNC_IMPL_ADD (array, i, wcscat, CPU_FEATURE_USABLE (AVX2),
+			      __wcscat_avx2)
+	      IFUNC_IMPL_ADD (array, i, wcscat, 1, __wcscat_generic))
+
+  /* Support sysdeps/x86_64/multiarch/wcsncat.c.  */
+  IFUNC_IMPL (i, name, wcsncat,
+	      IFUNC_IMPL_ADD (array, i, wcsncat,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __wcsncat_evex)
+	      IFUNC_IMPL_ADD (array, i, wcsncat, CPU_FEATURE_USABLE (AVX2),
+			      __wcsncat_avx2)
+	      IFUNC_IMPL_ADD (array, i, wcsncat, 1, __wcsncat_generic))
+
+  /* Support sysdeps/x86_64/multiarch/wcsncpy.c.  */
+  IFUNC_IMPL (i, name, wcsncpy,
+	      IFUNC_IMPL_ADD (array, i, wcsncpy,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __wcsncpy_evex)
+	      IFUNC_IMPL_ADD (array, i, wcsncpy, CPU_FEATURE_USABLE (AVX2),
+			      __wcsncpy_avx2)
+	      IFUNC_IMPL_ADD (array, i, wcsncpy, 1, __wcsncpy_generic))
+
+  /* Support sysdeps/x86_64/multiarch/wcscspn.c.  */
+  IFUNC_IMPL (i, name, wcscspn,
+	      IFUNC_IMPL_ADD (array, i, wcscspn,
+			      (CPU_FEATURE_USABLE (AVX512VL)
+			       && CPU_FEATURE_USABLE (AVX512BW)
+			       && CPU_FEATURE_USABLE (AVX2)),
+			      __wcscspn_evex)
+	      IFUNC_IMPL_ADD (array, i, wcscspn, CPU_FEATURE_USABLE (AVX2),
+			      __wcscspn_avx2)
+	      IFUNC_IMPL_ADD (array, i, wcscspn, 1, __wcscspn_generic))
+
   /* Support sysdeps/x86_64/multiarch/wcslen.c.  */
   IFUNC_IMPL (i, name, wcslen,
 	      X86_IFUNC_IMPL_ADD_V4 (array, i, wcslen,
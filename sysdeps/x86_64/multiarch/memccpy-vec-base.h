@@ -0,0 +1,195 @@
+/* Vectorized memccpy.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* This file is included by the AVX2 and EVEX variants of memccpy.
+   The includer defines MEMCCPY as the name of the function to define
+   and USE_EVEX to use AVX512VL/AVX512BW masked loads and stores.
+
+   The source is searched and copied in the same pass: each vector is
+   compared with the byte and stored unless it contains it, in which
+   case only the bytes up to and including the byte are stored.  */
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+#define VEC_SIZE 32
+#define PAGE_SIZE 4096
+
+/* Return the bit mask of the bytes of V equal to the bytes of C.  */
+static inline uint32_t
+match (__m256i v, __m256i c)
+{
+#ifdef USE_EVEX
+  return _mm256_cmpeq_epi8_mask (v, c);
+#else
+  return _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (v, c));
+#endif
+}
+
+/* Copy N bytes from S to D, where N is at most VEC_SIZE, with two
+   possibly overlapping moves of the same size.  */
+static inline void
+copy_short (unsigned char *d, const unsigned char *s, size_t n)
+{
+  if (n >= 16)
+    {
+      __m128i a = _mm_loadu_si128 ((const __m128i *) s);
+      __m128i b = _mm_loadu_si128 ((const __m128i *) (s + n - 16));
+      _mm_storeu_si128 ((__m128i *) d, a);
+      _mm_storeu_si128 ((__m128i *) (d + n - 16), b);
+    }
+  else if (n >= 8)
+    {
+      uint64_t a, b;
+      __builtin_memcpy (&a, s, 8);
+      __builtin_memcpy (&b, s + n - 8, 8);
+      __builtin_memcpy (d, &a, 8);
+      __builtin_memcpy (d + n - 8, &b, 8);
+    }
+  else if (n >= 4)
+    {
+      uint32_t a, b;
+      __builtin_memcpy (&a, s, 4);
+      __builtin_memcpy (&b, s + n - 4, 4);
+      __builtin_memcpy (d, &a, 4);
+      __builtin_memcpy (d + n - 4, &b, 4);
+    }
+  else if (n >= 2)
+    {
+      uint16_t a, b;
+      __builtin_memcpy (&a, s, 2);
+      __builtin_memcpy (&b, s + n - 2, 2);
+      __builtin_memcpy (d, &a, 2);
+      __builtin_memcpy (d + n - 2, &b, 2);
+    }
+  else if (n == 1)
+    *d = *s;
+}
+
+/* Store the first N bytes of V, which was loaded from S, to D.  */
+static inline void
+store_head (unsigned char *d, const unsigned char *s, __m256i v,
+	    size_t n)
+{
+#ifdef USE_EVEX
+  _mm256_mask_storeu_epi8 (d, n == VEC_SIZE ? -1 : (1U << n) - 1, v);
+#else
+  copy_short (d, s, n);
+#endif
+}
+
+void *
+MEMCCPY (void *__restrict dest, const void *__restrict src, int c,
+	 size_t n)
+{
+  unsigned char *d = dest;
+  const unsigned char *s = src;
+  const __m256i vc = _mm256_set1_epi8 (c);
+  __m256i v;
+  uint32_t mask;
+  size_t len;
+
+  if (n < VEC_SIZE)
+    {
+      if (n == 0)
+	return NULL;
+#ifdef USE_EVEX
+      /* Masked loads do not fault on the bytes which are masked
+	 out.  */
+      uint32_t valid = (1U << n) - 1;
+      v = _mm256_maskz_loadu_epi8 (valid, s);
+      mask = _mm256_mask_cmpeq_epi8_mask (valid, v, vc);
+#else
+      /* Do not read across a page boundary unless the page holds the
+	 end of the source.  Otherwise load the vector ending at the
+	 end of the source, which then starts in the page of S.  */
+      if (((uintptr_t) s & (PAGE_SIZE - 1)) <= PAGE_SIZE - VEC_SIZE)
+	{
+	  v = _mm256_loadu_si256 ((const __m256i *) s);
+	  mask = match (v, vc) & ((1U << n) - 1);
+	}
+      else
+	{
+	  v = _mm256_loadu_si256 ((const __m256i *) (s + n - VEC_SIZE));
+	  mask = match (v, vc) >> (VEC_SIZE - n);
+	}
+#endif
+      len = mask != 0 ? __builtin_ctz (mask) + 1 : n;
+      store_head (d, s, v, len);
+      return mask != 0 ? d + len : NULL;
+    }
+
+  /* Copy four vectors per iteration until one of them contains C.  */
+  while (n >= 4 * VEC_SIZE)
+    {
+      __m256i v0 = _mm256_loadu_si256 ((const __m256i *) s);
+      __m256i v1 = _mm256_loadu_si256 ((const __m256i *) (s + VEC_SIZE));
+      __m256i v2 = _mm256_loadu_si256 ((const __m256i *)
+				       (s + 2 * VEC_SIZE));
+      __m256i v3 = _mm256_loadu_si256 ((const __m256i *)
+				       (s + 3 * VEC_SIZE));
+      __m256i eq = _mm256_or_si256 (_mm256_or_si256
+				    (_mm256_cmpeq_epi8 (v0, vc),
+				     _mm256_cmpeq_epi8 (v1, vc)),
+				    _mm256_or_si256
+				    (_mm256_cmpeq_epi8 (v2, vc),
+				     _mm256_cmpeq_epi8 (v3, vc)));
+      if (!_mm256_testz_si256 (eq, eq))
+	break;
+      _mm256_storeu_si256 ((__m256i *) d, v0);
+      _mm256_storeu_si256 ((__m256i *) (d + VEC_SIZE), v1);
+      _mm256_storeu_si256 ((__m256i *) (d + 2 * VEC_SIZE), v2);
+      _mm256_storeu_si256 ((__m256i *) (d + 3 * VEC_SIZE), v3);
+      s += 4 * VEC_SIZE;
+      d += 4 * VEC_SIZE;
+      n -= 4 * VEC_SIZE;
+    }
+
+  while (n >= VEC_SIZE)
+    {
+      v = _mm256_loadu_si256 ((const __m256i *) s);
+      mask = match (v, vc);
+      if (mask != 0)
+	{
+	  len = __builtin_ctz (mask) + 1;
+	  store_head (d, s, v, len);
+	  return d + len;
+	}
+      _mm256_storeu_si256 ((__m256i *) d, v);
+      s += VEC_SIZE;
+      d += VEC_SIZE;
+      n -= VEC_SIZE;
+    }
+
+  if (n == 0)
+    return NULL;
+
+  /* The last vector of the source overlaps the bytes already
+     copied, which are stored again if C is not found.  */
+  v = _mm256_loadu_si256 ((const __m256i *) (s + n - VEC_SIZE));
+  mask = match (v, vc) >> (VEC_SIZE - n);
+  if (mask != 0)
+    {
+      len = __builtin_ctz (mask) + 1;
+      copy_short (d, s, len);
+      return d + len;
+    }
+  _mm256_storeu_si256 ((__m256i *) (d + n - VEC_SIZE), v);
+  return NULL;
+}
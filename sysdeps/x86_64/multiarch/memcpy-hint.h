@@ -0,0 +1,55 @@
+/* Cache bypassing copies for memcpy_hint.  x86-64 multiarch version.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _MEMCPY_HINT_H
+#define _MEMCPY_HINT_H 1
+
+#include <string.h>
+
+/* The entry points in memmove-vec-unaligned-erms.S.  They use the
+   loops of memmove for copies larger than
+   __x86_shared_non_temporal_threshold with the other kind of stores.  */
+extern void *__memcpy_nontemporal (void *__restrict, const void *__restrict,
+				   size_t) attribute_hidden;
+extern void *__memcpy_temporal (void *__restrict, const void *__restrict,
+				size_t) attribute_hidden;
+
+extern long int __x86_shared_non_temporal_threshold attribute_hidden;
+
+/* The non-temporal loops copy at least four pages at a time after
+   aligning the destination to 64 bytes.  */
+#define MEMCPY_NONTEMPORAL_MIN (4 * 4096 + 64)
+
+static inline void *
+memcpy_nontemporal (void *__restrict dest, const void *__restrict src,
+		    size_t n)
+{
+  return __memcpy_nontemporal (dest, src, n);
+}
+
+static inline void *
+memcpy_temporal (void *__restrict dest, const void *__restrict src,
+		 size_t n)
+{
+  /* Below the threshold memcpy does not use non-temporal stores.  */
+  if (n < __x86_shared_non_temporal_threshold)
+    return memcpy (dest, src, n);
+  return __memcpy_temporal (dest, src, n);
+}
+
+#endif /* memcpy-hint.h */
@@ -0,0 +1,30 @@
+/* Multiple versions of __memcpy_temporal for memcpy_hint.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Define multiple versions only for the definition in libc.  */
+#if IS_IN (libc)
+# define __memcpy_temporal __redirect_memcpy_temporal
+# include <memcpy-hint.h>
+# undef __memcpy_temporal
+
+# define SYMBOL_NAME memcpy_temporal
+# include "ifunc-memcpy-hint.h"
+
+libc_ifunc_redirected (__redirect_memcpy_temporal, __memcpy_temporal,
+		       IFUNC_SELECTOR ());
+#endif
@@ -0,0 +1,230 @@
+/* Vectorized memmem and strcasestr using first/last byte filtering.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The includer defines either MEMMEM or STRCASESTR to the name of the
+   function to define, and USE_EVEX to use AVX512VL/AVX512BW mask
+   compares instead of AVX2 byte masks.
+
+   Candidate positions are found 32 at a time by comparing the first
+   and the last byte of the needle against the haystack at the
+   corresponding offsets, and only candidates matching both are
+   verified.  This is much faster than the generic implementations for
+   typical inputs, but it is quadratic in the worst case.  The
+   verification work is therefore tracked, and the search continues in
+   the generic implementation, which has linear worst-case behavior,
+   once the work exceeds a small multiple of the scanned length.  */
+
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define VEC_SIZE 32
+
+#ifdef USE_EVEX
+# define VEC_CMPEQ_MASK(a, b) ((uint32_t) _mm256_cmpeq_epi8_mask (a, b))
+#else
+# define VEC_CMPEQ_MASK(a, b) \
+  ((uint32_t) _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (a, b)))
+#endif
+
+#ifdef STRCASESTR
+/* Only used in locales whose case mapping only affects ASCII letters,
+   as in the C locale.  */
+static inline unsigned char
+fold_byte (unsigned char c)
+{
+  return (unsigned char) (c - 'A') < 26 ? c | 0x20 : c;
+}
+
+static inline __m256i
+fold_vec (__m256i v)
+{
+# ifdef USE_EVEX
+  __mmask32 upper = _mm256_cmplt_epu8_mask (_mm256_sub_epi8
+					      (v, _mm256_set1_epi8 ('A')),
+					    _mm256_set1_epi8 (26));
+  return _mm256_mask_add_epi8 (v, upper, v, _mm256_set1_epi8 (0x20));
+# else
+  /* Shift 'A'..'Z' to the bottom of the signed range, so that a single
+     signed comparison detects them.  */
+  __m256i shifted = _mm256_add_epi8 (v, _mm256_set1_epi8 (0x80 - 'A'));
+  __m256i upper = _mm256_cmpgt_epi8 (_mm256_set1_epi8 (-128 + 26), shifted);
+  return _mm256_or_si256 (v, _mm256_and_si256 (upper,
+					       _mm256_set1_epi8 (0x20)));
+# endif
+}
+
+static inline int
+match_rest (const unsigned char *hs, const unsigned char *ne, size_t len)
+{
+  for (size_t i = 0; i < len; ++i)
+    if (fold_byte (hs[i]) != fold_byte (ne[i]))
+      return 0;
+  return 1;
+}
+#else
+# define fold_byte(c) (c)
+# define fold_vec(v) (v)
+# define match_rest(hs, ne, len) (memcmp (hs, ne, len) == 0)
+#endif
+
+/* Return the bit mask of the positions in the VEC_SIZE bytes starting
+   at P at which the first and the last byte of the needle match.  */
+static inline uint32_t
+candidates (const unsigned char *p, size_t last, __m256i first_vec,
+	    __m256i last_vec)
+{
+  __m256i head = fold_vec (_mm256_loadu_si256 ((const __m256i *) p));
+  __m256i tail = fold_vec (_mm256_loadu_si256 ((const __m256i *)
+					       (p + last)));
+  return VEC_CMPEQ_MASK (head, first_vec) & VEC_CMPEQ_MASK (tail, last_vec);
+}
+
+/* Search for NE of length NE_LEN in HS of length HS_LEN, where
+   HS_LEN - NE_LEN + 1 >= VEC_SIZE.  Returns NULL if there is no
+   match.  If the verification work exceeds the budget, *RESUME is
+   set to the offset at which the search has to continue with the
+   generic implementation.  */
+static inline const unsigned char *
+search_vec (const unsigned char *hs, size_t hs_len, const unsigned char *ne,
+	    size_t ne_len, size_t *resume)
+{
+  size_t last = ne_len - 1;
+  size_t npos = hs_len - last;
+  const __m256i first_vec = _mm256_set1_epi8 (fold_byte (ne[0]));
+  const __m256i last_vec = _mm256_set1_epi8 (fold_byte (ne[last]));
+  size_t work = 0;
+
+  for (size_t i = 0; ; i += VEC_SIZE)
+    {
+      uint32_t mask;
+      bool final = i + VEC_SIZE >= npos;
+      if (final)
+	{
+	  /* Check the remaining positions with an overlapping load,
+	     discarding the positions which have already been
+	     checked.  */
+	  size_t j = npos - VEC_SIZE;
+	  mask = candidates (hs + j, last, first_vec, last_vec) >> (i - j);
+	}
+      else
+	mask = candidates (hs + i, last, first_vec, last_vec);
+
+      while (mask != 0)
+	{
+	  size_t pos = i + __builtin_ctz (mask);
+	  /* Check the second byte inline before calling out to compare
+	     the rest of the needle.  */
+	  if (last < 2
+	      || (fold_byte (hs[pos + 1]) == fold_byte (ne[1])
+		  && match_rest (hs + pos + 2, ne + 2, last - 2)))
+	    return hs + pos;
+	  /* Charge each rejected candidate for its setup cost as well
+	     as for the bytes it may have compared.  */
+	  work += ne_len + 16;
+	  mask &= mask - 1;
+	}
+
+      if (final)
+	return NULL;
+
+      if (__glibc_unlikely (work > 2 * i + 1024))
+	{
+	  *resume = i + VEC_SIZE;
+	  return NULL;
+	}
+    }
+}
+
+#ifdef MEMMEM
+extern __typeof (memmem) __memmem_generic attribute_hidden;
+
+void *
+MEMMEM (const void *haystack, size_t hs_len, const void *needle,
+	size_t ne_len)
+{
+  const unsigned char *hs = haystack;
+  const unsigned char *ne = needle;
+
+  if (ne_len == 0)
+    return (void *) hs;
+  if (ne_len == 1)
+    return memchr (hs, ne[0], hs_len);
+  if (hs_len < ne_len + VEC_SIZE - 1)
+    return __memmem_generic (hs, hs_len, ne, ne_len);
+
+  size_t resume = 0;
+  const unsigned char *result = search_vec (hs, hs_len, ne, ne_len, &resume);
+  if (__glibc_likely (result != NULL || resume == 0))
+    return (void *) result;
+  return __memmem_generic (hs + resume, hs_len - resume, ne, ne_len);
+}
+#endif
+
+#ifdef STRCASESTR
+# include <locale/localeinfo.h>
+
+extern __typeof (strcasestr) __strcasestr_generic attribute_hidden;
+
+char *
+STRCASESTR (const char *haystack, const char *needle)
+{
+  if (_NL_CURRENT_WORD (LC_CTYPE, _NL_CTYPE_NONASCII_CASE) != 0)
+    return __strcasestr_generic (haystack, needle);
+
+  size_t ne_len = strlen (needle);
+  if (ne_len == 0)
+    return (char *) haystack;
+
+  /* The length of the haystack is not computed up front, because a
+     match is usually found long before its end.  Instead the haystack
+     is searched in windows of increasing size, each overlapping the
+     previous one by NE_LEN - 1 bytes.  KNOWN is the number of bytes at
+     the start of the haystack which are known not to contain the null
+     terminator, so that the overlap is not scanned again.  */
+  const unsigned char *hs = (const unsigned char *) haystack;
+  size_t known = 0;
+  size_t base = 0;
+  size_t window = 4 * VEC_SIZE;
+  while (true)
+    {
+      size_t want = base + ne_len - 1 + window;
+      known += __strnlen (haystack + known, want - known);
+      bool end = known < want;
+      size_t avail = known - base;
+      if (avail < ne_len + VEC_SIZE - 1)
+	return __strcasestr_generic (haystack + base, needle);
+
+      size_t resume = 0;
+      const unsigned char *result
+	= search_vec (hs + base, avail, (const unsigned char *) needle,
+		      ne_len, &resume);
+      if (result != NULL)
+	return (char *) result;
+      if (resume != 0)
+	return __strcasestr_generic (haystack + base + resume, needle);
+      if (end)
+	return NULL;
+
+      base += avail - (ne_len - 1);
+      if (window < 64 * 1024)
+	window *= 2;
+    }
+}
+#endif
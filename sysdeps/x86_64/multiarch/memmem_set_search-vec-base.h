@@ -0,0 +1,122 @@
+/* Vectorized memmem_set_search using a Teddy style bucket filter.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The includer defines MEMMEM_SET_SEARCH to the name of the function to
+   define, and USE_EVEX to use AVX512VL/AVX512BW mask tests instead of
+   AVX2 byte masks.
+
+   Candidate positions are found 32 at a time by looking up the low and
+   the high nibble of the first MEMMEM_SET_FILTER_LEN bytes at each
+   position in the bucket tables of the set with VPSHUFB.  A position is
+   a candidate if the bytes match the needles of some bucket, and only
+   candidates are verified.  */
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+#include <string/memmem-set.h>
+
+#define VEC_SIZE 32
+
+extern __typeof (memmem_set_search) __memmem_set_search_generic
+  attribute_hidden;
+
+/* Return for each of the VEC_SIZE bytes at P the buckets with a needle
+   which has that byte at the offset whose tables are LO and HI.  */
+static inline __m256i
+filter_vec (const unsigned char *p, __m256i lo, __m256i hi)
+{
+  const __m256i nibble = _mm256_set1_epi8 (0x0f);
+  __m256i v = _mm256_loadu_si256 ((const __m256i *) p);
+  __m256i l = _mm256_shuffle_epi8 (lo, _mm256_and_si256 (v, nibble));
+  __m256i h = _mm256_shuffle_epi8 (hi, _mm256_and_si256
+				       (_mm256_srli_epi16 (v, 4), nibble));
+  return _mm256_and_si256 (l, h);
+}
+
+static inline __m256i
+load_table (const unsigned char *table)
+{
+  return _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *)
+						       table));
+}
+
+void *
+MEMMEM_SET_SEARCH (const struct memmem_set *set, const void *haystack,
+		   size_t haystacklen, size_t *index)
+{
+  const unsigned char *hs = haystack;
+
+  if (!set->use_filter
+      || haystacklen < VEC_SIZE + MEMMEM_SET_FILTER_LEN - 1)
+    return __memmem_set_search_generic (set, haystack, haystacklen, index);
+
+  _Static_assert (MEMMEM_SET_FILTER_LEN == 3, "filter length");
+  const __m256i lo0 = load_table (set->lo[0]);
+  const __m256i hi0 = load_table (set->hi[0]);
+  const __m256i lo1 = load_table (set->lo[1]);
+  const __m256i hi1 = load_table (set->hi[1]);
+  const __m256i lo2 = load_table (set->lo[2]);
+  const __m256i hi2 = load_table (set->hi[2]);
+
+  /* The filter reads MEMMEM_SET_FILTER_LEN - 1 bytes past the last
+     position of each vector.  */
+  size_t last = haystacklen - (VEC_SIZE + MEMMEM_SET_FILTER_LEN - 1);
+  size_t i = 0;
+  size_t found;
+  for (; i <= last; i += VEC_SIZE)
+    {
+      const unsigned char *p = hs + i;
+      __m256i c = _mm256_and_si256 (filter_vec (p, lo0, hi0),
+				    _mm256_and_si256
+				    (filter_vec (p + 1, lo1, hi1),
+				     filter_vec (p + 2, lo2, hi2)));
+#ifdef USE_EVEX
+      uint32_t mask = _mm256_test_epi8_mask (c, c);
+#else
+      uint32_t mask = ~(uint32_t) _mm256_movemask_epi8
+	(_mm256_cmpeq_epi8 (c, _mm256_setzero_si256 ()));
+#endif
+      while (mask != 0)
+	{
+	  size_t pos = i + __builtin_ctz (mask);
+	  found = memmem_set_match (set, hs + pos, haystacklen - pos);
+	  if (found < set->count)
+	    {
+	      i = pos;
+	      goto done;
+	    }
+	  mask &= mask - 1;
+	}
+    }
+
+  /* Check the remaining positions without the filter.  */
+  for (; i + set->min_len <= haystacklen; i++)
+    if (memmem_set_maybe (set, hs + i))
+      {
+	found = memmem_set_match (set, hs + i, haystacklen - i);
+	if (found < set->count)
+	  goto done;
+      }
+  return NULL;
+
+ done:
+  if (index != NULL)
+    *index = found;
+  return (void *) (hs + i);
+}
@@ -0,0 +1,100 @@
+/* Vectorized strcmp_batch.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The includer defines STRCMP_BATCH to the name of the function to
+   define, and USE_EVEX to use AVX512VL/AVX512BW mask compares instead
+   of AVX2 byte masks.
+
+   The strings of typical arrays are short, so they are compared inline,
+   which avoids a function call and a VZEROUPPER per pair.  Pairs
+   which are equal in their first few vectors are passed to strcmp.  */
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+#define VEC_SIZE 32
+#define PAGE_SIZE 4096
+
+/* Number of vectors compared inline before calling strcmp.  */
+#define INLINE_VECS 4
+
+/* Return the bit mask of the positions at which A and B differ or A
+   has a null byte.  */
+static inline uint32_t
+diff_or_nul_mask (__m256i a, __m256i b)
+{
+#ifdef USE_EVEX
+  return _mm256_cmpneq_epi8_mask (a, b) | _mm256_testn_epi8_mask (a, a);
+#else
+  /* The bytes of A where A and B are equal and 0 elsewhere.  */
+  __m256i eq = _mm256_min_epu8 (a, _mm256_cmpeq_epi8 (a, b));
+  return _mm256_movemask_epi8 (_mm256_cmpeq_epi8
+			       (eq, _mm256_setzero_si256 ()));
+#endif
+}
+
+/* Return true if an unaligned load at P may cross into the next
+   page.  */
+static inline int
+page_cross (const unsigned char *p)
+{
+  return ((uintptr_t) p & (PAGE_SIZE - 1)) > PAGE_SIZE - VEC_SIZE;
+}
+
+void
+STRCMP_BATCH (int *results, const char *const *s1, const char *const *s2,
+	      size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    {
+      const unsigned char *a = (const unsigned char *) s1[i];
+      const unsigned char *b = (const unsigned char *) s2[i];
+      size_t j;
+
+      for (int k = 0; k < INLINE_VECS; k++)
+	{
+	  if (__glibc_unlikely (page_cross (a) || page_cross (b)))
+	    {
+	      for (j = 0; j < VEC_SIZE; j++)
+		if (a[j] != b[j] || a[j] == '\0')
+		  goto done;
+	    }
+	  else
+	    {
+	      uint32_t mask = diff_or_nul_mask
+		(_mm256_loadu_si256 ((const __m256i *) a),
+		 _mm256_loadu_si256 ((const __m256i *) b));
+	      if (mask != 0)
+		{
+		  j = __builtin_ctz (mask);
+		  goto done;
+		}
+	    }
+	  a += VEC_SIZE;
+	  b += VEC_SIZE;
+	}
+
+      int r = strcmp ((const char *) a, (const char *) b);
+      results[i] = (r > 0) - (r < 0);
+      continue;
+
+    done:
+      results[i] = (a[j] > b[j]) - (a[j] < b[j]);
+    }
+}
@@ -0,0 +1,305 @@
+/* Vectorized strspn, strcspn and strpbrk and their wide character
+   versions using a nibble lookup to classify characters.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* This file is included by the AVX2 and EVEX variants of strspn,
+   strcspn, strpbrk, wcsspn, wcscspn and wcspbrk.  The includer
+   defines STRCSPN as the name of the function to define and
+   STRCSPN_GENERIC as the generic fallback, USE_AS_STRSPN or
+   USE_AS_STRPBRK to select the function, USE_AS_WCSCSPN for the wide
+   character versions, and USE_EVEX to use AVX512VL/AVX512BW mask
+   tests.  The includer may instead define STRTOK_R or STRSEP as the
+   name of a strtok_r or strsep function, which then build the set
+   once and scan the tokens with it.
+
+   The characters of the set are recorded in two 16-byte tables
+   indexed by the low nibble of a byte, one for the bytes 0x00..0x7f
+   and one for the bytes 0x80..0xff, in which bit N of an entry is set
+   if the byte with the high nibble N (modulo 8) is in the set.  Two
+   VPSHUFB lookups then give the table entry for 32 bytes at a time,
+   and a third one the bit to test, so that sets of any size are
+   handled at the same speed.  The wide character versions classify
+   the low byte of each character and additionally require the other
+   three bytes to be zero, so they fall back to the generic code if
+   the set contains characters outside of 0..255.  */
+
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <wchar.h>
+
+#define VEC_SIZE 32
+
+#ifdef USE_AS_WCSCSPN
+# define CHAR wchar_t
+# define UCHAR uint32_t
+# define STRCHRNUL __wcschrnul
+/* Bit mask of the first byte of each character in a vector.  */
+# define CHAR_MASK 0x11111111U
+#else
+# define CHAR char
+# define UCHAR unsigned char
+# define STRCHRNUL __strchrnul
+# define CHAR_MASK 0xffffffffU
+#endif
+
+#ifdef STRCSPN
+# ifdef USE_AS_STRPBRK
+#  define RETURN_TYPE CHAR *
+# else
+#  define RETURN_TYPE size_t
+# endif
+
+extern RETURN_TYPE STRCSPN_GENERIC (const CHAR *, const CHAR *)
+  attribute_hidden;
+#endif
+
+struct char_class
+{
+  __m256i low;
+  __m256i high;
+};
+
+/* Fill in CLS for the characters in SET, and the null character if
+   WITH_NUL.  Return false if the set cannot be represented.  */
+static inline bool
+build_class (struct char_class *cls, const CHAR *set, bool with_nul)
+{
+  /* The tables are built in registers, since byte stores followed by
+     a vector load would stall on store forwarding.  */
+  const __m128i index = _mm_setr_epi8 (0, 1, 2, 3, 4, 5, 6, 7,
+				       8, 9, 10, 11, 12, 13, 14, 15);
+  __m128i low = _mm_cvtsi32_si128 (with_nul);
+  __m128i high = _mm_setzero_si128 ();
+
+  for (; *set != 0; ++set)
+    {
+      UCHAR c = *set;
+#ifdef USE_AS_WCSCSPN
+      if (c > 0xff)
+	return false;
+#endif
+      __m128i entry = _mm_and_si128 (_mm_cmpeq_epi8 (index,
+						     _mm_set1_epi8 (c & 15)),
+				     _mm_set1_epi8 (1 << ((c >> 4) & 7)));
+      __m128i is_high = _mm_set1_epi8 (-(c >> 7));
+      low = _mm_or_si128 (low, _mm_andnot_si128 (is_high, entry));
+      high = _mm_or_si128 (high, _mm_and_si128 (is_high, entry));
+    }
+
+  cls->low = _mm256_broadcastsi128_si256 (low);
+  cls->high = _mm256_broadcastsi128_si256 (high);
+  return true;
+}
+
+/* Return the bit mask of the characters in the vector at P which are
+   members of CLS.  For wide characters, only the bit of the first byte
+   of a character is set.  */
+static inline uint32_t
+class_mask (const struct char_class *cls, const char *p)
+{
+  const __m256i bits = _mm256_setr_epi8 (1, 2, 4, 8, 16, 32, 64, -128,
+					 1, 2, 4, 8, 16, 32, 64, -128,
+					 1, 2, 4, 8, 16, 32, 64, -128,
+					 1, 2, 4, 8, 16, 32, 64, -128);
+  __m256i v = _mm256_load_si256 ((const __m256i *) p);
+
+  /* VPSHUFB yields zero for indices with the top bit set, so each
+     byte is only looked up in the table for its half of the byte
+     range.  */
+  __m256i row = _mm256_or_si256 (_mm256_shuffle_epi8 (cls->low, v),
+				 _mm256_shuffle_epi8
+				 (cls->high,
+				  _mm256_xor_si256 (v, _mm256_set1_epi8
+						    (-128))));
+  __m256i bit = _mm256_shuffle_epi8 (bits,
+				     _mm256_and_si256
+				     (_mm256_srli_epi16 (v, 4),
+				      _mm256_set1_epi8 (15)));
+#ifdef USE_EVEX
+  uint32_t mask = _mm256_test_epi8_mask (row, bit);
+#else
+  uint32_t mask = ~_mm256_movemask_epi8
+    (_mm256_cmpeq_epi8 (_mm256_and_si256 (row, bit),
+			_mm256_setzero_si256 ()));
+#endif
+
+#ifdef USE_AS_WCSCSPN
+  /* Drop the characters with non-zero upper bytes.  */
+# ifdef USE_EVEX
+  uint32_t upper = _mm256_test_epi8_mask (v, v);
+# else
+  uint32_t upper = ~_mm256_movemask_epi8
+    (_mm256_cmpeq_epi8 (v, _mm256_setzero_si256 ()));
+# endif
+  upper &= ~CHAR_MASK;
+  upper = (upper >> 1) | (upper >> 2) | (upper >> 3);
+  mask &= ~upper;
+#endif
+
+  return mask & CHAR_MASK;
+}
+
+/* Return the bit mask of the characters in the vector at P which end
+   the initial segment, which consists of the members of CLS if SPN
+   and of the other characters otherwise.  */
+static inline uint32_t
+stop_mask (const struct char_class *cls, const char *p, bool spn)
+{
+  if (spn)
+    return ~class_mask (cls, p) & CHAR_MASK;
+  return class_mask (cls, p);
+}
+
+/* Return the length of the initial segment of S as selected by SPN.
+   The null character must end the segment.  */
+static inline size_t
+scan (const CHAR *s, const struct char_class *cls, bool spn)
+{
+  /* Aligned loads never cross a page boundary.  The bytes before S in
+     the first vector are shifted out of the mask.  */
+  uintptr_t offset = (uintptr_t) s & (VEC_SIZE - 1);
+  const char *p = (const char *) s - offset;
+  uint32_t mask = stop_mask (cls, p, spn) >> offset;
+  if (mask != 0)
+    return __builtin_ctz (mask) / sizeof (CHAR);
+
+  do
+    {
+      p += VEC_SIZE;
+      mask = stop_mask (cls, p, spn);
+    }
+  while (mask == 0);
+
+  return (p + __builtin_ctz (mask) - (const char *) s) / sizeof (CHAR);
+}
+
+#if defined STRCSPN && defined USE_AS_STRSPN
+size_t
+STRCSPN (const CHAR *s, const CHAR *accept)
+{
+  if (accept[0] == 0)
+    return 0;
+
+  struct char_class cls;
+  if (!build_class (&cls, accept, false))
+    return STRCSPN_GENERIC (s, accept);
+  return scan (s, &cls, true);
+}
+#elif defined STRCSPN
+RETURN_TYPE
+STRCSPN (const CHAR *s, const CHAR *reject)
+{
+  size_t len;
+  if (reject[0] == 0 || reject[1] == 0)
+    len = STRCHRNUL (s, reject[0]) - s;
+  else
+    {
+      struct char_class cls;
+      if (!build_class (&cls, reject, true))
+	return STRCSPN_GENERIC (s, reject);
+      len = scan (s, &cls, false);
+    }
+# ifdef USE_AS_STRPBRK
+  return s[len] != 0 ? (CHAR *) s + len : NULL;
+# else
+  return len;
+# endif
+}
+#endif
+
+#ifdef STRTOK_R
+/* Add the null character to CLS, which was built without it.  */
+static inline void
+add_nul (struct char_class *cls)
+{
+  cls->low = _mm256_or_si256 (cls->low,
+			      _mm256_setr_epi32 (1, 0, 0, 0, 1, 0, 0, 0));
+}
+
+char *
+STRTOK_R (char *s, const char *delim, char **save_ptr)
+{
+  char *end;
+
+  if (s == NULL)
+    s = *save_ptr;
+
+  if (*s == '\0')
+    {
+      *save_ptr = s;
+      return NULL;
+    }
+
+  /* The same table is used to skip the leading delimiters and to find
+     the end of the token, which is usually in the vector already
+     loaded by the first scan.  */
+  struct char_class cls;
+  build_class (&cls, delim, false);
+  s += scan (s, &cls, true);
+  if (*s == '\0')
+    {
+      *save_ptr = s;
+      return NULL;
+    }
+
+  add_nul (&cls);
+  end = s + scan (s, &cls, false);
+  if (*end == '\0')
+    {
+      *save_ptr = end;
+      return s;
+    }
+
+  *end = '\0';
+  *save_ptr = end + 1;
+  return s;
+}
+#endif
+
+#ifdef STRSEP
+char *
+STRSEP (char **stringp, const char *delim)
+{
+  char *begin, *end;
+
+  begin = *stringp;
+  if (begin == NULL)
+    return NULL;
+
+  if (delim[0] == 0 || delim[1] == 0)
+    end = __strchrnul (begin, delim[0]);
+  else
+    {
+      struct char_class cls;
+      build_class (&cls, delim, true);
+      end = begin + scan (begin, &cls, false);
+    }
+
+  if (*end)
+    {
+      *end++ = '\0';
+      *stringp = end;
+    }
+  else
+    *stringp = NULL;
+
+  return begin;
+}
+#endif
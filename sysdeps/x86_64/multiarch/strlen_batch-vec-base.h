@@ -0,0 +1,79 @@
+/* Vectorized strlen_batch.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The includer defines STRLEN_BATCH to the name of the function to
+   define, and USE_EVEX to use AVX512VL/AVX512BW mask tests instead of
+   AVX2 byte masks.
+
+   The strings of typical arrays are short, so the lengths are computed
+   inline, which avoids a function call and a VZEROUPPER per
+   string.  Strings which are longer than a few vectors are passed to
+   strlen.  */
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+#define VEC_SIZE 32
+
+/* Number of vectors checked inline before calling strlen.  */
+#define INLINE_VECS 4
+
+#ifdef USE_EVEX
+# define VEC_ZERO_MASK(v) ((uint32_t) _mm256_testn_epi8_mask (v, v))
+#else
+# define VEC_ZERO_MASK(v) \
+  ((uint32_t) _mm256_movemask_epi8 (_mm256_cmpeq_epi8 \
+				    (v, _mm256_setzero_si256 ())))
+#endif
+
+void
+STRLEN_BATCH (size_t *lengths, const char *const *strings, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    {
+      const char *s = strings[i];
+      /* Aligned loads never cross a page boundary.  */
+      uintptr_t off = (uintptr_t) s % VEC_SIZE;
+      const char *p = s - off;
+      __m256i v = _mm256_load_si256 ((const __m256i *) p);
+      uint32_t mask = VEC_ZERO_MASK (v) >> off;
+      if (mask != 0)
+	{
+	  lengths[i] = __builtin_ctz (mask);
+	  continue;
+	}
+
+      for (int k = 1; ; k++)
+	{
+	  p += VEC_SIZE;
+	  if (k == INLINE_VECS)
+	    {
+	      lengths[i] = p - s + strlen (p);
+	      break;
+	    }
+	  v = _mm256_load_si256 ((const __m256i *) p);
+	  mask = VEC_ZERO_MASK (v);
+	  if (mask != 0)
+	    {
+	      lengths[i] = p - s + __builtin_ctz (mask);
+	      break;
+	    }
+	}
+    }
+}
@@ -0,0 +1,45 @@
+/* Multiple versions of strsep.
+   All versions must be listed in ifunc-impl-list.c.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Define multiple versions only for the definition in libc.  */
+#if IS_IN (libc)
+# define strsep __redirect_strsep
+# define __strsep __redirect___strsep
+# define __strsep_g __redirect___strsep_g
+# include <string.h>
+# undef strsep
+# undef __strsep
+# undef __strsep_g
+
+# define SYMBOL_NAME strsep
+# include "ifunc-c-vector.h"
+
+libc_ifunc_redirected (__redirect___strsep, __strsep, IFUNC_SELECTOR ());
+weak_alias (__strsep, strsep)
+strong_alias (__strsep, __strsep_g)
+
+# ifdef SHARED
+__hidden_ver1 (__strsep, __GI___strsep, __redirect___strsep)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (__strsep);
+__hidden_ver1 (__strsep, __GI___strsep_g, __redirect___strsep_g)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (__strsep);
+# endif
+#else
+# include <string/strsep.c>
+#endif
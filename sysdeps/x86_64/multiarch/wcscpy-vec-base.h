@@ -0,0 +1,269 @@
+/* Vectorized wcscpy, wcpcpy, wcscat, wcsncpy and wcsncat.
+   Copyright (C) 2022 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* This file is included by the AVX2 and EVEX variants of the wide
+   character copy functions.  The includer defines WCSCPY as the name
+   of the function to define, one of USE_AS_WCPCPY, USE_AS_WCSCAT,
+   USE_AS_WCSNCPY or USE_AS_WCSNCAT to select a function other than
+   wcscpy, and USE_EVEX to use AVX512VL/AVX512BW mask compares.
+
+   The generic versions call __wcslen or __wcsnlen and then __wmemcpy,
+   which costs two calls and two passes over the source.  wcscpy,
+   wcpcpy and wcscat find the terminator and copy in a single pass:
+   the source is read with aligned loads, which never cross a page
+   boundary, short strings are copied with overlapping loads and
+   stores, and the main loop loads four vectors before storing them.
+   wcsncpy and wcsncat get the length from __wcsnlen, but copy and pad
+   inline unless the sizes are large.  */
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+#include <wchar.h>
+
+#define VEC_SIZE 32
+#define VEC_CHARS (VEC_SIZE / sizeof (wchar_t))
+
+/* Return the bit mask of the null characters in the aligned vector
+   at P.  */
+static inline uint32_t
+null_mask (const wchar_t *p)
+{
+  __m256i v = _mm256_load_si256 ((const __m256i *) p);
+#ifdef USE_EVEX
+  return _mm256_cmpeq_epi32_mask (v, _mm256_setzero_si256 ());
+#else
+  return _mm256_movemask_ps (_mm256_castsi256_ps
+			     (_mm256_cmpeq_epi32 (v,
+						  _mm256_setzero_si256 ())));
+#endif
+}
+
+/* Copy N characters from SRC to DST, where 1 <= N <= VEC_CHARS,
+   without accessing any other characters.  */
+static inline void
+copy_small (wchar_t *dst, const wchar_t *src, size_t n)
+{
+  if (n >= 4)
+    {
+      __m128i head = _mm_loadu_si128 ((const __m128i *) src);
+      __m128i tail = _mm_loadu_si128 ((const __m128i *) (src + n - 4));
+      _mm_storeu_si128 ((__m128i *) dst, head);
+      _mm_storeu_si128 ((__m128i *) (dst + n - 4), tail);
+    }
+  else if (n >= 2)
+    {
+      uint64_t head, tail;
+      memcpy (&head, src, sizeof head);
+      memcpy (&tail, src + n - 2, sizeof tail);
+      memcpy (dst, &head, sizeof head);
+      memcpy (dst + n - 2, &tail, sizeof tail);
+    }
+  else
+    dst[0] = src[0];
+}
+
+/* Copy N characters from SRC to DST, where N >= 1.  */
+static inline void
+copy_len (wchar_t *dst, const wchar_t *src, size_t n)
+{
+  if (n <= VEC_CHARS)
+    copy_small (dst, src, n);
+  else if (n <= 2 * VEC_CHARS)
+    {
+      __m256i head = _mm256_loadu_si256 ((const __m256i *) src);
+      __m256i tail = _mm256_loadu_si256 ((const __m256i *)
+					 (src + n - VEC_CHARS));
+      _mm256_storeu_si256 ((__m256i *) dst, head);
+      _mm256_storeu_si256 ((__m256i *) (dst + n - VEC_CHARS), tail);
+    }
+  else if (n <= 4 * VEC_CHARS)
+    {
+      __m256i head0 = _mm256_loadu_si256 ((const __m256i *) src);
+      __m256i head1 = _mm256_loadu_si256 ((const __m256i *)
+					  (src + VEC_CHARS));
+      __m256i tail1 = _mm256_loadu_si256 ((const __m256i *)
+					  (src + n - 2 * VEC_CHARS));
+      __m256i tail0 = _mm256_loadu_si256 ((const __m256i *)
+					  (src + n - VEC_CHARS));
+      _mm256_storeu_si256 ((__m256i *) dst, head0);
+      _mm256_storeu_si256 ((__m256i *) (dst + VEC_CHARS), head1);
+      _mm256_storeu_si256 ((__m256i *) (dst + n - 2 * VEC_CHARS), tail1);
+      _mm256_storeu_si256 ((__m256i *) (dst + n - VEC_CHARS), tail0);
+    }
+  else
+    __wmemcpy (dst, src, n);
+}
+
+#ifdef USE_AS_WCSNCPY
+/* Set N characters at DST to L'\0'.  */
+static inline void
+zero_len (wchar_t *dst, size_t n)
+{
+  const __m256i zero = _mm256_setzero_si256 ();
+
+  if (n < VEC_CHARS)
+    {
+      for (size_t i = 0; i < n; ++i)
+	dst[i] = L'\0';
+    }
+  else if (n <= 2 * VEC_CHARS)
+    {
+      _mm256_storeu_si256 ((__m256i *) dst, zero);
+      _mm256_storeu_si256 ((__m256i *) (dst + n - VEC_CHARS), zero);
+    }
+  else
+    __wmemset (dst, L'\0', n);
+}
+#else
+static inline void
+copy_vec (wchar_t *dst, const wchar_t *src)
+{
+  _mm256_storeu_si256 ((__m256i *) dst,
+		       _mm256_loadu_si256 ((const __m256i *) src));
+}
+
+/* Copy SRC including the terminator to DST and return the position of
+   the terminator in DST.  */
+static inline wchar_t *
+copy_string (wchar_t *dst, const wchar_t *src)
+{
+  /* Aligned loads never cross a page boundary.  The characters before
+     SRC in the first vector are shifted out of the mask.  */
+  uintptr_t offset = ((uintptr_t) src & (VEC_SIZE - 1)) / sizeof (wchar_t);
+  const wchar_t *p = src - offset;
+  uint32_t mask = null_mask (p) >> offset;
+  size_t len;
+
+  if (mask != 0)
+    {
+      len = __builtin_ctz (mask);
+      copy_small (dst, src, len + 1);
+      return dst + len;
+    }
+
+  for (int i = 0; i < 3; ++i)
+    {
+      p += VEC_CHARS;
+      mask = null_mask (p);
+      if (mask != 0)
+	{
+	  len = p - src + __builtin_ctz (mask);
+	  copy_len (dst, src, len + 1);
+	  return dst + len;
+	}
+    }
+
+  /* There are at least 3 * VEC_CHARS characters before the
+     terminator.  Copy them, then the aligned vectors up to a
+     4 * VEC_SIZE boundary, so that the main loop can load four vectors
+     at a time without crossing a page boundary.  */
+  __m256i v0 = _mm256_loadu_si256 ((const __m256i *) src);
+  __m256i v1 = _mm256_loadu_si256 ((const __m256i *) (src + VEC_CHARS));
+  __m256i v2 = _mm256_loadu_si256 ((const __m256i *) (src
+						      + 2 * VEC_CHARS));
+  _mm256_storeu_si256 ((__m256i *) dst, v0);
+  _mm256_storeu_si256 ((__m256i *) (dst + VEC_CHARS), v1);
+  _mm256_storeu_si256 ((__m256i *) (dst + 2 * VEC_CHARS), v2);
+  copy_vec (dst + (p - src), p);
+  p += VEC_CHARS;
+
+  while (((uintptr_t) p & (4 * VEC_SIZE - 1)) != 0)
+    {
+      mask = null_mask (p);
+      if (mask != 0)
+	goto found;
+      copy_vec (dst + (p - src), p);
+      p += VEC_CHARS;
+    }
+
+  while (1)
+    {
+      v0 = _mm256_load_si256 ((const __m256i *) p);
+      v1 = _mm256_load_si256 ((const __m256i *) (p + VEC_CHARS));
+      v2 = _mm256_load_si256 ((const __m256i *) (p + 2 * VEC_CHARS));
+      __m256i v3 = _mm256_load_si256 ((const __m256i *) (p
+							 + 3 * VEC_CHARS));
+      __m256i min = _mm256_min_epu32 (_mm256_min_epu32 (v0, v1),
+				      _mm256_min_epu32 (v2, v3));
+      if (!_mm256_testz_si256 (_mm256_cmpeq_epi32
+			       (min, _mm256_setzero_si256 ()),
+			       _mm256_set1_epi32 (-1)))
+	break;
+      wchar_t *d = dst + (p - src);
+      _mm256_storeu_si256 ((__m256i *) d, v0);
+      _mm256_storeu_si256 ((__m256i *) (d + VEC_CHARS), v1);
+      _mm256_storeu_si256 ((__m256i *) (d + 2 * VEC_CHARS), v2);
+      _mm256_storeu_si256 ((__m256i *) (d + 3 * VEC_CHARS), v3);
+      p += 4 * VEC_CHARS;
+    }
+
+  /* One of the four vectors at P contains the terminator.  */
+  while ((mask = null_mask (p)) == 0)
+    {
+      copy_vec (dst + (p - src), p);
+      p += VEC_CHARS;
+    }
+
+ found:
+  len = p - src + __builtin_ctz (mask);
+  copy_vec (dst + len + 1 - VEC_CHARS, src + len + 1 - VEC_CHARS);
+  return dst + len;
+}
+#endif
+
+#if defined USE_AS_WCSNCPY
+wchar_t *
+WCSCPY (wchar_t *dst, const wchar_t *src, size_t n)
+{
+  size_t len = __wcsnlen (src, n);
+  if (len != 0)
+    copy_len (dst, src, len);
+  zero_len (dst + len, n - len);
+  return dst;
+}
+#elif defined USE_AS_WCSNCAT
+wchar_t *
+WCSCPY (wchar_t *dst, const wchar_t *src, size_t n)
+{
+  wchar_t *end = dst + __wcslen (dst);
+  size_t len = __wcsnlen (src, n);
+  end[len] = L'\0';
+  if (len != 0)
+    copy_len (end, src, len);
+  return dst;
+}
+#elif defined USE_AS_WCSCAT
+wchar_t *
+WCSCPY (wchar_t *dst, const wchar_t *src)
+{
+  copy_string (dst + __wcslen (dst), src);
+  return dst;
+}
+#else
+wchar_t *
+WCSCPY (wchar_t *dst, const wchar_t *src)
+{
+# ifdef USE_AS_WCPCPY
+  return copy_string (dst, src);
+# else
+  copy_string (dst, src);
+  return dst;
+# endif
+}
+#endif
@@ -26,6 +26,8 @@
 # define SYMBOL_NAME wcscpy
 # include <init-arch.h>
 
+extern __typeof (REDIRECT_NAME) OPTIMIZE (evex) attribute_hidden;
+extern __typeof (REDIRECT_NAME) OPTIMIZE (avx2) attribute_hidden;
 extern __typeof (REDIRECT_NAME) OPTIMIZE (ssse3) attribute_hidden;
 
 extern __typeof (REDIRECT_NAME) OPTIMIZE (generic) attribute_hidden;
@@ -35,6 +37,23 @@ IFUNC_SELECTOR (void)
 {
   const struct cpu_features* cpu_features = __get_cpu_features ();
 
+  /* The vector versions are written in C, so the compiler emits
+     VZEROUPPER, which aborts RTM transactions.  There are no RTM
+     variants, so do not use them if RTM is usable.  */
+  if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, AVX2)
+      && X86_ISA_CPU_FEATURES_ARCH_P (cpu_features,
+				      AVX_Fast_Unaligned_Load, )
+      && X86_ISA_CPU_FEATURES_ARCH_P (cpu_features,
+				      Prefer_No_VZEROUPPER, !)
+      && !CPU_FEATURE_USABLE_P (cpu_features, RTM))
+    {
+      if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, AVX512VL)
+	  && X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, AVX512BW))
+	return OPTIMIZE (evex);
+
+      return OPTIMIZE (avx2);
+    }
+
   if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, SSSE3))
     return OPTIMIZE (ssse3);
 